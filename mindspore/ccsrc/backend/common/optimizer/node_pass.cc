@@ -65,6 +65,12 @@ bool NodePass::Run(const FuncGraphPtr &func_graph) {
   FuncGraphManagerPtr manager = func_graph->manager();
   MS_EXCEPTION_IF_NULL(manager);
   manager->AddFuncGraph(func_graph);
+  visited_node_num_ = 0;
+  matched_node_num_ = 0;
+  changed_node_num_ = 0;
+  if (!HasCandidateNodes(manager)) {
+    return false;
+  }
 
   mindspore::HashMap<AnfNodePtr, AnfNodePtr> subgraph_out_caller_map = {};
   mindspore::HashSet<AnfNodePtr> seen_node;
@@ -79,9 +85,13 @@ bool NodePass::Run(const FuncGraphPtr &func_graph) {
       continue;
     }
     (void)seen_node.insert(node);
+    ++visited_node_num_;
     TraceGuard guard(std::make_shared<TraceOpt>(node->debug_info()));
     AnfNodePtr new_node = Run(fg, node);
     bool change = (new_node != nullptr);
+    if (change) {
+      ++changed_node_num_;
+    }
     if (new_node != nullptr && new_node != node) {
       auto find_iter = subgraph_out_caller_map.find(node);
       if (find_iter != subgraph_out_caller_map.end()) {
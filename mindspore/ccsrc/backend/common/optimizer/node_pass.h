@@ -30,6 +30,21 @@ class BACKEND_EXPORT NodePass : public Pass {
   ~NodePass() override = default;
   bool Run(const FuncGraphPtr &func_graph) final;
   virtual AnfNodePtr Run(const FuncGraphPtr &func_graph, const AnfNodePtr &node) = 0;
+  // Whether there are candidate nodes of the pass in the graph, the traversal is skipped if not.
+  virtual bool HasCandidateNodes(const FuncGraphManagerPtr &) { return true; }
+  size_t visited_node_num() const { return visited_node_num_; }
+  size_t matched_node_num() const { return matched_node_num_; }
+  size_t changed_node_num() const { return changed_node_num_; }
+
+ protected:
+  // Called by the pass matching a pattern, the matched node may still be left unchanged.
+  void AddMatchedNode() { ++matched_node_num_; }
+
+ private:
+  // The statistics of the last run.
+  size_t visited_node_num_{0};
+  size_t matched_node_num_{0};
+  size_t changed_node_num_{0};
 };
 using NodePassPtr = std::shared_ptr<NodePass>;
 }  // namespace opt
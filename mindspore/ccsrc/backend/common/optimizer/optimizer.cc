@@ -56,12 +56,26 @@ AnfNodePtr PatternProcessPass::Run(const FuncGraphPtr &func_graph, const AnfNode
     equiv_->clear();
     EquivPtr equiv = pattern_engine_.Match(pattern_, node, *primitive_vars_, equiv_);
     if (equiv != nullptr && !equiv->empty()) {
+      AddMatchedNode();
       return Process(func_graph, node, equiv);
     }
   }
   return nullptr;
 }
 
+bool PatternProcessPass::HasCandidateNodes(const FuncGraphManagerPtr &manager) {
+  MS_EXCEPTION_IF_NULL(manager);
+  if (pattern_ == nullptr) {
+    Build();
+  }
+  // The pattern whose root is not a primitive cnode may match any node.
+  auto primitive = GetCNodePrimitive(pattern_);
+  if (primitive == nullptr) {
+    return true;
+  }
+  return !manager->primitive_nodes(primitive->name()).empty();
+}
+
 std::vector<AnfNodePtr> PatternProcessPass::GetOrigNodes() const {
   std::vector<AnfNodePtr> orig_nodes;
   for (auto &prim_var : *primitive_vars_) {
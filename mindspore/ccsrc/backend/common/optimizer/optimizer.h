@@ -42,6 +42,8 @@ class BACKEND_EXPORT PatternProcessPass : public NodePass {
   virtual const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const = 0;
   virtual const BaseRef DefinePattern() const;
   AnfNodePtr Run(const FuncGraphPtr &func_graph, const AnfNodePtr &node) override;
+  // The pattern can only be matched when the graph has the cnodes of the root primitive.
+  bool HasCandidateNodes(const FuncGraphManagerPtr &manager) override;
   CNodePtr NewCNode(const std::vector<AnfNodePtr> &inputs, const FuncGraphPtr &fg) const;
   CNodePtr NewCNode(const CNodePtr &cnode, const KernelGraphPtr &fg) const;
 
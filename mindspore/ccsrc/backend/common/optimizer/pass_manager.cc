@@ -105,17 +105,24 @@ bool PassManager::RunPass(const FuncGraphPtr &func_graph, size_t pass_id, const
   (void)gettimeofday(&start_time, nullptr);
 #endif
   bool changed = pass->Run(func_graph);
+  std::string statistics;
+  auto node_pass = std::dynamic_pointer_cast<NodePass>(pass);
+  if (node_pass != nullptr) {
+    statistics = ", visited nodes: " + std::to_string(node_pass->visited_node_num()) +
+                 ", matched nodes: " + std::to_string(node_pass->matched_node_num()) +
+                 ", changed nodes: " + std::to_string(node_pass->changed_node_num());
+  }
   constexpr auto kMicroSendUnit = 1000000;
 #if defined(_WIN32) || defined(_WIN64)
   auto end_time = std::chrono::steady_clock::now();
   std::chrono::duration<double, std::ratio<1, kMicroSendUnit>> cost = end_time - start_time;
-  MS_LOG(INFO) << "Run pass " + GetPassFullname(pass_id, pass) + " in " << cost.count() << " us";
+  MS_LOG(INFO) << "Run pass " + GetPassFullname(pass_id, pass) + " in " << cost.count() << " us" << statistics;
 #else
   (void)gettimeofday(&end_time, nullptr);
   // time unit: us
   uint64_t cost = kMicroSendUnit * static_cast<uint64_t>(end_time.tv_sec - start_time.tv_sec);
   cost += static_cast<uint64_t>(end_time.tv_usec - start_time.tv_usec);
-  MS_LOG(INFO) << "Run pass " + GetPassFullname(pass_id, pass) + " in " << cost << " us";
+  MS_LOG(INFO) << "Run pass " + GetPassFullname(pass_id, pass) + " in " << cost << " us" << statistics;
 #endif
   return changed;
 }
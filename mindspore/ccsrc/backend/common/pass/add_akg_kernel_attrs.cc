@@ -32,7 +32,7 @@ void ClonePrimitive(const AnfNodePtr &node) {
     return;
   }
   auto prim_node = NewValueNode(common::AnfAlgo::GetCNodePrimitive(cnode)->Clone());
-  cnode->set_input(kAnfPrimitiveIndex, prim_node);
+  common::AnfAlgo::SetCNodePrimitiveNode(cnode, prim_node);
 }
 }  // namespace
 
@@ -114,7 +114,7 @@ void AddMissingAttrs(const CNodePtr &cnode, kernel::OpImplyType imply_type,
     need_update = true;
   }
   if (need_update) {
-    cnode->set_input(kAnfPrimitiveIndex, NewValueNode(primitive));
+    common::AnfAlgo::SetCNodePrimitiveNode(cnode, NewValueNode(primitive));
   }
 }
 }  // namespace
@@ -148,7 +148,7 @@ void SetInternalOutputAttr(const AnfNodePtr &node) {
     return;
   }
   auto prim_node = NewValueNode(p->Clone());
-  node->cast<CNodePtr>()->set_input(kAnfPrimitiveIndex, prim_node);
+  common::AnfAlgo::SetCNodePrimitiveNode(node->cast<CNodePtr>(), prim_node);
   common::AnfAlgo::SetNodeAttr(kAttrIsInternalOutputNopNode, MakeValue(true), node);
 }
 
@@ -23,6 +23,8 @@
 #include "backend/graph_compiler/transform.h"
 #include "backend/common/session/session_factory.h"
 #include "runtime/pynative/op_executor.h"
+#include "runtime/pynative/op_kernel_cache.h"
+#include "include/common/thread_pool.h"
 #include "backend/common/optimizer/helper.h"
 #include "pipeline/pynative/pynative_execute.h"
 #include "pipeline/jit/action.h"
@@ -34,6 +36,7 @@
 #include "include/common/utils/convert_utils.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
+#include "utils/ms_exception.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "runtime/graph_scheduler/graph_compiler.h"
 #include "runtime/pynative/run_op_helper.h"
@@ -414,6 +417,13 @@ bool EnablePyNativeSyncRunning() {
   return ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_SYNCHRONIZE);
 }
 
+// The kernels of CPU ops are created independently, so the build tasks can be run in parallel. The other devices
+// compile the kernels of a batch together by themselves.
+bool EnableParallelOpBuild(const DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(device_context);
+  return device_context->GetDeviceType() == device::DeviceType::kCPU;
+}
+
 std::vector<std::vector<tensor::TensorPtr>> GetRunGraphInputs(const GraphCompilerInfo &graph_compiler_info,
                                                               const VectorRef &args) {
   const auto &origin_parameters = graph_compiler_info.origin_parameters_order_;
@@ -1429,6 +1439,7 @@ void MindRTBackend::EraseSingleOpCache(const ActorInfo &actor_info, const std::s
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(graph_compiler_);
   graph_compiler_->EraseSingleOpCache(graph_info, graph->graph_id());
+  runtime::OpKernelCache::GetInstance().Erase(graph_info);
   actor_to_graph_compiler_info_.erase(actor_info);
   (void)graph_info_to_device_context_.erase(graph_info);
 }
@@ -1458,13 +1469,62 @@ void MindRTBackend::CompileSingleOpGraphs(const std::vector<std::shared_ptr<runt
   ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, task_context->is_pynative_infer());
 
   auto device_context = task_context->device_context();
-  graph_compiler_->BuildSingleOpGraphs(graphs, device_context);
+  if (EnableParallelOpBuild(device_context)) {
+    ParallelCompileSingleOpGraphs(build_tasks, device_context);
+  } else {
+    graph_compiler_->BuildSingleOpGraphs(graphs, device_context);
+  }
   for (const auto &graph_compile_info : graph_compiler_infos) {
     MS_EXCEPTION_IF_NULL(graph_compile_info);
     graph_compile_info->input_tensors_.clear();
   }
 }
 
+void MindRTBackend::ParallelCompileSingleOpGraphs(const std::vector<std::shared_ptr<runtime::OpBuildTask>> &build_tasks,
+                                                  const DeviceContext *device_context) {
+  // Group the build tasks by graph info in the order of dispatch, and the identical ops are built only once.
+  std::vector<std::vector<std::shared_ptr<runtime::OpBuildTask>>> task_groups;
+  mindspore::HashMap<std::string, size_t> graph_info_to_group;
+  for (const auto &task : build_tasks) {
+    const auto &graph_info = task->context()->op_run_info()->base_op_run_info.graph_info;
+    auto iter = graph_info_to_group.find(graph_info);
+    if (iter == graph_info_to_group.end()) {
+      graph_info_to_group[graph_info] = task_groups.size();
+      (void)task_groups.emplace_back(std::vector<std::shared_ptr<runtime::OpBuildTask>>{task});
+    } else {
+      (void)task_groups[iter->second].emplace_back(task);
+    }
+  }
+
+  std::vector<common::Task> build_jobs;
+  for (const auto &task_group : task_groups) {
+    auto build_job = [this, &task_group, device_context]() {
+      const auto &graph_info = task_group.front()->context()->op_run_info()->base_op_run_info.graph_info;
+      auto &kernel_cache = runtime::OpKernelCache::GetInstance();
+      for (const auto &task : task_group) {
+        const auto &graph = task->context()->graph();
+        // The graph erased after running is not cached, neither are its kernels.
+        const auto &graph_compiler_info = task->context()->graph_compiler_info();
+        MS_EXCEPTION_IF_NULL(graph_compiler_info);
+        const bool use_kernel_cache = !graph_compiler_info->need_erase_;
+        bool kernel_cache_hit = use_kernel_cache && kernel_cache.FetchKernels(graph_info, graph);
+        graph_compiler_->BuildSingleOpGraphs({graph}, device_context);
+        if (use_kernel_cache && !kernel_cache_hit) {
+          kernel_cache.SaveKernels(graph_info, graph);
+        }
+        // The run task only waits for the kernel it needs, so launch it as soon as the build finished.
+        task->SetBuildReady(true);
+      }
+      return common::SUCCESS;
+    };
+    (void)build_jobs.emplace_back(build_job);
+  }
+  MS_LOG(DEBUG) << "Build " << build_tasks.size() << " op tasks with " << build_jobs.size() << " jobs in parallel";
+  (void)common::ThreadPool::GetInstance().SyncRun(build_jobs);
+  // The exception in the build jobs is caught by the thread pool.
+  MsException::Instance().CheckException();
+}
+
 void MindRTBackend::OpRunCallback(const std::shared_ptr<runtime::OpTaskContext> &context) {
   MS_LOG(DEBUG) << "OpRunCallback start";
   auto ms_context = MsContext::GetInstance();
@@ -142,6 +142,10 @@ class BACKEND_EXPORT MindRTBackend : public Backend {
   // Get saved OpBuildTask in OpExecutor and build all the kernels together in PyNative mode.
   void CompileSingleOpGraphs(const std::vector<std::shared_ptr<runtime::OpBuildTask>> &build_tasks);
 
+  // Build the kernels of CPU single op graphs on the thread pool, identical ops share the kernels in op kernel cache.
+  void ParallelCompileSingleOpGraphs(const std::vector<std::shared_ptr<runtime::OpBuildTask>> &build_tasks,
+                                     const DeviceContext *device_context);
+
   void ConstructOutputs(runtime::ActorSet *actor_set, VectorRef *outputs, const FuncGraphPtr &root_graph);
 
   // Restore the outputs tuple by the origin funcGraph output node and output tensors.
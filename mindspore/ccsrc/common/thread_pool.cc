@@ -27,6 +27,8 @@ namespace common {
 constexpr size_t kDeviceNum = 8;
 constexpr size_t kMaxThreadNum = 23;
 constexpr size_t kYieldThreshold = 1000;
+// Whether the current thread is a thread of the pool, whose nested SyncRun can not wait for the pool.
+static thread_local bool is_sync_run_thread = false;
 
 ThreadPool::ThreadPool() {
   size_t process_core_num = std::thread::hardware_concurrency() - 1;
@@ -52,6 +54,7 @@ void ThreadPool::SyncRunLoop(const std::shared_ptr<ThreadContext> &context) {
   if (context == nullptr) {
     return;
   }
+  is_sync_run_thread = true;
   size_t yield_count = 0;
   while (true) {
     if (exit_run_) {
@@ -93,6 +96,14 @@ bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
     auto ret = tasks[0]();
     return ret == SUCCESS;
   }
+  // The pool is busy with the task calling SyncRun, so the nested tasks run in the current thread.
+  if (is_sync_run_thread) {
+    bool ret = true;
+    for (auto &task : tasks) {
+      ret = (task() == SUCCESS) && ret;
+    }
+    return ret;
+  }
   std::unique_lock<std::mutex> lock(pool_mtx_);
   exit_run_ = false;
   size_t task_num = tasks.size();
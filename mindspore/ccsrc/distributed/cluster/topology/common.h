@@ -54,6 +54,9 @@ constexpr char kEnvMetaServerPort[] = "MS_SCHED_PORT";
 
 constexpr char kEnvNodeId[] = "MS_NODE_ID";
 
+// The number of event loops used by the TCP server of meta server node, each loop owns a receive and a send thread.
+constexpr char kEnvRpcEventLoopNum[] = "MS_RPC_EVENT_LOOP_NUM";
+
 // The key of compute graph node's hostname metadata stored in meta server.
 constexpr char kHostNames[] = "hostnames";
 
@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 #include "utils/ms_exception.h"
+#include "utils/ms_utils.h"
+#include "utils/convert_utils_base.h"
 #include "proto/topology.pb.h"
 #include "ps/ps_context.h"
 #include "distributed/rpc/tcp/constants.h"
@@ -106,7 +108,14 @@ bool MetaServerNode::Finalize(bool force) {
 
 bool MetaServerNode::InitTCPServer() {
   bool enable_ssl = ps::PSContext::instance()->enable_ssl();
-  tcp_server_ = std::make_unique<rpc::TCPServer>(enable_ssl);
+  size_t event_loop_num = 1;
+  auto event_loop_num_env = common::GetEnv(kEnvRpcEventLoopNum);
+  if (!event_loop_num_env.empty()) {
+    TRY_AND_CATCH_WITH_EXCEPTION((event_loop_num = IntToSize(std::stoi(event_loop_num_env))),
+                                 "The environment variable " + std::string(kEnvRpcEventLoopNum) + " is invalid.");
+    event_loop_num = std::max(event_loop_num, size_t(1));
+  }
+  tcp_server_ = std::make_unique<rpc::TCPServer>(enable_ssl, event_loop_num);
   MS_EXCEPTION_IF_NULL(tcp_server_);
   RETURN_IF_FALSE_WITH_LOG(tcp_server_->Initialize(meta_server_addr_.GetUrl()), "Failed to init the tcp server.");
   tcp_server_->SetMessageHandler(std::bind(&MetaServerNode::HandleMessage, this, std::placeholders::_1));
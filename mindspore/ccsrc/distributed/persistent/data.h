@@ -25,6 +25,7 @@
 #include <utility>
 
 #include "distributed/persistent/storage/local_file.h"
+#include "distributed/persistent/storage/async_log_file.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -79,6 +80,9 @@ class PersistentData : public Data<T> {
   // In disaster recovery mode, memory of tensor need to be saved into disk file periodically.
   void Persist(const storage::DirtyInfo &dirty_info) const;
 
+  // Wait until the persisted data have been saved to the storage medium.
+  void Flush() const;
+
   // In disaster recovery mode, server node or worker node need to restore persistent data when restart.
   void Restore() const;
 
@@ -93,7 +97,12 @@ class PersistentData : public Data<T> {
 
 template <typename T>
 void PersistentData<T>::Initialize(const std::map<std::string, std::string> &storage_config) {
-  storage_ = std::make_shared<storage::LocalFile>(storage_config);
+  auto storage_type_iter = storage_config.find(storage::kStorageType);
+  if (storage_type_iter != storage_config.end() && storage_type_iter->second == storage::kAsyncLogFileStorage) {
+    storage_ = std::make_shared<storage::AsyncLogFile>(storage_config);
+  } else {
+    storage_ = std::make_shared<storage::LocalFile>(storage_config);
+  }
 }
 
 template <typename T>
@@ -103,6 +112,12 @@ void PersistentData<T>::Persist(const storage::DirtyInfo &dirty_info) const {
   storage_->Write(input, dirty_info);
 }
 
+template <typename T>
+void PersistentData<T>::Flush() const {
+  MS_EXCEPTION_IF_NULL(storage_);
+  storage_->Flush();
+}
+
 template <typename T>
 void PersistentData<T>::Restore() const {
   storage::OutputData output = std::make_pair(Data<T>::data(), Data<T>::size() * sizeof(T));
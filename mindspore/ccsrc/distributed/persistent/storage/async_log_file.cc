@@ -0,0 +1,642 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/persistent/storage/async_log_file.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cctype>
+#include <cstdio>
+#include <algorithm>
+#include <utility>
+
+#include "utils/convert_utils_base.h"
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+#include "utils/system/crc32c.h"
+#include "include/common/thread_pool.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+namespace {
+size_t GetConfigValue(const std::map<std::string, std::string> &storage_config, const std::string &key,
+                      size_t default_value) {
+  auto iter = storage_config.find(key);
+  if (iter != storage_config.end() && !(iter->second).empty()) {
+    return std::stoul(iter->second);
+  }
+  return default_value;
+}
+
+uint32_t GetPayloadCrc(const char *payload, size_t size) {
+  return system::Crc32c::GetMaskCrc32cValue(payload, size);
+}
+
+// Sync the data of the file, or the entries of the directory, to the disk.
+bool SyncPath(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  bool ret = fsync(fd) == 0;
+  (void)close(fd);
+  return ret;
+}
+}  // namespace
+
+AsyncLogFile::AsyncLogFile(const std::map<std::string, std::string> &storage_config) {
+  auto file_path_iter = storage_config.find(kFileStoragePath);
+  if (file_path_iter != storage_config.end()) {
+    file_path_ = file_path_iter->second;
+  }
+  max_chunk_length_ = GetConfigValue(storage_config, kMaxBlockLength, DEFAULT_MAX_CHUNK_LENGTH);
+  max_segment_length_ = GetConfigValue(storage_config, kMaxSegmentLength, DEFAULT_MAX_SEGMENT_LENGTH);
+  max_pending_length_ = GetConfigValue(storage_config, kMaxPendingLength, DEFAULT_MAX_PENDING_LENGTH);
+  flush_thread_ = std::thread(&AsyncLogFile::FlushLoop, this);
+}
+
+AsyncLogFile::~AsyncLogFile() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+  cond_var_.notify_all();
+  if (flush_thread_.joinable()) {
+    flush_thread_.join();
+  }
+  if (active_segment_.is_open()) {
+    active_segment_.close();
+  }
+}
+
+void AsyncLogFile::Write(const InputData &input, const DirtyInfo &dirty_info) {
+  std::vector<InputData> inputs = {input};
+  Write(inputs, dirty_info);
+}
+
+void AsyncLogFile::Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) {
+  if (inputs.empty()) {
+    MS_LOG(EXCEPTION) << "The inputs is empty";
+  }
+  CheckFlushError();
+
+  // Write all the rows for the first time, which supersedes the stale log segments in the folder once it is durable.
+  // The rows are copied by the flusher, so the caller is not blocked by copying the whole table.
+  if (!table_initialized_) {
+    InitTableInfo(inputs);
+    AppendTableSnapshot(inputs);
+    return;
+  }
+
+  for (const auto &input : inputs) {
+    if (std::get<2>(input) != row_num_ * row_size_) {
+      MS_LOG(EXCEPTION) << "The input size " << std::get<2>(input) << " is not equal to the persisted table size "
+                        << (row_num_ * row_size_);
+    }
+  }
+
+  // Merge the dirty rows into contiguous row ranges which do not cross the boundary of chunks.
+  DirtyInfo dirty_rows = dirty_info;
+  std::sort(dirty_rows.begin(), dirty_rows.end());
+  dirty_rows.erase(std::unique(dirty_rows.begin(), dirty_rows.end()), dirty_rows.end());
+  size_t index = 0;
+  while (index < dirty_rows.size()) {
+    if (dirty_rows[index] < 0 || IntToSize(dirty_rows[index]) >= row_num_) {
+      MS_LOG(EXCEPTION) << "The dirty row " << dirty_rows[index] << " is out of range [0, " << row_num_ << ")";
+    }
+    size_t row_begin = IntToSize(dirty_rows[index]);
+    size_t chunk_end = std::min((row_begin / chunk_rows_ + 1) * chunk_rows_, row_num_);
+    size_t row_end = row_begin + 1;
+    while (++index < dirty_rows.size() && IntToSize(dirty_rows[index]) == row_end && row_end < chunk_end) {
+      ++row_end;
+    }
+    AppendRecord(row_begin, row_end - row_begin, inputs);
+  }
+}
+
+void AsyncLogFile::InitTableInfo(const std::vector<InputData> &inputs) {
+  const std::vector<int> &shape = std::get<0>(inputs.front());
+  if (shape.empty() || shape[0] <= 0) {
+    MS_LOG(EXCEPTION) << "The dimension of input shape contain zero.";
+  }
+  row_num_ = IntToSize(shape[0]);
+  size_t input_size = std::get<2>(inputs.front());
+  row_size_ = input_size / row_num_;
+  if (row_size_ == 0 || input_size % row_num_ != 0) {
+    MS_LOG(EXCEPTION) << "The size of input tensor " << input_size << " is invalid for row number " << row_num_;
+  }
+  for (const auto &input : inputs) {
+    if (std::get<2>(input) != input_size) {
+      MS_LOG(EXCEPTION) << "The inputs should have the same size, but got " << std::get<2>(input) << " and "
+                        << input_size;
+    }
+  }
+  tensor_num_ = inputs.size();
+  chunk_rows_ = std::max(max_chunk_length_ / (row_size_ * tensor_num_), static_cast<size_t>(1));
+  table_length_ = input_size * tensor_num_;
+  table_initialized_ = true;
+}
+
+void AsyncLogFile::AppendRecord(size_t row_begin, size_t row_num, const std::vector<InputData> &inputs) {
+  auto record = std::make_shared<LogRecord>();
+  size_t range_size = row_num * row_size_;
+  record->payload.resize(range_size * tensor_num_);
+  for (size_t i = 0; i < tensor_num_; ++i) {
+    const char *data = reinterpret_cast<const char *>(std::get<1>(inputs[i])) + row_begin * row_size_;
+    MS_EXCEPTION_IF_NULL(data);
+    auto ret = memcpy_s(record->payload.data() + i * range_size, range_size, data, range_size);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Memcpy failed, errorno[" << ret << "]";
+    }
+  }
+  record->header = {kLogRecordMagic, GetPayloadCrc(record->payload.data(), record->payload.size()), 0,
+                    row_begin,       row_num,
+                    row_size_,       tensor_num_,
+                    chunk_rows_};
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  // Apply back pressure to the writer if the flusher can not catch up.
+  cond_var_.wait(lock, [this, &record]() {
+    return pending_length_ == 0 || pending_length_ + record->payload.size() <= max_pending_length_;
+  });
+  pending_length_ += record->payload.size();
+  pending_records_.push(record);
+  cond_var_.notify_all();
+}
+
+void AsyncLogFile::AppendTableSnapshot(const std::vector<InputData> &inputs) {
+  auto record = std::make_shared<LogRecord>();
+  record->type = RecordType::kTableSnapshot;
+  record->inputs = inputs;
+  std::lock_guard<std::mutex> lock(mtx_);
+  pending_records_.push(record);
+  cond_var_.notify_all();
+}
+
+void AsyncLogFile::FlushLoop() {
+  while (true) {
+    std::shared_ptr<LogRecord> record = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      cond_var_.wait(lock, [this]() { return stop_ || !pending_records_.empty(); });
+      if (pending_records_.empty()) {
+        return;
+      }
+      record = pending_records_.front();
+      pending_records_.pop();
+      flushing_ = true;
+    }
+
+    bool drained = false;
+    try {
+      if (record->type == RecordType::kTableSnapshot) {
+        WriteTableSnapshot(record->inputs);
+      } else {
+        record->header.sequence = next_sequence_++;
+        WriteRecord(record->header, record->payload.data(), &index_);
+      }
+      {
+        std::lock_guard<std::mutex> lock(mtx_);
+        drained = pending_records_.empty();
+      }
+      // Flush the segment file and compact the log when there is no more pending record.
+      if (drained) {
+        (void)active_segment_.flush();
+        if (index_.log_length > kLogCompactionRatio * table_length_) {
+          Compact();
+        }
+      }
+    } catch (const std::exception &e) {
+      std::lock_guard<std::mutex> lock(mtx_);
+      flush_error_ = e.what();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      pending_length_ -= record->payload.size();
+      flushing_ = false;
+    }
+    cond_var_.notify_all();
+  }
+}
+
+void AsyncLogFile::WriteRecord(const LogRecordHeader &header, const char *payload, LogIndex *index) {
+  MS_EXCEPTION_IF_NULL(index);
+  size_t payload_size = header.row_num * header.row_size * header.tensor_num;
+  size_t record_size = sizeof(LogRecordHeader) + payload_size;
+  if (!active_segment_.is_open() || active_segment_length_ + record_size > max_segment_length_) {
+    OpenNewSegment(index);
+  }
+
+  (void)active_segment_.write(reinterpret_cast<const char *>(&header), sizeof(LogRecordHeader));
+  (void)active_segment_.write(payload, SizeToLong(payload_size));
+  if (!active_segment_.good()) {
+    MS_LOG(EXCEPTION) << "Write to log segment file[" << SegmentFileName(active_segment_id_) << "] failed.";
+  }
+
+  size_t chunk_index = header.row_begin / header.chunk_rows;
+  if (index->chunk_records.size() <= chunk_index) {
+    index->chunk_records.resize(chunk_index + 1);
+  }
+  size_t offset = active_segment_length_ + sizeof(LogRecordHeader);
+  index->chunk_records[chunk_index].push_back({active_segment_id_, offset, header});
+  active_segment_length_ += record_size;
+  index->log_length += record_size;
+}
+
+void AsyncLogFile::OpenNewSegment(LogIndex *index) {
+  CloseActiveSegment();
+  size_t segment_id = next_segment_id_++;
+  std::string segment_file_name = snapshotting_ ? TempSegmentFileName(segment_id) : SegmentFileName(segment_id);
+  active_segment_.open(segment_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!active_segment_.is_open() || !active_segment_.good()) {
+    MS_LOG(EXCEPTION) << "Open log segment file[" << segment_file_name << "] failed.";
+  }
+  ChangeFileMode(segment_file_name, S_IRUSR | S_IWUSR);
+  index->segment_ids.push_back(segment_id);
+  if (snapshotting_) {
+    snapshot_segment_ids_.push_back(segment_id);
+  }
+  active_segment_id_ = segment_id;
+  active_segment_length_ = 0;
+}
+
+void AsyncLogFile::CloseActiveSegment() {
+  if (!active_segment_.is_open()) {
+    return;
+  }
+  (void)active_segment_.flush();
+  bool good = active_segment_.good();
+  active_segment_.close();
+  if (!good) {
+    MS_LOG(EXCEPTION) << "Flush log segment file[" << SegmentFileName(active_segment_id_) << "] failed.";
+  }
+}
+
+void AsyncLogFile::WriteSnapshot(const std::vector<size_t> &obsolete_segment_ids, const ChunkReader &read_chunk) {
+  CloseActiveSegment();
+  // The temporary segments left by an interrupted snapshot have never been committed.
+  for (auto segment_id : ListSegmentIds(true)) {
+    (void)std::remove(TempSegmentFileName(segment_id).c_str());
+  }
+  // The records are replayed in order of segment id, so the snapshot must follow the segments it supersedes.
+  for (auto segment_id : obsolete_segment_ids) {
+    next_segment_id_ = std::max(next_segment_id_, segment_id + 1);
+  }
+  snapshot_segment_ids_.clear();
+  snapshotting_ = true;
+
+  // The snapshot is indexed aside, the current index and segments are kept until the snapshot is committed.
+  LogIndex snapshot_index;
+  try {
+    std::vector<char> chunk;
+    for (size_t row_begin = 0; row_begin < row_num_; row_begin += chunk_rows_) {
+      size_t row_num = std::min(chunk_rows_, row_num_ - row_begin);
+      chunk.assign(row_num * row_size_ * tensor_num_, 0);
+      if (!read_chunk(row_begin / chunk_rows_, &chunk)) {
+        continue;
+      }
+      LogRecordHeader header = {kLogRecordMagic, GetPayloadCrc(chunk.data(), chunk.size()),
+                                next_sequence_++, row_begin,
+                                row_num,          row_size_,
+                                tensor_num_,      chunk_rows_};
+      WriteRecord(header, chunk.data(), &snapshot_index);
+    }
+    CommitSnapshot();
+  } catch (const std::exception &) {
+    AbortSnapshot();
+    throw;
+  }
+  snapshotting_ = false;
+  index_ = std::move(snapshot_index);
+
+  // The snapshot is durable, so the segments it supersedes can be removed.
+  for (auto segment_id : obsolete_segment_ids) {
+    (void)std::remove(SegmentFileName(segment_id).c_str());
+  }
+}
+
+void AsyncLogFile::CommitSnapshot() {
+  CloseActiveSegment();
+  for (auto segment_id : snapshot_segment_ids_) {
+    std::string temp_file_name = TempSegmentFileName(segment_id);
+    if (!SyncPath(temp_file_name)) {
+      MS_LOG(EXCEPTION) << "Sync log segment file[" << temp_file_name << "] failed.";
+    }
+  }
+  for (auto segment_id : snapshot_segment_ids_) {
+    std::string temp_file_name = TempSegmentFileName(segment_id);
+    if (std::rename(temp_file_name.c_str(), SegmentFileName(segment_id).c_str()) != 0) {
+      MS_LOG(EXCEPTION) << "Rename log segment file[" << temp_file_name << "] failed.";
+    }
+  }
+  if (!SyncPath(file_path_)) {
+    MS_LOG(EXCEPTION) << "Sync the folder of log segments [" << file_path_ << "] failed.";
+  }
+  snapshot_segment_ids_.clear();
+}
+
+void AsyncLogFile::AbortSnapshot() {
+  if (active_segment_.is_open()) {
+    active_segment_.close();
+  }
+  // The superseded segments are still complete, so the segments of the snapshot are removed even if some of them
+  // have been renamed.
+  for (auto segment_id : snapshot_segment_ids_) {
+    (void)std::remove(TempSegmentFileName(segment_id).c_str());
+    (void)std::remove(SegmentFileName(segment_id).c_str());
+  }
+  snapshot_segment_ids_.clear();
+  snapshotting_ = false;
+}
+
+void AsyncLogFile::WriteTableSnapshot(const std::vector<InputData> &inputs) {
+  // The rows may be updated during the copy, the updated rows are dirty and appended after the snapshot.
+  WriteSnapshot(ListSegmentIds(), [this, &inputs](size_t chunk_index, std::vector<char> *chunk) {
+    size_t row_begin = chunk_index * chunk_rows_;
+    size_t range_size = chunk->size() / tensor_num_;
+    for (size_t i = 0; i < tensor_num_; ++i) {
+      const char *data = reinterpret_cast<const char *>(std::get<1>(inputs[i])) + row_begin * row_size_;
+      auto ret = memcpy_s(chunk->data() + i * range_size, range_size, data, range_size);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Memcpy failed, errorno[" << ret << "]";
+      }
+    }
+    return true;
+  });
+}
+
+void AsyncLogFile::Compact() {
+  MS_LOG(INFO) << "Begin to compact log segments in " << file_path_ << ", log length: " << index_.log_length
+               << ", table length: " << table_length_;
+  // Replay the records of every chunk into a buffer of the whole chunk and write it as a new record.
+  std::map<size_t, std::ifstream> segments;
+  WriteSnapshot(index_.segment_ids, [this, &segments](size_t chunk_index, std::vector<char> *chunk) {
+    if (chunk_index >= index_.chunk_records.size() || index_.chunk_records[chunk_index].empty()) {
+      return false;
+    }
+    size_t row_begin = chunk_index * chunk_rows_;
+    size_t range_size = chunk->size() / tensor_num_;
+    std::vector<char> payload;
+    for (const auto &location : index_.chunk_records[chunk_index]) {
+      if (!ReadPayload(location, &segments[location.segment_id], &payload)) {
+        MS_LOG(EXCEPTION) << "Read log segment file[" << SegmentFileName(location.segment_id) << "] failed.";
+      }
+      const auto &header = location.header;
+      size_t record_range_size = header.row_num * row_size_;
+      for (size_t i = 0; i < tensor_num_; ++i) {
+        auto ret = memcpy_s(chunk->data() + i * range_size + (header.row_begin - row_begin) * row_size_,
+                            range_size - (header.row_begin - row_begin) * row_size_,
+                            payload.data() + i * record_range_size, record_range_size);
+        if (ret != EOK) {
+          MS_LOG(EXCEPTION) << "Memcpy failed, errorno[" << ret << "]";
+        }
+      }
+    }
+    return true;
+  });
+  MS_LOG(INFO) << "End compacting log segments in " << file_path_ << ", log length: " << index_.log_length;
+}
+
+void AsyncLogFile::Flush() {
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cond_var_.wait(lock, [this]() { return pending_records_.empty() && !flushing_; });
+  }
+  CheckFlushError();
+}
+
+void AsyncLogFile::CheckFlushError() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!flush_error_.empty()) {
+    auto error = flush_error_;
+    flush_error_.clear();
+    MS_LOG(EXCEPTION) << "Failed to flush the log segments in " << file_path_ << ", error: " << error;
+  }
+}
+
+void AsyncLogFile::Read(const OutputData &output) {
+  std::vector<OutputData> outputs = {output};
+  Read(outputs);
+}
+
+void AsyncLogFile::Read(const std::vector<OutputData> &outputs) {
+  if (outputs.empty()) {
+    MS_LOG(EXCEPTION) << "The outputs is empty";
+  }
+  Flush();
+
+  // The flusher is idle after Flush, so the chunk index can be accessed safely.
+  if (index_.segment_ids.empty() && !LoadSegments()) {
+    MS_LOG(EXCEPTION) << "Load log segments failed, file path [" << file_path_ << "]";
+  }
+  if (outputs.size() != tensor_num_) {
+    MS_LOG(EXCEPTION) << "The output number " << outputs.size() << " is not equal to the persisted tensor number "
+                      << tensor_num_;
+  }
+  size_t output_size = outputs.front().second;
+  for (const auto &output : outputs) {
+    MS_EXCEPTION_IF_NULL(output.first);
+    if (output.second != output_size || output_size % row_size_ != 0) {
+      MS_LOG(EXCEPTION) << "The output size " << output.second << " is invalid, row size: " << row_size_;
+    }
+  }
+  if (!table_initialized_) {
+    row_num_ = output_size / row_size_;
+    table_length_ = output_size * tensor_num_;
+    table_initialized_ = true;
+  } else if (output_size != row_num_ * row_size_) {
+    MS_LOG(EXCEPTION) << "The output size " << output_size << " is not equal to the persisted table size "
+                      << (row_num_ * row_size_);
+  }
+
+  // The chunks are disjoint, so they are restored in parallel. SyncRun swallows the exceptions of tasks, so every task
+  // keeps its own error.
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t thread_num = std::max(std::min(thread_pool.GetSyncRunThreadNum(), index_.chunk_records.size()), size_t(1));
+  std::vector<std::string> errors(thread_num);
+  std::vector<common::Task> tasks;
+  for (size_t i = 0; i < thread_num; ++i) {
+    (void)tasks.emplace_back([this, i, thread_num, &outputs, &errors]() {
+      try {
+        for (size_t chunk_index = i; chunk_index < index_.chunk_records.size(); chunk_index += thread_num) {
+          RestoreChunk(chunk_index, outputs);
+        }
+      } catch (const std::exception &e) {
+        errors[i] = e.what();
+        return common::FAIL;
+      }
+      return common::SUCCESS;
+    });
+  }
+  bool ret = thread_pool.SyncRun(tasks);
+  for (const auto &error : errors) {
+    if (!error.empty()) {
+      MS_LOG(EXCEPTION) << "Restore log segments failed, file path [" << file_path_ << "], error: " << error;
+    }
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Restore log segments failed, file path [" << file_path_ << "]";
+  }
+}
+
+void AsyncLogFile::RestoreChunk(size_t chunk_index, const std::vector<OutputData> &outputs) const {
+  std::map<size_t, std::ifstream> segments;
+  std::vector<char> payload;
+  for (const auto &location : index_.chunk_records[chunk_index]) {
+    const auto &header = location.header;
+    if (header.row_begin + header.row_num > row_num_) {
+      MS_LOG(EXCEPTION) << "The rows [" << header.row_begin << ", " << (header.row_begin + header.row_num)
+                        << ") of record is out of range, row number: " << row_num_;
+    }
+    if (!ReadPayload(location, &segments[location.segment_id], &payload)) {
+      MS_LOG(EXCEPTION) << "Read log segment file[" << SegmentFileName(location.segment_id) << "] failed.";
+    }
+    size_t range_size = header.row_num * row_size_;
+    for (size_t i = 0; i < tensor_num_; ++i) {
+      char *data = reinterpret_cast<char *>(outputs[i].first) + header.row_begin * row_size_;
+      // The row range has been checked above.
+      auto ret = memcpy_s(data, range_size, payload.data() + i * range_size, range_size);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Memcpy failed, errorno[" << ret << "]";
+      }
+    }
+  }
+}
+
+bool AsyncLogFile::ReadPayload(const LogRecordLocation &location, std::ifstream *segment,
+                               std::vector<char> *payload) const {
+  MS_EXCEPTION_IF_NULL(segment);
+  MS_EXCEPTION_IF_NULL(payload);
+  if (!segment->is_open()) {
+    segment->open(SegmentFileName(location.segment_id), std::ios::in | std::ios::binary);
+    if (!segment->is_open() || !segment->good()) {
+      MS_LOG(ERROR) << "Open log segment file[" << SegmentFileName(location.segment_id) << "] failed.";
+      return false;
+    }
+  }
+  const auto &header = location.header;
+  payload->resize(header.row_num * header.row_size * header.tensor_num);
+  (void)segment->seekg(SizeToLong(location.offset));
+  (void)segment->read(payload->data(), SizeToLong(payload->size()));
+  if (!segment->good()) {
+    MS_LOG(ERROR) << "Read the record at offset " << location.offset << " failed.";
+    return false;
+  }
+  if (GetPayloadCrc(payload->data(), payload->size()) != header.crc) {
+    MS_LOG(ERROR) << "The checksum of record at offset " << location.offset << " is mismatched.";
+    return false;
+  }
+  return true;
+}
+
+std::vector<size_t> AsyncLogFile::ListSegmentIds(bool temporary) const {
+  std::vector<size_t> segment_ids;
+  DIR *dir = opendir(file_path_.c_str());
+  if (dir == nullptr) {
+    MS_LOG(ERROR) << "The file path [" << file_path_ << "] is not exist";
+    return segment_ids;
+  }
+  struct dirent *entry;
+  std::string prefix = kLogSegmentFilePrefix;
+  std::string suffix = temporary ? kTempFileSuffix : "";
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string file_name = entry->d_name;
+    if (file_name.length() <= prefix.length() + suffix.length() || file_name.compare(0, prefix.length(), prefix) != 0 ||
+        file_name.compare(file_name.length() - suffix.length(), suffix.length(), suffix) != 0) {
+      continue;
+    }
+    std::string segment_id = file_name.substr(prefix.length(), file_name.length() - prefix.length() - suffix.length());
+    if (std::all_of(segment_id.begin(), segment_id.end(), [](char c) { return std::isdigit(c) != 0; })) {
+      segment_ids.push_back(std::stoul(segment_id));
+    }
+  }
+  (void)closedir(dir);
+  std::sort(segment_ids.begin(), segment_ids.end());
+  return segment_ids;
+}
+
+bool AsyncLogFile::LoadSegments() {
+  std::vector<size_t> segment_ids = ListSegmentIds();
+  if (segment_ids.empty()) {
+    MS_LOG(ERROR) << "There is no log segment file in path [" << file_path_ << "]";
+    return false;
+  }
+
+  std::vector<LogRecordLocation> locations;
+  for (auto segment_id : segment_ids) {
+    std::ifstream segment(SegmentFileName(segment_id), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!segment.is_open()) {
+      MS_LOG(ERROR) << "Open log segment file[" << SegmentFileName(segment_id) << "] failed.";
+      return false;
+    }
+    size_t segment_length = LongToSize(segment.tellg());
+    size_t offset = 0;
+    (void)segment.seekg(0);
+    LogRecordHeader header;
+    while (offset + sizeof(LogRecordHeader) <= segment_length) {
+      (void)segment.read(reinterpret_cast<char *>(&header), sizeof(LogRecordHeader));
+      size_t payload_size = header.row_num * header.row_size * header.tensor_num;
+      if (!segment.good() || header.magic != kLogRecordMagic || header.chunk_rows == 0 ||
+          offset + sizeof(LogRecordHeader) + payload_size > segment_length) {
+        // The tail of segment may be incomplete if the process exits during writing.
+        MS_LOG(WARNING) << "Ignore the incomplete record at offset " << offset << " of log segment file["
+                        << SegmentFileName(segment_id) << "]";
+        break;
+      }
+      if (row_size_ == 0) {
+        row_size_ = header.row_size;
+        tensor_num_ = header.tensor_num;
+        chunk_rows_ = header.chunk_rows;
+      } else if (row_size_ != header.row_size || tensor_num_ != header.tensor_num || chunk_rows_ != header.chunk_rows) {
+        MS_LOG(ERROR) << "The meta of record at offset " << offset << " of log segment file["
+                      << SegmentFileName(segment_id) << "] is inconsistent.";
+        return false;
+      }
+      locations.push_back({segment_id, offset + sizeof(LogRecordHeader), header});
+      offset += sizeof(LogRecordHeader) + payload_size;
+      (void)segment.seekg(SizeToLong(offset));
+    }
+    index_.log_length += offset;
+  }
+
+  // A snapshot always gets larger segment ids than the segments it supersedes, even if it is written by a new process
+  // whose sequence restarts, so the records are replayed in order of segment id and offset.
+  for (const auto &location : locations) {
+    size_t chunk_index = location.header.row_begin / chunk_rows_;
+    if (index_.chunk_records.size() <= chunk_index) {
+      index_.chunk_records.resize(chunk_index + 1);
+    }
+    index_.chunk_records[chunk_index].push_back(location);
+    next_sequence_ = std::max(next_sequence_, location.header.sequence + 1);
+  }
+  index_.segment_ids = segment_ids;
+  next_segment_id_ = segment_ids.back() + 1;
+  return true;
+}
+
+std::string AsyncLogFile::SegmentFileName(size_t segment_id) const {
+  return file_path_ + "/" + kLogSegmentFilePrefix + std::to_string(segment_id);
+}
+
+std::string AsyncLogFile::TempSegmentFileName(size_t segment_id) const {
+  return SegmentFileName(segment_id) + kTempFileSuffix;
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
@@ -0,0 +1,203 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_ASYNC_LOG_FILE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_ASYNC_LOG_FILE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <fstream>
+#include <condition_variable>
+#include <functional>
+
+#include "distributed/persistent/storage/storage.h"
+#include "distributed/persistent/storage/constants.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+// The default maximum length of the rows in one chunk : 16MB.
+constexpr size_t DEFAULT_MAX_CHUNK_LENGTH = 16 << 20;
+// The default maximum length of one log segment file : 1GB.
+constexpr size_t DEFAULT_MAX_SEGMENT_LENGTH = 1 << 30;
+// The default maximum length of the data waiting to be flushed, the writers are blocked when it is exceeded : 2GB.
+constexpr size_t DEFAULT_MAX_PENDING_LENGTH = 2UL << 30;
+// The log segments are compacted once their total length exceeds this multiple of the table length.
+constexpr size_t kLogCompactionRatio = 3;
+constexpr uint32_t kLogRecordMagic = 0x4D534C47;
+
+// The header of a record in the log segment file, followed by the payload: the rows [row_begin, row_begin + row_num)
+// of every tensor.
+struct LogRecordHeader {
+  uint32_t magic;
+  // The masked crc32c of the payload.
+  uint32_t crc;
+  uint64_t sequence;
+  uint64_t row_begin;
+  uint64_t row_num;
+  // The byte size of one row of one tensor.
+  uint64_t row_size;
+  uint64_t tensor_num;
+  // The row number of the chunk, a record never crosses the boundary of chunks.
+  uint64_t chunk_rows;
+};
+
+// The location of a record in the log segment files.
+struct LogRecordLocation {
+  size_t segment_id;
+  // The file offset of the payload.
+  size_t offset;
+  LogRecordHeader header;
+};
+
+// Asynchronous write-behind storage which saves the data into append-only log segment files.
+// The rows of the tensors are divided into chunks by row range. Write only takes a snapshot of the dirty rows and
+// returns, the snapshot is appended to the log segment files by a background flusher thread, and the segments are
+// compacted into one record per chunk when they grow too long. Read restores the chunks in parallel.
+// A full snapshot of the table (the first write and every compaction) is written into temporary segment files, which
+// are synced and renamed before the segments it supersedes are removed, so a crash never loses the persisted table.
+// The snapshot is indexed aside and replaces the index only when it is committed, so a failed snapshot leaves the log
+// as it was.
+class AsyncLogFile : public StorageBase {
+ public:
+  explicit AsyncLogFile(const std::map<std::string, std::string> &storage_config);
+  ~AsyncLogFile() override;
+
+  // Take a snapshot of the rows in dirty_info and append it to the log asynchronously. The first write leaves the copy
+  // of all the rows to the flusher, so the inputs must be kept alive until Flush or the destruction of the storage.
+  void Write(const InputData &input, const DirtyInfo &dirty_info) override;
+  void Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) override;
+
+  // Wait for the pending writes, then check the checksum of the records and replay them into the outputs.
+  void Read(const OutputData &output) override;
+  void Read(const std::vector<OutputData> &outputs) override;
+
+  // Wait until all the snapshots are written to the log segment files.
+  void Flush() override;
+
+ private:
+  enum class RecordType { kData, kTableSnapshot };
+  struct LogRecord {
+    RecordType type{RecordType::kData};
+    LogRecordHeader header;
+    std::vector<char> payload;
+    // The tables copied by the flusher for the record of kTableSnapshot.
+    std::vector<InputData> inputs;
+  };
+
+  // The index of the records in the log segment files.
+  struct LogIndex {
+    // The locations of records for every chunk in order of sequence.
+    std::vector<std::vector<LogRecordLocation>> chunk_records;
+    std::vector<size_t> segment_ids;
+    size_t log_length{0};
+  };
+
+  // Fill the buffer with all the rows of the chunk, return false if the chunk has no data.
+  using ChunkReader = std::function<bool(size_t chunk_index, std::vector<char> *chunk)>;
+
+  // Initialize the row size and chunk size according to the first written inputs.
+  void InitTableInfo(const std::vector<InputData> &inputs);
+
+  // Copy the rows [row_begin, row_begin + row_num) of inputs into a record and push it to the flusher, the caller is
+  // blocked if there are too many pending bytes.
+  void AppendRecord(size_t row_begin, size_t row_num, const std::vector<InputData> &inputs);
+  // Push a record which takes a full snapshot of the inputs to the flusher.
+  void AppendTableSnapshot(const std::vector<InputData> &inputs);
+
+  // The loop of the flusher thread.
+  void FlushLoop();
+
+  // Append the record to the active log segment file and add it to the index.
+  void WriteRecord(const LogRecordHeader &header, const char *payload, LogIndex *index);
+  void OpenNewSegment(LogIndex *index);
+  void CloseActiveSegment();
+
+  // Write every chunk read by read_chunk into temporary segment files and commit them, then the snapshot replaces the
+  // index and the segments in obsolete_segment_ids are removed. The snapshot is discarded if any step fails.
+  void WriteSnapshot(const std::vector<size_t> &obsolete_segment_ids, const ChunkReader &read_chunk);
+  // Sync and rename the temporary segment files of the snapshot.
+  void CommitSnapshot();
+  // Remove the segment files of the failed snapshot.
+  void AbortSnapshot();
+
+  // Copy all the rows of the inputs into a new snapshot which supersedes all the segments in the folder.
+  void WriteTableSnapshot(const std::vector<InputData> &inputs);
+
+  // Merge all the records of every chunk into one record in new log segments, and remove the old segments.
+  void Compact();
+
+  // Scan the headers of records in all the log segment files to rebuild the chunk index.
+  bool LoadSegments();
+
+  // Replay all the records of the chunk into outputs in sequence.
+  void RestoreChunk(size_t chunk_index, const std::vector<OutputData> &outputs) const;
+
+  // Read the payload of the record and check its checksum.
+  bool ReadPayload(const LogRecordLocation &location, std::ifstream *segment, std::vector<char> *payload) const;
+
+  // Get the ids of all the log segment files(or the temporary ones) in the folder in ascending order.
+  std::vector<size_t> ListSegmentIds(bool temporary = false) const;
+  std::string SegmentFileName(size_t segment_id) const;
+  std::string TempSegmentFileName(size_t segment_id) const;
+
+  // Throw the error occurred in the flusher thread.
+  void CheckFlushError();
+
+  // Folder path to save all log segment files.
+  std::string file_path_;
+  size_t max_chunk_length_;
+  size_t max_segment_length_;
+  size_t max_pending_length_;
+
+  // The meta of the persisted tensors.
+  bool table_initialized_{false};
+  size_t row_num_{0};
+  size_t row_size_{0};
+  size_t tensor_num_{0};
+  size_t chunk_rows_{0};
+  size_t table_length_{0};
+
+  // The following variables are only accessed by the flusher thread while it is running.
+  LogIndex index_;
+  size_t next_segment_id_{0};
+  std::ofstream active_segment_;
+  size_t active_segment_id_{0};
+  size_t active_segment_length_{0};
+  uint64_t next_sequence_{0};
+  bool snapshotting_{false};
+  std::vector<size_t> snapshot_segment_ids_;
+
+  // The records waiting to be flushed.
+  std::queue<std::shared_ptr<LogRecord>> pending_records_;
+  size_t pending_length_{0};
+  bool flushing_{false};
+  bool stop_{false};
+  std::string flush_error_;
+  std::mutex mtx_;
+  std::condition_variable cond_var_;
+  std::thread flush_thread_;
+};
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_ASYNC_LOG_FILE_H_
@@ -31,13 +31,22 @@ constexpr char kShardRangeUpperBound[] = "shard_range_upper_bound";
 constexpr char kHashSeq[] = "hash_seq";
 
 constexpr char kBlockFilePrefix[] = "block_";
+constexpr char kLogSegmentFilePrefix[] = "log_segment_";
 constexpr char kBlockMetaFilePrefix[] = "block_meta_";
 constexpr char kJsonSuffix[] = ".json";
+constexpr char kTempFileSuffix[] = ".tmp";
 constexpr size_t JSON_SUFFIX_LENS = 5;
 
 // Storage config related.
 constexpr char kFileStoragePath[] = "file_storage_path";
 constexpr char kMaxBlockLength[] = "max_block_length";
+constexpr char kMaxSegmentLength[] = "max_segment_length";
+constexpr char kMaxPendingLength[] = "max_pending_length";
+
+// Storage types, the block file storage is used by default.
+constexpr char kStorageType[] = "storage_type";
+constexpr char kLocalFileStorage[] = "local_file";
+constexpr char kAsyncLogFileStorage[] = "async_log_file";
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
@@ -57,6 +57,10 @@ class StorageBase {
 
   // Read data from the storage medium or memory buffer and merge them into contiguous memory for multiple tensors.
   virtual void Read(const std::vector<OutputData> &outputs) {}
+
+  // Wait until all the data written before have been saved to the storage medium, only the asynchronous storage needs
+  // to override it.
+  virtual void Flush() {}
 };
 }  // namespace storage
 }  // namespace distributed
@@ -269,6 +269,10 @@ int Connection::ReceiveMessage() {
     return 0;
   }
 
+  if (recv_event_loop != nullptr) {
+    recv_event_loop->AddTransferredBytes(GetMessageBaseRealDataSize(recv_message));
+  }
+
   // Call msg handler if set
   if (message_handler) {
     auto result = message_handler(recv_message);
@@ -342,6 +346,11 @@ std::string Connection::GenerateHttpMessage(MessageBase *msg) {
 void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg) {
   if (msg->type == MessageBase::Type::KMSG) {
     int index = 0;
+    auto vectored_msg = dynamic_cast<VectoredMessage *>(msg);
+    if (!isHttpKmsg && vectored_msg != nullptr) {
+      FillVectoredSendMessage(vectored_msg);
+      return;
+    }
     if (!isHttpKmsg) {
       send_to = msg->to;
       send_from = msg->from;
@@ -401,6 +410,44 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
   }
 }
 
+void Connection::FillVectoredSendMessage(VectoredMessage *msg) {
+  send_to = msg->to;
+  send_from = msg->from;
+  FillMessageHeader(*msg, &send_msg_header);
+  size_t body_size = msg->BodySize();
+  send_msg_header.body_len = htonl(static_cast<uint32_t>(body_size));
+
+  const auto &segments = msg->segments();
+  send_vectored_io_vec.resize(SEND_MSG_IO_VEC_LEN - 1 + segments.size());
+  size_t index = 0;
+  send_vectored_io_vec[index].iov_base = &send_msg_header;
+  send_vectored_io_vec[index].iov_len = sizeof(send_msg_header);
+  ++index;
+  send_vectored_io_vec[index].iov_base = const_cast<char *>(msg->name.data());
+  send_vectored_io_vec[index].iov_len = msg->name.size();
+  ++index;
+  send_vectored_io_vec[index].iov_base = const_cast<char *>(send_to.data());
+  send_vectored_io_vec[index].iov_len = send_to.size();
+  ++index;
+  send_vectored_io_vec[index].iov_base = const_cast<char *>(send_from.data());
+  send_vectored_io_vec[index].iov_len = send_from.size();
+  ++index;
+  // The segments refer to the memory of the caller directly, no copy happens here.
+  for (const auto &segment : segments) {
+    send_vectored_io_vec[index].iov_base = segment.data;
+    send_vectored_io_vec[index].iov_len = segment.size;
+    ++index;
+  }
+  send_kernel_msg.msg_iov = send_vectored_io_vec.data();
+  send_kernel_msg.msg_iovlen = index;
+  total_send_len = sizeof(send_msg_header) + msg->name.size() + send_to.size() + send_from.size() + body_size;
+  send_message = msg;
+
+  // update metrics
+  send_metrics->UpdateMax(body_size);
+  send_metrics->last_send_msg_name = msg->name;
+}
+
 void Connection::FillRecvMessage() {
   size_t recvNameLen = static_cast<size_t>(recv_msg_header.name_len);
   size_t recvToLen = static_cast<size_t>(recv_msg_header.to_len);
@@ -473,6 +520,14 @@ int Connection::Flush() {
         size_t real_data_size = GetMessageBaseRealDataSize(send_message);
         output_buffer_size -= real_data_size;
         total_send_bytes += real_data_size;
+        if (send_event_loop != nullptr) {
+          send_event_loop->AddTransferredBytes(real_data_size);
+        }
+
+        auto vectored_msg = dynamic_cast<VectoredMessage *>(send_message);
+        if (vectored_msg != nullptr) {
+          vectored_msg->set_sent();
+        }
 
         FreeMessageMemory(send_message);
         delete send_message;
@@ -623,6 +678,11 @@ void *Connection::GetMessageBaseRealData(MessageBase *msg) {
 
 size_t Connection::GetMessageBaseRealDataSize(MessageBase *msg) {
   MS_ERROR_IF_NULL_W_RET_VAL(msg, 0);
+  auto vectored_msg = dynamic_cast<VectoredMessage *>(msg);
+  if (vectored_msg != nullptr) {
+    return vectored_msg->BodySize();
+  }
+
   // The 'size' attribute is preferred.
   if (msg->data != nullptr) {
     return msg->size;
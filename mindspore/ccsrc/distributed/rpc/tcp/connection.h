@@ -21,11 +21,13 @@
 #include <string>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/event_loop.h"
 #include "distributed/rpc/tcp/socket_operation.h"
+#include "distributed/rpc/tcp/vectored_message.h"
 
 namespace mindspore {
 namespace distributed {
@@ -210,6 +212,9 @@ struct Connection {
   struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
   struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
 
+  // The io vector of the vectored message, whose length depends on the number of segments.
+  std::vector<struct iovec> send_vectored_io_vec;
+
   ParseType recv_message_type{kTcpMsg};
 
   // Callbacks for io events
@@ -245,6 +250,9 @@ struct Connection {
   // After ParseMessage, set from url and to url into recv message.
   bool SetUrlForRecvMessage();
 
+  // Fill the io vector with the header and all the segments of the vectored message.
+  void FillVectoredSendMessage(VectoredMessage *msg);
+
   // Make a http message based on given input message.
   std::string GenerateHttpMessage(MessageBase *msg);
 
@@ -49,6 +49,8 @@ using MemAllocateCallback = std::function<void *(size_t size)>;
 using MemFreeCallback = std::function<bool(void *data)>;
 
 constexpr int SEND_MSG_IO_VEC_LEN = 5;
+// The max number of segments in a vectored message, which keeps the io vector length of sendmsg under IOV_MAX.
+constexpr size_t MAX_MSG_SEGMENT_NUM = 1000;
 constexpr int RECV_MSG_IO_VEC_LEN = 4;
 
 constexpr unsigned int BUSMAGIC_LEN = 4;
@@ -106,6 +106,7 @@ void QueueReadyCallback(int fd, uint32_t events, void *arg) {
     evloop->task_queue_.swap(q);
     evloop->task_queue_mutex_.unlock();
 
+    evloop->task_count_ += q.size();
     // invoke functions in the queue
     while (!q.empty()) {
       q.front()();
@@ -137,6 +138,10 @@ size_t EventLoop::AddTask(std::function<int()> &&task) {
   // return the queue size to send's caller.
   auto result = task_queue_.size();
   task_queue_mutex_.unlock();
+  // the tasks are added by several threads
+  auto max_depth = max_queue_depth_.load();
+  while (result > max_depth && !max_queue_depth_.compare_exchange_weak(max_depth, result)) {
+  }
 
   if (result == 1) {
     // wakeup event loop
@@ -161,6 +166,8 @@ bool EventLoop::Initialize(const std::string &threadName) {
   if (retval != RPC_OK) {
     return false;
   }
+  name_ = threadName;
+  start_time_ = std::chrono::steady_clock::now();
   (void)sem_init(&sem_id_, 0, 0);
 
   if (pthread_create(&loop_thread_, nullptr, EvloopRun, reinterpret_cast<void *>(this)) != 0) {
@@ -205,6 +212,21 @@ void EventLoop::Finalize() {
   MS_LOG(INFO) << "Stop loop succ";
 }
 
+EventLoopStatistics EventLoop::GetStatistics() {
+  EventLoopStatistics statistics;
+  statistics.name = name_;
+  statistics.event_count = event_count_;
+  statistics.task_count = task_count_;
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+  if (elapsed > 0) {
+    statistics.events_per_sec = statistics.event_count / elapsed;
+  }
+  statistics.queue_depth = RemainingTaskNum();
+  statistics.max_queue_depth = max_queue_depth_;
+  statistics.bytes = bytes_;
+  return statistics;
+}
+
 void EventLoop::DeleteEvent(int fd) {
   auto iter = events_.find(fd);
   if (iter == events_.end()) {
@@ -432,6 +454,7 @@ void EventLoop::HandleEvent(struct epoll_event *events, size_t nevent) {
   int found;
   Event *tev = nullptr;
 
+  event_count_ += nevent;
   for (size_t i = 0; i < nevent; i++) {
     tev = reinterpret_cast<Event *>(events[i].data.ptr);
 
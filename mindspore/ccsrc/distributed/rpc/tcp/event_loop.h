@@ -27,6 +27,8 @@
 #include <queue>
 #include <map>
 #include <string>
+#include <atomic>
+#include <chrono>
 
 namespace mindspore {
 namespace distributed {
@@ -52,6 +54,23 @@ typedef struct {
   EventHandler handler;
 } Event;
 
+/*
+ * The statistics of an event loop, which are used to check whether the event loop threads are saturated.
+ */
+struct EventLoopStatistics {
+  std::string name;
+  // The number of handled epoll events and tasks.
+  uint64_t event_count{0};
+  uint64_t task_count{0};
+  // The handled epoll events per second since the event loop started.
+  double events_per_sec{0};
+  // The current and max number of pending tasks.
+  size_t queue_depth{0};
+  size_t max_queue_depth{0};
+  // The bytes of messages sent or received by the connections on this event loop.
+  uint64_t bytes{0};
+};
+
 /*
  * The class EventLoop monitors a certain file descriptor created by eventfd function call,
  * and triggers tasks when any event occurred on the file descriptor.
@@ -80,6 +99,11 @@ class EventLoop {
   int UpdateEpollEvent(int fd, uint32_t events);
   int DeleteEpollEvent(int fd);
 
+  // Record the bytes transferred by the connections on this event loop.
+  void AddTransferredBytes(size_t bytes) { bytes_ += bytes; }
+
+  EventLoopStatistics GetStatistics();
+
  private:
   void AddEvent(Event *event);
 
@@ -125,6 +149,14 @@ class EventLoop {
   std::mutex event_lock_;
   std::map<int, Event *> events_;
 
+  // The statistics of this event loop.
+  std::string name_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::atomic<uint64_t> event_count_{0};
+  std::atomic<uint64_t> task_count_{0};
+  std::atomic<size_t> max_queue_depth_{0};
+  std::atomic<uint64_t> bytes_{0};
+
   // To be safe, use a list to preserve deleted events rather than a map. Because the caller may
   // delete events on the same fd twice in once epoll_wait.
   std::map<int, std::list<Event *>> deleted_events_;
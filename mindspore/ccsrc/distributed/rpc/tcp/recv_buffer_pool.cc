@@ -0,0 +1,109 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/tcp/recv_buffer_pool.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+RecvBufferPool::~RecvBufferPool() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &bucket : free_buffers_) {
+    for (auto buffer : bucket.second) {
+      delete[] static_cast<char *>(buffer);
+    }
+  }
+  free_buffers_.clear();
+  if (!used_buffers_.empty()) {
+    MS_LOG(WARNING) << "There are still " << used_buffers_.size() << " buffers in use when the pool is destroyed.";
+  }
+  cached_bytes_ = 0;
+}
+
+size_t RecvBufferPool::BucketSize(size_t size) {
+  size_t bucket_size = kMinRecvBufferSize;
+  while (bucket_size < size) {
+    bucket_size <<= 1;
+  }
+  return bucket_size;
+}
+
+bool RecvBufferPool::Register(size_t size, size_t count) {
+  size_t bucket_size = BucketSize(size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < count; ++i) {
+    if (cached_bytes_ + bucket_size > max_cached_bytes_) {
+      MS_LOG(WARNING) << "Only " << i << " buffers of size " << bucket_size << " are registered, the cached size "
+                      << cached_bytes_ << " reaches the limit " << max_cached_bytes_;
+      return false;
+    }
+    void *buffer = new (std::nothrow) char[bucket_size];
+    MS_ERROR_IF_NULL(buffer);
+    (void)free_buffers_[bucket_size].emplace_back(buffer);
+    cached_bytes_ += bucket_size;
+  }
+  return true;
+}
+
+void *RecvBufferPool::Allocate(size_t size) {
+  size_t bucket_size = BucketSize(size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  void *buffer = nullptr;
+  auto iter = free_buffers_.find(bucket_size);
+  if (iter != free_buffers_.end() && !iter->second.empty()) {
+    buffer = iter->second.back();
+    iter->second.pop_back();
+    cached_bytes_ -= bucket_size;
+    ++hit_count_;
+  } else {
+    buffer = new (std::nothrow) char[bucket_size];
+    MS_ERROR_IF_NULL_W_RET_VAL(buffer, nullptr);
+    ++miss_count_;
+  }
+  used_buffers_[buffer] = bucket_size;
+  return buffer;
+}
+
+bool RecvBufferPool::Free(void *data) {
+  MS_ERROR_IF_NULL(data);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = used_buffers_.find(data);
+  if (iter == used_buffers_.end()) {
+    MS_LOG(ERROR) << "The buffer is not allocated by this pool.";
+    return false;
+  }
+  size_t bucket_size = iter->second;
+  (void)used_buffers_.erase(iter);
+  // Release the memory to system if the pool caches too much.
+  if (cached_bytes_ + bucket_size > max_cached_bytes_) {
+    delete[] static_cast<char *>(data);
+    return true;
+  }
+  (void)free_buffers_[bucket_size].emplace_back(data);
+  cached_bytes_ += bucket_size;
+  return true;
+}
+
+MemAllocateCallback RecvBufferPool::allocate_cb() {
+  return [this](size_t size) { return Allocate(size); };
+}
+
+MemFreeCallback RecvBufferPool::free_cb() {
+  return [this](void *data) { return Free(data); };
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
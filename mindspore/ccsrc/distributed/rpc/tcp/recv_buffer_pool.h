@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_RECV_BUFFER_POOL_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_RECV_BUFFER_POOL_H_
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+#include "distributed/rpc/tcp/constants.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// The cached memory of the receive buffer pool is 1GB at most by default.
+constexpr size_t kDefaultMaxCachedBytes = 1UL << 30;
+// The minimum buffer size is 4KB, and buffers are rounded up to the power of two.
+constexpr size_t kMinRecvBufferSize = 4096;
+
+/*
+ * The pool of memory buffers for the body of received messages. Messages with the similar sizes are received every
+ * step in embedding-cache and PS, so the released buffers are cached and reused instead of allocating new memory for
+ * each message. The pool is passed to TCPServer by `allocate_cb()`, and the receiver returns the message body to the
+ * pool by `free_cb()` after using it.
+ */
+class RecvBufferPool {
+ public:
+  explicit RecvBufferPool(size_t max_cached_bytes = kDefaultMaxCachedBytes) : max_cached_bytes_(max_cached_bytes) {}
+  ~RecvBufferPool();
+
+  // Preallocate buffers, so the first step needs no allocation.
+  bool Register(size_t size, size_t count);
+
+  // Get a buffer whose size is not less than the given size.
+  void *Allocate(size_t size);
+
+  // Return the buffer allocated by this pool, which is cached for the later allocation.
+  bool Free(void *data);
+
+  // The callbacks which allocate and free the message memory through this pool.
+  MemAllocateCallback allocate_cb();
+  MemFreeCallback free_cb();
+
+  // Statistics of the pool.
+  size_t cached_bytes() const { return cached_bytes_; }
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+ private:
+  // Round up the size to the size of buffer bucket.
+  static size_t BucketSize(size_t size);
+
+  // The free buffers of each bucket size.
+  std::map<size_t, std::vector<void *>> free_buffers_;
+
+  // The buffers in use and their bucket sizes.
+  std::unordered_map<void *, size_t> used_buffers_;
+
+  size_t cached_bytes_{0};
+  size_t max_cached_bytes_;
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+  std::mutex mutex_;
+
+  DISABLE_COPY_AND_ASSIGN(RecvBufferPool);
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+#endif
@@ -26,7 +26,7 @@ bool TCPClient::Initialize() {
     if (enable_ssl_) {
       ps::core::SSLClient::GetInstance().GetSSLCtx();
     }
-    tcp_comm_ = std::make_unique<TCPComm>(enable_ssl_);
+    tcp_comm_ = std::make_unique<TCPComm>(enable_ssl_, event_loop_num_);
     MS_EXCEPTION_IF_NULL(tcp_comm_);
 
     // This message handler is used to accept and maintain the received message from the tcp server.
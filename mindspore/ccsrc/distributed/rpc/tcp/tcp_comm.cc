@@ -19,10 +19,14 @@
 #include <mutex>
 #include <utility>
 #include <memory>
+#include <string>
+#include <vector>
+#include <functional>
 
 #include "actor/aid.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
+#include "distributed/rpc/tcp/vectored_message.h"
 
 namespace mindspore {
 namespace distributed {
@@ -67,7 +71,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
     return;
   }
   TCPComm *tcpmgr = reinterpret_cast<TCPComm *>(arg);
-  if (tcpmgr->recv_event_loop_ == nullptr) {
+  if (tcpmgr->recv_event_loops_.empty()) {
     MS_LOG(ERROR) << "EventLoop is null, server fd: " << server << ", events: " << events;
     return;
   }
@@ -108,10 +112,10 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->peer = conn->destination;
 
   conn->is_remote = true;
-  conn->recv_event_loop = tcpmgr->recv_event_loop_;
-  conn->send_event_loop = tcpmgr->send_event_loop_;
+  conn->recv_event_loop = tcpmgr->NextRecvEventLoop();
+  conn->send_event_loop = tcpmgr->GetSendEventLoop(conn->destination);
 
-  conn->conn_mutex = tcpmgr->conn_mutex_;
+  conn->conn_mutex = tcpmgr->GetConnMutex();
   conn->message_handler = tcpmgr->message_handler_;
 
   conn->event_callback = std::bind(&TCPComm::EventCallBack, tcpmgr, std::placeholders::_1);
@@ -132,6 +136,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
     delete conn;
     return;
   }
+  std::lock_guard<std::mutex> lock(*tcpmgr->conn_mutex_);
   tcpmgr->conn_pool_->AddConnection(conn);
 }
 
@@ -144,40 +149,100 @@ bool TCPComm::Initialize() {
   conn_mutex_ = std::make_shared<std::mutex>();
   MS_EXCEPTION_IF_NULL(conn_mutex_);
 
-  recv_event_loop_ = new (std::nothrow) EventLoop();
-  if (recv_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create recv evLoop.";
+  if (!InitEventLoops(TCP_RECV_EVLOOP_THREADNAME, &recv_event_loops_)) {
+    MS_LOG(ERROR) << "Failed to init recv evLoop";
     return false;
   }
-
-  bool ok = recv_event_loop_->Initialize(TCP_RECV_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init recv evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
+  if (!InitEventLoops(TCP_SEND_EVLOOP_THREADNAME, &send_event_loops_)) {
+    MS_LOG(ERROR) << "Failed to init send evLoop";
+    FinalizeEventLoops(&recv_event_loops_);
     return false;
   }
+  MS_LOG(INFO) << "Initialize " << event_loop_num_ << " recv and send event loops.";
+  return true;
+}
 
-  send_event_loop_ = new (std::nothrow) EventLoop();
-  if (send_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create send evLoop.";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
+bool TCPComm::InitEventLoops(const std::string &thread_name, std::vector<EventLoop *> *event_loops) const {
+  MS_EXCEPTION_IF_NULL(event_loops);
+  for (size_t i = 0; i < event_loop_num_; ++i) {
+    EventLoop *event_loop = new (std::nothrow) EventLoop();
+    if (event_loop == nullptr) {
+      MS_LOG(ERROR) << "Failed to create evLoop " << thread_name;
+      FinalizeEventLoops(event_loops);
+      return false;
+    }
+    auto name = event_loop_num_ == 1 ? thread_name : thread_name + "_" + std::to_string(i);
+    if (!event_loop->Initialize(name)) {
+      MS_LOG(ERROR) << "Failed to init evLoop " << name;
+      delete event_loop;
+      FinalizeEventLoops(event_loops);
+      return false;
+    }
+    (void)event_loops->emplace_back(event_loop);
   }
-  ok = send_event_loop_->Initialize(TCP_SEND_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init send evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-    return false;
+  return true;
+}
+
+void TCPComm::FinalizeEventLoops(std::vector<EventLoop *> *event_loops) const {
+  MS_EXCEPTION_IF_NULL(event_loops);
+  for (auto &event_loop : *event_loops) {
+    if (event_loop != nullptr) {
+      event_loop->Finalize();
+      delete event_loop;
+      event_loop = nullptr;
+    }
+  }
+  event_loops->clear();
+}
+
+EventLoop *TCPComm::GetSendEventLoop(const std::string &dst_url) const {
+  if (send_event_loops_.empty()) {
+    return nullptr;
+  }
+  return send_event_loops_[std::hash<std::string>()(dst_url) % send_event_loops_.size()];
+}
+
+EventLoop *TCPComm::GetRecvEventLoop(const std::string &dst_url) const {
+  if (recv_event_loops_.empty()) {
+    return nullptr;
   }
+  return recv_event_loops_[std::hash<std::string>()(dst_url) % recv_event_loops_.size()];
+}
+
+EventLoop *TCPComm::NextRecvEventLoop() {
+  if (recv_event_loops_.empty()) {
+    return nullptr;
+  }
+  return recv_event_loops_[next_recv_event_loop_++ % recv_event_loops_.size()];
+}
+
+std::shared_ptr<std::mutex> TCPComm::GetConnMutex() const { return std::make_shared<std::mutex>(); }
 
+bool TCPComm::NoRemainingTask() const {
+  for (const auto &event_loop : recv_event_loops_) {
+    if (event_loop->RemainingTaskNum() != 0) {
+      return false;
+    }
+  }
+  for (const auto &event_loop : send_event_loops_) {
+    if (event_loop->RemainingTaskNum() != 0) {
+      return false;
+    }
+  }
   return true;
 }
 
+std::vector<EventLoopStatistics> TCPComm::GetEventLoopStatistics() const {
+  std::vector<EventLoopStatistics> statistics;
+  for (const auto &event_loop : recv_event_loops_) {
+    (void)statistics.emplace_back(event_loop->GetStatistics());
+  }
+  for (const auto &event_loop : send_event_loops_) {
+    (void)statistics.emplace_back(event_loop->GetStatistics());
+  }
+  return statistics;
+}
+
 bool TCPComm::StartServerSocket(const std::string &url, const MemAllocateCallback &allocate_cb) {
   server_fd_ = SocketOperation::Listen(url);
   if (server_fd_ < 0) {
@@ -191,8 +256,8 @@ bool TCPComm::StartServerSocket(const std::string &url, const MemAllocateCallbac
     url_ = url.substr(index + sizeof(URL_PROTOCOL_IP_SEPARATOR) - 1);
   }
 
-  // Register read event callback for server socket
-  int retval = recv_event_loop_->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
+  // Register read event callback for server socket, the accepted connections are sharded across all the event loops.
+  int retval = recv_event_loops_[0]->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
                                                  reinterpret_cast<void *>(this));
   if (retval != RPC_OK) {
     MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str();
@@ -244,6 +309,9 @@ void TCPComm::EventCallBack(void *connection) {
     conn->conn_mutex->unlock();
   } else if (conn->state == ConnectionState::kDisconnecting) {
     std::lock_guard<std::mutex> lock(*conn_mutex_);
+    // Wait for the sends which are flushing this connection.
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> conn_lock(*conn_mutex);
     conn_pool_->DeleteConnection(conn->destination);
   }
 }
@@ -316,9 +384,19 @@ void TCPComm::DropMessage(MessageBase *msg) {
 
 ssize_t TCPComm::Send(MessageBase *msg, bool sync) {
   auto task = [msg, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+    auto vectored_msg = dynamic_cast<VectoredMessage *>(msg);
+    if (vectored_msg != nullptr &&
+        (vectored_msg->segments().size() > MAX_MSG_SEGMENT_NUM || vectored_msg->BodySize() > MAX_KMSG_BODY_LEN)) {
+      MS_LOG(ERROR) << "Invalid vectored message " << msg->name.c_str() << ", segment number: "
+                    << vectored_msg->segments().size() << ", body size: " << vectored_msg->BodySize();
+      DropMessage(msg);
+      int error_no = -1;
+      return error_no;
+    }
+
     // Search connection by the target address
     std::string destination = msg->to.Url();
+    std::unique_lock<std::mutex> pool_lock(*conn_mutex_);
     Connection *conn = conn_pool_->FindConnection(destination);
     if (conn == nullptr) {
       MS_LOG(ERROR) << "Can not found remote link and send fail name: " << msg->name.c_str()
@@ -327,6 +405,11 @@ ssize_t TCPComm::Send(MessageBase *msg, bool sync) {
       int error_no = -1;
       return error_no;
     }
+    // The connection is always locked after the connection pool, so it can not be deleted while it is locked. The pool
+    // is released before flushing, so that the sends on different connections are not blocked by the socket I/O.
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> conn_lock(*conn_mutex);
+    pool_lock.unlock();
 
     if (conn->send_message_queue.size() >= SENDMSG_QUEUELEN) {
       MS_LOG(WARNING) << "The message queue is full(max len:" << SENDMSG_QUEUELEN
@@ -358,18 +441,23 @@ ssize_t TCPComm::Send(MessageBase *msg, bool sync) {
   if (sync) {
     return task();
   } else {
-    send_event_loop_->AddTask(task);
+    auto send_event_loop = GetSendEventLoop(msg->to.Url());
+    MS_EXCEPTION_IF_NULL(send_event_loop);
+    send_event_loop->AddTask(task);
     return true;
   }
 }
 
 bool TCPComm::Flush(const std::string &dst_url) {
+  std::unique_lock<std::mutex> pool_lock(*conn_mutex_);
   Connection *conn = conn_pool_->FindConnection(dst_url);
   if (conn == nullptr) {
     MS_LOG(ERROR) << "Can not find the connection to url: " << dst_url;
     return false;
   } else {
-    std::lock_guard<std::mutex> lock(*(conn->conn_mutex));
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> lock(*conn_mutex);
+    pool_lock.unlock();
     return conn->Flush();
   }
 }
@@ -388,9 +476,9 @@ bool TCPComm::Connect(const std::string &dst_url) {
       return false;
     }
     conn->enable_ssl = enable_ssl_;
-    conn->recv_event_loop = this->recv_event_loop_;
-    conn->send_event_loop = this->send_event_loop_;
-    conn->conn_mutex = conn_mutex_;
+    conn->recv_event_loop = GetRecvEventLoop(dst_url);
+    conn->send_event_loop = GetSendEventLoop(dst_url);
+    conn->conn_mutex = GetConnMutex();
     conn->message_handler = message_handler_;
     conn->InitSocketOperation();
 
@@ -452,11 +540,11 @@ bool TCPComm::IsConnected(const std::string &dst_url) {
 bool TCPComm::Disconnect(const std::string &dst_url) {
   int interval = 100000;
   size_t retry = 30;
-  while (recv_event_loop_->RemainingTaskNum() != 0 && send_event_loop_->RemainingTaskNum() != 0 && retry > 0) {
+  while (!NoRemainingTask() && retry > 0) {
     usleep(interval);
     retry--;
   }
-  if (recv_event_loop_->RemainingTaskNum() > 0 || send_event_loop_->RemainingTaskNum() > 0) {
+  if (!NoRemainingTask()) {
     MS_LOG(ERROR) << "Failed to disconnect from url " << dst_url
                   << ", because there are still pending tasks to be executed, please try later.";
     return false;
@@ -464,6 +552,9 @@ bool TCPComm::Disconnect(const std::string &dst_url) {
   std::lock_guard<std::mutex> lock(*conn_mutex_);
   auto conn = conn_pool_->FindConnection(dst_url);
   if (conn != nullptr) {
+    // Wait for the receive event loop and the sends which are using the connection.
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> recv_lock(*conn_mutex);
     std::lock_guard<std::mutex> conn_lock(conn->conn_owned_mutex_);
     conn_pool_->DeleteConnection(dst_url);
   }
@@ -479,28 +570,20 @@ Connection *TCPComm::CreateDefaultConn(const std::string &to) {
   conn->enable_ssl = enable_ssl_;
   conn->source = url_.data();
   conn->destination = to;
-  conn->recv_event_loop = this->recv_event_loop_;
-  conn->send_event_loop = this->send_event_loop_;
-  conn->conn_mutex = conn_mutex_;
+  conn->recv_event_loop = GetRecvEventLoop(to);
+  conn->send_event_loop = GetSendEventLoop(to);
+  conn->conn_mutex = GetConnMutex();
   conn->message_handler = message_handler_;
   conn->InitSocketOperation();
   return conn;
 }
 
 void TCPComm::Finalize() {
-  if (send_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete send event loop";
-    send_event_loop_->Finalize();
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-  }
+  MS_LOG(INFO) << "Delete send event loops";
+  FinalizeEventLoops(&send_event_loops_);
 
-  if (recv_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete recv event loop";
-    recv_event_loop_->Finalize();
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-  }
+  MS_LOG(INFO) << "Delete recv event loops";
+  FinalizeEventLoops(&recv_event_loops_);
 
   if (server_fd_ > 0) {
     if (close(server_fd_) != 0) {
@@ -21,6 +21,7 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <atomic>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/connection.h"
@@ -39,8 +40,9 @@ void ConnectedEventHandler(int fd, uint32_t events, void *context);
 
 class TCPComm {
  public:
-  explicit TCPComm(bool enable_ssl = false)
-      : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr), enable_ssl_(enable_ssl) {}
+  // The connections are sharded across event_loop_num receive and send event loops.
+  explicit TCPComm(bool enable_ssl = false, size_t event_loop_num = 1)
+      : server_fd_(-1), event_loop_num_(event_loop_num == 0 ? 1 : event_loop_num), enable_ssl_(enable_ssl) {}
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm() = default;
@@ -90,7 +92,28 @@ class TCPComm {
    */
   const MemAllocateCallback &allocate_cb() const { return allocate_cb_; }
 
+  // Returns the statistics of all the receive and send event loops.
+  std::vector<EventLoopStatistics> GetEventLoopStatistics() const;
+
  private:
+  // Create and destroy the event loops.
+  bool InitEventLoops(const std::string &thread_name, std::vector<EventLoop *> *event_loops) const;
+  void FinalizeEventLoops(std::vector<EventLoop *> *event_loops) const;
+
+  // All the messages to the same destination are sent by the same send event loop, which keeps the order of messages
+  // on one connection.
+  EventLoop *GetSendEventLoop(const std::string &dst_url) const;
+  EventLoop *GetRecvEventLoop(const std::string &dst_url) const;
+  // The connections accepted by the server are assigned to the receive event loops in turn.
+  EventLoop *NextRecvEventLoop();
+
+  // Each connection owns a mutex for its socket I/O, so that the connections are not blocked by each other. The mutex
+  // of tcp comm only guards the connection pool, and it is always locked before the mutex of a connection.
+  std::shared_ptr<std::mutex> GetConnMutex() const;
+
+  // Whether all the event loops have no pending tasks.
+  bool NoRemainingTask() const;
+
   // Build the connection.
   Connection *CreateDefaultConn(const std::string &to);
 
@@ -121,14 +144,18 @@ class TCPComm {
   // User defined handler for Handling received messages.
   MessageHandler message_handler_;
 
-  // All the connections share the same read and write event loop objects.
-  EventLoop *recv_event_loop_;
-  EventLoop *send_event_loop_;
+  // The number of receive and send event loops.
+  size_t event_loop_num_;
+
+  // The connections are sharded across the read and write event loop objects.
+  std::vector<EventLoop *> recv_event_loops_;
+  std::vector<EventLoop *> send_event_loops_;
+  std::atomic<size_t> next_recv_event_loop_{0};
 
   // The connection pool used to store new connections.
   std::shared_ptr<ConnectionPool> conn_pool_;
 
-  // The mutex for connection operations.
+  // The mutex for the connection pool.
   std::shared_ptr<std::mutex> conn_mutex_;
 
   // The method used to allocate memory when tcp servers of this TcpComm receive message from the remote.
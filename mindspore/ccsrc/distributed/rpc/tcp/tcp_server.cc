@@ -39,9 +39,16 @@ std::string TCPServer::GetIP() const { return ip_; }
 
 uint32_t TCPServer::GetPort() const { return port_; }
 
+std::vector<EventLoopStatistics> TCPServer::GetEventLoopStatistics() const {
+  if (tcp_comm_ == nullptr) {
+    return {};
+  }
+  return tcp_comm_->GetEventLoopStatistics();
+}
+
 bool TCPServer::InitializeImpl(const std::string &url, const MemAllocateCallback &allocate_cb) {
   if (tcp_comm_ == nullptr) {
-    tcp_comm_ = std::make_unique<TCPComm>(enable_ssl_);
+    tcp_comm_ = std::make_unique<TCPComm>(enable_ssl_, event_loop_num_);
     MS_EXCEPTION_IF_NULL(tcp_comm_);
     bool rt = tcp_comm_->Initialize();
     if (!rt) {
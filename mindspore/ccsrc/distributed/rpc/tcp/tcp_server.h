@@ -19,6 +19,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "distributed/rpc/tcp/tcp_comm.h"
 #include "utils/ms_utils.h"
@@ -28,7 +29,8 @@ namespace distributed {
 namespace rpc {
 class TCPServer {
  public:
-  explicit TCPServer(bool enable_ssl = false) : enable_ssl_(enable_ssl) {}
+  explicit TCPServer(bool enable_ssl = false, size_t event_loop_num = 1)
+      : enable_ssl_(enable_ssl), event_loop_num_(event_loop_num) {}
   ~TCPServer() = default;
 
   // Init the tcp server using the specified url.
@@ -47,6 +49,9 @@ class TCPServer {
   std::string GetIP() const;
   uint32_t GetPort() const;
 
+  // Return the statistics of the receive and send event loops.
+  std::vector<EventLoopStatistics> GetEventLoopStatistics() const;
+
  private:
   bool InitializeImpl(const std::string &url, const MemAllocateCallback &allocate_cb);
 
@@ -58,6 +63,9 @@ class TCPServer {
 
   bool enable_ssl_;
 
+  // The number of event loops used to receive and send messages.
+  size_t event_loop_num_;
+
   DISABLE_COPY_AND_ASSIGN(TCPServer);
 };
 }  // namespace rpc
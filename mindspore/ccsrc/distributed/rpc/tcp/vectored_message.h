@@ -0,0 +1,93 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_VECTORED_MESSAGE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_VECTORED_MESSAGE_H_
+
+#include <list>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "actor/msg.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// A segment of the message body. The memory is owned by the caller and must stay valid until the message is completed.
+struct MessageSegment {
+  void *data{nullptr};
+  size_t size{0};
+};
+
+/**
+ * @description: The callback function which is called exactly once when the vectored message is released.
+ * @param {bool} success: Whether all the bytes of the message have been sent to the peer.
+ */
+using SendCompletionCallback = std::function<void(bool success)>;
+
+/*
+ * The message whose body is made up of several segments, e.g. the tensors of one step. The segments are gathered by the
+ * kernel in one sendmsg call through iovec, so the tensor memory is referenced directly instead of being copied into
+ * 'body' or 'data'. The peer receives it as a normal message with contiguous body.
+ */
+class VectoredMessage : public MessageBase {
+ public:
+  VectoredMessage(const AID &from, const AID &to, const std::string &name, std::vector<MessageSegment> &&segments = {},
+                  SendCompletionCallback completion_cb = nullptr)
+      : MessageBase(from, to, name), segments_(std::move(segments)), completion_cb_(std::move(completion_cb)) {}
+
+  // The completion callback is called when the message is released, no matter it's sent or dropped.
+  ~VectoredMessage() override {
+    if (completion_cb_) {
+      completion_cb_(sent_);
+    }
+  }
+
+  const std::vector<MessageSegment> &segments() const { return segments_; }
+
+  // Append a segment which refers to the memory of the caller.
+  void AddSegment(void *data, size_t size) { (void)segments_.emplace_back(MessageSegment{data, size}); }
+
+  // Append a segment whose memory is owned by this message, e.g. the header of the caller's data in the next segment.
+  void AddOwnedSegment(std::string &&data) {
+    auto &owned = owned_data_.emplace_back(std::move(data));
+    (void)segments_.emplace_back(MessageSegment{const_cast<char *>(owned.data()), owned.size()});
+  }
+
+  size_t BodySize() const {
+    size_t body_size = 0;
+    for (const auto &segment : segments_) {
+      body_size += segment.size;
+    }
+    return body_size;
+  }
+
+  // Called by the connection after the last byte of this message has been sent.
+  void set_sent() { sent_ = true; }
+
+ private:
+  std::vector<MessageSegment> segments_;
+  // The memory of the owned segments, whose addresses do not change when more segments are added.
+  std::list<std::string> owned_data_;
+  SendCompletionCallback completion_cb_;
+  bool sent_{false};
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+#endif
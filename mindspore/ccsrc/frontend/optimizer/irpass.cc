@@ -308,6 +308,11 @@ OptimizeIRPassLib::OptimizeIRPassLib() {
   lamb_for_ge_ = MakeSubstitution(std::make_shared<LambForGE>(), "lamb_for_ge", prim::kPrimLamb);
   clip_by_norm_for_ge_ =
     MakeSubstitution(std::make_shared<ClipByNormForGE>(), "clip_by_norm_for_ge", prim::kPrimClipByNorm);
+
+  // The stateless substitutions which can be applied to the independent func graphs concurrently.
+  for (auto &substitution : {arithmetic_simplify_, arithmetic_simplify2_, value_based_eliminate_, depend_value_elim_}) {
+    substitution->is_local_ = true;
+  }
 }
 
 ResolveIRPassLib::ResolveIRPassLib() {
@@ -19,17 +19,104 @@
 #include <deque>
 #include <memory>
 #include <algorithm>
+#include <chrono>
+#include <exception>
+#include <mutex>
 #include <utility>
 
 #include "utils/hash_map.h"
+#include "utils/hash_set.h"
 #include "ir/anf.h"
 #include "ir/manager.h"
+#include "ir/graph_utils.h"
 #include "frontend/optimizer/optimizer.h"
+#include "include/common/thread_pool.h"
+#include "utils/ms_exception.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 /* namespace to support opt */
 namespace opt {
+namespace {
+constexpr char kParallelSubstitutionEnv[] = "MS_DEV_PARALLEL_SUBSTITUTION";
+
+struct SubstitutionChange {
+  AnfNodePtr node;
+  AnfNodePtr result;
+  SubstitutionPtr substitution;
+};
+
+// Match the local substitutions on the nodes of one func graph from the users to the inputs. The inputs of the
+// replaced node are not matched in this round, which are visited again after the replacement is committed.
+void MatchLocalSubstitutions(const OptimizerPtr &optimizer, const std::vector<AnfNodePtr> &nodes,
+                             const std::vector<SubstitutionPtr> &local_list, std::vector<SubstitutionChange> *changes) {
+  mindspore::HashSet<AnfNodePtr> skip_nodes;
+  for (auto iter = nodes.rbegin(); iter != nodes.rend(); ++iter) {
+    const auto &node = *iter;
+    auto cnode = dyn_cast_ptr<CNode>(node);
+    if (cnode == nullptr || skip_nodes.find(node) != skip_nodes.end()) {
+      continue;
+    }
+    for (auto &substitution : local_list) {
+      if (!substitution->predicate_(node)) {
+        continue;
+      }
+      TraceGuard trace_guard(std::make_shared<TraceOpt>(node->debug_info()));
+      ScopeGuard scope_guard(node->scope());
+      auto res = (*substitution->transform_)(optimizer, node);
+      if (res != nullptr && res != node) {
+        (void)changes->emplace_back(SubstitutionChange{node, res, substitution});
+        skip_nodes.insert(cnode->inputs().begin(), cnode->inputs().end());
+        break;
+      }
+    }
+  }
+}
+
+// The analyses of manager are computed lazily when they are read, so compute them before the func graphs are matched
+// concurrently, and the transforms only read them.
+void ComputeManagerAnalyses(const FuncGraphManagerPtr &manager, const std::vector<FuncGraphPtr> &func_graphs) {
+  MS_EXCEPTION_IF_NULL(manager);
+  (void)manager->free_variables_total();
+  for (auto &fg : func_graphs) {
+    (void)manager->func_graph_parents_total(fg);
+    (void)manager->parent(fg);
+    (void)manager->children(fg);
+    (void)manager->scopes(fg);
+    (void)manager->func_graphs_used_total(fg);
+    (void)manager->recursive(fg);
+    (void)manager->func_graph_meta_fg_prim_total(fg);
+  }
+}
+
+// Collect the managed nodes used by the new nodes of the result. It fails if the result uses a node replaced in this
+// round, which is matched on the replaced node and will be matched again in the next round.
+bool CollectUsedNodes(const AnfNodePtr &result, const AnfNodeSet &all_nodes,
+                      const mindspore::HashSet<AnfNodePtr> &replaced_nodes, std::vector<AnfNodePtr> *used_nodes) {
+  std::vector<AnfNodePtr> todo = {result};
+  mindspore::HashSet<AnfNodePtr> seen;
+  while (!todo.empty()) {
+    auto node = todo.back();
+    todo.pop_back();
+    if (node == nullptr || !seen.insert(node).second) {
+      continue;
+    }
+    if (replaced_nodes.find(node) != replaced_nodes.end()) {
+      return false;
+    }
+    if (all_nodes.contains(node)) {
+      (void)used_nodes->emplace_back(node);
+      continue;
+    }
+    auto cnode = dyn_cast_ptr<CNode>(node);
+    if (cnode != nullptr) {
+      (void)todo.insert(todo.end(), cnode->inputs().begin(), cnode->inputs().end());
+    }
+  }
+  return true;
+}
+}  // namespace
+
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action, bool has_priority_pattern) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
@@ -326,11 +413,100 @@ bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, con
   return changes;
 }
 
-bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
-  MS_EXCEPTION_IF_NULL(optimizer);
-  MS_EXCEPTION_IF_NULL(func_graph);
+bool SubstitutionList::ApplyLocalSubstitutionsInParallel(const OptimizerPtr &optimizer,
+                                                         const FuncGraphPtr &func_graph,
+                                                         const std::vector<SubstitutionPtr> &local_list) const {
   FuncGraphManagerPtr manager = optimizer->manager();
-  manager->AddFuncGraph(func_graph);
+  bool changes = false;
+  size_t round = 0;
+  size_t change_num = 0;
+  double match_cost = 0;
+  double commit_cost = 0;
+  auto start_time = std::chrono::steady_clock::now();
+  while (true) {
+    ++round;
+    // Collect the nodes of each func graph, the large func graphs are matched first.
+    std::vector<FuncGraphPtr> func_graphs = {func_graph};
+    for (auto &fg : func_graph->func_graphs_used_total()) {
+      if (fg != func_graph) {
+        (void)func_graphs.emplace_back(fg);
+      }
+    }
+    ComputeManagerAnalyses(manager, func_graphs);
+    std::vector<std::vector<AnfNodePtr>> graph_nodes;
+    for (auto &fg : func_graphs) {
+      auto include = [&fg](const AnfNodePtr &node) { return node->func_graph() == fg ? FOLLOW : EXCLUDE; };
+      (void)graph_nodes.emplace_back(TopoSort(fg->get_return(), SuccIncoming, include));
+    }
+    std::sort(graph_nodes.begin(), graph_nodes.end(),
+              [](const std::vector<AnfNodePtr> &a, const std::vector<AnfNodePtr> &b) { return a.size() > b.size(); });
+
+    // Match the substitutions of the func graphs concurrently, the manager is only read in this phase.
+    auto match_start_time = std::chrono::steady_clock::now();
+    std::vector<std::vector<SubstitutionChange>> graph_changes(graph_nodes.size());
+    std::vector<common::Task> tasks;
+    tasks.reserve(graph_nodes.size());
+    for (size_t i = 0; i < graph_nodes.size(); ++i) {
+      (void)tasks.emplace_back([&optimizer, &graph_nodes, &local_list, &graph_changes, i]() {
+        MatchLocalSubstitutions(optimizer, graph_nodes[i], local_list, &graph_changes[i]);
+        return common::SUCCESS;
+      });
+    }
+    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+    MsException::Instance().CheckException();
+    auto commit_start_time = std::chrono::steady_clock::now();
+    match_cost += std::chrono::duration<double, std::milli>(commit_start_time - match_start_time).count();
+
+    // Merge the replacements of each func graph into the manager. The replacement is left to the next round if its
+    // result uses a node replaced by the former replacements, or its node is used by the former results, which may be
+    // in another func graph.
+    bool round_changes = false;
+    auto &all_nodes = manager->all_nodes();
+    mindspore::HashSet<AnfNodePtr> replaced_nodes;
+    mindspore::HashSet<AnfNodePtr> result_used_nodes;
+    for (auto &changes_of_graph : graph_changes) {
+      if (changes_of_graph.empty()) {
+        continue;
+      }
+      auto tr = manager->Transact();
+      for (auto &change : changes_of_graph) {
+        std::vector<AnfNodePtr> used_nodes;
+        if (!all_nodes.contains(change.node) || result_used_nodes.find(change.node) != result_used_nodes.end() ||
+            !CollectUsedNodes(change.result, all_nodes, replaced_nodes, &used_nodes)) {
+          continue;
+        }
+        MS_LOG(DEBUG) << "Replace " << change.node->DebugString() << " with " << change.result->DebugString()
+                      << ", by " << change.substitution->name_;
+        if (!tr.Replace(change.node, change.result)) {
+          continue;
+        }
+        (void)replaced_nodes.insert(change.node);
+        result_used_nodes.insert(used_nodes.begin(), used_nodes.end());
+        round_changes = true;
+        ++change_num;
+        if (optimizer->is_watch_renormalize() &&
+            (change.substitution->renorm_action_ == FORCE_RENORM || change.result->abstract() == nullptr)) {
+          optimizer->set_is_untyped_generated();
+        }
+      }
+      tr.Commit();
+    }
+    auto commit_end_time = std::chrono::steady_clock::now();
+    commit_cost += std::chrono::duration<double, std::milli>(commit_end_time - commit_start_time).count();
+    changes = changes || round_changes;
+    if (!round_changes || is_once_) {
+      break;
+    }
+  }
+  auto total_cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+  MS_LOG(INFO) << "Parallel substitution of " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_"
+               << optimizer->CurPass_.name << ", round: " << round << ", replaced nodes: " << change_num
+               << ", match cost: " << match_cost << "ms, commit cost: " << commit_cost
+               << "ms, total cost: " << total_cost << "ms.";
+  return changes;
+}
+
+bool SubstitutionList::ApplySerially(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
   bool changes = false;
   static const auto traverse_mode =
     (common::GetEnv("MS_DEV_TRAVERSE_SUBSTITUTIONS_MODE") != "1" ? kOptTraverseFromIRToSubstitutions
@@ -349,6 +525,39 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
   return changes;
 }
 
+bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
+  MS_EXCEPTION_IF_NULL(optimizer);
+  MS_EXCEPTION_IF_NULL(func_graph);
+  FuncGraphManagerPtr manager = optimizer->manager();
+  manager->AddFuncGraph(func_graph);
+  bool enable_parallel = (common::GetEnv(kParallelSubstitutionEnv) == "1");
+  if (!enable_parallel || global_sensitive_ || optimizer->is_on_debug_ ||
+      MsContext::GetInstance()->get_param<int>(MS_CTX_EXECUTION_MODE) == kPynativeMode ||
+      func_graph->func_graphs_used_total().empty()) {
+    return ApplySerially(func_graph, optimizer);
+  }
+
+  // The local substitutions are applied to the func graphs concurrently, and then the others are applied serially.
+  std::vector<SubstitutionPtr> local_list;
+  std::vector<SubstitutionPtr> serial_list;
+  for (auto &substitution : list_) {
+    if (substitution->is_local_) {
+      (void)local_list.emplace_back(substitution);
+    } else {
+      (void)serial_list.emplace_back(substitution);
+    }
+  }
+  if (local_list.empty()) {
+    return ApplySerially(func_graph, optimizer);
+  }
+  bool changes = ApplyLocalSubstitutionsInParallel(optimizer, func_graph, local_list);
+  if (!serial_list.empty()) {
+    SubstitutionList serial_substitutions(serial_list, is_once_, global_sensitive_);
+    changes = serial_substitutions.ApplySerially(func_graph, optimizer) || changes;
+  }
+  return changes;
+}
+
 bool SimpleRewriter::Run() {
   bool changed = false;
   auto seen = NewSeenGeneration();
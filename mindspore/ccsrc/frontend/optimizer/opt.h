@@ -48,6 +48,9 @@ class Substitution {
   RenormAction renorm_action_;
   // Determine whether it is a priority substitution, that is, some patterns need to be matched prior to others.
   bool has_priority_pattern_{false};
+  // Whether the transform is stateless and only creates new nodes in the func graph of the matched node without
+  // modifying the manager, so that it can be applied to the different func graphs concurrently.
+  bool is_local_{false};
 
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
                const RenormAction &renorm_action, bool has_priority_pattern)
@@ -83,6 +86,11 @@ class SubstitutionList {
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
+  bool ApplySerially(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
+  // Apply the local substitutions to the independent func graphs concurrently, and commit the replacements of each
+  // func graph to the manager by one transaction.
+  bool ApplyLocalSubstitutionsInParallel(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                                         const std::vector<SubstitutionPtr> &local_list) const;
   bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
   bool ApplySubstitutionToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
                              const SubstitutionPtr &substitution) const;
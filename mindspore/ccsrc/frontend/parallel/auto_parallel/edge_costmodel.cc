@@ -19,14 +19,44 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 #include <utility>
 #include "frontend/parallel/auto_parallel/costmodel.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
 #include "frontend/parallel/ops_info/reshape_info.h"
+#include "include/common/thread_pool.h"
+#include "utils/ms_exception.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+// The redistribution cost only depends on the two layouts, the data type and the devices, so it is shared by the edges
+// carrying the same tensors, e.g. the edges of the repeated layers.
+std::mutex redistribution_cost_mutex;
+std::unordered_map<std::string, CostPtr> redistribution_cost_cache;
+// The redistribution costs are computed concurrently when an edge has at least so many uncached layout pairs.
+constexpr size_t kParallelRedistributionCostThreshold = 64;
+
+std::string RedistributionCostKey(size_t type_length, const TypePtr &type, const RankList &dev_list) {
+  MS_EXCEPTION_IF_NULL(type);
+  std::ostringstream buffer;
+  buffer << "type: " << type->ToString() << ", type length: " << type_length
+         << ", gamma: " << CostModelContext::GetInstance()->costmodel_gamma() << ", devices:";
+  for (auto rank : dev_list) {
+    buffer << " " << rank;
+  }
+  return buffer.str();
+}
+}  // namespace
+
+void Edge::ClearRedistributionCostCache() {
+  std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+  redistribution_cost_cache.clear();
+}
+
 Status Edge::InitEdgeCost() {
   bool has_available_cost = false;
   pre_op_output_.clear();
@@ -64,33 +94,8 @@ Status Edge::InitEdgeCost() {
       }
     }
   } else {
-    for (auto &target_output : pre_op_output_) {
-      auto target_output_lyt = target_output.second[prev_op_output_index_].tensor_layout();
-      auto target_output_str = target_output.first;
-      auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
-      auto type = prev_op_->outputs_type()[prev_op_output_index_];
-      for (auto &target_input : next_op_input_) {
-        auto target_input_lyt = target_input.second[next_op_input_index_].tensor_layout();
-        auto target_input_str = target_input.first;
-        CostPtr cost;
-        if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &cost) != SUCCESS) {
-          MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
-        }
-        MS_EXCEPTION_IF_NULL(cost);
-        MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
-                      << ", communication_cost: " << cost->communication_cost_
-                      << ", communication_without_parameter_: " << cost->communication_without_parameter_
-                      << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
-        // refine communication cost calculation for practice
-        RefineForPracticalCost(cost, true);
-        cost->communication_forward_ = cost->communication_redis_forward_;
-        CostPtrKey ck = {target_output_str, target_input_str};
-        CostPtrList cl;
-        cl.push_back(cost);
-        (void)cost_map_.emplace(std::make_pair(ck, cl));
-        has_available_cost = true;
-      }
-    }
+    InitRedistributionCostMap();
+    has_available_cost = !cost_map_.empty();
   }
   if (!has_available_cost) {
     const auto fully_use = CostModelContext::GetInstance()->fully_use_device();
@@ -114,6 +119,95 @@ Status Edge::InitEdgeCost() {
   return Status::SUCCESS;
 }
 
+void Edge::InitRedistributionCostMap() {
+  auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
+  auto type = prev_op_->outputs_type()[prev_op_output_index_];
+  const auto common_key = RedistributionCostKey(type_length, type, prev_op_->stage_device_list());
+  std::vector<std::string> output_layout_keys;
+  std::vector<std::string> input_layout_keys;
+  for (auto &target_output : pre_op_output_) {
+    (void)output_layout_keys.emplace_back(target_output.second[prev_op_output_index_].tensor_layout().ToString());
+  }
+  for (auto &target_input : next_op_input_) {
+    (void)input_layout_keys.emplace_back(target_input.second[next_op_input_index_].tensor_layout().ToString());
+  }
+
+  // Look up the cached costs, and collect the distinct layout pairs whose cost is not cached yet.
+  const size_t input_num = next_op_input_.size();
+  const size_t pair_num = pre_op_output_.size() * input_num;
+  std::vector<std::string> pair_keys(pair_num);
+  std::vector<CostPtr> pair_costs(pair_num);
+  std::unordered_map<std::string, size_t> uncached_index;
+  std::vector<size_t> uncached_pairs;
+  {
+    std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+    for (size_t i = 0; i < pair_num; ++i) {
+      pair_keys[i] = common_key + output_layout_keys[i / input_num] + "->" + input_layout_keys[i % input_num];
+      auto iter = redistribution_cost_cache.find(pair_keys[i]);
+      if (iter != redistribution_cost_cache.end()) {
+        pair_costs[i] = iter->second;
+      } else if (uncached_index.emplace(pair_keys[i], uncached_pairs.size()).second) {
+        uncached_pairs.push_back(i);
+      }
+    }
+  }
+
+  std::vector<CostPtr> uncached_costs(uncached_pairs.size());
+  auto compute_cost = [this, type_length, &type, input_num, &uncached_pairs, &uncached_costs](size_t index) {
+    auto pair = uncached_pairs[index];
+    auto target_output_lyt = pre_op_output_[pair / input_num].second[prev_op_output_index_].tensor_layout();
+    auto target_input_lyt = next_op_input_[pair % input_num].second[next_op_input_index_].tensor_layout();
+    CostPtr cost;
+    if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &cost) != SUCCESS) {
+      MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
+    }
+    MS_EXCEPTION_IF_NULL(cost);
+    MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
+                  << ", communication_cost: " << cost->communication_cost_
+                  << ", communication_without_parameter_: " << cost->communication_without_parameter_
+                  << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
+    // refine communication cost calculation for practice
+    RefineForPracticalCost(cost, true);
+    cost->communication_forward_ = cost->communication_redis_forward_;
+    uncached_costs[index] = cost;
+  };
+  auto thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  if (uncached_pairs.size() >= kParallelRedistributionCostThreshold && thread_num > 1) {
+    std::vector<common::Task> tasks;
+    size_t task_size = (uncached_pairs.size() + thread_num - 1) / thread_num;
+    for (size_t begin = 0; begin < uncached_pairs.size(); begin += task_size) {
+      size_t end = std::min(begin + task_size, uncached_pairs.size());
+      (void)tasks.emplace_back([&compute_cost, begin, end]() {
+        for (size_t index = begin; index < end; ++index) {
+          compute_cost(index);
+        }
+        return common::SUCCESS;
+      });
+    }
+    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+    MsException::Instance().CheckException();
+  } else {
+    for (size_t index = 0; index < uncached_pairs.size(); ++index) {
+      compute_cost(index);
+    }
+  }
+  if (!uncached_pairs.empty()) {
+    std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+    for (size_t index = 0; index < uncached_pairs.size(); ++index) {
+      redistribution_cost_cache[pair_keys[uncached_pairs[index]]] = uncached_costs[index];
+    }
+  }
+
+  // Each strategy pair owns a copy of the cost, since the costs are updated by the later memory cost calculation.
+  for (size_t i = 0; i < pair_num; ++i) {
+    const auto &cost = (pair_costs[i] != nullptr) ? pair_costs[i] : uncached_costs[uncached_index[pair_keys[i]]];
+    CostPtrKey ck = {pre_op_output_[i / input_num].first, next_op_input_[i % input_num].first};
+    CostPtrList cl;
+    cl.push_back(std::make_shared<Cost>(*cost));
+    (void)cost_map_.emplace(std::make_pair(ck, cl));
+  }
+}
+
 Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, const TensorLayout &next_op_input_layout,
                                    size_t type_length, const TypePtr &type, CostPtr *cost) {
   MS_EXCEPTION_IF_NULL(prev_op_);
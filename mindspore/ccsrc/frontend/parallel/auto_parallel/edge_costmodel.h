@@ -82,6 +82,8 @@ class Edge {
   std::string edge_name() const { return edge_name_; }
   // Init cost_map_: for each output layout and input layout, calculate the cost
   Status InitEdgeCost();
+  // Clear the redistribution costs shared by the edges, which is called before building a new cost graph.
+  static void ClearRedistributionCostCache();
   std::map<CostPtrKey, CostPtrList> GetCostMap() { return cost_map_; }
   CostPtr GetCostByStrategyPair(const CostPtrKey &stra_pair);
 
@@ -182,6 +184,9 @@ class Edge {
   // In the inference phase, this is used to mark whether the output of the previous operator is critical.
   int64_t is_output_critical_ = 0;
 
+  // Init cost_map_ of the edge needing redistribution, the costs of the same layout pairs are computed only once.
+  void InitRedistributionCostMap();
+
   // Returns whether two double variable are equal.
   bool IsDoubleEqual(double x, double y) const { return std::abs(x - y) < EPS; }
 };
@@ -16,6 +16,7 @@
 
 #include "frontend/parallel/auto_parallel/rec_core/rec_partition.h"
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -24,9 +25,29 @@
 #include "ir/anf.h"
 #include "frontend/parallel/status.h"
 #include "frontend/parallel/ops_info/ops_utils.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+constexpr char kRecPartitionTimeBudgetEnv[] = "MS_DEV_REC_PARTITION_TIME_BUDGET";
+
+// Get the time budget of partitioning in seconds, 0 means no budget.
+double GetPartitionTimeBudget() {
+  auto budget_str = common::GetEnv(kRecPartitionTimeBudgetEnv);
+  if (budget_str.empty()) {
+    return 0;
+  }
+  try {
+    auto budget = std::stod(budget_str);
+    return budget > 0 ? budget : 0;
+  } catch (const std::exception &) {
+    MS_LOG(WARNING) << "Invalid " << kRecPartitionTimeBudgetEnv << ": " << budget_str << ", it is ignored.";
+    return 0;
+  }
+}
+}  // namespace
+
 // Get the target node's weight for sorting.
 double GetWeights(const Graph::NodeType &node) {
   const OperatorRec &op = node.apply;
@@ -222,8 +243,21 @@ Status PartitionForAllDevices(const size_t num_device, const double device_memor
   if (iter_times > 10) {
     MS_LOG(EXCEPTION) << "ERROR: Number of iter_times can't be larger than 10.";
   }
+  // When the time budget is exhausted, the remaining cuts are skipped and the nodes keep the strategies of the
+  // finished cuts, which are always valid since the uncut dimensions are replicated.
+  const double time_budget = GetPartitionTimeBudget();
+  const auto start_time = std::chrono::steady_clock::now();
+  auto is_budget_exhausted = [time_budget, &start_time]() {
+    return time_budget > 0 &&
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count() > time_budget;
+  };
   // N-cuts loop
   for (int64_t loop = 0; loop < iter_times; loop++) {
+    if (is_budget_exhausted()) {
+      MS_LOG(WARNING) << "The time budget of partitioning " << time_budget << "s is exhausted after " << loop
+                      << " of " << iter_times << " cuts, use the strategies of the finished cuts.";
+      break;
+    }
     // Sort by weights
     std::vector<size_t> reorder_node_list = SortByWeight(graph);
 
@@ -60,6 +60,8 @@ class COMMON_EXPORT AnfAlgo {
   // get cnode primitive
   static AnfNodePtr GetCNodePrimitiveNode(const CNodePtr &node);
   static void SetNodeInput(const CNodePtr &node, const AnfNodePtr &input_node, size_t index);
+  // set cnode primitive node through the manager if any, which keeps the primitive nodes index of manager
+  static void SetCNodePrimitiveNode(const CNodePtr &node, const AnfNodePtr &primitive_node);
   static PrimitivePtr GetCNodePrimitive(const AnfNodePtr &node);
   // check whether anf node is a node of 'primitive_type',such as make_tuple is a cnode of kPrimMakeTuple
   static bool CheckPrimitiveType(const AnfNodePtr &node, const PrimitivePtr &primitive_type);
@@ -685,6 +685,17 @@ Status DeviceQueueOp::SendDataToCPU() {
   MS_LOG(INFO) << "Device queue, sending data to CPU.";
   int64_t total_batch = 0;
 
+  // In the dynamic shape data sinking mode, the rows are pushed to the lock free data queue of CPU, which copies the
+  // data to the memory pool of CPU in the push, so the host data needs no release.
+  bool sink_data = dynamic_shape_;
+  if (sink_data) {
+    std::function<void(void *, int32_t)> release_function([](void *, int32_t) { return; });
+    auto ret = mindspore::DataQueueHandler::OpenDynamicBufQueue(channel_name_, release_function);
+    if (ret != BlockQueueStatus_T::SUCCESS) {
+      RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to open channel for sending data.");
+    }
+  }
+
   while (!(child_iterator_->EofHandled())) {
     TensorRow curr_row;
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
@@ -696,14 +707,34 @@ Status DeviceQueueOp::SendDataToCPU() {
       for (auto &tensor : curr_row) {
         MS_LOG(DEBUG) << "Feature size is " << tensor->SizeInBytes() << ".";
       }
+      if (sink_data) {
+        RETURN_IF_NOT_OK(FilterMetadata(&curr_row));
+        RETURN_IF_NOT_OK(CheckExceptions(curr_row));
+        std::vector<device::DataQueueItem> items;
+        for (auto &i : curr_row) {
+          device::DataQueueItem data_item;
+          data_item.data_len_ = static_cast<size_t>(i->SizeInBytes());
+          data_item.shapes_ = i->shape().AsVector();
+          data_item.data_ptr_ = const_cast<void *>(static_cast<const void *>(i->GetBuffer()));
+          data_item.data_type_ = i->type().ToString();
+          items.push_back(data_item);
+        }
+        uint64_t push_cost = 0;
+        RETURN_IF_NOT_OK(RetryPushData(items, false, &push_cost));
+      }
       total_batch++;
-      if (stop_send_) {
+      if (stop_send_ || (sink_data && total_batch_ > 0 && total_batch >= total_batch_)) {
         break;
       }
     }
   }
 
   MS_LOG(INFO) << "Device queue total batch is " << total_batch << ".";
+  if (sink_data) {
+    send_finished_ = !TaskManager::FindMe()->Interrupted();
+    mindspore::DataQueueHandler::Close(channel_name_);
+    mindspore::DataQueueHandler::CloseConfirm();
+  }
 
   return Status::OK();
 }
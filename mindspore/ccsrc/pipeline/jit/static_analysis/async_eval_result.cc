@@ -46,11 +46,20 @@ void AnalysisSchedule::Yield(AsyncInferTask *async_infer_task) {
       MS_LOG(DEBUG) << " The active thread count: " << activate_threads_.size() << " thread id: " << thread_id()
                     << " async_infer_task thread id:" << async_infer_task->thread_id();
       (void)activate_threads_.erase(thread_id());
+      HandOffToNextReady();
     }
   }
   activate_thread_cv_.notify_one();
 }
 
+void AnalysisSchedule::HandOffToNextReady() {
+  if (!activate_threads_.empty() || schedule_list_.empty()) {
+    return;
+  }
+  (void)hand_off_count_.fetch_add(1);
+  SetNextReady();
+}
+
 void AnalysisSchedule::HandleException(const std::exception &ex) {
   // Just record the first exception information.
   if (!StaticAnalysisException::Instance().HasException()) {
@@ -119,6 +128,7 @@ void AnalysisSchedule::Add2Schedule(const AsyncInferTaskPtr &async_infer_task_pt
   std::lock_guard<std::mutex> lock(activate_thread_lock_);
   MS_EXCEPTION_IF_NULL(async_infer_task_ptr);
   schedule_list_.push_back(async_infer_task_ptr);
+  (void)scheduled_task_count_.fetch_add(1);
   activate_thread_cv_.notify_one();
   MS_LOG(DEBUG) << " async: " << async_infer_task_ptr->thread_id() << " address: " << async_infer_task_ptr.get()
                 << " The active thread count: " << activate_threads_.size()
@@ -31,6 +31,8 @@
 #include <fstream>
 #include <chrono>
 #include <mutex>
+#include <array>
+#include <atomic>
 
 #include "pipeline/jit/static_analysis/static_analysis.h"
 
@@ -64,6 +66,7 @@ class AnalysisSchedule {
       std::lock_guard<std::mutex> activeLock(activate_thread_lock_);
       activate_threads_.erase(AnalysisSchedule::thread_id());
       MS_LOG(DEBUG) << "Infer return to main thread.";
+      HandOffToNextReady();
     }
     activate_thread_cv_.notify_one();
   }
@@ -89,79 +92,110 @@ class AnalysisSchedule {
                     << " The infer_thread_count: " << infer_thread_count_
                     << " schedule list size: " << schedule_list_.size() << " thread: " << thread_id() + " "
                     << (activate_threads_.size() > 0 ? activate_threads_.begin()->c_str() : "");
+      HandOffToNextReady();
     }
     activate_thread_cv_.notify_one();
   }
 
+  void ResetStatistics() {
+    scheduled_task_count_ = 0;
+    hand_off_count_ = 0;
+    schedule_wait_time_us_ = 0;
+  }
+
+  void RecordScheduleWaitTime(uint64_t wait_time_us) { (void)schedule_wait_time_us_.fetch_add(wait_time_us); }
+
+  size_t scheduled_task_count() const { return scheduled_task_count_.load(); }
+  size_t hand_off_count() const { return hand_off_count_.load(); }
+  uint64_t schedule_wait_time_us() const { return schedule_wait_time_us_.load(); }
+
  private:
   void Schedule();
   void SetNextReady();
+  // The thread giving up the activation picks the next ready task itself, instead of waking up the schedule thread
+  // and waiting for it. The caller should hold activate_thread_lock_.
+  void HandOffToNextReady();
   void Start() {
     auto thread = std::thread([this] { Schedule(); });
     thread.detach();
   }
   AnalysisSchedule() { Start(); }
   std::atomic<int> infer_thread_count_{0};
-  bool run_{true};
+  std::atomic<bool> run_{true};
   std::mutex infer_thread_lock_;
   std::condition_variable infer_thread_cv_;
   std::mutex activate_thread_lock_;
   std::condition_variable activate_thread_cv_;
   std::list<AsyncInferTaskPtr> schedule_list_;
   std::set<std::string> activate_threads_;
+  // The statistics of the schedule, which are reported when the analysis finishes.
+  std::atomic<size_t> scheduled_task_count_{0};
+  std::atomic<size_t> hand_off_count_{0};
+  std::atomic<uint64_t> schedule_wait_time_us_{0};
   const std::string kStateStop = "Stop";
   static thread_local std::string thread_id_;
 };
 
+// The cache is split into shards guarded by their own locks, so the infer threads accessing different keys do not
+// contend for one lock.
 template <typename KeyType, typename ValueType, typename CacheType>
 class MultiThreadCache {
  public:
-  using iterator = typename CacheType::iterator;
-  using const_iterator = typename CacheType::const_iterator;
-
   ValueType get(const KeyType &key) {
-    std::lock_guard<std::mutex> lock(lock_);
-    auto it = cache_.find(key);
-    if (it != cache_.end()) {
+    auto &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.cache.find(key);
+    if (it != shard.cache.end()) {
       return it->second;
     }
     return nullptr;
   }
 
   void set(const KeyType &key, const ValueType &data) {
-    std::lock_guard<std::mutex> lock(lock_);
-    cache_[key] = data;
+    auto &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.cache[key] = data;
   }
 
   void clear() {
-    std::lock_guard<std::mutex> lock(lock_);
-    cache_.clear();
+    for (auto &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      shard.cache.clear();
+    }
   }
 
-  size_t size() { return cache_.size(); }
+  size_t size() {
+    size_t total_size = 0;
+    for (auto &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      total_size += shard.cache.size();
+    }
+    return total_size;
+  }
 
   bool empty() { return size() == 0; }
 
   std::string dump() {
     std::ostringstream buf;
-    for (auto &item : cache_) {
-      buf << "{" << item.first->ToString() << ": " << item.second->ToString() << "}" << std::endl;
+    for (auto &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      for (auto &item : shard.cache) {
+        buf << "{" << item.first->ToString() << ": " << item.second->ToString() << "}" << std::endl;
+      }
     }
     return buf.str();
   }
 
-  iterator begin() { return cache_.begin(); }
-  iterator end() { return cache_.end(); }
-
-  const_iterator begin() const { return cache_.cbegin(); }
-  const_iterator end() const { return cache_.cend(); }
+ private:
+  static constexpr size_t kShardNum = 16;
+  struct Shard {
+    std::mutex lock;
+    CacheType cache;
+  };
 
-  const_iterator cbegin() const { return cache_.cbegin(); }
-  const_iterator cend() const { return cache_.cend(); }
+  Shard &GetShard(const KeyType &key) { return shards_[typename CacheType::hasher{}(key) % kShardNum]; }
 
- private:
-  std::mutex lock_;
-  CacheType cache_;
+  std::array<Shard, kShardNum> shards_;
 };
 
 template <typename KeyType, typename ValueType, typename CacheType>
@@ -330,7 +364,11 @@ class AsyncInferTask {
     AnalysisSchedule::GetInstance().Yield(this);
     std::unique_lock<std::mutex> lock(lock_);
     MS_LOG(DEBUG) << AnalysisSchedule::thread_id() << " waiting.";
+    auto start_time = std::chrono::steady_clock::now();
     condition_var_.wait(lock, [this] { return ready_; });
+    auto wait_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+    AnalysisSchedule::GetInstance().RecordScheduleWaitTime(static_cast<uint64_t>(wait_time.count()));
     MS_LOG(DEBUG) << this << " received notify and wake up: " << ready_ << " thread id:" << thread_id_;
     ProcessResult();
     auto ans = abstract_ptr_->TryGetResult();
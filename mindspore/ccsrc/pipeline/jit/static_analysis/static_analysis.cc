@@ -26,6 +26,7 @@
 #include "frontend/operator/ops.h"
 #include "utils/symbolic.h"
 #include "utils/ms_exception.h"
+#include "utils/profile.h"
 #include "ir/func_graph_cloner.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "pipeline/jit/static_analysis/evaluator.h"
@@ -105,8 +106,35 @@ void PrimitiveEvalCache::Clear() {
   prim_cache_.clear();
 }
 
+namespace {
+constexpr double kSecondToMicrosecond = 1e6;
+
+void ReportScheduleStatistics(double start_time, double infer_end_time, double end_time) {
+  auto &schedule = AnalysisSchedule::GetInstance();
+  if (schedule.scheduled_task_count() == 0) {
+    return;
+  }
+  // The infer phase runs the main thread, the wait phase waits for the infer threads of the branches to exit.
+  double infer_time = infer_end_time - start_time;
+  double wait_time = end_time - infer_end_time;
+  double schedule_wait_time = static_cast<double>(schedule.schedule_wait_time_us()) / kSecondToMicrosecond;
+  MS_LOG(INFO) << "Multi-thread static analysis cost " << (end_time - start_time) << "s, infer: " << infer_time
+               << "s, wait for infer threads: " << wait_time << "s, total schedule wait of all threads: "
+               << schedule_wait_time << "s, scheduled tasks: " << schedule.scheduled_task_count()
+               << ", hand-offs: " << schedule.hand_off_count();
+#ifdef ENABLE_PROFILE
+  MsProfile::StatTime("static_analysis.infer", infer_time);
+  MsProfile::StatTime("static_analysis.wait_threads", wait_time);
+  MsProfile::StatTime("static_analysis.schedule_wait", schedule_wait_time);
+#endif
+}
+}  // namespace
+
 AnalysisResult AnalysisEngine::Run(const FuncGraphPtr &func_graph, const AbstractBasePtrList &args_spec_list) {
   StaticAnalysisException::Instance().ClearException();
+  AnalysisSchedule::GetInstance().ResetStatistics();
+  double start_time = GetTime();
+  double infer_end_time = start_time;
   AnalysisResult result;
   try {
     MS_EXCEPTION_IF_NULL(func_graph);
@@ -123,6 +151,7 @@ AnalysisResult AnalysisEngine::Run(const FuncGraphPtr &func_graph, const Abstrac
     AnalysisContextPtr dummy_context = AnalysisContext::DummyContext();
     MS_LOG(DEBUG) << func_graph->ToString() << ": Run begin.";
     AnalysisContextPtr root_context = Run(func_graph, dummy_context, args_conf_list);
+    infer_end_time = GetTime();
     AnalysisSchedule::GetInstance().Wait();
     MS_EXCEPTION_IF_NULL(root_context);
     auto root_context_fg = root_context->func_graph();
@@ -141,6 +170,7 @@ AnalysisResult AnalysisEngine::Run(const FuncGraphPtr &func_graph, const Abstrac
   }
   AnalysisSchedule::GetInstance().Wait();
   MS_LOG(DEBUG) << func_graph->ToString() << ": Run end.";
+  ReportScheduleStatistics(start_time, infer_end_time, GetTime());
   // Set the sequence nodes' elements use flags all true.
   SetSequenceElementsUseFlagsRecursively(result.eval_result->abstract(), true);
   MS_LOG(DEBUG) << func_graph->ToString() << ":SetSequenceElementsUseFlagsRecursively Run end.";
@@ -22,6 +22,7 @@
 #include "frontend/optimizer/ad/grad.h"
 #include "pipeline/jit/pass.h"
 #include "runtime/pynative/op_executor.h"
+#include "runtime/pynative/op_kernel_cache.h"
 #include "ir/cell.h"
 
 namespace mindspore::pynative {
@@ -107,6 +108,7 @@ void PyNativeExecutor::ClearRes() {
   MS_LOG(DEBUG) << "Clear all res";
   session::PynativeTaskManager::GetInstance().Reset();
   runtime::OpExecutor::GetInstance().Reset();
+  runtime::OpKernelCache::GetInstance().Clear();
 
   // Maybe exit in runop step
   auto ms_context = MsContext::GetInstance();
@@ -326,6 +326,13 @@ void AscendKernelRuntime::ReleaseDeviceRes() {
 
   // DestroyHccl must be called before FreeDeviceMemory
   (void)DestroyHccl();
+  if (copy_stream_ != nullptr) {
+    auto ret = rtStreamDestroy(copy_stream_);
+    if (ret != RT_ERROR_NONE) {
+      MS_LOG(ERROR) << "Destroy copy stream failed, ret:" << ret;
+    }
+    copy_stream_ = nullptr;
+  }
   if (mem_manager_ != nullptr) {
     mem_manager_->Finalize();
   }
@@ -1376,6 +1383,17 @@ void AscendKernelRuntime::KernelLaunchProfiling(const std::string &kernel_name)
 #endif
 }
 
+void *AscendKernelRuntime::GetOrCreateCopyStream() {
+  if (copy_stream_ == nullptr) {
+    auto ret = rtStreamCreate(&copy_stream_, 0);
+    if (ret != RT_ERROR_NONE) {
+      MS_LOG(WARNING) << "Create copy stream failed, ret:" << ret;
+      copy_stream_ = nullptr;
+    }
+  }
+  return copy_stream_;
+}
+
 std::shared_ptr<DeviceEvent> AscendKernelRuntime::CreateDeviceEvent() {
   auto ascend_event = std::make_shared<AscendEvent>();
   MS_EXCEPTION_IF_NULL(ascend_event);
@@ -74,6 +74,7 @@ class AscendKernelRuntime : public KernelRuntime {
   std::shared_ptr<DeviceEvent> CreateDeviceTimeEvent() override;
   void *compute_stream() const override { return stream_; }
   void *communication_stream() const override { return communication_stream_; }
+  void *GetOrCreateCopyStream() override;
   void *GetModelStream(uint32_t graph_id) const override;
   // add for MindRT
   void ReleaseDeviceRes() override;
@@ -127,6 +128,8 @@ class AscendKernelRuntime : public KernelRuntime {
   static std::vector<rtExceptionInfo> task_fail_infoes_;
   std::map<uint32_t, std::shared_ptr<std::map<uint32_t, void *>>> device_stream_id_map_;
   std::map<uint32_t, void *> stream_id_map_;
+  // The stream is created on demand and is not assigned to the kernels.
+  void *copy_stream_{nullptr};
   std::set<uint32_t> initialized_device_set_{};
   void CreateDefaultStream(uint32_t device_id);
 };
@@ -142,7 +142,7 @@ void UpdateFracNZReduceOp(const CNodePtr &cnode) {
     auto prim = GetCNodePrimitive(cnode);
     auto new_prim = std::make_shared<Primitive>(*prim);
     auto new_prim_node = NewValueNode(new_prim);
-    cnode->set_input(0, new_prim_node);
+    common::AnfAlgo::SetCNodePrimitiveNode(cnode, new_prim_node);
 
     auto axis_value = new_prim->GetAttr(kAttrAxis);
     std::vector<int64_t> default_axis;
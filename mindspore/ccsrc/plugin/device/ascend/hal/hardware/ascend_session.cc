@@ -770,7 +770,7 @@ void StoreCNodePrimitive(const KernelGraphPtr &graph) {
     auto primitive = common::AnfAlgo::GetCNodePrimitive(node);
     MS_EXCEPTION_IF_NULL(primitive);
     auto new_primitive = std::make_shared<Primitive>(*primitive);
-    node->set_input(kAnfPrimitiveIndex, NewValueNode(new_primitive));
+    common::AnfAlgo::SetCNodePrimitiveNode(node, NewValueNode(new_primitive));
   }
 }
 
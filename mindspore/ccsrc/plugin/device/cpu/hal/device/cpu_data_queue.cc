@@ -0,0 +1,64 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/device/cpu_data_queue.h"
+#include "runtime/hardware/device_context_manager.h"
+#include "utils/ms_context.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+DeviceContext *GetCpuDeviceContext() {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  uint32_t device_id = ms_context->get_param<uint32_t>(MS_CTX_DEVICE_ID);
+  auto device_context = DeviceContextManager::GetInstance().GetOrCreateDeviceContext({kCPUDevice, device_id});
+  MS_EXCEPTION_IF_NULL(device_context);
+  device_context->Initialize();
+  return device_context;
+}
+}  // namespace
+
+CpuDataQueueDynamic::CpuDataQueueDynamic(const size_t capacity)
+    : LockFreeDataQueue(capacity, GetCpuDeviceContext()) {}
+
+BlockQueueStatus_T CpuDataQueueDynamic::CopyToDevice(std::vector<DataQueueItem> *data) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  MS_EXCEPTION_IF_NULL(device_context_->device_res_manager_);
+  for (auto &item : *data) {
+    if (item.data_ptr_ == nullptr) {
+      MS_LOG(ERROR) << "Invalid Input: ptr: " << item.data_ptr_ << ", len: " << item.data_len_;
+      return ERROR_INPUT;
+    }
+    void *addr = device_context_->device_res_manager_->AllocateMemory(item.data_len_);
+    if (addr == nullptr) {
+      MS_LOG(ERROR) << "Allocate memory failed, size: " << item.data_len_;
+      return INTERNAL_ERROR;
+    }
+    auto ret = memcpy_s(addr, item.data_len_, item.data_ptr_, item.data_len_);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy failed, ret: " << ret << ", size: " << item.data_len_;
+      device_context_->device_res_manager_->FreeMemory(addr);
+      return INTERNAL_ERROR;
+    }
+    item.device_addr_ = addr;
+  }
+  return SUCCESS;
+}
+}  // namespace device
+}  // namespace mindspore
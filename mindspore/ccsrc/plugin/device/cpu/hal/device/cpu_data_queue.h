@@ -0,0 +1,37 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATA_QUEUE_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATA_QUEUE_H_
+
+#include <vector>
+#include "runtime/data_queue/lock_free_data_queue.h"
+
+namespace mindspore {
+namespace device {
+// The dynamic shape data queue of data sinking on the CPU device, the host data is copied to the memory pool of CPU.
+class CpuDataQueueDynamic : public LockFreeDataQueue {
+ public:
+  explicit CpuDataQueueDynamic(const size_t capacity);
+  ~CpuDataQueueDynamic() override = default;
+
+ protected:
+  BlockQueueStatus_T CopyToDevice(std::vector<DataQueueItem> *data) override;
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_DATA_QUEUE_H_
@@ -16,9 +16,11 @@
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
 
+#include <utility>
+
+#include "abstract/utils.h"
 #include "distributed/constants.h"
 #include "runtime/collective/collective_communication_lib.h"
-#include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
 
 namespace mindspore {
 namespace device {
@@ -39,13 +41,8 @@ bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_
     return true;
   }
 
-  launcher_ = std::make_unique<AllReduceLauncher>();
-  CHECK_IF_NULL(launcher_);
-  if (!launcher_->Initialize()) {
-    MS_LOG(EXCEPTION) << "Failed to initialize the allreduce launcher.";
-  }
-  node_ = launcher_->collective_node();
-
+  // The topology of the ranks is built by the first collective operation, so a job which never runs one doesn't wait
+  // for the other ranks here.
   cgn_ = std::dynamic_pointer_cast<distributed::cluster::topology::ComputeGraphNode>(
     ClusterContext::instance()->node_base());
 
@@ -57,8 +54,48 @@ bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_
 }
 
 bool MsCollectiveCommLib::Finalize() {
-  if (launcher_ != nullptr) {
-    return launcher_->Finalize();
+  std::lock_guard<std::mutex> lock(collective_ops_mutex_);
+  collective_ops_impl_.reset();
+  if (topo_node_ != nullptr) {
+    (void)topo_node_->Finalize();
+    topo_node_.reset();
+  }
+  return true;
+}
+
+bool MsCollectiveCommLib::InitializeCollectiveOps() {
+  std::lock_guard<std::mutex> lock(collective_ops_mutex_);
+  if (collective_ops_impl_ != nullptr) {
+    return true;
+  }
+  CHECK_IF_NULL(cgn_);
+  // Connecting to the other ranks blocks until all of them have registered their addresses to the meta server.
+  topo_node_ = std::make_shared<TopologyNode>(global_rank_size_, cgn_);
+  if (!topo_node_->Initialize() || !topo_node_->Initialized()) {
+    MS_LOG(ERROR) << "Failed to initialize the topology node of rank " << global_rank_id_;
+    (void)topo_node_->Finalize();
+    topo_node_.reset();
+    return false;
+  }
+  auto collective_ops_impl = std::make_unique<MSCollectiveOpsImpl>(topo_node_);
+  if (!collective_ops_impl->Initialize()) {
+    MS_LOG(ERROR) << "Failed to initialize the collective operations of rank " << global_rank_id_;
+    return false;
+  }
+  collective_ops_impl_ = std::move(collective_ops_impl);
+  return true;
+}
+
+bool MsCollectiveCommLib::CopyForSingleRank(const void *send_buff, void *recv_buff, size_t count,
+                                            TypeId data_type) const {
+  if (send_buff == recv_buff) {
+    return true;
+  }
+  size_t data_size = count * abstract::TypeIdSize(data_type);
+  auto ret = memcpy_s(recv_buff, data_size, send_buff, data_size);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+    return false;
   }
   return true;
 }
@@ -105,18 +142,10 @@ bool MsCollectiveCommLib::AllGatherHostHashName(size_t host_hash_name, std::vect
 
 bool MsCollectiveCommLib::BroadcastUniqueID(const std::string &group_name, size_t root_info_size, void *root_info) {
   CHECK_IF_NULL(root_info);
-  CHECK_IF_NULL(node_);
+  CHECK_IF_NULL(cgn_);
   auto group = GetGroup(group_name);
   CHECK_IF_NULL(group);
 
-  if (!synchronized_) {
-    if (!node_->SynchronizeAddresses()) {
-      return false;
-    }
-  } else {
-    synchronized_ = false;
-  }
-
   uint32_t group_rank_id = group->GetGroupRank(cgn_->rank_id());
   if (group_rank_id == 0) {
     while (!SendUniqueID(group_name, root_info_size, root_info)) {
@@ -143,7 +172,6 @@ bool MsCollectiveCommLib::BroadcastUniqueID(const std::string &group_name, size_
 bool MsCollectiveCommLib::SendUniqueID(const std::string &group_name, size_t root_info_size,
                                        const void *root_info) const {
   CHECK_IF_NULL(root_info);
-  CHECK_IF_NULL(node_);
   CHECK_IF_NULL(cgn_);
 
   // Create the group info which contains the unique id and send it to the meta server.
@@ -159,7 +187,6 @@ bool MsCollectiveCommLib::SendUniqueID(const std::string &group_name, size_t roo
 
 bool MsCollectiveCommLib::QueryUniqueID(const std::string &group_name, size_t root_info_size, void *root_info) const {
   CHECK_IF_NULL(root_info);
-  CHECK_IF_NULL(node_);
   CHECK_IF_NULL(cgn_);
 
   std::string node_role_prefix = cgn_->role() + "_";
@@ -190,37 +217,64 @@ bool MsCollectiveCommLib::QueryUniqueID(const std::string &group_name, size_t ro
 }
 
 bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
-                                    CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+                                    CollectiveOpReduceType reduce_op, const std::string &, void *) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
-  CHECK_IF_NULL(node_);
-  if (data_type != TypeId::kNumberTypeFloat32) {
-    MS_LOG(EXCEPTION) << "AllReduce only support float32.";
-  }
   if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
     MS_LOG(EXCEPTION) << "AllReduce only support reduce sum.";
   }
-  bool ret = launcher_->Execute(send_buff, recv_buff, send_count);
-  return ret;
+  if (global_rank_size_ == 1) {
+    return CopyForSingleRank(send_buff, recv_buff, send_count, data_type);
+  }
+  // The scheduler doesn't participate in the reduction.
+  if (cgn_ == nullptr) {
+    return true;
+  }
+  if (!InitializeCollectiveOps()) {
+    return false;
+  }
+
+  // MSCollectiveOpsImpl reduces in place on the receive buffer.
+  void *send_data = const_cast<void *>(send_buff);
+  switch (data_type) {
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return collective_ops_impl_->AllReduce<int>(kMCCLGlobalGroupName, send_data, recv_buff, send_count);
+    case TypeId::kNumberTypeFloat16:
+      return collective_ops_impl_->AllReduce<float16>(kMCCLGlobalGroupName, send_data, recv_buff, send_count);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return collective_ops_impl_->AllReduce<float>(kMCCLGlobalGroupName, send_data, recv_buff, send_count);
+    default:
+      MS_LOG(EXCEPTION) << "AllReduce only support int32, float16 and float32, but got " << TypeIdLabel(data_type);
+  }
 }
 
 bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
                                     const std::string &, void *) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
-  CHECK_IF_NULL(node_);
+  if (global_rank_size_ == 1) {
+    return CopyForSingleRank(send_buff, recv_buff, send_count, data_type);
+  }
+  if (cgn_ == nullptr) {
+    return true;
+  }
+  if (!InitializeCollectiveOps()) {
+    return false;
+  }
 
   switch (data_type) {
     case TypeId::kNumberTypeInt8:
-      return CollectiveOpsImpl::GetInstance().AllGather<char>(send_buff, recv_buff, send_count, node_);
+      return collective_ops_impl_->AllGather<char>(send_buff, recv_buff, send_count);
     case TypeId::kNumberTypeInt32:
     case TypeId::kNumberTypeInt:
-      return CollectiveOpsImpl::GetInstance().AllGather<int32_t>(send_buff, recv_buff, send_count, node_);
+      return collective_ops_impl_->AllGather<int>(send_buff, recv_buff, send_count);
     case TypeId::kNumberTypeUInt64:
-      return CollectiveOpsImpl::GetInstance().AllGather<uint64_t>(send_buff, recv_buff, send_count, node_);
+      return collective_ops_impl_->AllGather<uint64_t>(send_buff, recv_buff, send_count);
     case TypeId::kNumberTypeFloat32:
     case TypeId::kNumberTypeFloat:
-      return CollectiveOpsImpl::GetInstance().AllGather<float>(send_buff, recv_buff, send_count, node_);
+      return collective_ops_impl_->AllGather<float>(send_buff, recv_buff, send_count);
     default:
       return false;
   }
@@ -230,12 +284,20 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
                                     uint32_t root_rank, const std::string &group_name, void *) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
-  CHECK_IF_NULL(node_);
 
   if (groups_.count(group_name) == 0) {
     MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
     return false;
   }
+  if (global_rank_size_ == 1) {
+    return CopyForSingleRank(send_buff, recv_buff, send_count, data_type);
+  }
+  if (cgn_ == nullptr) {
+    return true;
+  }
+  if (!InitializeCollectiveOps()) {
+    return false;
+  }
 
   auto group = groups_[group_name];
   CommunicationGroupInfo group_info = {};
@@ -247,21 +309,17 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
 
   switch (data_type) {
     case TypeId::kNumberTypeInt8:
-      return CollectiveOpsImpl::GetInstance().Broadcast<char>(send_buff, recv_buff, send_count, root_rank, node_,
-                                                              group_info);
+      return collective_ops_impl_->Broadcast<char>(send_buff, recv_buff, send_count, root_rank, group_info);
     case TypeId::kNumberTypeInt32:
       [[fallthrough]];
     case TypeId::kNumberTypeInt:
-      return CollectiveOpsImpl::GetInstance().Broadcast<int32_t>(send_buff, recv_buff, send_count, root_rank, node_,
-                                                                 group_info);
+      return collective_ops_impl_->Broadcast<int>(send_buff, recv_buff, send_count, root_rank, group_info);
     case TypeId::kNumberTypeUInt64:
-      return CollectiveOpsImpl::GetInstance().Broadcast<uint64_t>(send_buff, recv_buff, send_count, root_rank, node_,
-                                                                  group_info);
+      return collective_ops_impl_->Broadcast<uint64_t>(send_buff, recv_buff, send_count, root_rank, group_info);
     case TypeId::kNumberTypeFloat32:
       [[fallthrough]];
     case TypeId::kNumberTypeFloat:
-      return CollectiveOpsImpl::GetInstance().Broadcast<float>(send_buff, recv_buff, send_count, root_rank, node_,
-                                                               group_info);
+      return collective_ops_impl_->Broadcast<float>(send_buff, recv_buff, send_count, root_rank, group_info);
     default:
       return false;
   }
@@ -18,14 +18,13 @@
 #define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_COMM_LIB_H_
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include "runtime/collective/collective_communication_lib.h"
 #include "plugin/device/cpu/hal/hardware/ms_communication_group.h"
 #include "distributed/cluster/cluster_context.h"
-#include "fl/server/collective_ops_impl.h"
-#include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
-#include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
 #include "distributed/cluster/topology/compute_graph_node.h"
 
 namespace mindspore {
@@ -33,9 +32,6 @@ namespace device {
 namespace cpu {
 constexpr char kMCCLGlobalGroupName[] = "mccl_world_group";
 using ClusterContext = mindspore::distributed::cluster::ClusterContext;
-using CollectiveOpsImpl = mindspore::fl::server::CollectiveOpsImpl;
-using CommunicationGroupInfo = mindspore::fl::server::CommunicationGroupInfo;
-using ps::core::NodeCommand;
 
 // The time interval for send info or query info between worker and scheduler.
 constexpr uint32_t kWaitDuration = 5;
@@ -82,15 +78,21 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
   // Query unique id from scheduler.
   bool QueryUniqueID(const std::string &group_name, size_t root_info_size, void *root_info) const;
 
-  std::shared_ptr<ps::core::CollectiveNode> node_;
+  // Connect to the other ranks and create the collective operations on the first call.
+  bool InitializeCollectiveOps();
+
+  // The collective operations of a single rank only copy the data to the receive buffer.
+  bool CopyForSingleRank(const void *send_buff, void *recv_buff, size_t count, TypeId data_type) const;
 
   // This compute graph node is maintained by the clusster context and used for metadata synchronization.
   std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> cgn_;
 
-  std::unique_ptr<AllReduceLauncher> launcher_;
-
-  // Indicates whether the collective node has to synchronize the addresses of all the collective nodes.
-  bool synchronized_{true};
+  // The topology node connects the compute graph nodes directly, the collective operations are executed on it by
+  // MSCollectiveOpsImpl. They are created by the first collective operation of a compute graph node with more than one
+  // rank, and never on the scheduler.
+  std::shared_ptr<TopologyNode> topo_node_;
+  std::unique_ptr<MSCollectiveOpsImpl> collective_ops_impl_;
+  std::mutex collective_ops_mutex_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -15,7 +15,9 @@
  */
 
 #include <numeric>
+#include <algorithm>
 #include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
 #include "distributed/cluster/cluster_context.h"
 #include "utils/ms_context.h"
 
@@ -27,6 +29,59 @@ const char kCollectivePhaseRing[] = "ring";
 const char kCollectivePhaseGather[] = "gather";
 const char kCollectivePhaseReduce[] = "reduce";
 const char kCollectivePhaseBroadcast[] = "broadcast";
+
+// The number of elements reduced by one call of the vectorized add kernels.
+constexpr size_t kReduceBlockSize = 1024;
+
+uint32_t GetCollectiveCommTimeout() {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // If enable recovery, set timeout 300s to prevent networking flapping.
+  return context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
+}
+
+template <typename T>
+void ReduceSum(T *dst, const T *src, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    dst[i] += src[i];
+  }
+}
+
+// The nnacl add kernels are vectorized with NEON/SSE/AVX/AVX512 according to the target platform.
+template <>
+void ReduceSum(float *dst, const float *src, size_t count) {
+  for (size_t offset = 0; offset < count; offset += kReduceBlockSize) {
+    size_t size = std::min(kReduceBlockSize, count - offset);
+    (void)ElementAdd(dst + offset, src + offset, dst + offset, SizeToInt(size));
+  }
+}
+
+template <>
+void ReduceSum(int *dst, const int *src, size_t count) {
+  for (size_t offset = 0; offset < count; offset += kReduceBlockSize) {
+    size_t size = std::min(kReduceBlockSize, count - offset);
+    (void)ElementAddInt(dst + offset, src + offset, dst + offset, SizeToInt(size));
+  }
+}
+
+// Half precision data is widened to float block by block, so the additions are vectorized and every element is
+// rounded only once.
+template <>
+void ReduceSum(float16 *dst, const float16 *src, size_t count) {
+  float dst_block[kReduceBlockSize];
+  float src_block[kReduceBlockSize];
+  for (size_t offset = 0; offset < count; offset += kReduceBlockSize) {
+    size_t size = std::min(kReduceBlockSize, count - offset);
+    for (size_t i = 0; i < size; i++) {
+      dst_block[i] = static_cast<float>(dst[offset + i]);
+      src_block[i] = static_cast<float>(src[offset + i]);
+    }
+    (void)ElementAdd(dst_block, src_block, dst_block, SizeToInt(size));
+    for (size_t i = 0; i < size; i++) {
+      dst[offset + i] = float16(dst_block[i]);
+    }
+  }
+}
 }  // namespace
 
 bool MSCollectiveOpsImpl::Initialize() {
@@ -73,12 +128,7 @@ template <typename T>
 bool MSCollectiveOpsImpl::RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                                             const std::vector<size_t> &chunk_offset,
                                             const std::vector<size_t> &chunk_sizes) {
-  auto context_ptr = MsContext::GetInstance();
-  MS_EXCEPTION_IF_NULL(context_ptr);
-  // If enable recovery, set timeout 300s to prevent networking flapping.
-  uint32_t timeout =
-    context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
-
+  uint32_t timeout = GetCollectiveCommTimeout();
   for (size_t i = 0; i < rank_size_ - 1; i++) {
     size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
     T *send_chunk = output_buff + chunk_offset[send_chunk_index];
@@ -117,6 +167,193 @@ bool MSCollectiveOpsImpl::RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv
   return true;
 }
 
+template <typename T>
+bool MSCollectiveOpsImpl::ReceiveAndReduce(uint32_t recv_from_rank, T *buff, size_t count, bool reduce) {
+  MessageBase *message = nullptr;
+  if (!topo_node_->Receive(recv_from_rank, &message, GetCollectiveCommTimeout())) {
+    MS_LOG(ERROR) << "Failed to receive data from rank " << recv_from_rank;
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(message);
+  std::unique_ptr<MessageBase> message_holder(message);
+  if (message->body.length() != count * sizeof(T)) {
+    MS_LOG(ERROR) << "The received data size " << message->body.length() << " from rank " << recv_from_rank
+                  << " is not equal to the expected size " << (count * sizeof(T));
+    return false;
+  }
+  if (reduce) {
+    ReduceSum(buff, reinterpret_cast<const T *>(message->body.data()), count);
+    return true;
+  }
+  auto ret = memcpy_s(buff, count * sizeof(T), message->body.data(), message->body.length());
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                  << ", dest size is " << (count * sizeof(T)) << ", src size is " << message->body.length();
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RingAllReduce(T *output_buff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(output_buff, false);
+  // The rest of the data is assigned to the leading chunks.
+  std::vector<size_t> chunk_sizes(rank_size_, count / rank_size_);
+  for (size_t i = 0; i < count % rank_size_; i++) {
+    chunk_sizes[i]++;
+  }
+  std::vector<size_t> chunk_offset(rank_size_, 0);
+  for (size_t i = 1; i < rank_size_; i++) {
+    chunk_offset[i] = chunk_offset[i - 1] + chunk_sizes[i - 1];
+  }
+  const size_t slice_count = std::max(kRingAllReduceSliceSize / sizeof(T), static_cast<size_t>(1));
+
+  uint32_t send_to_rank = (rank_id_ + 1) % rank_size_;
+  uint32_t recv_from_rank = (rank_id_ - 1 + rank_size_) % rank_size_;
+  MS_LOG(DEBUG) << "Ring AllReduce count:" << count << ", rank_size:" << rank_size_ << ", rank_id_:" << rank_id_
+                << ", chunk_sizes:" << chunk_sizes << ", slice_count:" << slice_count
+                << ", send_to_rank:" << send_to_rank << ", recv_from_rank:" << recv_from_rank;
+
+  size_t pending_slices = 0;
+  auto send_slice = [this, send_to_rank, &pending_slices](const T *slice, size_t size) -> bool {
+    (void)topo_node_->SendAsync(send_to_rank, slice, size * sizeof(T));
+    if (++pending_slices < kRingAllReduceMaxPendingSlices) {
+      return true;
+    }
+    pending_slices = 0;
+    return topo_node_->WaitForSend(send_to_rank);
+  };
+
+  // The first step of reduce-scatter sends the local chunk. In every following step, the slice received from the
+  // previous rank is reduced and forwarded immediately: the chunk reduced in the step i is exactly the one sent in the
+  // step i + 1, and the fully reduced chunk of the last reduce-scatter step is the first one of allgather.
+  T *local_chunk = output_buff + chunk_offset[rank_id_];
+  for (size_t offset = 0; offset < chunk_sizes[rank_id_]; offset += slice_count) {
+    if (!send_slice(local_chunk + offset, std::min(slice_count, chunk_sizes[rank_id_] - offset))) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+      return false;
+    }
+  }
+
+  size_t step_num = 2 * (rank_size_ - 1);
+  for (size_t step = 0; step < step_num; step++) {
+    bool reduce = step < rank_size_ - 1;
+    bool forward = step + 1 < step_num;
+    size_t recv_chunk_index = reduce ? (rank_id_ + rank_size_ - step - 1) % rank_size_
+                                     : (rank_id_ + rank_size_ - (step - (rank_size_ - 1))) % rank_size_;
+    T *recv_chunk = output_buff + chunk_offset[recv_chunk_index];
+    MS_LOG(DEBUG) << "Ring AllReduce " << (reduce ? "reduce-scatter" : "allgather") << " step:" << step
+                  << ", recv chunk:" << recv_chunk_index;
+
+    for (size_t offset = 0; offset < chunk_sizes[recv_chunk_index]; offset += slice_count) {
+      size_t size = std::min(slice_count, chunk_sizes[recv_chunk_index] - offset);
+      if (!ReceiveAndReduce(recv_from_rank, recv_chunk + offset, size, reduce)) {
+        return false;
+      }
+      if (forward && !send_slice(recv_chunk + offset, size)) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+        return false;
+      }
+    }
+  }
+
+  if (!topo_node_->WaitForSend(send_to_rank)) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RecursiveDoublingAllReduce(T *output_buff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(output_buff, false);
+  size_t data_size = count * sizeof(T);
+  uint32_t pof2 = 1;
+  while (pof2 * 2 <= rank_size_) {
+    pof2 *= 2;
+  }
+  uint32_t rem = rank_size_ - pof2;
+
+  // Fold: among the first 2 * rem ranks, every even rank sends its data to the next odd rank and waits for the result.
+  bool folded = rank_id_ < 2 * rem && rank_id_ % 2 == 0;
+  if (folded) {
+    (void)topo_node_->SendAsync(rank_id_ + 1, output_buff, data_size);
+    if (!topo_node_->WaitForSend(rank_id_ + 1)) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << (rank_id_ + 1);
+      return false;
+    }
+  } else {
+    if (rank_id_ < 2 * rem && !ReceiveAndReduce(rank_id_ - 1, output_buff, count, true)) {
+      return false;
+    }
+    // Exchange the data with the partner rank whose distance doubles in every step. Both sides sum the same two
+    // operands, so all the ranks get the bitwise identical result.
+    uint32_t new_rank = rank_id_ < 2 * rem ? rank_id_ / 2 : rank_id_ - rem;
+    for (uint32_t mask = 1; mask < pof2; mask <<= 1) {
+      uint32_t new_partner = new_rank ^ mask;
+      uint32_t partner = new_partner < rem ? new_partner * 2 + 1 : new_partner + rem;
+      MS_LOG(DEBUG) << "Recursive doubling AllReduce rank_id_:" << rank_id_ << ", partner:" << partner;
+      (void)topo_node_->SendAsync(partner, output_buff, data_size);
+      if (!ReceiveAndReduce(partner, output_buff, count, true)) {
+        return false;
+      }
+      if (!topo_node_->WaitForSend(partner)) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << partner;
+        return false;
+      }
+    }
+  }
+
+  // Unfold: send the result back to the folded ranks.
+  if (rank_id_ < 2 * rem) {
+    if (folded) {
+      return ReceiveAndReduce(rank_id_ + 1, output_buff, count, false);
+    }
+    (void)topo_node_->SendAsync(rank_id_ - 1, output_buff, data_size);
+    if (!topo_node_->WaitForSend(rank_id_ - 1)) {
+      MS_LOG(ERROR) << "Failed to send data to rank: " << (rank_id_ - 1);
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  // Initialize collective communication parameters.
+  rank_id_ = static_cast<uint32_t>(topo_node_->rank_id());
+  rank_size_ = static_cast<uint32_t>(topo_node_->rank_size());
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  if (recvbuff != sendbuff) {
+    size_t data_size = count * sizeof(T);
+    int ret = memcpy_s(recvbuff, data_size, sendbuff, data_size);
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                    << ", dest size is " << data_size << ", src size is " << data_size;
+      return false;
+    }
+  }
+  if (rank_size_ == 1) {
+    MS_LOG(INFO) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+
+  T *output_buff = reinterpret_cast<T *>(recvbuff);
+  if (count * sizeof(T) <= kRecursiveDoublingAllReduceMaxSize || count < rank_size_) {
+    MS_LOG(DEBUG) << "AllReduce " << data_name << " with recursive doubling algorithm, count: " << count;
+    return RecursiveDoublingAllReduce<T>(output_buff, count);
+  }
+  MS_LOG(DEBUG) << "AllReduce " << data_name << " with ring algorithm, count: " << count;
+  return RingAllReduce<T>(output_buff, count);
+}
+
 template <typename T>
 bool MSCollectiveOpsImpl::Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                                     const CommunicationGroupInfo &group_info) {
@@ -198,6 +435,32 @@ bool MSCollectiveOpsImpl::AllGather(const void *sendbuff, void *recvbuff, size_t
 
   return RingAllGather<T>(sendbuff, recvbuff, send_count);
 }
+
+template bool MSCollectiveOpsImpl::AllReduce<float>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                    size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<float16>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                      size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<int>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                  size_t count);
+
+template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                    const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                       uint32_t root, const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                  const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
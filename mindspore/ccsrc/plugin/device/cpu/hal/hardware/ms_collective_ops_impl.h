@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include "base/float16.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_topo.h"
 
 namespace mindspore {
@@ -32,6 +33,15 @@ constexpr uint32_t kCollectiveCommTimeout = 30;
 // The max timeout for server collective communication, used in disaster recovery to prevent networking flapping.
 constexpr uint32_t kCollectiveCommMaxTimeout = 300;
 
+// AllReduce of messages smaller than this size in bytes is latency-bound, so the recursive doubling algorithm which
+// needs only log2(rank_size) steps is used. Larger messages use the bandwidth-optimal ring algorithm.
+constexpr size_t kRecursiveDoublingAllReduceMaxSize = 64 * 1024;
+// The ring AllReduce transfers every chunk in slices of this size in bytes, so that sending a reduced slice to the
+// next rank overlaps with receiving and reducing the following slice.
+constexpr size_t kRingAllReduceSliceSize = 256 * 1024;
+// The max number of slices sent to the next rank before flushing the connection.
+constexpr size_t kRingAllReduceMaxPendingSlices = 64;
+
 // The collective communication groups which are composed of multiple processes. Refer to MPI_Group.
 struct CommunicationGroupInfo {
   // This group's rank size.
@@ -49,8 +59,8 @@ struct CommunicationGroupInfo {
 };
 
 // MSCollectiveOpsImpl is the collective communication API of the server.
-// For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// It implements two AllReduce(sum) algorithms which are selected by the message size: the pipelined ring
+// reduce-scatter + allgather for large messages and the recursive doubling for small messages.
 class MSCollectiveOpsImpl {
  public:
   explicit MSCollectiveOpsImpl(const std::shared_ptr<TopologyNode> topo_node)
@@ -83,6 +93,19 @@ class MSCollectiveOpsImpl {
   bool RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                          const std::vector<size_t> &chunk_offset, const std::vector<size_t> &chunk_sizes);
 
+  // Implementation of the pipelined ring AllReduce: reduce-scatter followed by allgather, both in rank_size - 1 steps.
+  template <typename T>
+  bool RingAllReduce(T *output_buff, size_t count);
+
+  // Implementation of the recursive doubling AllReduce. The ranks exceeding the largest power of two are folded into
+  // their neighbours before the exchange steps and receive the result afterwards.
+  template <typename T>
+  bool RecursiveDoublingAllReduce(T *output_buff, size_t count);
+
+  // Receive count elements from the specified rank and reduce(sum) them into buff, or copy them if reduce is false.
+  template <typename T>
+  bool ReceiveAndReduce(uint32_t recv_from_rank, T *buff, size_t count, bool reduce);
+
   uint32_t rank_id_;
   uint32_t rank_size_;
 
@@ -91,25 +114,6 @@ class MSCollectiveOpsImpl {
   // The mutex to ensure that collective communication is threadsafe.
   std::mutex mtx_;
 };
-
-template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                    const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
-                                                       uint32_t root, const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                  const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
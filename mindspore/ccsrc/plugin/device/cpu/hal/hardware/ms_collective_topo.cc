@@ -102,8 +102,32 @@ bool TopologyNode::Finalize() {
   return true;
 }
 
+bool TopologyNode::Connect(size_t rank_id) {
+  if (tcp_clients_.find(rank_id) != tcp_clients_.end()) {
+    return true;
+  }
+  // The connections to the ranks other than the next one are only used by some collective algorithms(eg. recursive
+  // doubling AllReduce), so they are created on demand.
+  auto rank_name = "RNAK_ID_" + std::to_string(rank_id);
+  std::string rank_addr = cgn_->GetMetadata(rank_name);
+  if (rank_addr.empty()) {
+    MS_LOG(ERROR) << "Failed to get the address of rank : " << rank_name;
+    return false;
+  }
+  auto tcp_client = std::make_unique<distributed::rpc::TCPClient>();
+  RETURN_IF_FALSE_WITH_LOG(tcp_client->Initialize(), "Failed to initialize the tcp client to rank " << rank_id);
+  if (!tcp_client->Connect(rank_addr)) {
+    MS_LOG(ERROR) << "Failed to connect to rank " << rank_id << ", address: " << rank_addr;
+    tcp_client->Finalize();
+    return false;
+  }
+  node_addresses_[rank_id] = rank_addr;
+  tcp_clients_[rank_id] = tcp_client.release();
+  return true;
+}
+
 bool TopologyNode::SendAsync(size_t rank_id, const void *data, size_t size) {
-  if (tcp_clients_.find(rank_id) == tcp_clients_.end()) {
+  if (!Connect(rank_id)) {
     MS_LOG(ERROR) << "Cann not find tcp client for rank id: " << rank_id << ", local rank: " << rank_id_;
     return false;
   }
@@ -171,6 +195,8 @@ MessageBase *const TopologyNode::HandleMessage(MessageBase *const message) {
   if (received_messages_.find(rank_id) == received_messages_.end()) {
     queue = new std::queue<MessageBase *>();
     received_messages_[rank_id] = queue;
+  } else {
+    queue = received_messages_[rank_id];
   }
   MS_EXCEPTION_IF_NULL(queue);
   queue->push(message);
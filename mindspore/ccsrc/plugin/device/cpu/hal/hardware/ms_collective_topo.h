@@ -47,6 +47,9 @@ class TopologyNode {
   // Destroy tcp clients and the tcp server.
   bool Finalize();
 
+  // Connect to the specified rank node if the connection does not exist.
+  bool Connect(size_t rank_id);
+
   // Send data asynchronously to the specified rank node.
   bool SendAsync(size_t rank_id, const void *data, size_t size);
 
@@ -45,6 +45,7 @@ void AllReduceCPUKernelMod::InitKernel(const CNodePtr &kernel_node) {
   if (!is_match) {
     MS_LOG(EXCEPTION) << kernel_name_ << " does not support this kernel data type: " << kernel_attr;
   }
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   auto group = common::AnfAlgo::GetNodeAttr<std::string>(kernel_node, GROUP);
   if (group != kMCCLGlobalGroupName) {
     MS_LOG(EXCEPTION) << kernel_name_ << " only support " << kMCCLGlobalGroupName << " on CPU, but got " << group;
@@ -60,7 +61,9 @@ void AllReduceCPUKernelMod::InitKernel(const CNodePtr &kernel_node) {
 
 std::vector<KernelAttr> AllReduceCPUKernelMod::GetOpSupport() {
   static std::vector<KernelAttr> support_list = {
-    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32)};
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+    KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32)};
   return support_list;
 }
 
@@ -75,8 +78,9 @@ bool AllReduceCPUKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs
   for (size_t i = 0; i < inputs.size(); ++i) {
     data_size += inputs[i]->size;
   }
-  bool ret = MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, data_size,
-                                                          kNumberTypeFloat32, Reduce_Sum, kMCCLGlobalGroupName);
+  size_t data_count = data_size / GetTypeByte(TypeIdToType(dtype_));
+  bool ret = MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, data_count, dtype_,
+                                                          Reduce_Sum, kMCCLGlobalGroupName);
   if (!ret) {
     MS_LOG(ERROR) << "AllReduceCPUKernelMod launch failed.";
   }
@@ -36,6 +36,9 @@ class AllReduceCPUKernelMod : public DeprecatedNativeCpuKernelMod {
               const std::vector<AddressPtr> &outputs) override;
 
   std::vector<KernelAttr> GetOpSupport() override;
+
+ private:
+  TypeId dtype_{kNumberTypeFloat32};
 };
 }  // namespace kernel
 }  // namespace mindspore
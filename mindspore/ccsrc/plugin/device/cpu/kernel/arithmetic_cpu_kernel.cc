@@ -266,28 +266,18 @@ void ArithmeticCpuTypeFunc<T>::AssignSub(T *input1, const T *input2, T *out) {
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Add(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] + input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T { return x + y; });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::AddV2(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] + input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T { return x + y; });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
@@ -315,14 +305,9 @@ void ArithmeticCpuTypeFunc<T>::Sub(const T *input1, const T *input2, T *out) {
     }
   }
 
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T { return x - y; });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
@@ -349,18 +334,15 @@ void ArithmeticCpuTypeFunc<T>::Mul(const T *input1, const T *input2, T *out) {
       return;
     }
   }
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
       if constexpr (std::is_same_v<T, bool>) {
-        out[i] = static_cast<T>(input1[iter.GetInputPosA()] && input2[iter.GetInputPosB()]);
+        return static_cast<T>(x && y);
       } else {
-        out[i] = static_cast<T>(input1[iter.GetInputPosA()] * input2[iter.GetInputPosB()]);
+        return static_cast<T>(x * y);
       }
-      iter.GenNextPos();
-    }
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
@@ -389,29 +371,21 @@ void ArithmeticCpuTypeFunc<T>::RealDiv(const T *input1, const T *input2, T *out)
     return;
   }
 
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
       auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
+      if (y == zero) {
+        if (x == zero) {
+          return std::numeric_limits<T>::quiet_NaN();
         }
         if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+          return x > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
         }
-        continue;
+        return x > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
       }
-      out[i] = dividend / divisor;
-    }
+      return static_cast<T>(x / y);
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
@@ -440,50 +414,36 @@ void ArithmeticCpuTypeFunc<T>::RealDivComplex(const T *input1, const T *input2,
     return;
   }
 
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
       auto zero = (T)0;
-      if (divisor == zero) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
+      if (y == zero) {
+        return std::numeric_limits<T>::quiet_NaN();
       }
-      out[i] = dividend / divisor;
-    }
+      return static_cast<T>(x / y);
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Div(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
       auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
+      if (y == zero) {
+        if (x == zero) {
+          return std::numeric_limits<T>::quiet_NaN();
         }
         if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+          return x > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
         }
-        continue;
+        return x > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
       }
-      out[i] = dividend / divisor;
-    }
+      return static_cast<T>(x / y);
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
@@ -514,89 +474,69 @@ void ArithmeticCpuTypeFunc<T>::DivComplex(const T *input1, const T *input2, T *o
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::DivNoNan(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
       auto zero = (T)0;
-      if (divisor == zero) {
-        out[i] = zero;
-        continue;
+      if (y == zero) {
+        return zero;
       }
-      out[i] = dividend / divisor;
-    }
+      return static_cast<T>(x / y);
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::FloorDiv(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
       auto zero = static_cast<T>(0);
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
+      if (y == zero) {
+        if (x == zero) {
+          return std::numeric_limits<T>::quiet_NaN();
         }
         if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+          return x > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
         }
-        continue;
+        return x > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
       }
-      out[i] = static_cast<T>(floor(static_cast<double>(dividend) / static_cast<double>(divisor)));
-    }
+      return static_cast<T>(floor(static_cast<double>(x) / static_cast<double>(y)));
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Mod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto data_div = x / y;
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
+      auto data_x = static_cast<double>(x);
+      auto data_y = static_cast<double>(y);
+      auto data_div = data_x / data_y;
       auto data_div_min = data_div < 0.0 ? data_div : 0.0;
       auto data_div_max = data_div > 0.0 ? data_div : 0.0;
       auto data_div_max_floor = floor(data_div_max);
       auto data_div_min_ceil = ceil(data_div_min);
       auto data_div_res = data_div_max_floor + data_div_min_ceil;
-      out[i] = static_cast<T>(x - data_div_res * y);
-    }
+      return static_cast<T>(data_x - data_div_res * data_y);
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::FloorMod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto res = x - floor(x / y) * y;
-      out[i] = static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
-    }
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
+      auto data_x = static_cast<double>(x);
+      auto data_y = static_cast<double>(y);
+      auto res = data_x - floor(data_x / data_y) * data_y;
+      return static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (data_y < 0.0)) ? res + data_y : res);
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
@@ -634,122 +574,83 @@ void ArithmeticCpuTypeFunc<T>::Pow(const T *input1, const T *input2, T *out) {
     }
   }
 
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto pow_op = [](T x, T y) -> T { return static_cast<T>(std::pow(static_cast<double>(x), static_cast<double>(y))); };
   if (output_size_ > kMaxPowSerialSize) {
-    auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-        auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-        out[i] = static_cast<T>(std::pow(x, y));
-        iter.GenNextPos();
-      }
+    auto task = [&input1, &input2, &out, &plan, &pow_op](size_t start, size_t end) {
+      plan.Compute(input1, input2, out, start, end, pow_op);
     };
     ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
   } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      auto sx = static_cast<double>(input1[base_iter.GetInputPosA()]);
-      auto sy = static_cast<double>(input2[base_iter.GetInputPosB()]);
-      out[i] = static_cast<T>(std::pow(sx, sy));
-      base_iter.GenNextPos();
-    }
+    plan.Compute(input1, input2, out, 0, output_size_, pow_op);
   }
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::PowComplex(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto pow_op = [](T x, T y) -> T { return static_cast<T>(std::pow(x, y)); };
   if (output_size_ > kMaxPowSerialSize) {
-    auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = (input1[iter.GetInputPosA()]);
-        auto y = (input2[iter.GetInputPosB()]);
-        out[i] = static_cast<T>(std::pow(x, y));
-        iter.GenNextPos();
-      }
+    auto task = [&input1, &input2, &out, &plan, &pow_op](size_t start, size_t end) {
+      plan.Compute(input1, input2, out, start, end, pow_op);
     };
     ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
   } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      auto sx = (input1[base_iter.GetInputPosA()]);
-      auto sy = (input2[base_iter.GetInputPosB()]);
-      out[i] = static_cast<T>(std::pow(sx, sy));
-      base_iter.GenNextPos();
-    }
+    plan.Compute(input1, input2, out, 0, output_size_, pow_op);
   }
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::SquaredDifference(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      T diff = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
+      T diff = x - y;
       if constexpr (std::is_same_v<T, bool>) {
-        out[i] = static_cast<T>(diff);
+        return static_cast<T>(diff);
       } else {
-        out[i] = static_cast<T>(diff * diff);
+        return static_cast<T>(diff * diff);
       }
-      iter.GenNextPos();
-    }
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::SquaredDifferenceComplex(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      T diff = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-      out[i] = static_cast<T>(std::conj(diff) * diff);
-      iter.GenNextPos();
-    }
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
+      T diff = x - y;
+      return static_cast<T>(std::conj(diff) * diff);
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Xlogy(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x1 = input1[iter.GetInputPosA()];
-      auto x2 = input2[iter.GetInputPosB()];
-      auto logx2 = log(x2);
-      iter.GenNextPos();
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
+      auto logx2 = log(y);
       if constexpr (std::is_same_v<T, bool>) {
-        out[i] = static_cast<T>(x1 && logx2);
+        return static_cast<T>(x && logx2);
       } else {
-        out[i] = static_cast<T>(x1 * logx2);
+        return static_cast<T>(x * logx2);
       }
-    }
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::Atan2(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&input1, &input2, &out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(
-        atan2(static_cast<double>(input1[iter.GetInputPosA()]), static_cast<double>(input2[iter.GetInputPosB()])));
-      iter.GenNextPos();
-    }
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [&input1, &input2, &out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) -> T {
+      return static_cast<T>(atan2(static_cast<double>(x), static_cast<double>(y)));
+    });
   };
   ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
 }
@@ -247,16 +247,9 @@ void ArithLogicCpuTypeFunc<T>::BinaryOp(const T *input1, const T *input2, bool *
     };
     ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
   } else {
-    BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-    auto task = [this, input1, input2, out, op, &base_iter](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = input1[iter.GetInputPosA()];
-        auto y = input2[iter.GetInputPosB()];
-        out[i] = op(x, y);
-        iter.GenNextPos();
-      }
+    BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+    auto task = [input1, input2, out, op, &plan](size_t start, size_t end) {
+      plan.Compute(input1, input2, out, start, end, op);
     };
     ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
   }
@@ -295,16 +288,9 @@ void ArithComplexLogicCpuTypeFunc<T>::BinaryOp(const T *input1, const T *input2,
     };
     ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
   } else {
-    BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-    auto task = [this, input1, input2, out, op, &base_iter](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = input1[iter.GetInputPosA()];
-        auto y = input2[iter.GetInputPosB()];
-        out[i] = op(x, y);
-        iter.GenNextPos();
-      }
+    BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+    auto task = [input1, input2, out, op, &plan](size_t start, size_t end) {
+      plan.Compute(input1, input2, out, start, end, op);
     };
     ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
   }
@@ -337,14 +323,9 @@ void ArithLogicCpuTypeFunc<T>::LogicalOr(const T *input1, const T *input2, bool
 
 template <typename T>
 void ArithLogicCpuTypeFunc<T>::LogicalXor(const T *input1, const T *input2, bool *out) const {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [input1, input2, out, &base_iter](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] != input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
+  BroadcastPlan plan(input_shape1_, input_shape2_, output_shape_);
+  auto task = [input1, input2, out, &plan](size_t start, size_t end) {
+    plan.Compute(input1, input2, out, start, end, [](T x, T y) { return x != y; });
   };
   CPUKernelUtils::ParallelFor(task, output_size_);
 }
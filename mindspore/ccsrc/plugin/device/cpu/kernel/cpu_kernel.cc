@@ -19,11 +19,20 @@
 #include <algorithm>
 #include <utility>
 #include <cmath>
+#include <fstream>
 #include <map>
+#include <mutex>
 #include <set>
 #include <numeric>
+#include <typeindex>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
 #include "kernel/oplib/oplib.h"
 #include "utils/profile.h"
+#include "utils/ms_utils.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "kernel/common_utils.h"
 
@@ -215,37 +224,176 @@ void CPUKernelUtils::ParallelFor(const CTask &task, size_t count, float block_si
   ParallelLaunch(tasks);
 }
 
+namespace {
+constexpr size_t kSearchAvgCount = 5;
+constexpr char kParallelSearchCacheEnv[] = "MS_DEV_PARALLEL_SEARCH_CACHE";
+
+// Process-wide cache of the searched block size, the value is the power of two the count is divided by.
+// If MS_DEV_PARALLEL_SEARCH_CACHE is set, the cache is loaded from that file at startup and the newly searched
+// results are appended to it, so that the next process skips the search. The later lines override the former ones.
+class ParallelSearchCache {
+ public:
+  static ParallelSearchCache &GetInstance() {
+    static ParallelSearchCache instance;
+    return instance;
+  }
+
+  bool Get(const std::string &key, size_t *best_pow) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = best_pows_.find(key);
+    if (iter == best_pows_.end()) {
+      return false;
+    }
+    *best_pow = iter->second;
+    return true;
+  }
+
+  void Put(const std::string &key, size_t best_pow) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = best_pows_.find(key);
+    if (iter != best_pows_.end() && iter->second == best_pow) {
+      return;
+    }
+    best_pows_[key] = best_pow;
+    if (file_path_.empty()) {
+      return;
+    }
+    Append(key + " " + std::to_string(best_pow) + "\n");
+  }
+
+ private:
+  ParallelSearchCache() : file_path_(common::GetEnv(kParallelSearchCacheEnv)) {
+    if (file_path_.empty()) {
+      return;
+    }
+    std::ifstream ifs(file_path_);
+    if (!ifs.is_open()) {
+      return;
+    }
+    std::string key;
+    size_t best_pow = 0;
+    while (ifs >> key >> best_pow) {
+      best_pows_[key] = best_pow;
+    }
+    MS_LOG(INFO) << "Load " << best_pows_.size() << " parallel search results from " << file_path_;
+  }
+  ~ParallelSearchCache() = default;
+
+  // Several processes may share one cache file, so the line is written by one append under the file lock.
+  void Append(const std::string &line) const {
+#if defined(_WIN32) || defined(_WIN64)
+    std::ofstream ofs(file_path_, std::ios::app);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Open parallel search cache file " << file_path_ << " failed.";
+      return;
+    }
+    ofs << line;
+#else
+    int fd = open(file_path_.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      MS_LOG(WARNING) << "Open parallel search cache file " << file_path_ << " failed.";
+      return;
+    }
+    if (flock(fd, LOCK_EX) != 0) {
+      MS_LOG(WARNING) << "Lock parallel search cache file " << file_path_ << " failed.";
+      (void)close(fd);
+      return;
+    }
+    if (write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+      MS_LOG(WARNING) << "Write parallel search cache file " << file_path_ << " failed.";
+    }
+    (void)flock(fd, LOCK_UN);
+    (void)close(fd);
+#endif
+  }
+
+  std::mutex mutex_;
+  std::string file_path_;
+  std::map<std::string, size_t> best_pows_;
+};
+
+// The counts of the same power of two share one bucket, so a resized kernel keeps the searched result if the count
+// does not change much.
+size_t ParallelSearchBucket(size_t count) {
+  size_t bucket = 0;
+  while (count > 1) {
+    count >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+// The type of the task tells apart the call sites and the data types of the templated kernels sharing one op name.
+std::string ParallelSearchKey(const ParallelSearchInfo &info, const CTask &task, size_t bucket) {
+  return info.kernel_name + ":" + task.target_type().name() + ":" + std::to_string(bucket) + ":" +
+         std::to_string(info.thread_num);
+}
+
+// Get the search state of the task with the bucket of the count, and reuse the result searched before by the same
+// kernel with the same task, bucket and thread num.
+ParallelSearchState *PrepareParallelSearch(const CTask &task, size_t count, size_t max_pow,
+                                           ParallelSearchInfo *parallel_search_info) {
+  size_t bucket = ParallelSearchBucket(count);
+  auto state_key = std::make_pair(std::type_index(task.target_type()), bucket);
+  auto iter = parallel_search_info->search_states.find(state_key);
+  if (iter != parallel_search_info->search_states.end()) {
+    return &iter->second;
+  }
+  auto &state = parallel_search_info->search_states[state_key];
+  if (parallel_search_info->kernel_name.empty()) {
+    return &state;
+  }
+  state.cache_key = ParallelSearchKey(*parallel_search_info, task, bucket);
+  size_t best_pow = 0;
+  if (ParallelSearchCache::GetInstance().Get(state.cache_key, &best_pow) && best_pow < max_pow) {
+    state.best_pow = best_pow;
+    state.search_count = kSearchAvgCount * max_pow;
+  }
+  return &state;
+}
+
+// Record one timed run of the search, and publish the best result to the cache when the search is finished.
+void UpdateParallelSearch(double cost_time, size_t current_pow, size_t max_pow, float block_size,
+                          ParallelSearchState *state) {
+  state->tmp_sum_cost_time += cost_time;
+  state->search_count++;
+  if (state->search_count % kSearchAvgCount == 0) {
+    double avg_time = state->tmp_sum_cost_time / kSearchAvgCount;
+    if (state->min_cost_time > avg_time) {
+      state->min_cost_time = avg_time;
+      state->best_block_size = block_size;
+      state->best_pow = current_pow;
+    } else if (current_pow - state->best_pow >= 2) {
+      state->search_count = kSearchAvgCount * max_pow;
+    }
+  }
+  if (state->search_count >= kSearchAvgCount * max_pow && !state->cache_key.empty()) {
+    ParallelSearchCache::GetInstance().Put(state->cache_key, state->best_pow);
+  }
+}
+}  // namespace
+
 // Search for best block_size to get best thread num : 1 2 4 8 16 23(32)
 // Each block_size runs 5 times to get an average cpu kernel cost time.
 // If the speed of block_size[i] is slower than block_size[i-2], than we
 // assume that  block_size[i-2] is the best block_size.
 void CPUKernelUtils::ParallelForAutoSearch(const CTask &task, size_t count, ParallelSearchInfo *parallel_search_info) {
   const size_t MAX_POW = 6;
-  const size_t AVG_COUNT = 5;
   MS_EXCEPTION_IF_NULL(parallel_search_info);
-  size_t current_pow = parallel_search_info->search_count / AVG_COUNT;
+  parallel_search_info->thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  auto state = PrepareParallelSearch(task, count, MAX_POW, parallel_search_info);
+  size_t current_pow = state->search_count / kSearchAvgCount;
   if (current_pow < MAX_POW) {
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
-      parallel_search_info->tmp_sum_cost_time = 0;
+    if (state->search_count % kSearchAvgCount == 0) {
+      state->tmp_sum_cost_time = 0;
     }
     float block_size = static_cast<float>(count) / std::pow(2.0f, current_pow);
     double start_time = GetTime();
     ParallelFor(task, count, block_size);
     double cost_time = GetTime() - start_time;
-    parallel_search_info->tmp_sum_cost_time += cost_time;
-    parallel_search_info->search_count++;
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
-      double avg_time = parallel_search_info->tmp_sum_cost_time / AVG_COUNT;
-      if (parallel_search_info->min_cost_time > avg_time) {
-        parallel_search_info->min_cost_time = avg_time;
-        parallel_search_info->best_block_size = block_size;
-        parallel_search_info->best_pow = current_pow;
-      } else if (current_pow - parallel_search_info->best_pow >= 2) {
-        parallel_search_info->search_count = AVG_COUNT * MAX_POW;
-      }
-    }
+    UpdateParallelSearch(cost_time, current_pow, MAX_POW, block_size, state);
   } else {
-    ParallelFor(task, count, parallel_search_info->best_block_size);
+    ParallelFor(task, count, static_cast<float>(count) / std::pow(2.0f, state->best_pow));
   }
 }
 
@@ -323,6 +471,7 @@ void ParallelLaunch(const std::vector<common::Task> &tasks, Content content, Thr
 
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
                               ParallelSearchInfo *parallel_search_info, ThreadPool *pool) {
+  MS_EXCEPTION_IF_NULL(parallel_search_info);
   if (!parallel_search_info->kernel_thread_num_set) {
     auto thread_pool = pool == nullptr ? GetActorMgrInnerThreadPool() : pool;
     size_t kernel_thread_num = thread_pool->GetKernelThreadNum();
@@ -334,32 +483,23 @@ void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
       max_pow_current++;
     }
     parallel_search_info->max_pow = max_pow_current + 1;
+    parallel_search_info->thread_num = kernel_thread_num;
     parallel_search_info->kernel_thread_num_set = true;
   }
-  const size_t AVG_COUNT = 5;
-  size_t current_pow = parallel_search_info->search_count / AVG_COUNT;
+  auto state = PrepareParallelSearch(task, count, parallel_search_info->max_pow, parallel_search_info);
+  size_t current_pow = state->search_count / kSearchAvgCount;
   if (current_pow < parallel_search_info->max_pow) {
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
-      parallel_search_info->tmp_sum_cost_time = 0;
+    if (state->search_count % kSearchAvgCount == 0) {
+      state->tmp_sum_cost_time = 0;
     }
     float block_size = static_cast<float>(count) / std::pow(2.0f, current_pow);
     double start_time = GetTime();
     ParallelLaunch(task, count, block_size, content, pool);
     double cost_time = GetTime() - start_time;
-    parallel_search_info->tmp_sum_cost_time += cost_time;
-    parallel_search_info->search_count++;
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
-      double avg_time = parallel_search_info->tmp_sum_cost_time / AVG_COUNT;
-      if (parallel_search_info->min_cost_time > avg_time) {
-        parallel_search_info->min_cost_time = avg_time;
-        parallel_search_info->best_block_size = block_size;
-        parallel_search_info->best_pow = current_pow;
-      } else if (current_pow - parallel_search_info->best_pow >= 2) {
-        parallel_search_info->search_count = AVG_COUNT * parallel_search_info->max_pow;
-      }
-    }
+    UpdateParallelSearch(cost_time, current_pow, parallel_search_info->max_pow, block_size, state);
   } else {
-    ParallelLaunch(task, count, parallel_search_info->best_block_size, content, pool);
+    float block_size = static_cast<float>(count) / std::pow(2.0f, state->best_pow);
+    ParallelLaunch(task, count, block_size, content, pool);
   }
 }
 
@@ -454,6 +594,78 @@ void BroadcastIterator::InitStrides() {
                        input_strides_b_.begin(), [](const auto &a, const auto &b) { return b == 1 ? 0 : a; });
 }
 
+BroadcastPlan::BroadcastPlan(const ShapeVector &input_shape_a, const ShapeVector &input_shape_b,
+                             const ShapeVector &output_shape) {
+  const size_t rank = output_shape.size();
+  if (input_shape_a.size() > rank || input_shape_b.size() > rank) {
+    MS_LOG(EXCEPTION) << "The rank of inputs " << input_shape_a << " and " << input_shape_b
+                      << " should not be greater than the rank of output " << output_shape;
+  }
+  auto get_dim = [rank](const ShapeVector &shape, size_t index) {
+    size_t offset = rank - shape.size();
+    return index < offset ? 1 : shape[index - offset];
+  };
+  // Collapse the adjacent dimensions in which both inputs are broadcast or not broadcast in the same way.
+  ShapeVector shape_a;
+  ShapeVector shape_b;
+  bool last_full_a = false;
+  bool last_full_b = false;
+  for (size_t i = 0; i < rank; ++i) {
+    auto dim = output_shape[i];
+    if (dim == 1) {
+      continue;
+    }
+    auto dim_a = get_dim(input_shape_a, i);
+    auto dim_b = get_dim(input_shape_b, i);
+    if ((dim_a != dim && dim_a != 1) || (dim_b != dim && dim_b != 1)) {
+      MS_LOG(EXCEPTION) << "The inputs " << input_shape_a << " and " << input_shape_b
+                        << " can not be broadcast to output " << output_shape;
+    }
+    bool full_a = (dim_a == dim);
+    bool full_b = (dim_b == dim);
+    if (!shape_.empty() && full_a == last_full_a && full_b == last_full_b) {
+      shape_.back() *= dim;
+      shape_a.back() *= dim_a;
+      shape_b.back() *= dim_b;
+      continue;
+    }
+    shape_.push_back(dim);
+    shape_a.push_back(dim_a);
+    shape_b.push_back(dim_b);
+    last_full_a = full_a;
+    last_full_b = full_b;
+  }
+  if (shape_.empty()) {
+    shape_ = shape_a = shape_b = {1};
+  }
+
+  const size_t collapsed_rank = shape_.size();
+  strides_a_.resize(collapsed_rank);
+  strides_b_.resize(collapsed_rank);
+  int64_t stride_a = 1;
+  int64_t stride_b = 1;
+  for (size_t i = collapsed_rank; i > 0; --i) {
+    strides_a_[i - 1] = (shape_a[i - 1] == 1) ? 0 : stride_a;
+    strides_b_[i - 1] = (shape_b[i - 1] == 1) ? 0 : stride_b;
+    stride_a *= shape_a[i - 1];
+    stride_b *= shape_b[i - 1];
+  }
+
+  // A single collapsed dimension is the same shape, or a scalar with an input which is not broadcast. A scalar with
+  // an input broadcast in some dimensions is left to the general pattern.
+  if (collapsed_rank == 1 && strides_a_[0] != 0 && strides_b_[0] != 0) {
+    pattern_ = Pattern::kSameShape;
+  } else if (collapsed_rank == 1) {
+    pattern_ = Pattern::kScalar;
+  } else if (collapsed_rank == kDim2 && strides_a_[1] != 0 && strides_b_[1] != 0) {
+    pattern_ = Pattern::kRow;
+  } else if (collapsed_rank == kDim2) {
+    pattern_ = Pattern::kColumn;
+  } else {
+    pattern_ = Pattern::kGeneral;
+  }
+}
+
 MultipleBroadcastIterator::MultipleBroadcastIterator(std::vector<shape_info> multi_inputs, shape_info output_shape)
     : multi_inputs_(std::move(multi_inputs)), output_shape_(std::move(output_shape)) {
   output_dimension_ = SizeToInt(output_shape_.size());
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -25,6 +26,8 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <typeindex>
+#include <utility>
 
 #include "kernel/kernel.h"
 #include "plugin/factory/ms_factory.h"
@@ -124,14 +127,25 @@ constexpr size_t D_INDEX = 2;
 constexpr size_t H_INDEX = 3;
 constexpr size_t W_INDEX = 4;
 
-struct ParallelSearchInfo {
+struct ParallelSearchState {
   double min_cost_time{DBL_MAX};
   double tmp_sum_cost_time{0.f};
   float best_block_size{0.f};
   size_t best_pow{0};
   size_t search_count{0};
+  // The key of the process-wide tuning cache, empty means not shared.
+  std::string cache_key;
+};
+
+struct ParallelSearchInfo {
   bool kernel_thread_num_set{false};
   size_t max_pow{6};
+  // Used to share the searched block size through the process-wide tuning cache, empty means not shared.
+  std::string kernel_name;
+  size_t thread_num{0};
+  // A kernel may launch several tasks with different counts in one Launch, so each task, identified by the type of
+  // its callable, and each count bucket keeps its own search.
+  std::map<std::pair<std::type_index, size_t>, ParallelSearchState> search_states;
 };
 
 class BACKEND_EXPORT NativeCpuKernelMod : public CpuKernelMod {
@@ -141,6 +155,9 @@ class BACKEND_EXPORT NativeCpuKernelMod : public CpuKernelMod {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs, void * /*stream_ptr*/) override {
+    if (parallel_search_info_.kernel_name.empty()) {
+      parallel_search_info_.kernel_name = kernel_name_;
+    }
     return Launch(inputs, workspace, outputs);
   }
   virtual bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
@@ -307,6 +324,133 @@ class MultipleBroadcastIterator {
   int output_dimension_{0};
 };
 
+// Broadcast of two inputs with precomputed strides. The adjacent dimensions broadcasting in the same way are collapsed,
+// and the output is visited row by row of the innermost dimension, in which each input moves by stride 0 or 1. So the
+// element-wise function runs in plain inner loops which can be vectorized, instead of stepping a BroadcastIterator for
+// each element.
+class BACKEND_EXPORT BroadcastPlan {
+ public:
+  enum class Pattern { kSameShape, kScalar, kRow, kColumn, kGeneral };
+
+  BroadcastPlan(const ShapeVector &input_shape_a, const ShapeVector &input_shape_b, const ShapeVector &output_shape);
+  ~BroadcastPlan() = default;
+  Pattern pattern() const { return pattern_; }
+  const ShapeVector &shape() const { return shape_; }
+
+  // Compute out[i] = op(a[i'], b[i'']) for the output positions in [start, end). The same shape and scalar patterns
+  // are one row, the row and column patterns are rows of a matrix, and only the general pattern walks the coordinates.
+  template <typename TA, typename TB, typename TOut, typename Op>
+  void Compute(const TA *a, const TB *b, TOut *out, size_t start, size_t end, const Op &op) const {
+    if (start >= end) {
+      return;
+    }
+    switch (pattern_) {
+      case Pattern::kSameShape:
+      case Pattern::kScalar:
+        ComputeRow(a + start * LongToSize(strides_a_[0]), b + start * LongToSize(strides_b_[0]), out + start,
+                   end - start, strides_a_[0], strides_b_[0], op);
+        return;
+      case Pattern::kRow:
+      case Pattern::kColumn: {
+        const size_t inner = LongToSize(shape_[1]);
+        for (size_t pos = start; pos < end;) {
+          size_t row = pos / inner;
+          size_t col = pos % inner;
+          size_t count = std::min(inner - col, end - pos);
+          ComputeRow(a + row * LongToSize(strides_a_[0]) + col * LongToSize(strides_a_[1]),
+                     b + row * LongToSize(strides_b_[0]) + col * LongToSize(strides_b_[1]), out + pos, count,
+                     strides_a_[1], strides_b_[1], op);
+          pos += count;
+        }
+        return;
+      }
+      default:
+        RunRows(start, end, [a, b, out, &op](size_t out_pos, size_t pos_a, size_t pos_b, size_t count,
+                                             int64_t stride_a, int64_t stride_b) {
+          ComputeRow(a + pos_a, b + pos_b, out + out_pos, count, stride_a, stride_b, op);
+        });
+        return;
+    }
+  }
+
+ private:
+  // Compute count elements of a row, in which each input moves by stride 0 or 1.
+  template <typename TA, typename TB, typename TOut, typename Op>
+  static void ComputeRow(const TA *row_a, const TB *row_b, TOut *row_out, size_t count, int64_t stride_a,
+                         int64_t stride_b, const Op &op) {
+    if (stride_a != 0 && stride_b != 0) {
+      for (size_t i = 0; i < count; ++i) {
+        row_out[i] = op(row_a[i], row_b[i]);
+      }
+    } else if (stride_b != 0) {
+      const TA value_a = row_a[0];
+      for (size_t i = 0; i < count; ++i) {
+        row_out[i] = op(value_a, row_b[i]);
+      }
+    } else if (stride_a != 0) {
+      const TB value_b = row_b[0];
+      for (size_t i = 0; i < count; ++i) {
+        row_out[i] = op(row_a[i], value_b);
+      }
+    } else {
+      const TOut value = op(row_a[0], row_b[0]);
+      for (size_t i = 0; i < count; ++i) {
+        row_out[i] = value;
+      }
+    }
+  }
+
+  // Call row_func(out_pos, pos_a, pos_b, count, stride_a, stride_b) for each piece of the innermost rows in the range.
+  template <typename RowFunc>
+  void RunRows(size_t start, size_t end, const RowFunc &row_func) const {
+    const size_t rank = shape_.size();
+    const size_t inner = LongToSize(shape_[rank - 1]);
+    if (start >= end || inner == 0) {
+      return;
+    }
+    ShapeVector coordinates(rank, 0);
+    size_t pos = start;
+    size_t pos_a = 0;
+    size_t pos_b = 0;
+    for (size_t i = rank; i > 0 && pos != 0; --i) {
+      coordinates[i - 1] = SizeToLong(pos % LongToSize(shape_[i - 1]));
+      pos_a += LongToSize(coordinates[i - 1] * strides_a_[i - 1]);
+      pos_b += LongToSize(coordinates[i - 1] * strides_b_[i - 1]);
+      pos /= LongToSize(shape_[i - 1]);
+    }
+    size_t out_pos = start;
+    while (out_pos < end) {
+      size_t count = std::min(inner - LongToSize(coordinates[rank - 1]), end - out_pos);
+      row_func(out_pos, pos_a, pos_b, count, strides_a_[rank - 1], strides_b_[rank - 1]);
+      out_pos += count;
+      if (out_pos >= end) {
+        break;
+      }
+      // Move to the beginning of the next row.
+      pos_a -= LongToSize(coordinates[rank - 1] * strides_a_[rank - 1]);
+      pos_b -= LongToSize(coordinates[rank - 1] * strides_b_[rank - 1]);
+      coordinates[rank - 1] = 0;
+      for (size_t i = rank - 1; i > 0; --i) {
+        if (coordinates[i - 1] + 1 < shape_[i - 1]) {
+          ++coordinates[i - 1];
+          pos_a += LongToSize(strides_a_[i - 1]);
+          pos_b += LongToSize(strides_b_[i - 1]);
+          break;
+        }
+        pos_a -= LongToSize(coordinates[i - 1] * strides_a_[i - 1]);
+        pos_b -= LongToSize(coordinates[i - 1] * strides_b_[i - 1]);
+        coordinates[i - 1] = 0;
+      }
+    }
+  }
+
+  // The collapsed output shape, and the strides of the inputs in it, where the stride of a broadcast dimension is 0.
+  ShapeVector shape_;
+  ShapeVector strides_a_;
+  ShapeVector strides_b_;
+  Pattern pattern_{Pattern::kGeneral};
+};
+
 class TransposeIterator {
  public:
   TransposeIterator(ShapeVector output_shape, std::vector<size_t> axes, const ShapeVector &input_shape);
@@ -18,6 +18,20 @@
 
 #include "nnacl/op_base.h"
 
+typedef struct AttentionParameter {
+  // Primitive parameter
+  OpParameter op_parameter_;
+  int head_num_;  // number of heads of multi-head-attention
+  // args for compute
+  int head_size_;  // d_model / head_num
+  int batch_;      // batch of query/key/value
+  int d_model_;    // d_model of multi-head-attention
+  int q_seq_;      // length of sequence of query of attention
+  int kv_seq_;     // length of sequence of key/value of attention
+  int row_tile_;   // row tile for matrix pack
+  int col_tile_;   // col tile for matrix pack
+} AttentionParameter;
+
 typedef struct RelativePositionAttentionParameter {
   // Primitive parameter
   OpParameter op_parameter_;
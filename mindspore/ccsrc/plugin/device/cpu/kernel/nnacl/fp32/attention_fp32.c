@@ -17,13 +17,21 @@
 #include "nnacl/fp32/attention_fp32.h"
 #include <string.h>
 #include <math.h>
+#include <float.h>
 #include "nnacl/fp32/pack_fp32.h"
 #include "nnacl/fp32/matmul_fp32.h"
 #include "nnacl/fp32/add_fp32.h"
 #include "nnacl/fp32/transpose_fp32.h"
 #include "nnacl/fp32/softmax_fp32.h"
+#include "nnacl/fp32/exp_fp32.h"
+#include "nnacl/intrinsics/ms_simd_instructions.h"
 #include "nnacl/errorcode.h"
 
+#define FLASH_ATTENTION_Q_BLOCK C16NUM
+#define FLASH_ATTENTION_KV_BLOCK C64NUM
+// additive value of the masked logits, the same as the bert attention mask: (1 - mask) * -10000
+#define ATTENTION_MASK_VALUE (-10000.0f)
+
 int InitMatrix(Matrix *matrix, int batch, int row, int col, bool is_trans) {
   if (matrix == NULL) {
     return NNACL_NULL_PTR;
@@ -567,3 +575,141 @@ void RelPosAttention(RelativePositionAttentionParameter *param, Matrix *logits_m
               logits2v_trans_mat->row_, wo_mat->col_, wo_mat->col_, OutType_Nhwc);
   }
 }
+
+int FlashAttentionBufferSize(int head_size) {
+  // transposed key block, logits block, output accumulator, running max and running sum of each query row
+  return head_size * FLASH_ATTENTION_KV_BLOCK +
+         FLASH_ATTENTION_Q_BLOCK * (FLASH_ATTENTION_KV_BLOCK + head_size + C2NUM);
+}
+
+// k[kv_block, head_size] with kv_stride -> dst[head_size, FLASH_ATTENTION_KV_BLOCK]
+static void FlashAttentionTransposeKey(const float *k, float *dst, int kv_block, int head_size, int kv_stride) {
+  for (int j = 0; j < kv_block; ++j) {
+    const float *src = k + j * kv_stride;
+    for (int d = 0; d < head_size; ++d) {
+      dst[d * FLASH_ATTENTION_KV_BLOCK + j] = src[d];
+    }
+  }
+}
+
+// logits[j] = sum(q[d] * k_trans[d][j]) * scale, the keys are the vectorized dimension, so no horizontal sum is needed.
+static void FlashAttentionLogits(const float *q, const float *k_trans, float *logits, int kv_block, int head_size,
+                                 float scale) {
+  int j = 0;
+#if defined(ENABLE_ARM64) || defined(ENABLE_SSE)
+  for (; j <= kv_block - C16NUM; j += C16NUM) {
+    MS_FLOAT32X4 sum0 = MS_MOVQ_F32(0.0f);
+    MS_FLOAT32X4 sum1 = MS_MOVQ_F32(0.0f);
+    MS_FLOAT32X4 sum2 = MS_MOVQ_F32(0.0f);
+    MS_FLOAT32X4 sum3 = MS_MOVQ_F32(0.0f);
+    for (int d = 0; d < head_size; ++d) {
+      const float *cur_k = k_trans + d * FLASH_ATTENTION_KV_BLOCK + j;
+      MS_FLOAT32X4 q_4 = MS_MOVQ_F32(q[d]);
+      sum0 = MS_MLAQ_F32(sum0, q_4, MS_LDQ_F32(cur_k));
+      sum1 = MS_MLAQ_F32(sum1, q_4, MS_LDQ_F32(cur_k + C4NUM));
+      sum2 = MS_MLAQ_F32(sum2, q_4, MS_LDQ_F32(cur_k + C8NUM));
+      sum3 = MS_MLAQ_F32(sum3, q_4, MS_LDQ_F32(cur_k + C12NUM));
+    }
+    MS_STQ_F32(logits + j, MS_MULQ_N_F32(sum0, scale));
+    MS_STQ_F32(logits + j + C4NUM, MS_MULQ_N_F32(sum1, scale));
+    MS_STQ_F32(logits + j + C8NUM, MS_MULQ_N_F32(sum2, scale));
+    MS_STQ_F32(logits + j + C12NUM, MS_MULQ_N_F32(sum3, scale));
+  }
+  for (; j <= kv_block - C4NUM; j += C4NUM) {
+    MS_FLOAT32X4 sum = MS_MOVQ_F32(0.0f);
+    for (int d = 0; d < head_size; ++d) {
+      sum = MS_MLAQ_F32(sum, MS_MOVQ_F32(q[d]), MS_LDQ_F32(k_trans + d * FLASH_ATTENTION_KV_BLOCK + j));
+    }
+    MS_STQ_F32(logits + j, MS_MULQ_N_F32(sum, scale));
+  }
+#endif
+  for (; j < kv_block; ++j) {
+    float sum = 0.0f;
+    for (int d = 0; d < head_size; ++d) {
+      sum += q[d] * k_trans[d * FLASH_ATTENTION_KV_BLOCK + j];
+    }
+    logits[j] = sum * scale;
+  }
+}
+
+// dst = dst * scale + sum(weight[j] * src[j]), src[j] is a row of v
+static inline void FlashAttentionAccumulate(float *dst, float scale, const float *src, int src_stride,
+                                            const float *weight, int rows, int len) {
+  int i = 0;
+#if defined(ENABLE_ARM64) || defined(ENABLE_SSE)
+  for (; i <= len - C4NUM; i += C4NUM) {
+    MS_FLOAT32X4 dst_4 = MS_MULQ_N_F32(MS_LDQ_F32(dst + i), scale);
+    for (int j = 0; j < rows; ++j) {
+      dst_4 = MS_MLAQ_F32(dst_4, MS_LDQ_F32(src + j * src_stride + i), MS_MOVQ_F32(weight[j]));
+    }
+    MS_STQ_F32(dst + i, dst_4);
+  }
+#endif
+  for (; i < len; ++i) {
+    float tmp = dst[i] * scale;
+    for (int j = 0; j < rows; ++j) {
+      tmp += src[j * src_stride + i] * weight[j];
+    }
+    dst[i] = tmp;
+  }
+}
+
+void FlashAttentionFp32(const float *q, const float *k, const float *v, const float *mask, float *output,
+                        float *buffer, int q_seq, int kv_seq, int head_size, int q_stride, int kv_stride,
+                        int out_stride, float scale) {
+  float *k_trans = buffer;
+  float *logits = k_trans + head_size * FLASH_ATTENTION_KV_BLOCK;
+  float *acc = logits + FLASH_ATTENTION_Q_BLOCK * FLASH_ATTENTION_KV_BLOCK;
+  float *row_max = acc + FLASH_ATTENTION_Q_BLOCK * head_size;
+  float *row_sum = row_max + FLASH_ATTENTION_Q_BLOCK;
+  for (int q_start = 0; q_start < q_seq; q_start += FLASH_ATTENTION_Q_BLOCK) {
+    int q_block = MSMIN(FLASH_ATTENTION_Q_BLOCK, q_seq - q_start);
+    memset(acc, 0, q_block * head_size * sizeof(float));
+    for (int i = 0; i < q_block; ++i) {
+      row_max[i] = -FLT_MAX;
+      row_sum[i] = 0.0f;
+    }
+    // the key and value block stay in cache while all the query rows of the block visit it.
+    for (int kv_start = 0; kv_start < kv_seq; kv_start += FLASH_ATTENTION_KV_BLOCK) {
+      int kv_block = MSMIN(FLASH_ATTENTION_KV_BLOCK, kv_seq - kv_start);
+      const float *cur_v = v + kv_start * kv_stride;
+      FlashAttentionTransposeKey(k + kv_start * kv_stride, k_trans, kv_block, head_size, kv_stride);
+      for (int i = 0; i < q_block; ++i) {
+        const float *cur_q = q + (q_start + i) * q_stride;
+        float *cur_logits = logits + i * FLASH_ATTENTION_KV_BLOCK;
+        FlashAttentionLogits(cur_q, k_trans, cur_logits, kv_block, head_size, scale);
+        if (mask != NULL) {
+          const float *cur_mask = mask + (q_start + i) * kv_seq + kv_start;
+          for (int j = 0; j < kv_block; ++j) {
+            cur_logits[j] += (1.0f - cur_mask[j]) * ATTENTION_MASK_VALUE;
+          }
+        }
+        float block_max = row_max[i];
+        for (int j = 0; j < kv_block; ++j) {
+          block_max = MSMAX(block_max, cur_logits[j]);
+        }
+        for (int j = 0; j < kv_block; ++j) {
+          cur_logits[j] -= block_max;
+        }
+        ExpFp32(cur_logits, cur_logits, kv_block);
+        float block_sum = 0.0f;
+        for (int j = 0; j < kv_block; ++j) {
+          block_sum += cur_logits[j];
+        }
+        // rescale what was accumulated with the previous max to the new one
+        float correction = row_max[i] == -FLT_MAX ? 0.0f : expf(row_max[i] - block_max);
+        row_sum[i] = row_sum[i] * correction + block_sum;
+        row_max[i] = block_max;
+        FlashAttentionAccumulate(acc + i * head_size, correction, cur_v, kv_stride, cur_logits, kv_block, head_size);
+      }
+    }
+    for (int i = 0; i < q_block; ++i) {
+      float *cur_out = output + (q_start + i) * out_stride;
+      const float *cur_acc = acc + i * head_size;
+      float inv_sum = 1.0f / row_sum[i];
+      for (int d = 0; d < head_size; ++d) {
+        cur_out[d] = cur_acc[d] * inv_sum;
+      }
+    }
+  }
+}
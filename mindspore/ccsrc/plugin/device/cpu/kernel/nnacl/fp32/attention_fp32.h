@@ -66,6 +66,16 @@ void CalculateLogits(RelativePositionAttentionParameter *param, Matrix *q2wq_wit
 void RelPosAttention(RelativePositionAttentionParameter *param, Matrix *logits_mat, Matrix *softmax_mat,
                      Matrix *v2wv_trans_mat, Matrix *logits2v_mat, Matrix *logits2v_trans_mat, const Matrix *wo_mat,
                      Matrix *bo_mat, Matrix *output_mat);
+
+// number of floats of the workspace used by one call of FlashAttentionFp32
+int FlashAttentionBufferSize(int head_size);
+
+// softmax(q * k^T * scale + mask) * v of one head, the keys and values are visited block by block with an online
+// softmax, so the [q_seq, kv_seq] logits are never materialized. mask is optional, a [q_seq, kv_seq] matrix in which
+// 1 keeps and 0 drops a position. kv_seq may be longer than q_seq when cached keys and values are appended.
+void FlashAttentionFp32(const float *q, const float *k, const float *v, const float *mask, float *output,
+                        float *buffer, int q_seq, int kv_seq, int head_size, int q_stride, int kv_stride,
+                        int out_stride, float scale);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include "nnacl/fp32_sparse/matmul_sparse_fp32.h"
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+
+static inline __m512 SparseActAvx512(__m512 value, ActType act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = MS_MAX512_F32(value, MS_MOV512_VAL0_F32);
+  }
+  if (act_type == ActType_Relu6) {
+    value = MS_MIN512_F32(value, MS_MOV512_F32(6.0f));
+  }
+  return value;
+}
+
+static inline void SparseStoreColumnAvx512(__m512 value, float *dst, ActType act_type, int real_row, int stride) {
+  float acc[C16NUM];
+  MS_ST512_F32(acc, SparseActAvx512(value, act_type));
+  for (int i = 0; i < real_row; ++i) {
+    dst[i * stride] = acc[i];
+  }
+}
+
+static inline void SparseStoreBlockAvx512(__m512 value, float *dst, ActType act_type, int real_col) {
+  if (real_col == C16NUM) {
+    MS_ST512_F32(dst, SparseActAvx512(value, act_type));
+    return;
+  }
+  float acc[C16NUM];
+  MS_ST512_F32(acc, SparseActAvx512(value, act_type));
+  for (int i = 0; i < real_col; ++i) {
+    dst[i] = acc[i];
+  }
+}
+
+void SparseMatMulCsrAvx512Fp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                               const float *bias, float *c, ActType act_type, int row, int deep, int col, int start,
+                               int end) {
+  int tile_num = UP_DIV(row, C16NUM);
+  int tile_stride = C16NUM * deep;
+  // a group of 4 tiles stays in cache while the columns are computed, the weights are read once per group
+  for (int group = 0; group < tile_num; group += C4NUM) {
+    int group_end = MSMIN(tile_num, group + C4NUM);
+    for (int j = start; j < end; ++j) {
+      int t = group;
+      if (t + C3NUM < group_end) {
+        // a tile of 16 rows is one register, the 4 tiles share the loads of the weights
+        const float *a0 = a + t * tile_stride;
+        const float *a1 = a0 + tile_stride;
+        const float *a2 = a1 + tile_stride;
+        const float *a3 = a2 + tile_stride;
+        __m512 acc0 = MS_MOV512_F32(bias[j]);
+        __m512 acc1 = acc0;
+        __m512 acc2 = acc0;
+        __m512 acc3 = acc0;
+        for (uint32_t p = offset[j]; p < offset[j + 1]; ++p) {
+          __m512 w = MS_MOV512_F32(data[p]);
+          acc0 = MS_FMADD512_F32(MS_LD512_F32(a0 + index[p]), w, acc0);
+          acc1 = MS_FMADD512_F32(MS_LD512_F32(a1 + index[p]), w, acc1);
+          acc2 = MS_FMADD512_F32(MS_LD512_F32(a2 + index[p]), w, acc2);
+          acc3 = MS_FMADD512_F32(MS_LD512_F32(a3 + index[p]), w, acc3);
+        }
+        float *dst = c + t * C16NUM * col + j;
+        int tile_size = C16NUM * col;
+        SparseStoreColumnAvx512(acc0, dst, act_type, C16NUM, col);
+        SparseStoreColumnAvx512(acc1, dst + tile_size, act_type, C16NUM, col);
+        SparseStoreColumnAvx512(acc2, dst + C2NUM * tile_size, act_type, C16NUM, col);
+        SparseStoreColumnAvx512(acc3, dst + C3NUM * tile_size, act_type, MSMIN(C16NUM, row - (t + C3NUM) * C16NUM),
+                                col);
+        continue;
+      }
+      for (; t < group_end; ++t) {
+        // four accumulators hide the latency of fma
+        const float *a0 = a + t * tile_stride;
+        __m512 acc0 = MS_MOV512_F32(bias[j]);
+        __m512 acc1 = MS_MOV512_VAL0_F32;
+        __m512 acc2 = MS_MOV512_VAL0_F32;
+        __m512 acc3 = MS_MOV512_VAL0_F32;
+        uint32_t p = offset[j];
+        for (; p + C3NUM < offset[j + 1]; p += C4NUM) {
+          acc0 = MS_FMADD512_F32(MS_LD512_F32(a0 + index[p]), MS_MOV512_F32(data[p]), acc0);
+          acc1 = MS_FMADD512_F32(MS_LD512_F32(a0 + index[p + 1]), MS_MOV512_F32(data[p + 1]), acc1);
+          acc2 = MS_FMADD512_F32(MS_LD512_F32(a0 + index[p + C2NUM]), MS_MOV512_F32(data[p + C2NUM]), acc2);
+          acc3 = MS_FMADD512_F32(MS_LD512_F32(a0 + index[p + C3NUM]), MS_MOV512_F32(data[p + C3NUM]), acc3);
+        }
+        for (; p < offset[j + 1]; ++p) {
+          acc0 = MS_FMADD512_F32(MS_LD512_F32(a0 + index[p]), MS_MOV512_F32(data[p]), acc0);
+        }
+        acc0 = MS_ADD512_F32(MS_ADD512_F32(acc0, acc1), MS_ADD512_F32(acc2, acc3));
+        SparseStoreColumnAvx512(acc0, c + t * C16NUM * col + j, act_type, MSMIN(C16NUM, row - t * C16NUM), col);
+      }
+    }
+  }
+}
+
+void SparseMatMulBlockAvx512Fp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                                 const float *bias, float *c, ActType act_type, int row, int deep, int col, int start,
+                                 int end) {
+  for (int b = start; b < end; ++b) {
+    int col_start = b * C16NUM;
+    int real_col = MSMIN(C16NUM, col - col_start);
+    __m512 block_bias = MS_LD512_F32(bias + col_start);
+    int r = 0;
+    // a weight block is one register and is shared by 8 rows
+    for (; r + C8NUM <= row; r += C8NUM) {
+      const float *a_row = a + r * deep;
+      __m512 dst0 = block_bias;
+      __m512 dst1 = block_bias;
+      __m512 dst2 = block_bias;
+      __m512 dst3 = block_bias;
+      __m512 dst4 = block_bias;
+      __m512 dst5 = block_bias;
+      __m512 dst6 = block_bias;
+      __m512 dst7 = block_bias;
+      for (uint32_t p = offset[b]; p < offset[b + 1]; ++p) {
+        __m512 w = MS_LD512_F32(data + p * C16NUM);
+        const float *src = a_row + index[p];
+        dst0 = MS_FMADD512_F32(MS_MOV512_F32(src[0]), w, dst0);
+        dst1 = MS_FMADD512_F32(MS_MOV512_F32(src[deep]), w, dst1);
+        dst2 = MS_FMADD512_F32(MS_MOV512_F32(src[C2NUM * deep]), w, dst2);
+        dst3 = MS_FMADD512_F32(MS_MOV512_F32(src[C3NUM * deep]), w, dst3);
+        dst4 = MS_FMADD512_F32(MS_MOV512_F32(src[C4NUM * deep]), w, dst4);
+        dst5 = MS_FMADD512_F32(MS_MOV512_F32(src[C5NUM * deep]), w, dst5);
+        dst6 = MS_FMADD512_F32(MS_MOV512_F32(src[C6NUM * deep]), w, dst6);
+        dst7 = MS_FMADD512_F32(MS_MOV512_F32(src[C7NUM * deep]), w, dst7);
+      }
+      float *out = c + r * col + col_start;
+      SparseStoreBlockAvx512(dst0, out, act_type, real_col);
+      SparseStoreBlockAvx512(dst1, out + col, act_type, real_col);
+      SparseStoreBlockAvx512(dst2, out + C2NUM * col, act_type, real_col);
+      SparseStoreBlockAvx512(dst3, out + C3NUM * col, act_type, real_col);
+      SparseStoreBlockAvx512(dst4, out + C4NUM * col, act_type, real_col);
+      SparseStoreBlockAvx512(dst5, out + C5NUM * col, act_type, real_col);
+      SparseStoreBlockAvx512(dst6, out + C6NUM * col, act_type, real_col);
+      SparseStoreBlockAvx512(dst7, out + C7NUM * col, act_type, real_col);
+    }
+    for (; r < row; ++r) {
+      const float *a_row = a + r * deep;
+      __m512 dst = block_bias;
+      for (uint32_t p = offset[b]; p < offset[b + 1]; ++p) {
+        dst = MS_FMADD512_F32(MS_MOV512_F32(a_row[index[p]]), MS_LD512_F32(data + p * C16NUM), dst);
+      }
+      SparseStoreBlockAvx512(dst, c + r * col + col_start, act_type, real_col);
+    }
+  }
+}
+#endif
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32_sparse/matmul_sparse_fp32.h"
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+
+static inline float SparseActFp32(float value, ActType act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = MSMAX(value, 0.0f);
+  }
+  if (act_type == ActType_Relu6) {
+    value = MSMIN(value, 6.0f);
+  }
+  return value;
+}
+
+static inline void SparseStoreColumn(const float *acc, float *dst, ActType act_type, int real_row, int stride) {
+  for (int i = 0; i < real_row; ++i) {
+    dst[i * stride] = SparseActFp32(acc[i], act_type);
+  }
+}
+
+#ifdef ENABLE_AVX
+static inline void SparseStoreBlockAvx(__m256 lo, __m256 hi, float *dst, ActType act_type, int real_col) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    lo = MS_MAX256_F32(lo, MS_MOV256_VAL0_F32);
+    hi = MS_MAX256_F32(hi, MS_MOV256_VAL0_F32);
+  }
+  if (act_type == ActType_Relu6) {
+    lo = MS_MIN256_F32(lo, MS_MOV256_F32(6.0f));
+    hi = MS_MIN256_F32(hi, MS_MOV256_F32(6.0f));
+  }
+  if (real_col == C16NUM) {
+    MS_ST256_F32(dst, lo);
+    MS_ST256_F32(dst + C8NUM, hi);
+    return;
+  }
+  float tmp[C16NUM];
+  MS_ST256_F32(tmp, lo);
+  MS_ST256_F32(tmp + C8NUM, hi);
+  for (int i = 0; i < real_col; ++i) {
+    dst[i] = tmp[i];
+  }
+}
+#endif
+
+void SparseMatMulCsrFp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                         const float *bias, float *c, ActType act_type, int row, int deep, int col, int start,
+                         int end) {
+  float acc[C16NUM];
+  int tile_num = UP_DIV(row, C16NUM);
+  int tile_stride = C16NUM * deep;
+  // a group of 4 tiles stays in cache while the columns are computed, the weights are read once per group
+  for (int group = 0; group < tile_num; group += C4NUM) {
+    int group_end = MSMIN(tile_num, group + C4NUM);
+    for (int j = start; j < end; ++j) {
+      int t = group;
+#ifdef ENABLE_AVX
+      // two tiles share the loads of the weights and give four independent accumulators
+      for (; t + 1 < group_end; t += C2NUM) {
+        const float *a0 = a + t * tile_stride;
+        const float *a1 = a0 + tile_stride;
+        __m256 acc00 = MS_MOV256_F32(bias[j]);
+        __m256 acc01 = acc00;
+        __m256 acc10 = acc00;
+        __m256 acc11 = acc00;
+        for (uint32_t p = offset[j]; p < offset[j + 1]; ++p) {
+          __m256 w = MS_MOV256_F32(data[p]);
+          acc00 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p]), w, acc00);
+          acc01 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p] + C8NUM), w, acc01);
+          acc10 = MS_FMADD256_F32(MS_LD256_F32(a1 + index[p]), w, acc10);
+          acc11 = MS_FMADD256_F32(MS_LD256_F32(a1 + index[p] + C8NUM), w, acc11);
+        }
+        MS_ST256_F32(acc, acc00);
+        MS_ST256_F32(acc + C8NUM, acc01);
+        SparseStoreColumn(acc, c + t * C16NUM * col + j, act_type, MSMIN(C16NUM, row - t * C16NUM), col);
+        MS_ST256_F32(acc, acc10);
+        MS_ST256_F32(acc + C8NUM, acc11);
+        SparseStoreColumn(acc, c + (t + 1) * C16NUM * col + j, act_type, MSMIN(C16NUM, row - (t + 1) * C16NUM), col);
+      }
+      for (; t < group_end; ++t) {
+        const float *a0 = a + t * tile_stride;
+        __m256 acc00 = MS_MOV256_F32(bias[j]);
+        __m256 acc01 = acc00;
+        __m256 acc10 = MS_MOV256_VAL0_F32;
+        __m256 acc11 = MS_MOV256_VAL0_F32;
+        uint32_t p = offset[j];
+        for (; p + 1 < offset[j + 1]; p += C2NUM) {
+          __m256 w0 = MS_MOV256_F32(data[p]);
+          __m256 w1 = MS_MOV256_F32(data[p + 1]);
+          acc00 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p]), w0, acc00);
+          acc01 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p] + C8NUM), w0, acc01);
+          acc10 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p + 1]), w1, acc10);
+          acc11 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p + 1] + C8NUM), w1, acc11);
+        }
+        if (p < offset[j + 1]) {
+          __m256 w0 = MS_MOV256_F32(data[p]);
+          acc00 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p]), w0, acc00);
+          acc01 = MS_FMADD256_F32(MS_LD256_F32(a0 + index[p] + C8NUM), w0, acc01);
+        }
+        MS_ST256_F32(acc, MS_ADD256_F32(acc00, acc10));
+        MS_ST256_F32(acc + C8NUM, MS_ADD256_F32(acc01, acc11));
+        SparseStoreColumn(acc, c + t * C16NUM * col + j, act_type, MSMIN(C16NUM, row - t * C16NUM), col);
+      }
+#endif
+      for (; t < group_end; ++t) {
+        const float *a0 = a + t * tile_stride;
+        for (int i = 0; i < C16NUM; ++i) {
+          acc[i] = bias[j];
+        }
+        for (uint32_t p = offset[j]; p < offset[j + 1]; ++p) {
+          const float *src = a0 + index[p];
+          for (int i = 0; i < C16NUM; ++i) {
+            acc[i] += src[i] * data[p];
+          }
+        }
+        SparseStoreColumn(acc, c + t * C16NUM * col + j, act_type, MSMIN(C16NUM, row - t * C16NUM), col);
+      }
+    }
+  }
+}
+
+void SparseMatMulBlockFp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                           const float *bias, float *c, ActType act_type, int row, int deep, int col, int start,
+                           int end) {
+  float acc[C16NUM];
+  for (int b = start; b < end; ++b) {
+    int col_start = b * C16NUM;
+    int real_col = MSMIN(C16NUM, col - col_start);
+    const float *block_bias = bias + col_start;
+    int r = 0;
+#ifdef ENABLE_AVX
+    // 4 rows share the loads of each weight block
+    for (; r + C4NUM <= row; r += C4NUM) {
+      const float *a_row = a + r * deep;
+      __m256 lo0 = MS_LD256_F32(block_bias);
+      __m256 hi0 = MS_LD256_F32(block_bias + C8NUM);
+      __m256 lo1 = lo0;
+      __m256 hi1 = hi0;
+      __m256 lo2 = lo0;
+      __m256 hi2 = hi0;
+      __m256 lo3 = lo0;
+      __m256 hi3 = hi0;
+      for (uint32_t p = offset[b]; p < offset[b + 1]; ++p) {
+        const float *w = data + p * C16NUM;
+        __m256 w_lo = MS_LD256_F32(w);
+        __m256 w_hi = MS_LD256_F32(w + C8NUM);
+        const float *src = a_row + index[p];
+        __m256 x0 = MS_MOV256_F32(src[0]);
+        __m256 x1 = MS_MOV256_F32(src[deep]);
+        __m256 x2 = MS_MOV256_F32(src[C2NUM * deep]);
+        __m256 x3 = MS_MOV256_F32(src[C3NUM * deep]);
+        lo0 = MS_FMADD256_F32(x0, w_lo, lo0);
+        hi0 = MS_FMADD256_F32(x0, w_hi, hi0);
+        lo1 = MS_FMADD256_F32(x1, w_lo, lo1);
+        hi1 = MS_FMADD256_F32(x1, w_hi, hi1);
+        lo2 = MS_FMADD256_F32(x2, w_lo, lo2);
+        hi2 = MS_FMADD256_F32(x2, w_hi, hi2);
+        lo3 = MS_FMADD256_F32(x3, w_lo, lo3);
+        hi3 = MS_FMADD256_F32(x3, w_hi, hi3);
+      }
+      float *dst = c + r * col + col_start;
+      SparseStoreBlockAvx(lo0, hi0, dst, act_type, real_col);
+      SparseStoreBlockAvx(lo1, hi1, dst + col, act_type, real_col);
+      SparseStoreBlockAvx(lo2, hi2, dst + C2NUM * col, act_type, real_col);
+      SparseStoreBlockAvx(lo3, hi3, dst + C3NUM * col, act_type, real_col);
+    }
+#endif
+    for (; r < row; ++r) {
+      const float *a_row = a + r * deep;
+      for (int i = 0; i < C16NUM; ++i) {
+        acc[i] = block_bias[i];
+      }
+      for (uint32_t p = offset[b]; p < offset[b + 1]; ++p) {
+        const float *w = data + p * C16NUM;
+        float x = a_row[index[p]];
+        for (int i = 0; i < C16NUM; ++i) {
+          acc[i] += x * w[i];
+        }
+      }
+      float *dst = c + r * col + col_start;
+      for (int i = 0; i < real_col; ++i) {
+        dst[i] = SparseActFp32(acc[i], act_type);
+      }
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_FP32_H_
+#define MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_FP32_H_
+
+#include <stdint.h>
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*SparseMatMulFp32Func)(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                                     const float *bias, float *c, ActType act_type, int row, int deep, int col,
+                                     int start, int end);
+
+/* c[row, col] = a[row, deep] * w[deep, col] + bias, the weight is compressed by output column (csr of w^T).
+ * The non-zeros of column j are data[offset[j], offset[j + 1]), index holds their depth multiplied by C16NUM.
+ * a is packed by RowMajor2Col16Major, columns [start, end) are computed and bias can't be NULL. */
+void SparseMatMulCsrFp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                         const float *bias, float *c, ActType act_type, int row, int deep, int col, int start, int end);
+
+/* The weight is split into 1x16 blocks along the output columns. The non-zero blocks of block column b are
+ * data[offset[b] * C16NUM, offset[b + 1] * C16NUM) and index holds their depth.
+ * a is row major, block columns [start, end) are computed and bias is padded to C16NUM. */
+void SparseMatMulBlockFp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                           const float *bias, float *c, ActType act_type, int row, int deep, int col, int start,
+                           int end);
+
+#ifdef ENABLE_AVX512
+void SparseMatMulCsrAvx512Fp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                               const float *bias, float *c, ActType act_type, int row, int deep, int col, int start,
+                               int end);
+
+void SparseMatMulBlockAvx512Fp32(const float *a, const float *data, const uint32_t *index, const uint32_t *offset,
+                                 const float *bias, float *c, ActType act_type, int row, int deep, int col, int start,
+                                 int end);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_FP32_H_
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx512_int8.h"
+#include <string.h>
+#include <x86intrin.h>
+#include "nnacl/op_base.h"
+
+/* vpdpbusd multiplies unsigned a by signed b, so a is offset by 128 with xor, and the offset is removed by
+ * subtracting 128 * sum(b) of each column, which is accumulated with a vector of ones in the same loop. */
+#define INT8_TO_UINT8_OFFSET 128
+
+void MatMulInt8Block4x4Avx512Vnni(const int8_t *a, const int8_t *b, size_t deep16, int32_t *dst) {
+  const __m512i sign = _mm512_set1_epi8((char)0x80);
+  const __m512i ones = _mm512_set1_epi8(1);
+  __m512i acc[C4NUM];
+  for (int c = 0; c < C4NUM; ++c) {
+    acc[c] = _mm512_setzero_si512();
+  }
+  __m512i b_sum = _mm512_setzero_si512();
+  for (size_t d = 0; d < deep16; d += C16NUM) {
+    const int8_t *a_d = a + d * C4NUM;
+    const int8_t *b_d = b + d * C4NUM;
+    // each 128-bit lane holds the 16 deep values of one row
+    __m512i a_u8 = _mm512_xor_si512(_mm512_loadu_si512((const void *)a_d), sign);
+    b_sum = _mm512_dpbusd_epi32(b_sum, ones, _mm512_loadu_si512((const void *)b_d));
+    for (int c = 0; c < C4NUM; ++c) {
+      __m512i b_c = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(b_d + c * C16NUM)));
+      acc[c] = _mm512_dpbusd_epi32(acc[c], a_u8, b_c);
+    }
+  }
+  int32_t b_sum_buf[C16NUM];
+  int32_t acc_buf[C16NUM];
+  _mm512_storeu_si512((void *)b_sum_buf, b_sum);
+  for (int c = 0; c < C4NUM; ++c) {
+    int32_t col_sum = b_sum_buf[c * C4NUM] + b_sum_buf[c * C4NUM + 1] + b_sum_buf[c * C4NUM + 2] +
+                      b_sum_buf[c * C4NUM + 3];
+    _mm512_storeu_si512((void *)acc_buf, acc[c]);
+    for (int r = 0; r < C4NUM; ++r) {
+      int32_t value = acc_buf[r * C4NUM] + acc_buf[r * C4NUM + 1] + acc_buf[r * C4NUM + 2] + acc_buf[r * C4NUM + 3];
+      dst[r * C4NUM + c] = value - INT8_TO_UINT8_OFFSET * col_sum;
+    }
+  }
+}
+
+void MatMulInt8Block8x8Avx512Vnni(const int8_t *a, const int8_t *b, size_t deep_4, int32_t *dst) {
+  const __m256i sign = _mm256_set1_epi8((char)0x80);
+  const __m256i ones = _mm256_set1_epi8(1);
+  __m256i acc[C8NUM];
+  for (int c = 0; c < C8NUM; ++c) {
+    acc[c] = _mm256_setzero_si256();
+  }
+  __m256i b_sum = _mm256_setzero_si256();
+  for (size_t d = 0; d < deep_4; d += C4NUM) {
+    const int8_t *a_d = a + d * C8NUM;
+    const int8_t *b_d = b + d * C8NUM;
+    // each 32-bit lane holds the 4 deep values of one row
+    __m256i a_u8 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)a_d), sign);
+    b_sum = _mm256_dpbusd_epi32(b_sum, ones, _mm256_loadu_si256((const __m256i *)b_d));
+    for (int c = 0; c < C8NUM; ++c) {
+      int32_t b_c;
+      memcpy(&b_c, b_d + c * C4NUM, sizeof(int32_t));
+      acc[c] = _mm256_dpbusd_epi32(acc[c], a_u8, _mm256_set1_epi32(b_c));
+    }
+  }
+  int32_t b_sum_buf[C8NUM];
+  int32_t acc_buf[C8NUM];
+  _mm256_storeu_si256((__m256i *)b_sum_buf, b_sum);
+  for (int c = 0; c < C8NUM; ++c) {
+    _mm256_storeu_si256((__m256i *)acc_buf, acc[c]);
+    for (int r = 0; r < C8NUM; ++r) {
+      dst[r * C8NUM + c] = acc_buf[r] - INT8_TO_UINT8_OFFSET * b_sum_buf[c];
+    }
+  }
+}
+#endif
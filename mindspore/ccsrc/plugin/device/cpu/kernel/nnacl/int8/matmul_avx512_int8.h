@@ -0,0 +1,38 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_INT8_MATMUL_AVX512_H_
+#define MINDSPORE_NNACL_INT8_MATMUL_AVX512_H_
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef ENABLE_AVX512
+/* The vnni kernels compute one int32 block of the packed int8 matrices, the block is stored row-major.
+ * They need avx512_vnni and avx512vl, check X86_Avx512Vnni_Support before calling. */
+
+/* row4x16-major * row16x4-major => 4x4 block, the layout of MatmulInt8Opt */
+void MatMulInt8Block4x4Avx512Vnni(const int8_t *a, const int8_t *b, size_t deep16, int32_t *dst);
+
+/* row8x4-major * row4x8-major => 8x8 block, the layout of MatMulInt8_8x8_r */
+void MatMulInt8Block8x8Avx512Vnni(const int8_t *a, const int8_t *b, size_t deep_4, int32_t *dst);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_INT8_MATMUL_AVX512_H_
@@ -16,6 +16,13 @@
 
 #include "nnacl/int8/matmul_int8.h"
 #include "nnacl/int8/fixed_point.h"
+#ifdef ENABLE_AVX
+#include "nnacl/intrinsics/avx/common_utils.h"
+#endif
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx512_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
 
 void RowMajor2Row2x16MajorInt8(const int8_t *src_ptr, int8_t *dst_ptr, int row, int col) {
   int col16 = UP_ROUND(col, C16NUM);
@@ -292,11 +299,152 @@ void MatMulInt8_4x2_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row,
   return;
 }
 
+#ifdef ENABLE_AVX
+typedef void (*MatMulInt8BlockFunc)(const int8_t *a, const int8_t *b, size_t deep, int32_t *dst);
+
+void MatMulInt8Block4x4_AVX2(const int8_t *a, const int8_t *b, size_t deep16, int32_t *dst) {
+  /* row4x16-major * row16x4-major => 4x4 row-major block */
+  __m256i acc[C4NUM];
+  for (int r = 0; r < C4NUM; ++r) {
+    acc[r] = _mm256_setzero_si256();
+  }
+  for (size_t d = 0; d < deep16; d += C16NUM) {
+    const int8_t *a_d = a + d * C4NUM;
+    const int8_t *b_d = b + d * C4NUM;
+    __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d)));
+    __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d + C16NUM)));
+    __m256i b2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d + C2NUM * C16NUM)));
+    __m256i b3 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d + C3NUM * C16NUM)));
+    for (int r = 0; r < C4NUM; ++r) {
+      __m256i a_r = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a_d + r * C16NUM)));
+      // after two rounds of hadd, each 128-bit lane holds the partial sums of the 4 columns
+      __m256i sum01 = _mm256_hadd_epi32(_mm256_madd_epi16(a_r, b0), _mm256_madd_epi16(a_r, b1));
+      __m256i sum23 = _mm256_hadd_epi32(_mm256_madd_epi16(a_r, b2), _mm256_madd_epi16(a_r, b3));
+      acc[r] = _mm256_add_epi32(acc[r], _mm256_hadd_epi32(sum01, sum23));
+    }
+  }
+  for (int r = 0; r < C4NUM; ++r) {
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc[r]), _mm256_extracti128_si256(acc[r], 1));
+    _mm_storeu_si128((__m128i *)(dst + r * C4NUM), sum);
+  }
+}
+
+void MatMulInt8Block8x8_AVX2(const int8_t *a, const int8_t *b, size_t deep_4, int32_t *dst) {
+  /* row8x4-major * row4x8-major => 8x8 row-major block */
+  __m256i acc[C8NUM];
+  for (int c = 0; c < C8NUM; ++c) {
+    acc[c] = _mm256_setzero_si256();
+  }
+  for (size_t d = 0; d < deep_4; d += C4NUM) {
+    const int8_t *a_d = a + d * C8NUM;
+    const int8_t *b_d = b + d * C8NUM;
+    __m256i a_lo = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a_d)));
+    __m256i a_hi = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a_d + C16NUM)));
+    __m256i b_lo = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d)));
+    __m256i b_hi = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_d + C16NUM)));
+    __m256i b_c[C8NUM];
+    b_c[0] = _mm256_permute4x64_epi64(b_lo, 0x00);
+    b_c[1] = _mm256_permute4x64_epi64(b_lo, 0x55);
+    b_c[2] = _mm256_permute4x64_epi64(b_lo, 0xAA);
+    b_c[3] = _mm256_permute4x64_epi64(b_lo, 0xFF);
+    b_c[4] = _mm256_permute4x64_epi64(b_hi, 0x00);
+    b_c[5] = _mm256_permute4x64_epi64(b_hi, 0x55);
+    b_c[6] = _mm256_permute4x64_epi64(b_hi, 0xAA);
+    b_c[7] = _mm256_permute4x64_epi64(b_hi, 0xFF);
+    for (int c = 0; c < C8NUM; ++c) {
+      // the lanes of acc[c] are ordered as rows 0 1 4 5 2 3 6 7
+      __m256i sum = _mm256_hadd_epi32(_mm256_madd_epi16(a_lo, b_c[c]), _mm256_madd_epi16(a_hi, b_c[c]));
+      acc[c] = _mm256_add_epi32(acc[c], sum);
+    }
+  }
+  const __m256i row_order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+  int32_t col_buf[C8NUM];
+  for (int c = 0; c < C8NUM; ++c) {
+    _mm256_storeu_si256((__m256i *)col_buf, _mm256_permutevar8x32_epi32(acc[c], row_order));
+    for (int r = 0; r < C8NUM; ++r) {
+      dst[r * C8NUM + c] = col_buf[r];
+    }
+  }
+}
+
+static inline int8_t MatMulInt8Requant(int32_t value, int32_t multiplier, int32_t left_shift, int32_t right_shift,
+                                       int32_t out_zp, int32_t mini, int32_t maxi) {
+  value = MultiplyByQuantizedMultiplier(value, multiplier, left_shift, right_shift) + out_zp;
+  value = MSMIN(maxi, value);
+  value = MSMAX(mini, value);
+  return (int8_t)value;
+}
+
+static void MatmulInt8OptBlock(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                               const int32_t *a_sums, const int32_t *bias, int mini, int maxi, int out_zp,
+                               const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                               size_t stride, size_t filter_peroc, const int32_t *filter_zp,
+                               MatMulInt8BlockFunc block_func) {
+  int32_t block[C4NUM * C4NUM];
+  for (int r = 0; r < row; r += C4NUM) {
+    int row_num = MSMIN(C4NUM, row - r);
+    for (int c = 0; c < col; c += C4NUM) {
+      int col_num = MSMIN(C4NUM, col - c);
+      block_func(a + (size_t)r * deep16, b + (size_t)c * deep16, (size_t)deep16, block);
+      for (int i = 0; i < row_num; ++i) {
+        for (int j = 0; j < col_num; ++j) {
+          int cur_row = r + i;
+          int cur_col = c + j;
+          int32_t cur_input_sum = filter_peroc ? a_sums[cur_row] * filter_zp[cur_col] : a_sums[cur_row];
+          int32_t value = block[i * C4NUM + j] - cur_input_sum + bias[cur_col];
+          size_t quant_index = filter_peroc ? cur_col : 0;
+          dst[cur_row * stride + cur_col] = MatMulInt8Requant(
+            value, multiplier[quant_index], left_shift[quant_index], right_shift[quant_index], out_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+
+static void MatMulInt8_8x8_rBlock(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col,
+                                  size_t deep_4, size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                  const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                  int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+                                  MatMulInt8BlockFunc block_func) {
+  int32_t block[C8NUM * C8NUM];
+  size_t row_8 = UP_ROUND(row, C8NUM);
+  for (size_t r = 0; r < row; r += C8NUM) {
+    size_t row_num = MSMIN(C8NUM, row - r);
+    for (size_t c = 0; c < col; c += C8NUM) {
+      size_t col_num = MSMIN(C8NUM, col - c);
+      block_func(a + r * deep_4, b + c * deep_4, deep_4, block);
+      for (size_t i = 0; i < row_num; ++i) {
+        for (size_t j = 0; j < col_num; ++j) {
+          size_t cur_row = r + i;
+          size_t cur_col = c + j;
+          int32_t cur_input_sum = per_channel ? input_sum[c * row_8 + cur_row * C8NUM + j] : input_sum[cur_row];
+          int32_t value = block[i * C8NUM + j] - cur_input_sum + bias[cur_col];
+          size_t quant_index = per_channel ? cur_col : 0;
+          dst[cur_row * stride + cur_col] = MatMulInt8Requant(
+            value, multiplier[quant_index], left_shift[quant_index], right_shift[quant_index], output_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+#endif
+
 #ifndef ENABLE_ARM
 void MatmulInt8Opt(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int32_t *a_sums,
                    const int32_t *bias, int mini, int maxi, int out_zp, const int32_t *multiplier,
                    const int32_t *left_shift, const int32_t *right_shift, size_t stride, size_t filter_peroc,
                    const int32_t *filter_zp) {
+#ifdef ENABLE_AVX
+  MatMulInt8BlockFunc block_func = MatMulInt8Block4x4_AVX2;
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Vnni_Support()) {
+    block_func = MatMulInt8Block4x4Avx512Vnni;
+  }
+#endif
+  MatmulInt8OptBlock(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                     right_shift, stride, filter_peroc, filter_zp, block_func);
+  return;
+#endif
   /*
    * row4x16-major * row16x4-major => (int8)row-major
    * support per-layer && weight per-channel
@@ -334,6 +482,17 @@ void MatMulInt8_8x8_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row,
                       size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
                       const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
                       int32_t maxi, size_t per_channel) {
+#ifdef ENABLE_AVX
+  MatMulInt8BlockFunc block_func = MatMulInt8Block8x8_AVX2;
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Vnni_Support()) {
+    block_func = MatMulInt8Block8x8Avx512Vnni;
+  }
+#endif
+  MatMulInt8_8x8_rBlock(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                        output_zp, mini, maxi, per_channel, block_func);
+  return;
+#endif
   /*  row8x4-major * row4x8-major => (int8)row-major  */
   for (size_t r = 0; r < row; r++) {
     for (size_t c = 0; c < col; c++) {
@@ -72,6 +72,12 @@ void MatMulInt8_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row
                        const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
                        int32_t maxi, size_t per_channel, const int32_t *filter_zp);
 
+#ifdef ENABLE_AVX
+/* x86 blocks of MatmulInt8Opt and MatMulInt8_8x8_r, the int32 block is stored row-major */
+void MatMulInt8Block4x4_AVX2(const int8_t *a, const int8_t *b, size_t deep16, int32_t *dst);
+void MatMulInt8Block8x8_AVX2(const int8_t *a, const int8_t *b, size_t deep_4, int32_t *dst);
+#endif
+
 #ifdef ENABLE_ARM64
 void MatmulInt8Neon64(const int8_t *a, const int8_t *b, int8_t *dst, int row4, int col4, int deep16,
                       const int32_t *a_sums, const int32_t *bias, int act_min, int act_max, int out_zp,
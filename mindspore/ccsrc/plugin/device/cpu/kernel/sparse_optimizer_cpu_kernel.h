@@ -19,7 +19,6 @@
 
 #include <vector>
 #include <memory>
-#include <unordered_map>
 #include <algorithm>
 #include <utility>
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
@@ -69,14 +68,6 @@ struct MultiThreadComputeParams {
 template <typename T>
 using MultiThreadComputeFunc = std::function<void(MultiThreadComputeParams<T> *param, size_t start, size_t end)>;
 
-template <typename T>
-struct BucketSparseGradient {
-  float *value_;
-  T *indices_;
-  T *global_indices_;
-  size_t indices_size_;
-};
-
 template <typename T>
 struct MultiThreadReduceSparseGradientParam {
   SparseGradient<T> *input_grad_{nullptr};
@@ -85,7 +76,8 @@ struct MultiThreadReduceSparseGradientParam {
   size_t max_index_{0};
   size_t value_stride_{0};
   size_t thread_num_{0};
-  bool use_sort_reduce_{false};
+  // Each bucket holds the indices in [bucket_bounds_[bucket_id], bucket_bounds_[bucket_id + 1]).
+  std::vector<size_t> bucket_bounds_;
 };
 
 class SparseOptimizerCpuKernelMod : public NativeCpuKernelMod {
@@ -93,28 +85,38 @@ class SparseOptimizerCpuKernelMod : public NativeCpuKernelMod {
   SparseOptimizerCpuKernelMod() = default;
   ~SparseOptimizerCpuKernelMod() override = default;
 
+  // Reduce the rows of the same index in input_grad_ to output_grad_, the output indices are unique and sorted.
+  // The indices are partitioned into buckets of consecutive index ranges, then each bucket is sorted and summed by one
+  // thread without any lock, and the reduced buckets are merged.
   template <typename T>
   static void BucketReduceSparseGradient(const ReduceSparseGradientParam<T> &param) {
+    BucketReduceSparseGradient(param, common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+  }
+
+  // The same as above with at most thread_num buckets.
+  template <typename T>
+  static void BucketReduceSparseGradient(const ReduceSparseGradientParam<T> &param, size_t thread_num) {
     MS_LOG(DEBUG) << "Start";
     MS_EXCEPTION_IF_NULL(param.input_grad_);
-    size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_);
+    MS_EXCEPTION_IF_NULL(param.output_grad_);
     if (param.input_grad_->indices_size_ < thread_num) {
       thread_num = param.input_grad_->indices_size_;
     }
+    if (thread_num == 0 || param.max_index_ == 0) {
+      param.output_grad_->indices_size_ = 0;
+      return;
+    }
     MultiThreadReduceSparseGradientParam<T> multi_thread_param(
       {param.input_grad_, param.workspace_grad_, param.output_grad_, param.max_index_, param.value_stride_, thread_num,
-       param.use_sort_reduce_});
-    std::vector<std::shared_ptr<SparseGradient<T>>> segments;
-    std::vector<std::shared_ptr<std::vector<size_t>>> segment_bucket_sizes;
-    SplitAndCalculateSegmentBucketSize(multi_thread_param, &segments, &segment_bucket_sizes);
-
-    std::vector<std::shared_ptr<BucketSparseGradient<T>>> buckets;
-    GatherSegmentIndicesToOutputBucket(multi_thread_param, segments, segment_bucket_sizes, &buckets);
+       SampleBucketBounds(param, thread_num)});
+    std::vector<size_t> bucket_offsets;
+    PartitionSparseGradientToBucket(multi_thread_param, &bucket_offsets);
 
-    std::vector<std::shared_ptr<SparseGradient<T>>> reduced_buckets;
-    ReduceBucketSparseGradientToWorkspace(multi_thread_param, buckets, &reduced_buckets);
+    std::vector<size_t> unique_sizes(thread_num, 0);
+    SortAndReduceBucketToWorkspace(multi_thread_param, bucket_offsets, &unique_sizes);
 
-    MergeReduceSparseGradient(multi_thread_param, reduced_buckets);
+    MergeReduceSparseGradient(multi_thread_param, bucket_offsets, unique_sizes);
     MS_LOG(DEBUG) << "End";
   }
 
@@ -141,306 +143,248 @@ class SparseOptimizerCpuKernelMod : public NativeCpuKernelMod {
 
  private:
   template <typename T>
-  static void CalculateEachBucketSize(const std::shared_ptr<SparseGradient<T>> &sparse_grad, size_t max_index,
-                                      std::vector<size_t> *each_bucket_size) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(sparse_grad);
-    MS_EXCEPTION_IF_NULL(sparse_grad->indices_);
-    MS_EXCEPTION_IF_NULL(each_bucket_size);
-    size_t bucket_num = each_bucket_size->size();
-    if (bucket_num < 1) {
-      MS_LOG(EXCEPTION) << "For 'SparseOptimizer', the 'bucket_num' must be at least 1, but got " << bucket_num;
-    }
-    for (size_t i = 0; i < sparse_grad->indices_size_; ++i) {
-      T index = sparse_grad->indices_[i];
-      if (index >= 0 && LongToSize(index) < max_index) {
-        auto bucket_id = index % bucket_num;
-        each_bucket_size->at(bucket_id)++;
-      }
-    }
-    MS_LOG(DEBUG) << "End";
+  static bool IsValidIndex(T index, size_t max_index) {
+    return index >= 0 && LongToSize(index) < max_index;
   }
 
+  // The bounds of the buckets are the quantiles of indices sampled evenly from the input, so the buckets hold about the
+  // same number of indices however the indices are distributed. A bound repeated by a hot index is moved up, which
+  // leaves the hot index a bucket of its own.
   template <typename T>
-  static void SplitAndCalculateSegmentBucketSize(
-    const MultiThreadReduceSparseGradientParam<T> &param, std::vector<std::shared_ptr<SparseGradient<T>>> *segments_ptr,
-    std::vector<std::shared_ptr<std::vector<size_t>>> *segment_bucket_sizes_ptr) {
-    MS_EXCEPTION_IF_NULL(param.input_grad_);
-    MS_EXCEPTION_IF_NULL(segment_bucket_sizes_ptr);
-    MS_EXCEPTION_IF_NULL(segments_ptr);
-    auto &segments = *segments_ptr;
-    auto &segment_bucket_sizes = *segment_bucket_sizes_ptr;
-    auto input_grad = param.input_grad_;
-    if (param.thread_num_ < 1) {
-      MS_EXCEPTION(ArgumentError) << "Input param thread num must > 0!";
+  static std::vector<size_t> SampleBucketBounds(const ReduceSparseGradientParam<T> &param, size_t thread_num) {
+    constexpr size_t kSampleNumPerBucket = 64;
+    MS_EXCEPTION_IF_NULL(param.input_grad_->indices_);
+    size_t indices_size = param.input_grad_->indices_size_;
+    size_t sample_num = std::min(indices_size, thread_num * kSampleNumPerBucket);
+    std::vector<size_t> samples;
+    samples.reserve(sample_num);
+    for (size_t i = 0; i < sample_num; ++i) {
+      T index = param.input_grad_->indices_[i * indices_size / sample_num];
+      if (IsValidIndex(index, param.max_index_)) {
+        samples.push_back(LongToSize(index));
+      }
     }
-    size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
-    size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-    std::vector<common::Task> tasks;
-    tasks.reserve(param.thread_num_);
-    segments.reserve(param.thread_num_);
+    std::sort(samples.begin(), samples.end());
 
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < param.thread_num_; ++i) {
-      (void)segment_bucket_sizes.emplace_back(std::make_shared<std::vector<size_t>>(param.thread_num_, 0));
-      size_t indices_size = thread_indices_size;
-      if (i < left_indices_size) {
-        indices_size += 1;
-      }
-      (void)segments.emplace_back(std::make_shared<SparseGradient<T>>());
-      segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
-      segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
-      segments[i]->indices_size_ = indices_size;
-      auto task = [&segments, &param, &segment_bucket_sizes, i]() {
-        CalculateEachBucketSize<T>(segments[i], param.max_index_, segment_bucket_sizes[i].get());
-        return common::SUCCESS;
-      };
-      (void)tasks.emplace_back(task);
-      current_indices_offset += indices_size;
+    std::vector<size_t> bucket_bounds(thread_num + 1, 0);
+    bucket_bounds[thread_num] = param.max_index_;
+    for (size_t j = 1; j < thread_num; ++j) {
+      size_t bound = samples.empty() ? param.max_index_ * j / thread_num : samples[j * samples.size() / thread_num];
+      bucket_bounds[j] = std::min(std::max(bound, bucket_bounds[j - 1] + 1), param.max_index_);
     }
-    ParallelLaunch(tasks);
+    return bucket_bounds;
   }
 
   template <typename T>
-  static void CopySegmentIndicesToBucket(const MultiThreadReduceSparseGradientParam<T> &param,
-                                         const std::shared_ptr<SparseGradient<T>> &segment, size_t bucket_offset,
-                                         const std::vector<std::shared_ptr<BucketSparseGradient<T>>> &buckets) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(segment);
-    MS_EXCEPTION_IF_NULL(segment->indices_);
-    if (param.thread_num_ == 0) {
-      MS_EXCEPTION(ArgumentError) << "Input param thread num must > 0!";
-    }
-    std::vector<size_t> bucket_data_num(param.thread_num_, 0);
-    for (size_t i = 0; i < segment->indices_size_; ++i) {
-      T index = segment->indices_[i];
-      if (index >= 0 && LongToSize(index) < param.max_index_) {
-        auto bucket_id = index % param.thread_num_;
-        auto bucket_index = bucket_data_num[bucket_id];
-        buckets[bucket_id]->indices_[bucket_index] = index;
-        buckets[bucket_id]->global_indices_[bucket_index] = bucket_offset + i;
-        bucket_data_num[bucket_id]++;
-      }
-    }
-    MS_LOG(DEBUG) << "End";
+  static size_t GetBucketId(const MultiThreadReduceSparseGradientParam<T> &param, T index) {
+    const auto &bounds = param.bucket_bounds_;
+    auto iter = std::upper_bound(bounds.begin() + 1, bounds.end() - 1, LongToSize(index));
+    return static_cast<size_t>(iter - (bounds.begin() + 1));
   }
 
+  // Scatter the valid indices into the buckets: the index is written to output_grad_ and its position in input_grad_
+  // is written to workspace_grad_. Each thread counts and scatters its own segment of the input, and the positions in
+  // a bucket keep ascending since the segments are written in order.
   template <typename T>
-  static void GatherSegmentIndicesToOutputBucket(
-    const MultiThreadReduceSparseGradientParam<T> &param,
-    const std::vector<std::shared_ptr<SparseGradient<T>>> &segments,
-    const std::vector<std::shared_ptr<std::vector<size_t>>> &segment_bucket_sizes,
-    std::vector<std::shared_ptr<BucketSparseGradient<T>>> *buckets_ptr) {
-    MS_EXCEPTION_IF_NULL(param.output_grad_);
-    MS_EXCEPTION_IF_NULL(param.output_grad_->value_);
+  static void PartitionSparseGradientToBucket(const MultiThreadReduceSparseGradientParam<T> &param,
+                                              std::vector<size_t> *bucket_offsets_ptr) {
+    MS_EXCEPTION_IF_NULL(param.input_grad_->indices_);
     MS_EXCEPTION_IF_NULL(param.output_grad_->indices_);
-    MS_EXCEPTION_IF_NULL(buckets_ptr);
-    auto &buckets = *buckets_ptr;
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
+    MS_EXCEPTION_IF_NULL(bucket_offsets_ptr);
+    auto &bucket_offsets = *bucket_offsets_ptr;
     size_t thread_num = param.thread_num_;
-    if (thread_num != segment_bucket_sizes.size()) {
-      MS_EXCEPTION(ArgumentError) << "Input param thread num not equal to segment size!";
-    }
-    std::vector<size_t> bucket_data_size(thread_num, 0);
+    size_t indices_size = param.input_grad_->indices_size_;
+    std::vector<size_t> segment_offsets(thread_num + 1, 0);
     for (size_t i = 0; i < thread_num; ++i) {
-      for (size_t j = 0; j < thread_num; ++j) {
-        bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
-      }
-    }
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      (void)buckets.emplace_back(std::make_shared<BucketSparseGradient<T>>());
-      buckets[i]->value_ = param.output_grad_->value_ + current_indices_offset * param.value_stride_;
-      buckets[i]->indices_ = param.output_grad_->indices_ + current_indices_offset;
-      buckets[i]->global_indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-      buckets[i]->indices_size_ = bucket_data_size[i];
-      current_indices_offset += bucket_data_size[i];
-    }
-    std::vector<size_t> tmp_bucket_data_size(thread_num, 0);
-    std::vector<std::vector<std::shared_ptr<BucketSparseGradient<T>>>> each_thread_buckets;
-    for (size_t i = 0; i < thread_num; ++i) {
-      std::vector<std::shared_ptr<BucketSparseGradient<T>>> thread_buckets;
-      for (size_t j = 0; j < thread_num; ++j) {
-        (void)thread_buckets.emplace_back(std::make_shared<BucketSparseGradient<T>>());
-        thread_buckets[j]->indices_ = buckets[j]->indices_ + tmp_bucket_data_size[j];
-        thread_buckets[j]->global_indices_ = buckets[j]->global_indices_ + tmp_bucket_data_size[j];
-        thread_buckets[j]->value_ = buckets[j]->value_ + tmp_bucket_data_size[j] * param.value_stride_;
-        thread_buckets[j]->indices_size_ = segment_bucket_sizes[i]->at(j);
-        tmp_bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
-      }
-      (void)each_thread_buckets.emplace_back(thread_buckets);
+      size_t segment_size = indices_size / thread_num + (i < indices_size % thread_num ? 1 : 0);
+      segment_offsets[i + 1] = segment_offsets[i] + segment_size;
     }
+
+    // segment_bucket_offsets[i * thread_num + j] is the size, and then the write offset, of segment i in bucket j.
+    std::vector<size_t> segment_bucket_offsets(thread_num * thread_num, 0);
     std::vector<common::Task> tasks;
     tasks.reserve(thread_num);
-    current_indices_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
-      auto task = [&param, &segments, &each_thread_buckets, i, current_indices_offset]() {
-        CopySegmentIndicesToBucket<T>(param, segments[i], current_indices_offset, each_thread_buckets[i]);
+      auto task = [&param, &segment_offsets, &segment_bucket_offsets, i]() {
+        size_t *bucket_sizes = segment_bucket_offsets.data() + i * param.thread_num_;
+        const T *indices = param.input_grad_->indices_;
+        for (size_t k = segment_offsets[i]; k < segment_offsets[i + 1]; ++k) {
+          if (IsValidIndex(indices[k], param.max_index_)) {
+            bucket_sizes[GetBucketId(param, indices[k])]++;
+          }
+        }
         return common::SUCCESS;
       };
       (void)tasks.emplace_back(task);
-      current_indices_offset += segments[i]->indices_size_;
     }
     ParallelLaunch(tasks);
-  }
 
-  template <typename T>
-  static void SortAndReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                                const std::shared_ptr<BucketSparseGradient<T>> &bucket,
-                                                const std::shared_ptr<SparseGradient<T>> &reduced_bucket) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(bucket);
-    MS_EXCEPTION_IF_NULL(bucket->value_);
-    MS_EXCEPTION_IF_NULL(bucket->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
-    std::vector<std::pair<T, T>> sorted_indices;
-    sorted_indices.reserve(bucket->indices_size_);
-    for (size_t i = 0; i < bucket->indices_size_; ++i) {
-      T index = bucket->indices_[i];
-      T global_index = bucket->global_indices_[i];
-      (void)sorted_indices.emplace_back(std::pair<T, T>(index, global_index));
+    bucket_offsets.assign(thread_num + 1, 0);
+    size_t offset = 0;
+    for (size_t j = 0; j < thread_num; ++j) {
+      bucket_offsets[j] = offset;
+      for (size_t i = 0; i < thread_num; ++i) {
+        size_t size = segment_bucket_offsets[i * thread_num + j];
+        segment_bucket_offsets[i * thread_num + j] = offset;
+        offset += size;
+      }
     }
-    std::sort(sorted_indices.begin(), sorted_indices.end());
+    bucket_offsets[thread_num] = offset;
 
-    float *global_value = param.input_grad_->value_;
-    size_t unique_indices_size = 0;
-    size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-    T last_index{0};
-    size_t value_offset{0};
-    for (size_t i = 0; i < sorted_indices.size(); ++i) {
-      T index = sorted_indices[i].first;
-      T global_index = sorted_indices[i].second;
-      T global_value_offset = global_index * param.value_stride_;
-      if (i == 0 || index != last_index) {
-        if (i != 0) {
-          unique_indices_size++;
-        }
-        reduced_bucket->indices_[unique_indices_size] = index;
-        value_offset = unique_indices_size * param.value_stride_;
-        auto ret_code = memcpy_s(reduced_bucket->value_ + value_offset, (max_length - value_offset) * sizeof(float),
-                                 global_value + global_value_offset, param.value_stride_ * sizeof(float));
-        if (ret_code != EOK) {
-          MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
-        }
-      } else {
-        for (size_t j = 0; j < param.value_stride_; ++j) {
-          reduced_bucket->value_[value_offset + j] += global_value[global_value_offset + j];
+    tasks.clear();
+    for (size_t i = 0; i < thread_num; ++i) {
+      auto task = [&param, &segment_offsets, &segment_bucket_offsets, i]() {
+        size_t *write_offsets = segment_bucket_offsets.data() + i * param.thread_num_;
+        const T *indices = param.input_grad_->indices_;
+        T *bucket_indices = param.output_grad_->indices_;
+        T *bucket_positions = param.workspace_grad_->indices_;
+        for (size_t k = segment_offsets[i]; k < segment_offsets[i + 1]; ++k) {
+          T index = indices[k];
+          if (IsValidIndex(index, param.max_index_)) {
+            size_t write_offset = write_offsets[GetBucketId(param, index)]++;
+            bucket_indices[write_offset] = index;
+            bucket_positions[write_offset] = static_cast<T>(k);
+          }
         }
-      }
-      last_index = index;
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
     }
-    reduced_bucket->indices_size_ = unique_indices_size;
-    MS_LOG(DEBUG) << "End";
+    ParallelLaunch(tasks);
   }
 
-  template <typename T>
-  static void ReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                         const std::shared_ptr<BucketSparseGradient<T>> &bucket,
-                                         const std::shared_ptr<SparseGradient<T>> &reduced_bucket) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(bucket);
-    MS_EXCEPTION_IF_NULL(bucket->value_);
-    MS_EXCEPTION_IF_NULL(bucket->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
+  static void AddRow(float *dst, const float *src, size_t size) {
+    // Keep the loop simple so that it can be vectorized by the compiler.
+    for (size_t j = 0; j < size; ++j) {
+      dst[j] += src[j];
+    }
+  }
 
-    float *global_value = param.input_grad_->value_;
-    std::unordered_map<T, size_t> index_map;
-    size_t unique_indices_size = 0;
-    size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-    for (size_t i = 0; i < bucket->indices_size_; ++i) {
-      T index = bucket->indices_[i];
-      T global_index = bucket->global_indices_[i];
-      auto iter = index_map.find(index);
-      if (iter == index_map.end()) {
-        reduced_bucket->indices_[unique_indices_size] = index;
-        size_t start_index = unique_indices_size * param.value_stride_;
-        index_map[index] = start_index;
-        auto ret_code =
-          memcpy_s(reduced_bucket->value_ + start_index, (max_length - start_index) * sizeof(float),
-                   global_value + global_index * param.value_stride_, param.value_stride_ * sizeof(float));
-        if (ret_code != EOK) {
-          MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
+  // Sort the bucket [begin, end) by index and sum the rows of the same index. The reduced rows and unique indices are
+  // written to workspace_grad_ from begin, and the number of unique indices is returned.
+  template <typename T>
+  static size_t SortAndReduceBucket(const MultiThreadReduceSparseGradientParam<T> &param, size_t bucket_id,
+                                    size_t begin, size_t end) {
+    constexpr size_t kPositionBits = 32;
+    constexpr uint64_t kPositionMask = (static_cast<uint64_t>(1) << kPositionBits) - 1;
+    const float *input_value = param.input_grad_->value_;
+    const T *input_indices = param.input_grad_->indices_;
+    T *positions = param.workspace_grad_->indices_ + begin;
+    T *unique_indices = param.workspace_grad_->indices_ + begin;
+    float *unique_value = param.workspace_grad_->value_ + begin * param.value_stride_;
+    size_t size = end - begin;
+    size_t stride = param.value_stride_;
+    size_t unique_size = 0;
+    auto reduce_row = [&unique_size, &unique_indices, &unique_value, input_value, stride](T index, size_t position,
+                                                                                      bool is_new) {
+      const float *src = input_value + position * stride;
+      if (is_new) {
+        unique_indices[unique_size] = index;
+        auto ret = memcpy_s(unique_value + unique_size * stride, stride * sizeof(float), src, stride * sizeof(float));
+        if (ret != EOK) {
+          MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret;
         }
-        unique_indices_size++;
+        ++unique_size;
       } else {
-        size_t start_index = iter->second;
-        size_t end_index = start_index + param.value_stride_;
-        for (size_t j = start_index, k = global_index * param.value_stride_; j < end_index; ++j, ++k) {
-          reduced_bucket->value_[j] += global_value[k];
-        }
+        AddRow(unique_value + (unique_size - 1) * stride, src, stride);
+      }
+    };
+
+    size_t bucket_lower = param.bucket_bounds_[bucket_id];
+    size_t bucket_width = param.bucket_bounds_[bucket_id + 1] - bucket_lower;
+    if (bucket_width <= kPositionMask && param.input_grad_->indices_size_ <= kPositionMask) {
+      // Pack the index offset in the bucket and the position into one key, sorting the keys keeps the positions of
+      // the same index ascending. The buffer is kept by the thread to avoid allocating it every step.
+      thread_local std::vector<uint64_t> keys;
+      keys.resize(size);
+      const T *bucket_indices = param.output_grad_->indices_ + begin;
+      for (size_t i = 0; i < size; ++i) {
+        keys[i] = (static_cast<uint64_t>(LongToSize(bucket_indices[i]) - bucket_lower) << kPositionBits) |
+                  static_cast<uint64_t>(positions[i]);
+      }
+      std::sort(keys.begin(), keys.end());
+      for (size_t i = 0; i < size; ++i) {
+        uint64_t index_offset = keys[i] >> kPositionBits;
+        bool is_new = i == 0 || index_offset != (keys[i - 1] >> kPositionBits);
+        reduce_row(static_cast<T>(bucket_lower + index_offset), static_cast<size_t>(keys[i] & kPositionMask), is_new);
+      }
+    } else {
+      // The unique index i is written after position i has been read, so the positions can be reduced in place.
+      std::sort(positions, positions + size, [input_indices](T lhs, T rhs) {
+        return input_indices[lhs] < input_indices[rhs] || (input_indices[lhs] == input_indices[rhs] && lhs < rhs);
+      });
+      for (size_t i = 0; i < size; ++i) {
+        T position = positions[i];
+        T index = input_indices[position];
+        bool is_new = unique_size == 0 || index != unique_indices[unique_size - 1];
+        reduce_row(index, LongToSize(position), is_new);
       }
     }
-    reduced_bucket->indices_size_ = unique_indices_size;
-    MS_LOG(DEBUG) << "End";
+    return unique_size;
   }
 
   template <typename T>
-  static void ReduceBucketSparseGradientToWorkspace(
-    const MultiThreadReduceSparseGradientParam<T> &param,
-    const std::vector<std::shared_ptr<BucketSparseGradient<T>>> &buckets,
-    std::vector<std::shared_ptr<SparseGradient<T>>> *reduced_buckets_ptr) {
-    MS_EXCEPTION_IF_NULL(param.workspace_grad_);
+  static void SortAndReduceBucketToWorkspace(const MultiThreadReduceSparseGradientParam<T> &param,
+                                             const std::vector<size_t> &bucket_offsets,
+                                             std::vector<size_t> *unique_sizes_ptr) {
+    MS_EXCEPTION_IF_NULL(param.input_grad_->value_);
     MS_EXCEPTION_IF_NULL(param.workspace_grad_->value_);
-    MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
-    auto &reduced_buckets = *reduced_buckets_ptr;
-    size_t thread_num = buckets.size();
+    MS_EXCEPTION_IF_NULL(unique_sizes_ptr);
+    auto &unique_sizes = *unique_sizes_ptr;
     std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
-
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      (void)reduced_buckets.emplace_back(std::make_shared<SparseGradient<T>>());
-      reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
-      reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-      reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-      auto task = [&param, &buckets, &reduced_buckets, i]() {
-        if (param.use_sort_reduce_) {
-          SortAndReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
-        } else {
-          ReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
-        }
+    tasks.reserve(param.thread_num_);
+    for (size_t i = 0; i < param.thread_num_; ++i) {
+      auto task = [&param, &bucket_offsets, &unique_sizes, i]() {
+        unique_sizes[i] = SortAndReduceBucket<T>(param, i, bucket_offsets[i], bucket_offsets[i + 1]);
         return common::SUCCESS;
       };
       (void)tasks.emplace_back(task);
-      current_indices_offset += buckets[i]->indices_size_;
     }
     ParallelLaunch(tasks);
   }
 
   template <typename T>
   static void MergeReduceSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                        const std::vector<std::shared_ptr<SparseGradient<T>>> &reduced_buckets) {
-    MS_EXCEPTION_IF_NULL(param.output_grad_);
+                                        const std::vector<size_t> &bucket_offsets,
+                                        const std::vector<size_t> &unique_sizes) {
     auto output_grad = param.output_grad_;
     MS_EXCEPTION_IF_NULL(output_grad->value_);
     MS_EXCEPTION_IF_NULL(output_grad->indices_);
     size_t stride_data_size = param.value_stride_ * sizeof(float);
-    size_t unique_indices_size = 0;
-    for (size_t i = 0; i < reduced_buckets.size(); ++i) {
-      auto &bucket = reduced_buckets[i];
-      MS_EXCEPTION_IF_NULL(bucket);
-      if (bucket->indices_size_ == 0) {
+    std::vector<size_t> output_offsets(unique_sizes.size() + 1, 0);
+    for (size_t i = 0; i < unique_sizes.size(); ++i) {
+      output_offsets[i + 1] = output_offsets[i] + unique_sizes[i];
+    }
+    std::vector<common::Task> tasks;
+    tasks.reserve(unique_sizes.size());
+    for (size_t i = 0; i < unique_sizes.size(); ++i) {
+      if (unique_sizes[i] == 0) {
         continue;
       }
-      auto ret_code = memcpy_s(output_grad->value_ + unique_indices_size * param.value_stride_,
-                               (output_grad->indices_size_ - unique_indices_size) * stride_data_size, bucket->value_,
-                               bucket->indices_size_ * stride_data_size);
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
-      }
-      ret_code = memcpy_s(output_grad->indices_ + unique_indices_size,
-                          (output_grad->indices_size_ - unique_indices_size) * sizeof(T), bucket->indices_,
-                          bucket->indices_size_ * sizeof(T));
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
-      }
-      unique_indices_size += bucket->indices_size_;
+      auto task = [&param, &bucket_offsets, &unique_sizes, &output_offsets, stride_data_size, i]() {
+        auto output_grad = param.output_grad_;
+        size_t output_offset = output_offsets[i];
+        size_t bucket_offset = bucket_offsets[i];
+        auto ret_code = memcpy_s(output_grad->value_ + output_offset * param.value_stride_,
+                                 (output_grad->indices_size_ - output_offset) * stride_data_size,
+                                 param.workspace_grad_->value_ + bucket_offset * param.value_stride_,
+                                 unique_sizes[i] * stride_data_size);
+        if (ret_code != EOK) {
+          MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
+        }
+        ret_code =
+          memcpy_s(output_grad->indices_ + output_offset, (output_grad->indices_size_ - output_offset) * sizeof(T),
+                   param.workspace_grad_->indices_ + bucket_offset, unique_sizes[i] * sizeof(T));
+        if (ret_code != EOK) {
+          MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
     }
-    output_grad->indices_size_ = unique_indices_size;
+    ParallelLaunch(tasks);
+    output_grad->indices_size_ = output_offsets.back();
   }
 
  protected:
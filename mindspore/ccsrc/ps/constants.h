@@ -40,6 +40,8 @@ constexpr char kEnvSchedulerHost[] = "MS_SCHED_HOST";
 constexpr char kEnvSchedulerPort[] = "MS_SCHED_PORT";
 constexpr char kEnvSchedulerManagePort[] = "MS_SCHED_MANAGE_PORT";
 constexpr char kEnvNodeId[] = "MS_NODE_ID";
+// Set to "async_log_file" to persist the embedding tables by the asynchronous log segments instead of the block files.
+constexpr char kEnvEmbeddingStorageType[] = "MS_EMBEDDING_STORAGE_TYPE";
 
 constexpr char kCommTypeOfIBVerbs[] = "ibverbs";
 constexpr char kRoleOfPServer[] = "server";
@@ -65,6 +67,7 @@ constexpr char kCAcrt[] = "ca.crt";
 constexpr char kKeys[] = "keys";
 constexpr char kShapes[] = "shapes";
 constexpr char kParamNames[] = "param_names";
+constexpr char kEmbeddingStorageType[] = "embedding_storage_type";
 constexpr char kRecoverFunc[] = "recover_function";
 constexpr char kRecoverEmbedding[] = "RecoverEmbedding";
 constexpr char kCurrentDirOfServer[] = "./server_";
@@ -255,6 +255,15 @@ void ParameterServer::PersistKernels(const Key &key,
     config_storage->PutValue(kRecoverFunc, recover_funcs);
   }
 
+  // The storage type is decided once by the first persisted kernel of a job, so the recovered tables are always read
+  // by the storage which wrote them. The asynchronous log storage is opt-in, the block files are used by default.
+  if (!config_storage->Exists(kEmbeddingStorageType) && !config_storage->Exists(kKeys)) {
+    std::string storage_type = common::GetEnv(kEnvEmbeddingStorageType) == distributed::storage::kAsyncLogFileStorage
+                                 ? distributed::storage::kAsyncLogFileStorage
+                                 : distributed::storage::kLocalFileStorage;
+    config_storage->PutValue(kEmbeddingStorageType, storage_type);
+  }
+
   // Persist key.
   std::vector<Key> keys;
   if (config_storage->Exists(kKeys)) {
@@ -312,6 +321,7 @@ void ParameterServer::PersistInitParameters(const Key &key, const WeightPtr &par
   MS_EXCEPTION_IF_NULL(persistent_weight);
   std::map<std::string, std::string> config_map;
   config_map[distributed::storage::kFileStoragePath] = real_storage_file_path;
+  config_map[distributed::storage::kStorageType] = GetEmbeddingStorageType();
   persistent_weight->Initialize(config_map);
 
   (void)weights_dirty_info_.emplace(key, distributed::storage::DirtyInfo());
@@ -767,6 +777,7 @@ void ParameterServer::RecoverParameters(const std::vector<Key> &keys) {
 
       std::map<std::string, std::string> config_map;
       config_map[distributed::storage::kFileStoragePath] = real_storage_file_path;
+      config_map[distributed::storage::kStorageType] = GetEmbeddingStorageType();
       embedding->Initialize(config_map);
       embedding->Restore();
       weights_[key] = embedding;
@@ -775,6 +786,17 @@ void ParameterServer::RecoverParameters(const std::vector<Key> &keys) {
   }
 }
 
+std::string ParameterServer::GetEmbeddingStorageType() const {
+  MS_EXCEPTION_IF_NULL(recover_handler_);
+  auto *config_storage = recover_handler_->config_storage();
+  MS_EXCEPTION_IF_NULL(config_storage);
+  if (config_storage->Exists(kEmbeddingStorageType)) {
+    return config_storage->GetValue<std::string>(kEmbeddingStorageType);
+  }
+  // The jobs persisted without the storage type only have the local file storage.
+  return distributed::storage::kLocalFileStorage;
+}
+
 void ParameterServer::RecoverEmbedding(const std::vector<Key> &keys,
                                        const std::vector<std::vector<ShapeVector>> &shapes_list,
                                        const std::vector<std::string> &param_names) {
@@ -811,25 +833,34 @@ void ParameterServer::PersistParameters() {
   }
 
   auto do_persist_task = [this]() {
-    std::unique_lock<std::mutex> locker(access_weight_mutex_);
+    std::vector<PersistentWeightPtr> persistent_weights;
+    {
+      std::unique_lock<std::mutex> locker(access_weight_mutex_);
 
-    set_persistent_state(core::PersistentState::PERSISTING);
+      set_persistent_state(core::PersistentState::PERSISTING);
 
-    for (const auto &weight_key_pair : weights_) {
-      const WeightPtr &weight = weight_key_pair.second;
-      auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weight);
-      MS_EXCEPTION_IF_NULL(persistent_weight);
+      for (const auto &weight_key_pair : weights_) {
+        const WeightPtr &weight = weight_key_pair.second;
+        auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weight);
+        MS_EXCEPTION_IF_NULL(persistent_weight);
 
-      Key key = weight_key_pair.first;
-      auto iter = weights_dirty_info_.find(key);
-      if (iter == weights_dirty_info_.end()) {
-        MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
-      }
+        Key key = weight_key_pair.first;
+        auto iter = weights_dirty_info_.find(key);
+        if (iter == weights_dirty_info_.end()) {
+          MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
+        }
 
-      distributed::storage::DirtyInfo &dirty_info = iter->second;
-      persistent_weight->Persist(dirty_info);
+        distributed::storage::DirtyInfo &dirty_info = iter->second;
+        persistent_weight->Persist(dirty_info);
+        persistent_weights.push_back(persistent_weight);
+
+        dirty_info.clear();
+      }
+    }
 
-      dirty_info.clear();
+    // The storage takes snapshots of the dirty rows, so the weights can be updated while the snapshots are written.
+    for (const auto &persistent_weight : persistent_weights) {
+      persistent_weight->Flush();
     }
 
     set_persistent_state(core::PersistentState::FINISH_PERSIST);
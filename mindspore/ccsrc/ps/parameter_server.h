@@ -181,6 +181,9 @@ class BACKEND_EXPORT ParameterServer {
   // Persist parameters store in parameter server when receive init message.
   void PersistInitParameters(const Key &key, const WeightPtr &param);
 
+  // Get the type of storage which the embedding tables of this job are persisted by.
+  std::string GetEmbeddingStorageType() const;
+
   // Restore sparse network operators and parameters.
   void RecoverEmbedding(const std::vector<Key> &keys, const std::vector<std::vector<ShapeVector>> &shapes_list,
                         const std::vector<std::string> &param_names);
@@ -20,9 +20,16 @@
 namespace mindspore {
 namespace device {
 const size_t kTimeout = 100;
+const size_t kFrontTimeoutInSec = 30;
 void BlockingQueue::RegisterRelease(const std::function<void(void *, int32_t)> &func) { queue_->RegisterRelease(func); }
 
 BlockQueueStatus_T BlockingQueue::Push(const std::vector<DataQueueItem> &data, unsigned int) {
+  if (lock_free_queue_ != nullptr) {
+    if (!lock_free_queue_->WaitNotFull(std::chrono::microseconds(kTimeout))) {
+      return TIMEOUT;
+    }
+    return lock_free_queue_->Push(data);
+  }
   std::unique_lock<std::mutex> locker(mutex_);
   if (queue_->IsFull()) {
     if (not_full_cond_.wait_for(locker, std::chrono::microseconds(kTimeout)) == std::cv_status::timeout) {
@@ -38,6 +45,12 @@ BlockQueueStatus_T BlockingQueue::Push(const std::vector<DataQueueItem> &data, u
 }
 
 BlockQueueStatus_T BlockingQueue::Front(std::vector<DataQueueItem> *data) {
+  if (lock_free_queue_ != nullptr) {
+    if (!lock_free_queue_->WaitNotEmpty(std::chrono::seconds(kFrontTimeoutInSec))) {
+      return TIMEOUT;
+    }
+    return lock_free_queue_->Front(data);
+  }
   std::unique_lock<std::mutex> locker(mutex_);
   bool timeout = not_empty_cond_.wait_for(locker, std::chrono::seconds(30), [this] { return !queue_->IsEmpty(); });
   if (!timeout) {
@@ -47,6 +60,12 @@ BlockQueueStatus_T BlockingQueue::Front(std::vector<DataQueueItem> *data) {
 }
 
 BlockQueueStatus_T BlockingQueue::Pop() {
+  if (lock_free_queue_ != nullptr) {
+    while (!lock_free_queue_->WaitNotEmpty(std::chrono::seconds(kFrontTimeoutInSec))) {
+      MS_LOG(DEBUG) << "Wait for the data of lock free queue to pop.";
+    }
+    return lock_free_queue_->Pop();
+  }
   std::unique_lock<std::mutex> locker(mutex_);
   not_empty_cond_.wait(locker, [this] { return !queue_->IsEmpty(); });
   auto ret = queue_->Pop();
@@ -59,9 +78,11 @@ BlockQueueStatus_T BlockingQueue::Pop() {
 
 BlockQueueStatus_T BlockingQueue::Create(const std::shared_ptr<DataQueue> &data_queue) {
   this->queue_ = data_queue;
+  this->lock_free_queue_ = std::dynamic_pointer_cast<LockFreeDataQueue>(data_queue);
   return SUCCESS;
 }
 
+// The lock free data queue is cleared when the consumer doesn't pop the data concurrently.
 BlockQueueStatus_T BlockingQueue::Clear() {
   std::unique_lock<std::mutex> locker(mutex_);
   while (Size() > 0) {
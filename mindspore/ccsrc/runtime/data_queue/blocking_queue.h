@@ -26,6 +26,7 @@
 #include <condition_variable>
 #include <functional>
 #include "runtime/data_queue/data_queue.h"
+#include "runtime/data_queue/lock_free_data_queue.h"
 namespace mindspore {
 namespace device {
 class BlockingQueue {
@@ -48,6 +49,8 @@ class BlockingQueue {
   std::condition_variable not_full_cond_;
   std::condition_variable not_empty_cond_;
   std::shared_ptr<DataQueue> queue_;
+  // The lock free data queue is pushed and popped without the mutex, see LockFreeDataQueue.
+  std::shared_ptr<LockFreeDataQueue> lock_free_queue_{nullptr};
 };
 }  // namespace device
 }  // namespace mindspore
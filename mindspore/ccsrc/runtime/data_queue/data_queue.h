@@ -45,6 +45,10 @@ class DataQueue {
   virtual size_t Capacity() { return capacity_; }
 
  protected:
+  // The derived queue which doesn't use the device context of current device target, such as the host queue.
+  DataQueue(const size_t capacity, DeviceContext *device_context)
+      : head_(0), tail_(0), size_(0), capacity_(capacity), device_context_(device_context) {}
+
   size_t head_;
   size_t tail_;
   size_t size_;
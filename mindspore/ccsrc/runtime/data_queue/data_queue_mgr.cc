@@ -19,6 +19,8 @@
 #include "plugin/device/gpu/hal/device/gpu_data_queue.h"
 #elif ENABLE_D
 #include "plugin/device/ascend/hal/device/ascend_data_queue.h"
+#elif ENABLE_CPU
+#include "plugin/device/cpu/hal/device/cpu_data_queue.h"
 #endif
 #include <algorithm>
 #include <utility>
@@ -107,11 +109,15 @@ BlockQueueStatus_T DataQueueMgr::CreateDynamicBufQueue(const std::string &channe
 #elif ENABLE_D
   std::shared_ptr<BlockingQueue> queue = std::make_shared<BlockingQueue>();
   std::shared_ptr<DataQueue> device_queue = std::make_shared<AscendDataQueueDynamic>(capacity);
+#elif ENABLE_CPU
+  // The lock free data queue for the single producer of dataset and the single consumer of data kernel.
+  std::shared_ptr<BlockingQueue> queue = std::make_shared<BlockingQueue>();
+  std::shared_ptr<DataQueue> device_queue = std::make_shared<CpuDataQueueDynamic>(capacity);
 #else
-  MS_LOG(ERROR) << "Dynamic data queue only support Ascend/GPU target.";
+  MS_LOG(ERROR) << "Dynamic data queue only support Ascend/GPU/CPU target.";
   return QUEUE_EXIST;
 #endif
-#if ENABLE_GPU || ENABLE_D
+#if ENABLE_GPU || ENABLE_D || ENABLE_CPU
   BlockQueueStatus_T rt = queue->Create(device_queue);
   if (rt != SUCCESS) {
     MS_LOG(ERROR) << "Queue: " << channel_name << "create failed: " << rt;
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/data_queue/lock_free_data_queue.h"
+#include <thread>
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The data of one step usually arrives within the spinning, otherwise the thread is parked to release the cpu.
+constexpr size_t kMaxBusySpinCount = 1000;
+constexpr size_t kMaxYieldSpinCount = 2000;
+}  // namespace
+
+LockFreeDataQueue::LockFreeDataQueue(const size_t capacity, DeviceContext *device_context)
+    : DataQueue(capacity, device_context), slots_(capacity) {
+  if (capacity == 0) {
+    MS_LOG(EXCEPTION) << "The capacity of data queue can't be zero.";
+  }
+}
+
+BlockQueueStatus_T LockFreeDataQueue::Push(std::vector<DataQueueItem> data) {
+  auto tail = tail_index_.load(std::memory_order_relaxed);
+  if (tail - head_index_.load(std::memory_order_acquire) >= capacity_) {
+    MS_LOG(ERROR) << "The data queue is full, capacity: " << capacity_;
+    return INTERNAL_ERROR;
+  }
+  auto ret = CopyToDevice(&data);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  slots_[tail % capacity_] = std::move(data);
+  // Publish the slot to the consumer.
+  tail_index_.store(tail + 1, std::memory_order_seq_cst);
+  Notify();
+  return SUCCESS;
+}
+
+BlockQueueStatus_T LockFreeDataQueue::Front(std::vector<DataQueueItem> *data) const {
+  MS_EXCEPTION_IF_NULL(data);
+  auto head = head_index_.load(std::memory_order_relaxed);
+  if (head == tail_index_.load(std::memory_order_acquire)) {
+    MS_LOG(ERROR) << "The data queue is empty.";
+    return INTERNAL_ERROR;
+  }
+  const auto &slot = slots_[head % capacity_];
+  if (host_release_) {
+    for (auto &item : slot) {
+      host_release_(item.data_ptr_, item.worker_id_);
+    }
+  }
+  *data = slot;
+  return SUCCESS;
+}
+
+BlockQueueStatus_T LockFreeDataQueue::Pop() {
+  auto head = head_index_.load(std::memory_order_relaxed);
+  if (head == tail_index_.load(std::memory_order_acquire)) {
+    MS_LOG(ERROR) << "The data queue is empty.";
+    return INTERNAL_ERROR;
+  }
+  slots_[head % capacity_].clear();
+  // Return the slot to the producer.
+  head_index_.store(head + 1, std::memory_order_seq_cst);
+  Notify();
+  return SUCCESS;
+}
+
+bool LockFreeDataQueue::WaitNotFull(const std::chrono::microseconds &timeout) {
+  return Wait([this]() { return !IsFull(); }, timeout);
+}
+
+bool LockFreeDataQueue::WaitNotEmpty(const std::chrono::microseconds &timeout) {
+  return Wait([this]() { return !IsEmpty(); }, timeout);
+}
+
+bool LockFreeDataQueue::Wait(const std::function<bool()> &is_ready, const std::chrono::microseconds &timeout) {
+  for (size_t i = 0; i < kMaxYieldSpinCount; ++i) {
+    if (is_ready()) {
+      return true;
+    }
+    if (i >= kMaxBusySpinCount) {
+      std::this_thread::yield();
+    }
+  }
+
+  // The parked number is increased before checking the condition and the index is updated before checking the parked
+  // number in the notify, so the notification can't be lost.
+  std::unique_lock<std::mutex> locker(park_mutex_);
+  (void)parked_num_.fetch_add(1, std::memory_order_seq_cst);
+  bool ret = park_cond_.wait_for(locker, timeout, is_ready);
+  (void)parked_num_.fetch_sub(1, std::memory_order_seq_cst);
+  return ret;
+}
+
+void LockFreeDataQueue::Notify() {
+  if (parked_num_.load(std::memory_order_seq_cst) == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(park_mutex_);
+  park_cond_.notify_all();
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_LOCK_FREE_DATA_QUEUE_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_LOCK_FREE_DATA_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "runtime/data_queue/data_queue.h"
+
+namespace mindspore {
+namespace device {
+constexpr size_t kQueueCacheLineSize = 64;
+
+// The ring buffer data queue for one producer and one consumer, the push and pop don't need the lock of the blocking
+// queue. The waiting for the queue spins firstly and then parks the thread until the other side notifies.
+class LockFreeDataQueue : public DataQueue {
+ public:
+  LockFreeDataQueue(const size_t capacity, DeviceContext *device_context);
+  ~LockFreeDataQueue() override = default;
+
+  bool IsEmpty() const override { return GetSize() == 0; }
+  bool IsFull() const override { return GetSize() >= capacity_; }
+  size_t Size() override { return GetSize(); }
+
+  // Called by the producer only when the queue is not full.
+  BlockQueueStatus_T Push(std::vector<DataQueueItem> data) override;
+  // Called by the consumer only when the queue is not empty.
+  BlockQueueStatus_T Front(std::vector<DataQueueItem> *data) const override;
+  BlockQueueStatus_T Pop() override;
+  bool Destroy() override { return true; }
+
+  // Wait until the queue is not full or not empty, return false if timeout.
+  bool WaitNotFull(const std::chrono::microseconds &timeout);
+  bool WaitNotEmpty(const std::chrono::microseconds &timeout);
+
+ protected:
+  // Copy the data to the device memory and set the device address of items before the data is visible to the consumer.
+  virtual BlockQueueStatus_T CopyToDevice(std::vector<DataQueueItem> *) { return SUCCESS; }
+
+ private:
+  size_t GetSize() const {
+    return tail_index_.load(std::memory_order_acquire) - head_index_.load(std::memory_order_acquire);
+  }
+  bool Wait(const std::function<bool()> &is_ready, const std::chrono::microseconds &timeout);
+  void Notify();
+
+  std::vector<std::vector<DataQueueItem>> slots_;
+  // The head is only written by the consumer and the tail is only written by the producer. They are the monotonic
+  // counters in the different cache lines to avoid the false sharing between the producer and consumer.
+  alignas(kQueueCacheLineSize) std::atomic<size_t> head_index_{0};
+  alignas(kQueueCacheLineSize) std::atomic<size_t> tail_index_{0};
+  alignas(kQueueCacheLineSize) std::atomic<size_t> parked_num_{0};
+  std::mutex park_mutex_;
+  std::condition_variable park_cond_;
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_LOCK_FREE_DATA_QUEUE_H_
@@ -18,9 +18,16 @@
 #include <memory>
 #include <vector>
 #include <queue>
+#include <tuple>
+#include <algorithm>
 
 namespace mindspore {
 namespace device {
+namespace {
+// The index of memory key in the tuple of offload candidate.
+constexpr size_t kOffloadKeyIndex = 2;
+}  // namespace
+
 void *MemHandler::MallocHost(size_t mem_size) {
   auto &mem_que = cached_host_mem_[mem_size];
   if (!mem_que.empty()) {
@@ -85,6 +92,7 @@ void *AutoMemoryOffload::Get(const void *key, void *stream, const HashSet<const
     return nullptr;
   }
   mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+  swap_in_size_ += mem_size;
   if (!from_init) {
     (void)swap_host_ptr_.erase(key);
     mem_handler_->FreeHost(host_ptr);
@@ -93,6 +101,63 @@ void *AutoMemoryOffload::Get(const void *key, void *stream, const HashSet<const
   return device_ptr;
 }
 
+bool AutoMemoryOffload::Prefetch(const void *key, void *stream) {
+  if (mem_result_.find(key) != mem_result_.end()) {
+    return false;
+  }
+  void *host_ptr = nullptr;
+  bool from_init = false;
+  GetHostPtr(key, &host_ptr, &from_init);
+  if (host_ptr == nullptr) {
+    return false;
+  }
+  const auto mem_size = GetMemSize(key);
+  auto device_ptr = mem_handler_->MallocDevice(mem_size);
+  if (device_ptr == nullptr) {
+    return false;
+  }
+  mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+  swap_in_size_ += mem_size;
+  if (!from_init) {
+    (void)swap_host_ptr_.erase(key);
+    prefetch_host_ptrs_.push_back(host_ptr);
+  }
+  mem_result_[key] = device_ptr;
+  return true;
+}
+
+void AutoMemoryOffload::FreePrefetchHostMem() {
+  for (auto host_ptr : prefetch_host_ptrs_) {
+    mem_handler_->FreeHost(host_ptr);
+  }
+  prefetch_host_ptrs_.clear();
+}
+
+bool AutoMemoryOffload::OffloadByNextUse(void *stream, const HashSet<const void *> &not_offload,
+                                         bool skip_continuous_mem, const std::function<bool()> &malloc_func) {
+  MS_EXCEPTION_IF_NULL(next_use_getter_);
+  // The tuple of next use distance, memory size and key, the farthest and largest memory is offloaded first.
+  std::vector<std::tuple<size_t, size_t, const void *>> mem_can_offload;
+  for (const auto &mem : mem_result_) {
+    const auto offload_key = mem.first;
+    if (not_offload.count(offload_key) != 0 || (skip_continuous_mem && continuous_mem_key_.count(offload_key) != 0)) {
+      continue;
+    }
+    (void)mem_can_offload.emplace_back(next_use_getter_(offload_key), GetMemSize(offload_key), offload_key);
+  }
+  std::sort(mem_can_offload.begin(), mem_can_offload.end(),
+            [](const auto &a, const auto &b) -> bool { return a > b; });
+  for (const auto &mem : mem_can_offload) {
+    const auto offload_key = std::get<kOffloadKeyIndex>(mem);
+    (void)SwapOut(offload_key, stream);
+    Free(offload_key);
+    if (malloc_func()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::vector<void *> AutoMemoryOffload::MallocContinuous(const std::vector<const void *> &keys,
                                                         const std::vector<size_t> &size_list, void *stream,
                                                         const HashSet<const void *> &not_offload) {
@@ -105,6 +170,21 @@ std::vector<void *> AutoMemoryOffload::MallocContinuous(const std::vector<const
     }
     return device_ptr;
   }
+  if (next_use_getter_ != nullptr) {
+    auto malloc_func = [this, &size_list, &keys, &device_ptr]() -> bool {
+      device_ptr = mem_handler_->MallocContinuousMemFromMemPool(size_list);
+      return device_ptr.size() == keys.size();
+    };
+    if (!OffloadByNextUse(stream, not_offload, true, malloc_func)) {
+      return {};
+    }
+    for (size_t i = 0; i < keys.size(); i += 1) {
+      mem_result_[keys[i]] = device_ptr[i];
+      mem_size_[keys[i]] = size_list[i];
+      continuous_mem_key_.insert(keys[i]);
+    }
+    return device_ptr;
+  }
   const size_t total_size = std::accumulate(size_list.begin(), size_list.end(), 0);
   using KeySizePair = std::pair<const void *, size_t>;
   auto less = [](const KeySizePair &a, const KeySizePair &b) -> bool { return a.second < b.second; };
@@ -165,6 +245,18 @@ void *AutoMemoryOffload::Malloc(const void *key, size_t mem_size, void *stream,
     mem_size_[key] = mem_size;
     return device_ptr;
   }
+  if (next_use_getter_ != nullptr) {
+    auto malloc_func = [this, mem_size, &device_ptr]() -> bool {
+      device_ptr = mem_handler_->MallocDevice(mem_size);
+      return device_ptr != nullptr;
+    };
+    if (!OffloadByNextUse(stream, not_offload, false, malloc_func)) {
+      return nullptr;
+    }
+    mem_result_[key] = device_ptr;
+    mem_size_[key] = mem_size;
+    return device_ptr;
+  }
   using KeySizePair = std::pair<const void *, size_t>;
   auto less = [](const KeySizePair &a, const KeySizePair &b) -> bool { return a.second < b.second; };
   std::priority_queue<KeySizePair, std::vector<KeySizePair>, decltype(less)> mem_can_offload(less);
@@ -220,6 +312,7 @@ void *AutoMemoryOffload::SwapOut(const void *key, void *stream) {
   auto updated_iter = from_init ? updated_device_mem_.find(key) : updated_device_mem_.end();
   if (!from_init || updated_iter != updated_device_mem_.end()) {
     mem_handler_->SwapOut(device_ptr, host_ptr, mem_size, stream);
+    swap_out_size_ += mem_size;
     if (updated_iter != updated_device_mem_.end()) {
       (void)updated_device_mem_.erase(updated_iter);
     }
@@ -238,6 +331,7 @@ void *AutoMemoryOffload::SwapIn(const void *key, void *stream) {
   GetHostPtr(key, &host_ptr, &from_init);
   MS_EXCEPTION_IF_NULL(host_ptr);
   mem_handler_->SwapIn(host_ptr, iter->second, mem_size, stream);
+  swap_in_size_ += mem_size;
   if (!from_init) {
     mem_handler_->FreeHost(host_ptr);
     (void)swap_host_ptr_.erase(key);
@@ -295,6 +389,7 @@ void AutoMemoryOffload::Clear() {
     }
   }
   swap_host_ptr_.clear();
+  FreePrefetchHostMem();
   init_host_ptr_.clear();
   init_from_host_keys_.clear();
 }
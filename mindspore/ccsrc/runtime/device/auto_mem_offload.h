@@ -21,6 +21,7 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <functional>
 
 #include "runtime/device/memory_manager.h"
 #include "utils/hash_map.h"
@@ -55,6 +56,9 @@ class MemHandler {
 
 class AutoMemoryOffload {
  public:
+  // Return the distance to the next use of memory key, which is used to choose the memory to offload.
+  using NextUseGetter = std::function<size_t(const void *key)>;
+
   explicit AutoMemoryOffload(std::shared_ptr<MemHandler> mem_handler) : mem_handler_(std::move(mem_handler)) {}
   ~AutoMemoryOffload() = default;
   void *Get(const void *key, void *stream = nullptr, const HashSet<const void *> &not_offload = {});
@@ -70,8 +74,26 @@ class AutoMemoryOffload {
   void *SwapOut(const void *key, void *stream);
   // Return the device ptr where the data is copied to
   void *SwapIn(const void *key, void *stream);
+  // Swap in the memory ahead of use without offloading the other memory, return true if the swap in is issued.
+  bool Prefetch(const void *key, void *stream);
+  // Free the host memory copied by the prefetch, which must be called after the copies are ordered before the later
+  // copies, since the freed host memory is reused by them.
+  void FreePrefetchHostMem();
+
+  // The memory used farthest in the future is offloaded first when the getter is set, otherwise the largest one.
+  void set_next_use_getter(const NextUseGetter &next_use_getter) { next_use_getter_ = next_use_getter; }
+
+  size_t swap_in_size() const { return swap_in_size_; }
+  size_t swap_out_size() const { return swap_out_size_; }
+  void ResetSwapSize() {
+    swap_in_size_ = 0;
+    swap_out_size_ = 0;
+  }
 
  private:
+  // Offload the memory in the order of next use distance until the malloc function succeeds.
+  bool OffloadByNextUse(void *stream, const HashSet<const void *> &not_offload, bool skip_continuous_mem,
+                        const std::function<bool()> &malloc_func);
   size_t GetMemSize(const void *key);
   void GetHostPtr(const void *key, void **host_ptr, bool *from_init);
   void GetOrMallocHostPtr(const void *key, size_t mem_size, void **host_ptr, bool *from_init);
@@ -83,6 +105,10 @@ class AutoMemoryOffload {
   HashSet<const void *> continuous_mem_key_;
   HashMap<const void *, void *> init_host_ptr_;
   HashMap<const void *, void *> swap_host_ptr_;
+  std::vector<void *> prefetch_host_ptrs_;
+  NextUseGetter next_use_getter_{nullptr};
+  size_t swap_in_size_{0};
+  size_t swap_out_size_{0};
 };
 }  // namespace device
 }  // namespace mindspore
@@ -59,6 +59,7 @@ class KernelInfo : public KernelInfoDevice {
   bool SetWorkspaceAddr(const DeviceAddressPtr &output_address, size_t index);
   void set_kernel_mod(const kernel::KernelModPtr &kernel_mod);
   kernel::KernelMod *MutableKernelMod() const;
+  const kernel::KernelModPtr &GetKernelModPtr() const { return kernel_mod_; }
   const kernel::KernelMod *kernel_mod() const;
   uint32_t stream_id() const { return stream_id_; }
   void set_stream_id(uint32_t stream_id) { stream_id_ = stream_id; }
@@ -1830,6 +1830,7 @@ void KernelRuntime::UseMemSchedulerIfNeeded(const session::KernelGraph &graph) {
     return;
   }
   mem_scheduler->SetMemHandler(std::make_shared<MemHandler>(mem_manager_));
+  mem_scheduler->SetPrefetchStream(GetOrCreateCopyStream(), CreateDeviceEvent(), CreateDeviceEvent());
   mem_scheduler->SetTotalStep(graph.execution_order().size());
 
   if (mem_scheduler->need_record_event()) {
@@ -124,6 +124,8 @@ class KernelRuntime {
   virtual DeviceType GetTargetDeviceType() const = 0;
   virtual void *compute_stream() const { return nullptr; }
   virtual void *communication_stream() const { return nullptr; }
+  // The stream of the memory copies which run in parallel with the kernels, such as the prefetch of memory offload.
+  virtual void *GetOrCreateCopyStream() { return nullptr; }
   void UpdateRefNodeOutputMem(const session::KernelGraph &graph) const;
   virtual DeviceAddressPtr AssignExtraStaticMem(const TensorPtr &tensor, const AnfNodePtr &node, size_t index);
   virtual void *GetModelStream(uint32_t graph_id) const { return nullptr; }
@@ -151,6 +151,10 @@ bool MemScheduler::PreComputeMalloc(const std::shared_ptr<MemEvent> &event, void
 }
 
 bool MemScheduler::PreComputeSwapIn(const std::shared_ptr<MemEvent> &event, void *stream) {
+  // The memory prefetched in the previous steps is already on the device.
+  if (auto_mem_offload_->Get(event->key) != nullptr) {
+    return true;
+  }
   if (Malloc(event, stream) == nullptr) {
     return false;
   }
@@ -166,6 +170,11 @@ bool MemScheduler::PreCompute(void *stream) {
     return true;
   }
   MS_EXCEPTION_IF_NULL(mem_handler_);
+  const double pre_compute_start_time = optimized_ ? GetCurrentTime() : 0;
+  if (optimized_) {
+    CheckPrefetchHit();
+    WaitPrefetch(stream);
+  }
   auto &events = strategy_->GetPreComputeEvents(current_step_);
   for (auto &event : events) {
     MS_EXCEPTION_IF_NULL(event);
@@ -187,6 +196,14 @@ bool MemScheduler::PreCompute(void *stream) {
       return false;
     }
   }
+  if (optimized_) {
+    CurStepStatistics().pre_compute_time_ += GetCurrentTime() - pre_compute_start_time;
+    if (copy_stream_ != nullptr && stream != nullptr) {
+      // The prefetch issued after the kernel launch only waits for the kernels launched before this one.
+      kernel_event_->set_record_stream(stream);
+      kernel_event_->RecordEvent();
+    }
+  }
   if (record_compute_time_ && !updated_) {
     compute_start_time_ = GetCurrentTime();
   }
@@ -202,6 +219,11 @@ bool MemScheduler::PostCompute(void *stream) {
   if (record_compute_time_ && !updated_ && current_step_ < compute_time_.size()) {
     compute_time_[current_step_] = GetCurrentTime() - compute_start_time_;
   }
+  if (optimized_) {
+    // The kernel of this step has been launched, so the prefetch copies don't delay it. The prefetch is issued before
+    // the memory used by this kernel is freed, so that the prefetched memory is not reused from it.
+    Prefetch(stream);
+  }
   auto &events = strategy_->GetPostComputeEvents(current_step_);
   for (auto &event : events) {
     MS_EXCEPTION_IF_NULL(event);
@@ -211,10 +233,146 @@ bool MemScheduler::PostCompute(void *stream) {
     }
     auto_mem_offload_->Free(event->key);
   }
+  if (optimized_) {
+    auto &step_statistics = CurStepStatistics();
+    step_statistics.swap_in_size_ += auto_mem_offload_->swap_in_size();
+    step_statistics.swap_out_size_ += auto_mem_offload_->swap_out_size();
+    auto_mem_offload_->ResetSwapSize();
+  }
   ++current_step_;
+  if (optimized_ && current_step_ == total_step_) {
+    UpdateStatistics();
+  }
   return true;
 }
 
+void MemScheduler::InitUseSteps() {
+  use_steps_.clear();
+  for (size_t step = 0; step < step_keys_.size(); ++step) {
+    for (const auto &key : step_keys_[step]) {
+      (void)use_steps_[key].emplace_back(step);
+    }
+  }
+  // The offload order of memory follows the next use distance, which is the optimal one when all the memory has the
+  // same size.
+  auto_mem_offload_->set_next_use_getter([this](const void *key) { return GetNextUseDistance(key); });
+}
+
+size_t MemScheduler::GetNextUseDistance(const void *key) const {
+  const auto &iter = use_steps_.find(key);
+  if (iter == use_steps_.end() || iter->second.empty()) {
+    return SIZE_MAX;
+  }
+  const auto &steps = iter->second;
+  const auto &step_iter = std::lower_bound(steps.begin(), steps.end(), current_step_);
+  if (step_iter != steps.end()) {
+    return *step_iter - current_step_;
+  }
+  // The memory is used in the next run of graph.
+  return steps.front() + total_step_ - current_step_;
+}
+
+void MemScheduler::SetPrefetchStream(void *copy_stream, const std::shared_ptr<DeviceEvent> &kernel_event,
+                                     const std::shared_ptr<DeviceEvent> &prefetch_event) {
+  if (copy_stream == nullptr || kernel_event == nullptr || prefetch_event == nullptr) {
+    MS_LOG(INFO) << "The copy stream or events are not available, the prefetch is issued on the kernel stream.";
+    copy_stream_ = nullptr;
+    return;
+  }
+  copy_stream_ = copy_stream;
+  kernel_event_ = kernel_event;
+  kernel_event_->set_wait_stream(copy_stream_);
+  prefetch_event_ = prefetch_event;
+  prefetch_event_->set_record_stream(copy_stream_);
+}
+
+void MemScheduler::Prefetch(void *stream) {
+  if (stream == nullptr) {
+    return;
+  }
+  void *prefetch_stream = copy_stream_ == nullptr ? stream : copy_stream_;
+  bool kernel_event_waited = false;
+  bool prefetched = false;
+  for (size_t step = current_step_ + 1; step <= current_step_ + prefetch_step_num_ && step < total_step_; ++step) {
+    for (const auto &key : step_keys_[step]) {
+      if (continuous_mem_info_helper_->IsContinuousMem(key) || auto_mem_offload_->Get(key) != nullptr) {
+        continue;
+      }
+      if (copy_stream_ != nullptr && !kernel_event_waited) {
+        // The prefetched memory may be reused from the memory of the launched kernels or swapped out by them.
+        kernel_event_->WaitEvent();
+        kernel_event_waited = true;
+      }
+      if (auto_mem_offload_->Prefetch(key, prefetch_stream)) {
+        MS_LOG(DEBUG) << "Prefetch " << current_step_ << ": " << key << " for step " << step;
+        (void)prefetched_keys_.insert(key);
+        ++CurStepStatistics().prefetch_count_;
+        prefetched = true;
+      }
+    }
+  }
+  if (copy_stream_ == nullptr) {
+    // The copies are ordered with the later kernels and swap out on the same stream.
+    auto_mem_offload_->FreePrefetchHostMem();
+  } else if (prefetched) {
+    prefetch_event_->RecordEvent();
+    prefetch_pending_ = true;
+  }
+}
+
+void MemScheduler::WaitPrefetch(void *stream) {
+  if (!prefetch_pending_ || stream == nullptr) {
+    return;
+  }
+  // The next kernel may use the prefetched memory or offload it, so it waits for the copies. The host memory of the
+  // copies is reused only by the copies issued after the waiting.
+  prefetch_event_->set_wait_stream(stream);
+  prefetch_event_->WaitEvent();
+  prefetch_pending_ = false;
+  auto_mem_offload_->FreePrefetchHostMem();
+}
+
+void MemScheduler::CheckPrefetchHit() {
+  if (prefetched_keys_.empty()) {
+    return;
+  }
+  for (const auto &key : step_keys_[current_step_]) {
+    if (prefetched_keys_.erase(key) != 0 && auto_mem_offload_->Get(key) != nullptr) {
+      ++CurStepStatistics().prefetch_hit_count_;
+    }
+  }
+}
+
+MemOffloadStatistics &MemScheduler::CurStepStatistics() {
+  if (cur_step_statistics_.size() != total_step_) {
+    cur_step_statistics_.resize(total_step_);
+  }
+  return cur_step_statistics_[current_step_];
+}
+
+void MemScheduler::UpdateStatistics() {
+  statistics_ = MemOffloadStatistics();
+  for (const auto &step_statistics : cur_step_statistics_) {
+    statistics_.swap_in_size_ += step_statistics.swap_in_size_;
+    statistics_.swap_out_size_ += step_statistics.swap_out_size_;
+    statistics_.pre_compute_time_ += step_statistics.pre_compute_time_;
+    statistics_.prefetch_count_ += step_statistics.prefetch_count_;
+    statistics_.prefetch_hit_count_ += step_statistics.prefetch_hit_count_;
+  }
+  const float prefetch_accuracy =
+    statistics_.prefetch_count_ == 0
+      ? 0
+      : static_cast<float>(statistics_.prefetch_hit_count_) / statistics_.prefetch_count_;
+  MS_LOG(INFO) << "Memory offload statistics, swap in size: " << statistics_.swap_in_size_
+               << ", swap out size: " << statistics_.swap_out_size_
+               << ", pre compute host time: " << statistics_.pre_compute_time_
+               << " us, prefetch count: " << statistics_.prefetch_count_
+               << ", prefetch accuracy: " << prefetch_accuracy;
+  step_statistics_.swap(cur_step_statistics_);
+  cur_step_statistics_.assign(total_step_, MemOffloadStatistics());
+  prefetched_keys_.clear();
+}
+
 void MemScheduler::OptMemUsage(float mem_used_factor) {
   MS_EXCEPTION_IF_NULL(mem_handler_);
   MS_EXCEPTION_IF_NULL(auto_mem_offload_);
@@ -236,6 +394,7 @@ void MemScheduler::OptMemUsage(float mem_used_factor) {
 
 bool MemScheduler::Optimize() {
   AdjustFirstEventIndex();
+  InitUseSteps();
   float mem_used_factor = kMaxMemReuseFactor;
   while (mem_used_factor >= kMinMemReuseFactor) {
     bool ret = true;
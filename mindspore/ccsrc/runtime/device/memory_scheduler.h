@@ -24,9 +24,22 @@
 #include <utility>
 #include "runtime/device/memory_offload_strategy.h"
 #include "runtime/device/auto_mem_offload.h"
+#include "ir/device_event.h"
 
 namespace mindspore {
 namespace device {
+// The statistics of memory offload in one step or one run of graph, the time is in microseconds.
+struct MemOffloadStatistics {
+  size_t swap_in_size_{0};
+  size_t swap_out_size_{0};
+  // The host time of the pre-compute events, which allocate and issue the swap in of the memory needed by the kernel
+  // before launching it. The device time of the copies is not included.
+  double pre_compute_time_{0};
+  size_t prefetch_count_{0};
+  // The prefetched memory which is still on the device when it is used.
+  size_t prefetch_hit_count_{0};
+};
+
 class MemScheduler {
  public:
   MemScheduler() = default;
@@ -78,6 +91,21 @@ class MemScheduler {
                             const std::vector<size_t> &align_size_list,
                             const std::vector<const void *> &address_key_list);
 
+  // The memory used in the next steps is swapped in ahead, set zero to disable the prefetch.
+  void set_prefetch_step_num(size_t prefetch_step_num) { prefetch_step_num_ = prefetch_step_num; }
+
+  // Issue the prefetch on the copy stream in parallel with the kernels. The copies wait for the 'kernel_event' recorded
+  // before the kernel launch, and the kernel using the prefetched memory waits for the 'prefetch_event' recorded after
+  // the copies. The prefetch is issued on the kernel stream if the copy stream is not set.
+  void SetPrefetchStream(void *copy_stream, const std::shared_ptr<DeviceEvent> &kernel_event,
+                         const std::shared_ptr<DeviceEvent> &prefetch_event);
+
+  // The statistics of the last run.
+  const MemOffloadStatistics &statistics() const { return statistics_; }
+
+  // The statistics of each step in the last run, the prefetch is counted by the step issuing it.
+  const std::vector<MemOffloadStatistics> &step_statistics() const { return step_statistics_; }
+
  private:
   void Record(const void *key, const MemEventType &event_type, size_t mem_size = 0);
 
@@ -101,6 +129,21 @@ class MemScheduler {
 
   void *Malloc(const MemEventPtr &event, void *stream);
 
+  // Record the steps using each memory by the recorded events, which decide the memory to offload and prefetch.
+  void InitUseSteps();
+
+  size_t GetNextUseDistance(const void *key) const;
+
+  void Prefetch(void *stream);
+
+  void WaitPrefetch(void *stream);
+
+  void CheckPrefetchHit();
+
+  MemOffloadStatistics &CurStepStatistics();
+
+  void UpdateStatistics();
+
   // Scheduler status
   bool need_record_event_{true};
   bool optimized_{false};
@@ -119,6 +162,17 @@ class MemScheduler {
   // Compute time
   std::vector<double> compute_time_;
   double compute_start_time_{0};
+  // Prefetch
+  size_t prefetch_step_num_{2};
+  std::map<const void *, std::vector<size_t>> use_steps_;
+  HashSet<const void *> prefetched_keys_;
+  void *copy_stream_{nullptr};
+  std::shared_ptr<DeviceEvent> kernel_event_{nullptr};
+  std::shared_ptr<DeviceEvent> prefetch_event_{nullptr};
+  bool prefetch_pending_{false};
+  std::vector<MemOffloadStatistics> cur_step_statistics_;
+  std::vector<MemOffloadStatistics> step_statistics_;
+  MemOffloadStatistics statistics_;
 
   std::shared_ptr<AutoMemoryOffload> auto_mem_offload_;
   std::shared_ptr<MemHandler> mem_handler_{nullptr};
@@ -148,6 +148,11 @@ void AbstractActor::InitOutputData() {
       SET_FLAG(output_data_flag, kOutputDataFlagToFusion);
     }
 
+    // Add the static schedule flag.
+    if (TEST_FLAG(data_arrow->flag_, kOutputDataFlagInStaticSchedule)) {
+      SET_FLAG(output_data_flag, kOutputDataFlagInStaticSchedule);
+    }
+
     // Add the output data.
     (void)output_data_.emplace_back(std::make_pair(std::move(data), output_data_flag));
   }
@@ -166,6 +171,11 @@ void AbstractActor::SendOutput(OpContext<DeviceTensor> *const context) {
   size_t output_data_arrow_index = 0;
   for (auto &output_data : output_data_) {
     MS_EXCEPTION_IF_NULL(output_data.first);
+    // The output data between the kernel actors of static schedule doesn't need to be sent.
+    if (TEST_FLAG(output_data.second, kOutputDataFlagInStaticSchedule)) {
+      ++output_data_arrow_index;
+      continue;
+    }
     auto &to_op_id = output_data.first->op_id_;
     auto &output_data_arrow = output_data_arrows_[output_data_arrow_index];
     UpdateOutputData(output_data.first.get(), output_data_arrow, output_data_nodes_[output_data_arrow_index], context);
@@ -212,6 +222,9 @@ void AbstractActor::SendOutput(OpContext<DeviceTensor> *const context) {
     auto from_aid = const_cast<AID *>(&GetAID());
     for (auto &output_control : output_control_arrows_) {
       MS_EXCEPTION_IF_NULL(output_control);
+      if (TEST_FLAG(output_control->flag_, kOutputDataFlagInStaticSchedule)) {
+        continue;
+      }
       if (TEST_FLAG(output_control->flag_, kOutputDataFlagBetweenFusion)) {
         const auto &to_actor = FetchSubActorInFusionActor(output_control->to_op_id_.Name());
         ActorDispatcher::SendSync(to_actor, &OpActor::RunOpControl, from_aid, context);
@@ -46,6 +46,8 @@ constexpr int kOutputDataFlagLastBatch = 4;
 constexpr int kOutputDataFlagBetweenFusion = 8;
 // Indicates that the output data destination is the fusion actor, and needs to use the fusion output index.
 constexpr int kOutputDataFlagToFusion = 16;
+// Indicates that the arrow is between the kernel actors of static schedule, and is replaced by the topological order.
+constexpr int kOutputDataFlagInStaticSchedule = 32;
 
 // The abstract common attributes of actors. The actor inheritance relationship:  OpActor --> AbstractActor -->
 // MemoryAwareActor --> DebugAwareActor --> KernelActor/DataSourceActor/CopyActor/LoopCountActor/OutputActor.
@@ -206,6 +206,7 @@ class ActorDispatcher {
     (actor->*method)(std::forward<Args1>(args)...);
   }
 
+  static bool is_multi_thread_execution() { return is_multi_thread_execution_; }
   static void set_is_multi_thread_execution(bool is_multi_thread_execution) {
     is_multi_thread_execution_ = is_multi_thread_execution;
   }
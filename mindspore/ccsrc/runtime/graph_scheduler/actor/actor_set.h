@@ -43,6 +43,8 @@
 #include "runtime/graph_scheduler/actor/control_flow/entrance_actor.h"
 #include "runtime/graph_scheduler/actor/control_flow/exit_actor.h"
 #include "runtime/graph_scheduler/actor/control_flow/stack_actor.h"
+#include "runtime/graph_scheduler/static_schedule.h"
+#include "runtime/graph_scheduler/dynamic_memory_planner.h"
 
 #ifdef ENABLE_RPC_ACTOR
 #include "runtime/graph_scheduler/actor/rpc/send_actor.h"
@@ -112,6 +114,14 @@ struct ActorSet {
 #ifdef ENABLE_RPC_ACTOR
   RpcActorSetPtr rpc_actors_{nullptr};
 #endif
+  // The kernel actors run by the static schedule instead of the arrows between them, see StaticSchedule.
+  StaticSchedulePtr static_schedule_{nullptr};
+  // Fuse the kernel actors by the launch time profiled in the warm-up step of the former running instead of the
+  // structural fusion, see CostGuidedActorFusion. The launch time is profiled when the actor set has no profile.
+  bool is_cost_guided_fusion_{false};
+  bool is_launch_time_profiled_{false};
+  // The kernel memory of dynamic shape graphs is served by the plan of input shapes, see DynamicMemoryPlanner.
+  DynamicMemoryPlannerPtr memory_planner_{nullptr};
   ActorInfo name_;
   // The related statistics information of multi thread and single thread to decide whether use the multi thread.
   bool is_multi_thread_execution_{true};
@@ -15,6 +15,7 @@
  */
 
 #include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_actor.h"
+#include <future>
 #include <limits>
 #include "backend/common/optimizer/dynamic_shape/dynamic_shape_helper.h"
 #include "kernel/common_utils.h"
@@ -1128,26 +1129,28 @@ bool EmbeddingCachePrefetchActor::PullEembeddingsFromRemote(int32_t param_key, c
     return true;
   }
 
-  std::vector<std::vector<int>> slice_ids_list(server_num_);
+  // The ids are sent asynchronously, and the messages own the ids until they are sent or dropped.
+  auto slice_ids_list = std::make_shared<std::vector<std::vector<int>>>(server_num_);
   // 1. Partition ids by remote embedding slice bound and get unique ids.
-  RETURN_IF_FALSE_WITH_LOG(PartitionIds(ids, ids_num, &slice_ids_list), "Partition ids failed.");
+  RETURN_IF_FALSE_WITH_LOG(PartitionIds(ids, ids_num, slice_ids_list.get()), "Partition ids failed.");
 
   size_t embedding_dim = outputs->size() / ids_num;
   for (size_t i = 0; i < server_num_; i++) {
-    auto &slice_ids = slice_ids_list[i];
+    auto &slice_ids = (*slice_ids_list)[i];
     if (slice_ids.empty()) {
       continue;
     }
 
     // 2. Send unique ids to remote to do embedding lookup.
-    RETURN_IF_FALSE_WITH_LOG(SendToRemote(distributed::kLookupEmbeddingCache, param_key, i, embedding_dim,
-                                          slice_ids.data(), slice_ids.size() * sizeof(int), nullptr, 0, false, false),
-                             "Send ids to server failed.");
+    RETURN_IF_FALSE_WITH_LOG(
+      SendToRemote(distributed::kLookupEmbeddingCache, param_key, i, embedding_dim, slice_ids.data(),
+                   slice_ids.size() * sizeof(int), nullptr, 0, false, false, slice_ids_list),
+      "Send ids to server failed.");
   }
 
-  std::vector<std::unique_ptr<std::vector<char>>> slice_embeddings_list(server_num_);
+  std::vector<ReceivedDataPtr> slice_embeddings_list(server_num_);
   for (size_t i = 0; i < server_num_; i++) {
-    if (slice_ids_list[i].empty()) {
+    if ((*slice_ids_list)[i].empty()) {
       continue;
     }
 
@@ -1155,7 +1158,7 @@ bool EmbeddingCachePrefetchActor::PullEembeddingsFromRemote(int32_t param_key, c
     slice_embeddings_list[i] = ReceiveFromRemote(distributed::kLookupEmbeddingCache, param_key, i);
     MS_ERROR_IF_NULL(slice_embeddings_list[i]);
     // Received embedding integrity check.
-    size_t expected_embedding_size = SizetMulWithOverflowCheck(slice_ids_list[i].size(), embedding_dim);
+    size_t expected_embedding_size = SizetMulWithOverflowCheck((*slice_ids_list)[i].size(), embedding_dim);
     size_t received_embedding_size = slice_embeddings_list[i]->size() / sizeof(float);
     if (received_embedding_size != expected_embedding_size) {
       MS_LOG(ERROR) << "Received embedding data from remote is incomplete, expected embedding size: "
@@ -1165,7 +1168,7 @@ bool EmbeddingCachePrefetchActor::PullEembeddingsFromRemote(int32_t param_key, c
   }
 
   // 4. Retrieve embeddings by input ids order.
-  RETURN_IF_FALSE_WITH_LOG(RetrieveEmbeddings(ids, ids_num, slice_ids_list, slice_embeddings_list, outputs),
+  RETURN_IF_FALSE_WITH_LOG(RetrieveEmbeddings(ids, ids_num, *slice_ids_list, slice_embeddings_list, outputs),
                            "Retrieve embeddings failed.");
 
   return true;
@@ -1293,7 +1296,8 @@ bool EmbeddingCachePrefetchActor::PartitionIdsAndEmbeddings(const int *ids, size
 bool EmbeddingCachePrefetchActor::SendToRemote(const std::string &cache_operation, int32_t param_key,
                                                size_t server_rank_id, size_t embedding_dim, const void *keys,
                                                size_t keys_len, const void *values, size_t values_len,
-                                               bool finalize_remote, bool sync) {
+                                               bool finalize_remote, bool sync,
+                                               const std::shared_ptr<void> &data_owner) {
   MS_ERROR_IF_NULL(keys);
   // Find sender corresponding to cache operation and parameter key.
   auto iter = rpc_operators_.find(cache_operation);
@@ -1333,12 +1337,11 @@ bool EmbeddingCachePrefetchActor::SendToRemote(const std::string &cache_operatio
                               std::make_shared<Address>(&service_id, sizeof(int32_t))};
 
   // Send data.
-  return sender->Send(shapes, data_types, data_list, finalize_remote, sync);
+  return sender->Send(shapes, data_types, data_list, finalize_remote, sync, data_owner);
 }
 
-std::unique_ptr<std::vector<char>> EmbeddingCachePrefetchActor::ReceiveFromRemote(const std::string &cache_operation,
-                                                                                  int32_t param_key,
-                                                                                  size_t server_rank_id) const {
+ReceivedDataPtr EmbeddingCachePrefetchActor::ReceiveFromRemote(const std::string &cache_operation, int32_t param_key,
+                                                               size_t server_rank_id) const {
   // Find receiver corresponding to cache operation and parameter key.
   auto iter = rpc_operators_.find(cache_operation);
   if (iter == rpc_operators_.end()) {
@@ -1354,7 +1357,7 @@ std::unique_ptr<std::vector<char>> EmbeddingCachePrefetchActor::ReceiveFromRemot
 
 bool EmbeddingCachePrefetchActor::RetrieveEmbeddings(
   const int *ids, size_t ids_num, const std::vector<std::vector<int>> &slice_ids_list,
-  const std::vector<std::unique_ptr<std::vector<char>>> &slice_embeddings_list, std::vector<float> *outputs) const {
+  const std::vector<ReceivedDataPtr> &slice_embeddings_list, std::vector<float> *outputs) const {
   MS_ERROR_IF_NULL(ids);
   MS_ERROR_IF_NULL(outputs);
 
@@ -1372,9 +1375,9 @@ bool EmbeddingCachePrefetchActor::RetrieveEmbeddings(
     if (slice_ids.empty()) {
       continue;
     }
-    const std::unique_ptr<std::vector<char>> &slice_embeddings = slice_embeddings_list[i];
+    const ReceivedDataPtr &slice_embeddings = slice_embeddings_list[i];
     MS_ERROR_IF_NULL(slice_embeddings);
-    const float *embeddings_data = reinterpret_cast<float *>(slice_embeddings->data());
+    const float *embeddings_data = reinterpret_cast<const float *>(slice_embeddings->data());
     for (size_t j = 0; j < slice_ids.size(); j++) {
       (void)ids_to_addrs.emplace(slice_ids[j], embeddings_data + offset);
       offset += embedding_dim;
@@ -1627,16 +1630,33 @@ void EmbeddingCachePrefetchActor::LinkRpcOperators() {
 }
 
 bool Sender::Send(const std::vector<ShapeVector> &shapes, const std::vector<TypeId> data_types,
-                  const AddressPtrList &data_list, bool finalize_remote, bool sync) const {
+                  const AddressPtrList &data_list, bool finalize_remote, bool sync,
+                  const std::shared_ptr<void> &data_owner) const {
   MS_ERROR_IF_NULL(receiver_);
-  auto message = BuildRpcMessage(shapes, data_types, data_list, receiver_->get_url(), server_url_, finalize_remote);
-  MS_ERROR_IF_NULL(message);
   MS_ERROR_IF_NULL(client_);
   if (sync) {
-    auto ret = client_->SendSync(std::move(message));
-    return ret > 0;
+    // The message refers to the data of the caller, so wait until the message is sent or dropped.
+    std::promise<bool> sent;
+    auto sent_future = sent.get_future();
+    auto message = BuildRpcMessage(shapes, data_types, data_list, receiver_->get_url(), server_url_, finalize_remote,
+                                   [&sent](bool success) { sent.set_value(success); });
+    MS_ERROR_IF_NULL(message);
+    // The message is released even if it fails to be sent, so the future is always set. The message which is not sent
+    // completely by the flush is sent later by the event loop.
+    int send_result = client_->SendSync(std::move(message));
+    bool sent_result = sent_future.get();
+    if (send_result < 0 || !sent_result) {
+      MS_LOG(ERROR) << "Failed to send message to " << server_url_ << ", send result: " << send_result;
+      return false;
+    }
+    return true;
   }
 
+  // The message owns the data of the caller instead of copying it, and releases the data after it's sent or dropped.
+  MS_ERROR_IF_NULL(data_owner);
+  auto message = BuildRpcMessage(shapes, data_types, data_list, receiver_->get_url(), server_url_, finalize_remote,
+                                 [data_owner](bool) {});
+  MS_ERROR_IF_NULL(message);
   client_->SendAsync(std::move(message));
   return true;
 }
@@ -1678,14 +1698,15 @@ bool Sender::ConnectServer() {
   return true;
 }
 
-std::unique_ptr<MessageBase> Sender::BuildRpcMessage(const std::vector<ShapeVector> &shapes,
-                                                     const std::vector<TypeId> data_types,
-                                                     const AddressPtrList &data_list, const std::string &from_url,
-                                                     const std::string &to_url, bool finalize_remote) const {
-  std::unique_ptr<MessageBase> message = std::make_unique<MessageBase>();
+std::unique_ptr<VectoredMessage> Sender::BuildRpcMessage(const std::vector<ShapeVector> &shapes,
+                                                         const std::vector<TypeId> data_types,
+                                                         const AddressPtrList &data_list, const std::string &from_url,
+                                                         const std::string &to_url, bool finalize_remote,
+                                                         SendCompletionCallback completion_cb) const {
+  std::vector<distributed::rpc::MessageSegment> segments;
+  std::unique_ptr<VectoredMessage> message = std::make_unique<VectoredMessage>(
+    AID("", from_url), AID("", to_url), "", std::move(segments), std::move(completion_cb));
   MS_ERROR_IF_NULL_W_RET_VAL(message, nullptr);
-  message->from = AID("", from_url);
-  message->to = AID("", to_url);
 
   if (shapes.size() != data_list.size()) {
     MS_LOG(ERROR) << "The shape list size[" << shapes.size() << "] should be equal to data list size["
@@ -1710,20 +1731,22 @@ std::unique_ptr<MessageBase> Sender::BuildRpcMessage(const std::vector<ShapeVect
     // Message format:
     // |RPC_DYNAMIC_SHAPE_DATA | dynamic shape PB data size |---dynamic shape PB data----|---real data----|
     // 1. The dynamic shape header.
-    (void)message->body.append(kRpcDynamicShapeData);
+    std::string header(kRpcDynamicShapeData);
     // 2. The size of the protobuf DynamicShapeMessage.
     size_t ds_pb_msg_size = ds_pb_msg_str.size();
-    (void)message->body.append(reinterpret_cast<char *>(&ds_pb_msg_size), sizeof(ds_pb_msg_size));
+    (void)header.append(reinterpret_cast<char *>(&ds_pb_msg_size), sizeof(ds_pb_msg_size));
     // 3. Protobuf DynamicShapeMessage.
-    (void)message->body.append(ds_pb_msg_str);
-    // 4. The real data buffer need to be sent.
-    (void)message->body.append(static_cast<char *>(data->addr), data->size);
+    (void)header.append(ds_pb_msg_str);
+    message->AddOwnedSegment(std::move(header));
+    // 4. The real data buffer need to be sent, which is referenced without copying.
+    message->AddSegment(data->addr, data->size);
   }
 
   // 5. Finalize remote command.
   if (finalize_remote) {
-    (void)message->body.append(distributed::kFinalizeMuxRecvActor);
-    (void)message->body.append(reinterpret_cast<char *>(&finalize_remote), sizeof(finalize_remote));
+    std::string finalize_command(distributed::kFinalizeMuxRecvActor);
+    (void)finalize_command.append(reinterpret_cast<char *>(&finalize_remote), sizeof(finalize_remote));
+    message->AddOwnedSegment(std::move(finalize_command));
   }
 
   return message;
@@ -1741,7 +1764,7 @@ Receiver::~Receiver() {
   received_buffer_ = nullptr;
 }
 
-std::unique_ptr<std::vector<char>> Receiver::Receive() {
+ReceivedDataPtr Receiver::Receive() {
   std::unique_lock<std::mutex> locker(received_msg_mtx_);
   // The maximum time(300 seconds) to wait to receive message.
   const int64_t longest_time_to_wait = 300;
@@ -1752,7 +1775,7 @@ std::unique_ptr<std::vector<char>> Receiver::Receive() {
     return nullptr;
   }
 
-  std::unique_ptr<std::vector<char>> output = std::move(received_buffer_);
+  ReceivedDataPtr output = std::move(received_buffer_);
   MS_EXCEPTION_IF_NULL(output);
   received_msg_ = false;
   return output;
@@ -1762,7 +1785,7 @@ bool Receiver::StartServer() {
   // 1. Create a tcp server and start listening.
   server_ = std::make_unique<TCPServer>();
   MS_EXCEPTION_IF_NULL(server_);
-  if (!server_->Initialize()) {
+  if (!server_->Initialize(recv_buffer_pool_.allocate_cb())) {
     MS_LOG(EXCEPTION) << "Failed to initialize tcp server for recv actor";
   }
   ip_ = server_->GetIP();
@@ -1846,28 +1869,24 @@ MessageBase *Receiver::HandleMessage(MessageBase *const msg) {
     return distributed::rpc::NULL_MSG;
   }
 
-  const std::string &msg_body = msg->body;
+  // The message and its body allocated from the receive buffer pool are released even if the message is invalid.
+  std::unique_ptr<MessageBase> message(msg);
+  MS_EXCEPTION_IF_NULL(message->data);
+  auto received_data = std::make_unique<ReceivedData>(&recv_buffer_pool_, message->data);
   // The data pair: <addr of data, size of data>.
   std::pair<const void *, size_t> real_data;
   // Get real data addr and size.
-  if (!ParseDynamicShapeData(msg_body.c_str(), msg_body.size(), &real_data)) {
+  if (!ParseDynamicShapeData(static_cast<const char *>(message->data), message->size, &real_data)) {
     MS_LOG(EXCEPTION) << "Parse dynamic shape data failed.";
   }
-
-  std::unique_lock<std::mutex> locker(received_msg_mtx_);
-  received_buffer_ = std::make_unique<std::vector<char>>();
-  received_buffer_->resize(real_data.second);
   MS_EXCEPTION_IF_NULL(real_data.first);
+  // Hand over the message body to the receiving thread without copying the real data.
+  received_data->set_data(real_data.first, real_data.second);
 
-  int ret = memcpy_s(received_buffer_->data(), received_buffer_->size(), real_data.first, real_data.second);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "Memcpy for received data failed, errno[" << ret << "]";
-  }
-
+  std::unique_lock<std::mutex> locker(received_msg_mtx_);
+  received_buffer_ = std::move(received_data);
   received_msg_ = true;
   received_msg_cv_.notify_one();
-
-  delete msg;
   return distributed::rpc::NULL_MSG;
 }
 }  // namespace runtime
@@ -29,6 +29,8 @@
 #include "distributed/cluster/cluster_context.h"
 #include "distributed/rpc/tcp/tcp_client.h"
 #include "distributed/rpc/tcp/tcp_server.h"
+#include "distributed/rpc/tcp/recv_buffer_pool.h"
+#include "distributed/rpc/tcp/vectored_message.h"
 #include "utils/hash_map.h"
 #include "distributed/embedding_cache/embedding_cache_utils.h"
 
@@ -47,10 +49,12 @@ using kernel::AddressPtrList;
 
 class Sender;
 class Receiver;
+class ReceivedData;
 using SenderPtr = std::shared_ptr<Sender>;
 using ReceiverPtr = std::shared_ptr<Receiver>;
 using SendRecvPair = std::pair<SenderPtr, ReceiverPtr>;
 using SendRecvPairList = std::vector<SendRecvPair>;
+using ReceivedDataPtr = std::unique_ptr<ReceivedData>;
 
 using distributed::EmbeddingCacheStatisticsInfo;
 using distributed::EmbeddingDeviceCache;
@@ -61,8 +65,11 @@ using distributed::INVALID_STEP_VALUE;
 
 using distributed::cluster::ActorRouteTableProxy;
 using distributed::cluster::ActorRouteTableProxyPtr;
+using distributed::rpc::RecvBufferPool;
+using distributed::rpc::SendCompletionCallback;
 using distributed::rpc::TCPClient;
 using distributed::rpc::TCPServer;
+using distributed::rpc::VectoredMessage;
 
 // The EmbeddingCachePrefetchActor is used to cache large embedding table scenarios. The cache level is: Device
 // Cache->Local Host Cache->Remote Cache. This Actor is used to perform Local and Device Cache hit analysis and cache
@@ -177,15 +184,13 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   // The parameter 'cache_operation' is cache operation name such as LookupEmbeddingCache and UpdateEmbeddingCache.
   bool SendToRemote(const std::string &cache_operation, int32_t param_key, size_t server_rank_id, size_t embedding_dim,
                     const void *keys, size_t keys_len, const void *values = nullptr, size_t values_len = 0,
-                    bool finalize_remote = false, bool sync = true);
+                    bool finalize_remote = false, bool sync = true, const std::shared_ptr<void> &data_owner = nullptr);
   // Wait response of remote and get return result.
   // The parameter 'cache_operation' is cache operation name such as LookupEmbeddingCache and UpdateEmbeddingCache.
-  std::unique_ptr<std::vector<char>> ReceiveFromRemote(const std::string &cache_operation, int32_t param_key,
-                                                       size_t server_rank_id) const;
+  ReceivedDataPtr ReceiveFromRemote(const std::string &cache_operation, int32_t param_key, size_t server_rank_id) const;
   // Retrieve embeddings by input ids order.
   bool RetrieveEmbeddings(const int *ids, size_t ids_num, const std::vector<std::vector<int>> &slice_ids_list,
-                          const std::vector<std::unique_ptr<std::vector<char>>> &slice_embeddings_list,
-                          std::vector<float> *outputs) const;
+                          const std::vector<ReceivedDataPtr> &slice_embeddings_list, std::vector<float> *outputs) const;
 
   // Send finalize request to remote and finalize it.
   bool FinalizeRemote();
@@ -367,9 +372,12 @@ class Sender : public RpcOperator {
   Sender() : server_url_(""), client_(nullptr) {}
   ~Sender() override;
 
-  // Send buffer to peer.
+  // Send buffer to peer. The synchronous sending waits until the message is sent or dropped. The asynchronous sending
+  // returns at once, and the message refers to the data without copying and keeps 'data_owner' alive until the message
+  // is released, so 'data_owner' must own the memory of 'data_list'.
   bool Send(const std::vector<ShapeVector> &shapes, const std::vector<TypeId> data_types,
-            const AddressPtrList &data_list, bool finalize_remote = false, bool sync = true) const;
+            const AddressPtrList &data_list, bool finalize_remote = false, bool sync = true,
+            const std::shared_ptr<void> &data_owner = nullptr) const;
 
   // Set the receiver paired with the sender to get the 'from url' from the receiver.
   void set_receiver(const ReceiverPtr &receiver) { receiver_ = receiver; }
@@ -378,15 +386,17 @@ class Sender : public RpcOperator {
   bool ConnectServer();
 
  private:
-  // Build the MessageBase include dynamic shape protobuf, which will be sent to peer receiver.
+  // Build the VectoredMessage include dynamic shape protobuf, which will be sent to peer receiver.
   // The message format is as below:
   // |--------22 bytes-------|-------sizeof(size_t)-------|-dynamic shape PB data size-| real data size |
   // |RPC_DYNAMIC_SHAPE_DATA | dynamic shape PB data size |---dynamic shape PB data----|---real data----|
-  // The message.from (from url) must be set.
-  std::unique_ptr<MessageBase> BuildRpcMessage(const std::vector<ShapeVector> &shapes,
-                                               const std::vector<TypeId> data_types, const AddressPtrList &data_list,
-                                               const std::string &from_url, const std::string &to_url,
-                                               bool finalize_remote) const;
+  // The message.from (from url) must be set. The real data is referenced by the message without copying, so it must be
+  // valid until 'completion_cb' is called.
+  std::unique_ptr<VectoredMessage> BuildRpcMessage(const std::vector<ShapeVector> &shapes,
+                                                   const std::vector<TypeId> data_types,
+                                                   const AddressPtrList &data_list, const std::string &from_url,
+                                                   const std::string &to_url, bool finalize_remote,
+                                                   SendCompletionCallback completion_cb) const;
 
   // The url of the peer receiver's tcp server.
   std::string server_url_;
@@ -398,6 +408,35 @@ class Sender : public RpcOperator {
   ReceiverPtr receiver_;
 };
 
+// The real data of a received message. It refers to the message body allocated from the receive buffer pool of the
+// receiver without copying, and returns the body to the pool when it's destroyed.
+class ReceivedData {
+ public:
+  ReceivedData(RecvBufferPool *pool, void *body) : pool_(pool), body_(body), data_(nullptr), size_(0) {}
+  ~ReceivedData() {
+    if (pool_ != nullptr && body_ != nullptr) {
+      (void)pool_->Free(body_);
+    }
+  }
+
+  // Set the real data which is a part of the message body.
+  void set_data(const void *data, size_t size) {
+    data_ = static_cast<const char *>(data);
+    size_ = size;
+  }
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  RecvBufferPool *pool_;
+  void *body_;
+  const char *data_;
+  size_t size_;
+
+  DISABLE_COPY_AND_ASSIGN(ReceivedData);
+};
+
 // Receiver is used to receive data from other process.
 class Receiver : public RpcOperator {
  public:
@@ -406,7 +445,7 @@ class Receiver : public RpcOperator {
 
   // Receive message from the peer sender, this interface is a synchronous interface and will wait for the message
   // until the timeout period is reached.
-  std::unique_ptr<std::vector<char>> Receive();
+  ReceivedDataPtr Receive();
 
   // Start receiver server and register this server address to route table in scheduler by proxy.
   bool StartServer();
@@ -430,8 +469,11 @@ class Receiver : public RpcOperator {
 
   std::unique_ptr<TCPServer> server_;
 
-  // The buffer used save received content of message.
-  std::unique_ptr<std::vector<char>> received_buffer_;
+  // The bodies of the received messages of similar sizes every step are allocated from the pool.
+  RecvBufferPool recv_buffer_pool_;
+
+  // The received content of message, which must be released before the pool.
+  ReceivedDataPtr received_buffer_;
 
   // The flag indicates whether receive message successfully.
   std::atomic_bool received_msg_;
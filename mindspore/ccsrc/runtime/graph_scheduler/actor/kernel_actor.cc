@@ -19,11 +19,13 @@
 #include "runtime/graph_scheduler/actor/output_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
+#include "runtime/graph_scheduler/static_schedule.h"
 #include "mindrt/include/async/async.h"
 #include "utils/log_adapter.h"
 #include "distributed/recovery/recovery_context.h"
 #include "distributed/collective/collective_manager.h"
 #include "kernel/common_utils.h"
+#include "utils/profile.h"
 
 namespace mindspore {
 namespace runtime {
@@ -104,6 +106,14 @@ void KernelActor::Init() {
 void KernelActor::Run(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(context);
   MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  // The kernel launch is taken over by the static schedule.
+  if (static_schedule_ != nullptr) {
+    static_schedule_->OnKernelActorReady(context);
+    return;
+  }
+  if (is_launch_time_profiled_) {
+    run_begin_time_ = GetTime();
+  }
 
   FetchInputDeviceTensor(context);
   FetchOutputDeviceTensor(context);
@@ -210,7 +220,8 @@ void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *const context) {
 void KernelActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(device_contexts_[0]);
   if (strategy_ == GraphExecutionStrategy::kPipeline) {
-    if (ActorDispatcher::is_memory_free_sync()) {
+    // The static schedule allocates memory synchronously, so the memory free must be synchronous too.
+    if (ActorDispatcher::is_memory_free_sync() || (static_schedule_ != nullptr)) {
       ActorDispatcher::SendSync(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list_,
                                 device_contexts_[0], context, GetAID());
     } else {
@@ -229,6 +240,69 @@ void KernelActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
   }
 }
 
+void KernelActor::PrepareStaticLaunch(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  for (auto &static_input_info : static_input_infos_) {
+    auto input_index = std::get<0>(static_input_info);
+    auto from_actor = std::get<1>(static_input_info);
+    auto from_output_index = std::get<2>(static_input_info);
+    MS_EXCEPTION_IF_NULL(from_actor);
+    if ((input_index >= input_device_tensors_.size()) ||
+        (from_output_index >= from_actor->output_device_tensors_.size())) {
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), "The static input index is out of range: " + GetAID().Name());
+    }
+    auto input_device_tensor = from_actor->output_device_tensors_[from_output_index];
+    if (input_device_tensors_[input_index] != input_device_tensor) {
+      input_device_tensors_[input_index] = input_device_tensor;
+      memory_free_list_[input_index] = input_device_tensor;
+    }
+  }
+  FetchInputDeviceTensor(context);
+  FetchOutputDeviceTensor(context);
+  if (IsRunningFailed(context)) {
+    return;
+  }
+
+  // Allocate memory by the memory manager actor synchronously, which serves the memory plan of actor set too.
+  ActorDispatcher::SendSync(memory_manager_aid_, &MemoryManagerActor::AllocateMemoryWithoutCallback,
+                            &memory_alloc_list_, device_contexts_[0], context, GetAID());
+}
+
+bool KernelActor::LaunchInStaticSchedule(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(kernel_);
+  // The kernels of one level launch on the threads of actor thread pool, so the exception can't be thrown out.
+  try {
+    PreLaunchKernel(context);
+    if (RecoveryContext::GetInstance()->enable_recovery() && CollectiveManager::instance()->need_reinit()) {
+      MS_LOG(WARNING) << "Collective communication need reinitialize, skip launch kernel: "
+                      << kernel_->fullname_with_scope();
+      return true;
+    }
+    double launch_begin_time = is_launch_time_profiled_ ? GetTime() : 0;
+    auto ret = LaunchKernel(context);
+    if (is_launch_time_profiled_) {
+      launch_end_time_ = GetTime();
+      launch_time_ = launch_end_time_ - launch_begin_time;
+    }
+    return ret;
+  } catch (const std::exception &) {
+    MsException::Instance().SetException();
+    return false;
+  }
+}
+
+void KernelActor::FinishStaticLaunch(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  // Debug actor is blocked, must wait debug actor callback message to process continue.
+  if (debug_aid_ != nullptr) {
+    SendDebugReq(context);
+    return;
+  }
+  PostLaunchKernel(context);
+}
+
 void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(context);
   MS_EXCEPTION_IF_NULL(kernel_);
@@ -245,7 +319,12 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
       MS_LOG(WARNING) << "Collective communication need reinitialize, skip launch kernel: "
                       << kernel_->fullname_with_scope();
     } else {
+      double launch_begin_time = is_launch_time_profiled_ ? GetTime() : 0;
       auto ret = LaunchKernel(context);
+      if (is_launch_time_profiled_) {
+        launch_end_time_ = GetTime();
+        launch_time_ = launch_end_time_ - launch_begin_time;
+      }
       if (!ret) {
         std::string error_info = "Launch kernel failed: " + kernel_->fullname_with_scope();
         SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
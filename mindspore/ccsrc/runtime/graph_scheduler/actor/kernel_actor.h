@@ -22,6 +22,7 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <tuple>
 #include "utils/hash_map.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "runtime/graph_scheduler/actor/debug_aware_actor.h"
@@ -39,6 +40,8 @@ using mindspore::kernel::Address;
 using mindspore::kernel::KernelLaunchInfo;
 using mindspore::tensor::TensorPtr;
 
+class StaticSchedule;
+
 struct InputDataInfo {
   InputDataInfo(const std::string &format, const ShapeVector &shape, size_t size, TypeId type_id)
       : format_(format), shape_(shape), size_(size), type_id_(type_id) {}
@@ -88,6 +91,12 @@ class KernelActor : public DebugAwareActor {
   bool is_dynamic_shape() const { return is_dynamic_shape_; }
   bool is_launch_skipped() const { return is_launch_skipped_; }
 
+  // The launch time profiling used by the cost guided actor fusion, and the time unit is second.
+  void set_is_launch_time_profiled(bool is_launch_time_profiled) { is_launch_time_profiled_ = is_launch_time_profiled; }
+  double run_begin_time() const { return run_begin_time_; }
+  double launch_time() const { return launch_time_; }
+  double launch_end_time() const { return launch_end_time_; }
+
  protected:
   void Init() override;
   void Run(OpContext<DeviceTensor> *const context) override;
@@ -124,6 +133,7 @@ class KernelActor : public DebugAwareActor {
  private:
   friend class GraphScheduler;
   friend class ControlNodeScheduler;
+  friend class StaticSchedule;
 #ifdef ENABLE_RPC_ACTOR
   friend class RpcNodeScheduler;
 #endif
@@ -143,6 +153,12 @@ class KernelActor : public DebugAwareActor {
   void PostLaunchKernel(OpContext<DeviceTensor> *const context);
   // Back refresh the dynamic device tensor stores that have been triggered copy.
   void RefreshDeviceTensorCopyStore(OpContext<DeviceTensor> *const context);
+  // The processing before kernel launch in the static schedule: fetch the device tensors and allocate memory.
+  void PrepareStaticLaunch(OpContext<DeviceTensor> *const context);
+  // Launch the kernel of the level concurrently in the static schedule, return false if the launch fails.
+  bool LaunchInStaticSchedule(OpContext<DeviceTensor> *const context);
+  // The processing after all the kernels of the level launch in the static schedule: debug and post launch.
+  void FinishStaticLaunch(OpContext<DeviceTensor> *const context);
 
   // The real input number of kernel launch.
   size_t real_input_num_;
@@ -161,6 +177,17 @@ class KernelActor : public DebugAwareActor {
 
   // Whether skip the kernel launch.
   bool is_launch_skipped_;
+
+  // The static schedule which launches this actor, the inputs from other kernel actors are replaced by the
+  // std::tuple<input_index, from_actor, from_output_index> and fetched from the output of from actor directly.
+  StaticSchedule *static_schedule_{nullptr};
+  std::vector<std::tuple<size_t, KernelActor *, size_t>> static_input_infos_;
+
+  // Record the time of running begin, kernel launch cost and kernel launch end when profiling the launch time.
+  bool is_launch_time_profiled_{false};
+  double run_begin_time_{0};
+  double launch_time_{0};
+  double launch_end_time_{0};
 };
 
 using KernelActorPtr = std::shared_ptr<KernelActor>;
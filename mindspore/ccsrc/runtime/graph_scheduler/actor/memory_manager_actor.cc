@@ -33,6 +33,23 @@ void OnMemoryAllocFinish(const AID &from_aid, OpContext<DeviceTensor> *const op_
 void MemoryManagerActor::AllocateMemory(const std::vector<DeviceTensor *> *alloc_list,
                                         const DeviceContext *device_context, OpContext<DeviceTensor> *const op_context,
                                         const AID &from_aid) {
+  if (!AllocateMemoryList(alloc_list, device_context, op_context, from_aid)) {
+    return;
+  }
+
+  // Call back to the from actor to process after memory allocation finished.
+  OnMemoryAllocFinish(from_aid, op_context);
+}
+
+void MemoryManagerActor::AllocateMemoryWithoutCallback(const std::vector<DeviceTensor *> *alloc_list,
+                                                       const DeviceContext *device_context,
+                                                       OpContext<DeviceTensor> *const op_context, const AID &from_aid) {
+  (void)AllocateMemoryList(alloc_list, device_context, op_context, from_aid);
+}
+
+bool MemoryManagerActor::AllocateMemoryList(const std::vector<DeviceTensor *> *alloc_list,
+                                            const DeviceContext *device_context,
+                                            OpContext<DeviceTensor> *const op_context, const AID &from_aid) {
   MS_EXCEPTION_IF_NULL(alloc_list);
   MS_EXCEPTION_IF_NULL(device_context);
   MS_EXCEPTION_IF_NULL(op_context);
@@ -42,21 +59,23 @@ void MemoryManagerActor::AllocateMemory(const std::vector<DeviceTensor *> *alloc
     if (device_tensor->GetPtr() != nullptr) {
       continue;
     }
+    // Serve the memory from the plan of dynamic memory planner firstly.
+    if ((memory_planner_ != nullptr) && memory_planner_->Allocate(device_tensor, from_aid.Name())) {
+      continue;
+    }
     try {
       // Allocate memory through the device context.
       device::DynamicMemAllocatorDebugInfo::SetDebugInfo(from_aid.Name(), device::AllocatorType::kKernelOutput);
       if (!device_context->device_res_manager_->AllocateMemory(device_tensor)) {
         SetOpContextMemoryAllocFail(from_aid.Name(), device_context, device_tensor->GetSize(), op_context);
-        return;
+        return false;
       }
     } catch (const std::exception &e) {
       SetOpContextMemoryAllocFail(from_aid.Name(), device_context, device_tensor->GetSize(), op_context);
-      return;
+      return false;
     }
   }
-
-  // Call back to the from actor to process after memory allocation finished.
-  OnMemoryAllocFinish(from_aid, op_context);
+  return true;
 }
 
 void MemoryManagerActor::AllocateContinuousMemory(const std::vector<std::vector<DeviceTensorPtr>> *alloc_list_list,
@@ -134,6 +153,10 @@ void MemoryManagerActor::AllocateBatchMemory(const std::vector<DeviceTensor *> *
     if (device_tensor->GetPtr() != nullptr) {
       continue;
     }
+    // Serve the memory from the plan of dynamic memory planner firstly.
+    if ((memory_planner_ != nullptr) && memory_planner_->Allocate(device_tensor, from_aid.Name())) {
+      continue;
+    }
 
     try {
       // Allocate memory through the device context.
@@ -189,6 +212,9 @@ void MemoryManagerActor::FreeMemoryByRefCount(DeviceTensor *const device_tensor,
   MS_EXCEPTION_IF_NULL(device_tensor);
 
   std::lock_guard<std::mutex> locker(mem_free_mutex_);
+  if (memory_planner_ != nullptr) {
+    memory_planner_->RecordUser(device_tensor, op_name);
+  }
   if (device_tensor->original_ref_count() != SIZE_MAX) {
     // The static reference count is decremented to zero to free memory, and reset to the original count.
     device_tensor->DecreaseRefCount();
@@ -197,7 +223,7 @@ void MemoryManagerActor::FreeMemoryByRefCount(DeviceTensor *const device_tensor,
       if (device_tensor->GetPtr() != nullptr) {
         auto held_by_nodes = device_tensor->held_by_nodes();
         if (held_by_nodes.empty()) {
-          FreeMemoryByDeviceContext(device_tensor, device_context);
+          FreeMemoryByPlanner(device_tensor, device_context);
         } else {
           FreeMemoryByValueNode(held_by_nodes, device_tensor);
         }
@@ -208,11 +234,19 @@ void MemoryManagerActor::FreeMemoryByRefCount(DeviceTensor *const device_tensor,
     device_tensor->DecreaseDynamicRefCount(op_name);
     if ((device_tensor->dynamic_ref_count() == 0) && (device_tensor->GetPtr() != nullptr)) {
       MS_LOG(DEBUG) << "Free memory by the dynamic reference count, device address" << device_tensor->GetPtr();
-      FreeMemoryByDeviceContext(device_tensor, device_context);
+      FreeMemoryByPlanner(device_tensor, device_context);
     }
   }
 }
 
+void MemoryManagerActor::FreeMemoryByPlanner(DeviceTensor *const device_tensor, const DeviceContext *device_context) {
+  // The memory served by the dynamic memory planner is returned to the arena instead of the memory pool.
+  if ((memory_planner_ != nullptr) && memory_planner_->Free(device_tensor)) {
+    return;
+  }
+  FreeMemoryByDeviceContext(device_tensor, device_context);
+}
+
 void MemoryManagerActor::SetOpContextMemoryAllocFail(const std::string &kernel_name,
                                                      const DeviceContext *device_context, size_t alloc_size,
                                                      OpContext<DeviceTensor> *const op_context) {
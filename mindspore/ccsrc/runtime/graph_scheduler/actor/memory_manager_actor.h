@@ -25,6 +25,7 @@
 #include "utils/hash_map.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "runtime/graph_scheduler/device_tensor_store.h"
+#include "runtime/graph_scheduler/dynamic_memory_planner.h"
 #include "runtime/hardware/device_context.h"
 
 namespace mindspore {
@@ -40,6 +41,10 @@ class MemoryManagerActor : public ActorBase {
   // The process entry of memory alloc.
   void AllocateMemory(const std::vector<DeviceTensor *> *alloc_list, const DeviceContext *device_context,
                       OpContext<DeviceTensor> *const op_context, const AID &from_aid);
+  // The process entry of memory alloc whose caller waits for the allocation by SendSync, so the from actor isn't called
+  // back after the allocation.
+  void AllocateMemoryWithoutCallback(const std::vector<DeviceTensor *> *alloc_list, const DeviceContext *device_context,
+                                     OpContext<DeviceTensor> *const op_context, const AID &from_aid);
   // The process entry of continuous memory alloc, the size of alloc_list_list, size_list_list, total_size_list and
   // device_contexts must be equal.
   void AllocateContinuousMemory(const std::vector<std::vector<DeviceTensorPtr>> *alloc_list_list,
@@ -63,9 +68,15 @@ class MemoryManagerActor : public ActorBase {
   // Wait the MemoryManagerActor to finish running all current messages.
   void Wait(OpContext<DeviceTensor> *const op_context, const AID &from_aid);
 
+  // The memory planner is only set during the running of the actor set which uses the dynamic memory plan.
+  void set_memory_planner(DynamicMemoryPlanner *memory_planner) { memory_planner_ = memory_planner; }
+
  private:
+  bool AllocateMemoryList(const std::vector<DeviceTensor *> *alloc_list, const DeviceContext *device_context,
+                          OpContext<DeviceTensor> *const op_context, const AID &from_aid);
   void FreeMemoryByRefCount(DeviceTensor *const device_tensor, const DeviceContext *device_context,
                             const std::string &op_name);
+  void FreeMemoryByPlanner(DeviceTensor *const device_tensor, const DeviceContext *device_context);
 
   // When allocate device memory fail, print error log and set op context failed status.
   void SetOpContextMemoryAllocFail(const std::string &kernel_name, const DeviceContext *device_context,
@@ -79,6 +90,8 @@ class MemoryManagerActor : public ActorBase {
 
   // The memory free by the ref count maybe triggered concurrently, and the ref count decreased need the lock.
   std::mutex mem_free_mutex_;
+
+  DynamicMemoryPlanner *memory_planner_{nullptr};
 };
 }  // namespace runtime
 }  // namespace mindspore
@@ -0,0 +1,361 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/dynamic_memory_planner.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include "backend/common/somas/somas_solver_core.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The max number of input shapes which are planned, the other shapes use the memory pool.
+constexpr size_t kMaxMemoryPlanNum = 16;
+constexpr size_t kArenaAlignSize = 512;
+
+size_t AlignArenaSize(size_t size) { return ((size + kArenaAlignSize - 1) / kArenaAlignSize) * kArenaAlignSize; }
+
+std::vector<int64_t> GetShapeKey(const std::vector<std::vector<TensorPtr>> &input_tensors) {
+  std::vector<int64_t> shape_key;
+  for (auto &tensors : input_tensors) {
+    for (auto &tensor : tensors) {
+      if (tensor == nullptr) {
+        continue;
+      }
+      const auto &shape = tensor->shape();
+      // The rank is added in front of the dims to distinguish the shapes of different tensors.
+      (void)shape_key.emplace_back(SizeToLong(shape.size()));
+      (void)shape_key.insert(shape_key.end(), shape.begin(), shape.end());
+    }
+  }
+  return shape_key;
+}
+}  // namespace
+
+DynamicMemoryPlanner::~DynamicMemoryPlanner() {
+  if ((arena_ != nullptr) && (device_context_ != nullptr) && (device_context_->device_res_manager_ != nullptr)) {
+    device_context_->device_res_manager_->FreeMemory(arena_);
+  }
+  arena_ = nullptr;
+}
+
+void DynamicMemoryPlanner::Init(const std::vector<AbstractActorPtr> &actors) {
+  for (auto &actor : actors) {
+    MS_EXCEPTION_IF_NULL(actor);
+    actor_indexes_[actor->GetAID().Name()] = actor_indexes_.size();
+  }
+
+  // Collect the output actors by the input arrows, which keep the real actors in the fusion actor.
+  std::vector<std::vector<size_t>> output_actors(actors.size());
+  std::vector<size_t> input_nums(actors.size(), 0);
+  for (auto &actor : actors) {
+    auto to_index = actor_indexes_[actor->GetAID().Name()];
+    std::set<size_t> input_indexes;
+    for (auto &input_data_arrow_aid : actor->input_data_arrow_aids()) {
+      const auto &iter = actor_indexes_.find(input_data_arrow_aid.first.Name());
+      if (iter != actor_indexes_.end()) {
+        (void)input_indexes.insert(iter->second);
+      }
+    }
+    for (auto &input_control_arrow_aid : actor->input_control_arrow_aids()) {
+      const auto &iter = actor_indexes_.find(input_control_arrow_aid.first.Name());
+      if (iter != actor_indexes_.end()) {
+        (void)input_indexes.insert(iter->second);
+      }
+    }
+    for (auto input_index : input_indexes) {
+      (void)output_actors[input_index].emplace_back(to_index);
+    }
+    input_nums[to_index] = input_indexes.size();
+  }
+
+  // Get the topological order and compute the reachability in the reverse order.
+  std::vector<size_t> topological_order;
+  std::queue<size_t> ready_indexes;
+  for (size_t i = 0; i < input_nums.size(); ++i) {
+    if (input_nums[i] == 0) {
+      ready_indexes.push(i);
+    }
+  }
+  while (!ready_indexes.empty()) {
+    auto index = ready_indexes.front();
+    ready_indexes.pop();
+    (void)topological_order.emplace_back(index);
+    for (auto output_index : output_actors[index]) {
+      if (--input_nums[output_index] == 0) {
+        ready_indexes.push(output_index);
+      }
+    }
+  }
+
+  reachable_actors_.clear();
+  reachable_actors_.reserve(actors.size());
+  for (size_t i = 0; i < actors.size(); ++i) {
+    (void)reachable_actors_.emplace_back(actors.size());
+  }
+  if (topological_order.size() != actors.size()) {
+    MS_LOG(INFO) << "The actors of " << name_ << " have the cycle arrows and the memory isn't reused in the plan.";
+    return;
+  }
+  for (auto iter = topological_order.rbegin(); iter != topological_order.rend(); ++iter) {
+    auto &reachable_actors = reachable_actors_[*iter];
+    for (auto output_index : output_actors[*iter]) {
+      reachable_actors.SetBitTrue(output_index);
+      Union(&reachable_actors, &reachable_actors_[output_index]);
+    }
+  }
+}
+
+void DynamicMemoryPlanner::BeginStep(const std::vector<std::vector<TensorPtr>> &input_tensors) {
+  if (phase_ != StepPhase::kIdle) {
+    EndStep(false);
+  }
+
+  auto shape_key = GetShapeKey(input_tensors);
+  const auto &iter = plans_.find(shape_key);
+  if (iter == plans_.end()) {
+    if (plans_.size() >= kMaxMemoryPlanNum) {
+      return;
+    }
+    current_plan_ = &(plans_[shape_key]);
+    phase_ = StepPhase::kRecord;
+    return;
+  }
+
+  if ((!iter->second.is_valid_) || (iter->second.slots_.empty()) || (!PrepareArena(iter->second.size_))) {
+    return;
+  }
+  current_plan_ = &(iter->second);
+  phase_ = StepPhase::kServe;
+}
+
+void DynamicMemoryPlanner::EndStep(bool is_success) {
+  if (phase_ == StepPhase::kRecord) {
+    MS_EXCEPTION_IF_NULL(current_plan_);
+    if (is_success) {
+      BuildPlan(current_plan_);
+    } else {
+      current_plan_->is_valid_ = false;
+    }
+    traces_.clear();
+  } else if (phase_ == StepPhase::kServe) {
+    CheckServedMemory(current_plan_);
+  }
+  current_plan_ = nullptr;
+  phase_ = StepPhase::kIdle;
+}
+
+bool DynamicMemoryPlanner::Allocate(DeviceTensor *const device_tensor, const std::string &actor_name) {
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  if (phase_ == StepPhase::kServe) {
+    const auto &iter = current_plan_->slots_.find(device_tensor);
+    if (iter == current_plan_->slots_.end()) {
+      return false;
+    }
+    auto &slot = iter->second;
+    // The size may exceed the plan when the output shape depends on the input values.
+    if ((slot.producer_ != actor_name) || (device_tensor->GetSize() > slot.size_) ||
+        (slot.served_device_tensor_ != nullptr)) {
+      return false;
+    }
+    device_tensor->set_ptr(static_cast<uint8_t *>(arena_) + slot.offset_);
+    device_tensor->set_from_mem_pool(false);
+    slot.served_device_tensor_ = device_tensor;
+    return true;
+  }
+
+  if (phase_ == StepPhase::kRecord) {
+    const auto &actor_iter = actor_indexes_.find(actor_name);
+    std::lock_guard<std::mutex> locker(trace_mutex_);
+    auto &trace = traces_[device_tensor];
+    // The device tensor allocated repeatedly in one step can't be planned.
+    if ((trace.size_ != 0) || (actor_iter == actor_indexes_.end()) || (device_tensor->GetSize() == 0)) {
+      trace.is_valid_ = false;
+    } else {
+      trace.producer_ = actor_iter->second;
+      trace.size_ = device_tensor->GetSize();
+    }
+  }
+  return false;
+}
+
+bool DynamicMemoryPlanner::Free(DeviceTensor *const device_tensor) {
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  if (phase_ == StepPhase::kRecord) {
+    std::lock_guard<std::mutex> locker(trace_mutex_);
+    const auto &iter = traces_.find(device_tensor);
+    if (iter != traces_.end()) {
+      iter->second.is_freed_ = true;
+    }
+    return false;
+  }
+
+  if (!IsInArena(device_tensor->GetPtr())) {
+    return false;
+  }
+  device_tensor->set_ptr(nullptr);
+  return true;
+}
+
+void DynamicMemoryPlanner::RecordUser(const DeviceTensor *device_tensor, const std::string &actor_name) {
+  if (phase_ != StepPhase::kRecord) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(trace_mutex_);
+  const auto &iter = traces_.find(device_tensor);
+  if (iter == traces_.end()) {
+    return;
+  }
+  const auto &actor_iter = actor_indexes_.find(actor_name);
+  if (actor_iter == actor_indexes_.end()) {
+    iter->second.is_valid_ = false;
+    return;
+  }
+  (void)iter->second.users_.insert(actor_iter->second);
+}
+
+bool DynamicMemoryPlanner::CanReuse(const MemoryTrace &previous_trace, const MemoryTrace &next_trace) const {
+  // All the users have finished when the producer of next memory runs, includes the producer of previous memory.
+  for (auto user : previous_trace.users_) {
+    if (!reachable_actors_[user].IsBitTrue(next_trace.producer_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void DynamicMemoryPlanner::BuildPlan(MemoryPlan *const plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  // The memory which isn't freed in the step is used after the step, such as the graph output.
+  std::vector<std::pair<const DeviceTensor *, MemoryTrace *>> planned_traces;
+  for (auto &trace_iter : traces_) {
+    auto &trace = trace_iter.second;
+    if (trace.is_valid_ && trace.is_freed_ && (!trace.users_.empty())) {
+      (void)planned_traces.emplace_back(trace_iter.first, &trace);
+    }
+  }
+  if (planned_traces.empty()) {
+    plan->is_valid_ = false;
+    return;
+  }
+
+  // The bit of constraints[i] is true when the memory i and j can share the same memory.
+  somas::TensorsDescMap tensors;
+  std::vector<somas::DynamicBitSet> constraints;
+  constraints.reserve(planned_traces.size());
+  for (size_t i = 0; i < planned_traces.size(); ++i) {
+    (void)constraints.emplace_back(planned_traces.size());
+  }
+  for (size_t i = 0; i < planned_traces.size(); ++i) {
+    tensors[i] =
+      std::make_shared<somas::SomasSolverTensorDesc>(i, AlignArenaSize(planned_traces[i].second->size_), 0, false);
+    for (size_t j = 0; j < i; ++j) {
+      if (CanReuse(*planned_traces[i].second, *planned_traces[j].second) ||
+          CanReuse(*planned_traces[j].second, *planned_traces[i].second)) {
+        constraints[i].SetBitTrue(j);
+        constraints[j].SetBitTrue(i);
+      }
+    }
+  }
+
+  somas::SomasSolverCore solver(tensors, &constraints, 0, false);
+  solver.SetAllStrategies(false);
+  if (solver.MemoryAllocationSolver() != somas::SUCCESS) {
+    MS_LOG(INFO) << "Solve the memory plan of " << name_ << " failed.";
+    plan->is_valid_ = false;
+    return;
+  }
+
+  size_t total_size = 0;
+  for (size_t i = 0; i < planned_traces.size(); ++i) {
+    const auto &tensor_desc = tensors[i];
+    MS_EXCEPTION_IF_NULL(tensor_desc);
+    auto &slot = plan->slots_[planned_traces[i].first];
+    slot.offset_ = tensor_desc->offset_;
+    slot.size_ = tensor_desc->size_;
+    for (auto &actor_index : actor_indexes_) {
+      if (actor_index.second == planned_traces[i].second->producer_) {
+        slot.producer_ = actor_index.first;
+        break;
+      }
+    }
+    plan->size_ = std::max(plan->size_, slot.offset_ + slot.size_);
+    total_size += slot.size_;
+  }
+  MS_LOG(INFO) << "The memory plan of " << name_ << " has " << plan->slots_.size() << " device tensors, the arena size: "
+               << plan->size_ << ", the total size without reuse: " << total_size;
+}
+
+bool DynamicMemoryPlanner::PrepareArena(size_t size) {
+  if (arena_size_ >= size) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(device_context_);
+  MS_EXCEPTION_IF_NULL(device_context_->device_res_manager_);
+  if (arena_ != nullptr) {
+    device_context_->device_res_manager_->FreeMemory(arena_);
+    arena_ = nullptr;
+    arena_size_ = 0;
+  }
+  arena_ = device_context_->device_res_manager_->AllocateMemory(size);
+  if (arena_ == nullptr) {
+    MS_LOG(INFO) << "Allocate the memory arena of " << name_ << " failed, size: " << size;
+    return false;
+  }
+  arena_size_ = size;
+  return true;
+}
+
+void DynamicMemoryPlanner::CheckServedMemory(MemoryPlan *const plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  MS_EXCEPTION_IF_NULL(device_context_->device_res_manager_);
+  for (auto &slot_iter : plan->slots_) {
+    auto &slot = slot_iter.second;
+    auto device_tensor = slot.served_device_tensor_;
+    slot.served_device_tensor_ = nullptr;
+    if ((device_tensor == nullptr) || (!IsInArena(device_tensor->GetPtr()))) {
+      continue;
+    }
+
+    MS_LOG(INFO) << "The memory of " << slot.producer_ << " is still used after the step, invalidate the plan of "
+                 << name_;
+    plan->is_valid_ = false;
+    auto device_ptr = device_context_->device_res_manager_->AllocateMemory(device_tensor->GetSize());
+    if (device_ptr == nullptr) {
+      MS_LOG(EXCEPTION) << "Allocate memory failed for size: " << device_tensor->GetSize();
+    }
+    auto ret = memcpy_s(device_ptr, device_tensor->GetSize(), device_tensor->GetPtr(), device_tensor->GetSize());
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Memcpy failed, ret: " << ret;
+    }
+    device_tensor->set_ptr(device_ptr);
+    device_tensor->set_from_mem_pool(true);
+  }
+}
+
+bool DynamicMemoryPlanner::IsInArena(const void *ptr) const {
+  if ((arena_ == nullptr) || (ptr == nullptr)) {
+    return false;
+  }
+  auto begin = static_cast<const uint8_t *>(arena_);
+  auto addr = static_cast<const uint8_t *>(ptr);
+  return (addr >= begin) && (addr < begin + arena_size_);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_DYNAMIC_MEMORY_PLANNER_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_DYNAMIC_MEMORY_PLANNER_H_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <map>
+#include <set>
+#include <mutex>
+#include "utils/hash_map.h"
+#include "runtime/graph_scheduler/actor/abstract_actor.h"
+#include "runtime/hardware/device_context.h"
+#include "backend/common/somas/somas_solver_pre.h"
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace runtime {
+using mindspore::device::DeviceContext;
+using mindspore::tensor::TensorPtr;
+
+// The dynamic memory planner is used by the dynamic shape graphs on the CPU device, which can't be planned by the SOMAS
+// in the graph compiling. The kernel memory allocation and free of the first step with new input shapes are recorded,
+// then the memory offsets are solved by the SOMAS solver with the reuse constraints from the actor dependencies. The
+// following steps with the same input shapes serve the planned kernel memory from one contiguous arena, and the
+// memory which is not planned or mismatches the plan falls back to the memory pool.
+class DynamicMemoryPlanner {
+ public:
+  DynamicMemoryPlanner(const std::string &name, const DeviceContext *device_context)
+      : name_(name), device_context_(device_context) {}
+  ~DynamicMemoryPlanner();
+
+  // Build the reachability of actors by the input arrows, the memory can be reused only when the producer of the next
+  // memory is reachable from all the users of the previous memory.
+  void Init(const std::vector<AbstractActorPtr> &actors);
+
+  // Called before and after running one step, the plan of step is selected by the shapes of input tensors.
+  void BeginStep(const std::vector<std::vector<TensorPtr>> &input_tensors);
+  void EndStep(bool is_success);
+
+  // Serve the memory of device tensor from the arena, return false if the memory needs to be allocated from the pool.
+  bool Allocate(DeviceTensor *const device_tensor, const std::string &actor_name);
+  // Return the memory of device tensor to the arena, return false if the memory needs to be freed to the pool.
+  bool Free(DeviceTensor *const device_tensor);
+  // Record the actor which decreases the reference count of device tensor in the recording step.
+  void RecordUser(const DeviceTensor *device_tensor, const std::string &actor_name);
+
+ private:
+  // The phase of the current step.
+  enum class StepPhase { kIdle, kRecord, kServe };
+
+  // The allocation trace of device tensor in the recording step.
+  struct MemoryTrace {
+    size_t producer_{0};
+    size_t size_{0};
+    std::set<size_t> users_;
+    bool is_freed_{false};
+    bool is_valid_{true};
+  };
+
+  // The memory slot in the arena. The device tensor pointer is used to find the slot and the producer name is used to
+  // check whether the device tensor is the planned one.
+  struct MemorySlot {
+    std::string producer_;
+    size_t offset_{0};
+    size_t size_{0};
+    DeviceTensor *served_device_tensor_{nullptr};
+  };
+
+  struct MemoryPlan {
+    mindspore::HashMap<const DeviceTensor *, MemorySlot> slots_;
+    size_t size_{0};
+    bool is_valid_{true};
+  };
+
+  void BuildPlan(MemoryPlan *const plan);
+  bool CanReuse(const MemoryTrace &previous_trace, const MemoryTrace &next_trace) const;
+  bool PrepareArena(size_t size);
+  // The served memory which is still used after the step is moved to the memory pool, and the plan is invalidated.
+  void CheckServedMemory(MemoryPlan *const plan);
+  bool IsInArena(const void *ptr) const;
+
+  std::string name_;
+  const DeviceContext *device_context_;
+
+  mindspore::HashMap<std::string, size_t> actor_indexes_;
+  // The bit of reachable_actors_[i] is true when the actor is reachable from the actor i by the arrows.
+  std::vector<somas::DynamicBitSet> reachable_actors_;
+
+  // The plans are keyed by the shapes of input tensors.
+  std::map<std::vector<int64_t>, MemoryPlan> plans_;
+  MemoryPlan *current_plan_{nullptr};
+  StepPhase phase_{StepPhase::kIdle};
+
+  // The traces of the recording step, which is recorded concurrently by the actors.
+  mindspore::HashMap<const DeviceTensor *, MemoryTrace> traces_;
+  std::mutex trace_mutex_;
+
+  void *arena_{nullptr};
+  size_t arena_size_{0};
+};
+using DynamicMemoryPlannerPtr = std::shared_ptr<DynamicMemoryPlanner>;
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_DYNAMIC_MEMORY_PLANNER_H_
@@ -878,10 +878,14 @@ void GraphCompiler::BuildSingleOpGraphs(const std::vector<KernelGraphPtr> &graph
   std::vector<CNodePtr> node_to_build;
   for (const auto &graph : graphs) {
     const auto &nodes = graph->execution_order();
-    (void)std::copy(nodes.begin(), nodes.end(), std::back_inserter(node_to_build));
+    // The kernels may be set from the op kernel cache already.
+    (void)std::copy_if(nodes.begin(), nodes.end(), std::back_inserter(node_to_build),
+                       [](const CNodePtr &node) { return AnfAlgo::GetKernelMod(node) == nullptr; });
   }
   // Kernel build
-  device_context->kernel_executor_->CreateKernel(node_to_build);
+  if (!node_to_build.empty()) {
+    device_context->kernel_executor_->CreateKernel(node_to_build);
+  }
 
   for (const auto &graph : graphs) {
     device_context->kernel_executor_->PreprocessBeforeRun(graph);
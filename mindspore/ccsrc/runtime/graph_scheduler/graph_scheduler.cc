@@ -24,6 +24,8 @@
 #include "runtime/graph_scheduler/optimizer/invalid_data_arrow_elimination.h"
 #include "runtime/graph_scheduler/optimizer/batch_data_arrow_fusion.h"
 #include "runtime/graph_scheduler/optimizer/multi_actor_fusion.h"
+#include "runtime/graph_scheduler/optimizer/static_schedule_generation.h"
+#include "runtime/graph_scheduler/optimizer/cost_guided_actor_fusion.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "mindrt/src/actor/actormgr.h"
 #include "mindrt/include/async/async.h"
@@ -79,6 +81,17 @@ using distributed::recovery::RecoveryContext;
 namespace {
 constexpr char kNumaEnableEnv[] = "MS_ENABLE_NUMA";
 constexpr char kNumaEnableEnv2[] = "DATASET_ENABLE_NUMA";
+// The static schedule mode of kernel actors: "1" launches kernels in the topological order, "2" launches the kernels of
+// the same topological level concurrently.
+constexpr char kStaticScheduleEnv[] = "MS_DEV_STATIC_SCHEDULE";
+// Fuse the kernel actors by the profiled launch time instead of the structural fusion when the env is set to "1", and
+// the launch profile is kept by MS_DEV_COST_GUIDED_ACTOR_FUSION_PROFILE for the next process.
+constexpr char kCostGuidedFusionEnv[] = "MS_DEV_COST_GUIDED_ACTOR_FUSION";
+// The launch time of kernel actors is profiled in the step before the statistics of the thread execution strategy, when
+// the parallel search of cpu kernels is nearly finished.
+constexpr size_t kCostGuidedFusionProfileCount = ActorDispatcher::kMultiThreadExecutionCountBegin - 1;
+// Plan the kernel memory of dynamic shape graphs on the CPU device by the input shapes when the env is set to "1".
+constexpr char kDynamicMemoryPlanEnv[] = "MS_DEV_DYNAMIC_MEMORY_PLAN";
 
 // For the transform state synchronization.
 constexpr char kTransformFinishPrefix[] = "TRANSFORM_FINISH_";
@@ -120,6 +133,16 @@ bool IsNeedInsertCopyActor(const DeviceContext *from_device_context, const Devic
   }
 }
 
+StaticScheduleMode GetStaticScheduleMode() {
+  const auto &mode = common::GetEnv(kStaticScheduleEnv);
+  if (mode == "1") {
+    return StaticScheduleMode::kInOrder;
+  } else if (mode == "2") {
+    return StaticScheduleMode::kByLevel;
+  }
+  return StaticScheduleMode::kDisable;
+}
+
 inline bool IsSingleOpActorSet(const ActorSet *actor_set) {
   MS_EXCEPTION_IF_NULL(actor_set);
   return actor_set->kernel_actors_.size() == 1;
@@ -268,6 +291,44 @@ void DoDisasterRecovery(const std::string &actor_set_name) {
   }
 }
 #endif
+
+// Serve the kernel memory of one step by the memory planner, the planner is detached from the memory manager actor and
+// the step is ended as failed when leaving the running by the exception.
+class MemoryPlannerStepGuard {
+ public:
+  MemoryPlannerStepGuard(MemoryManagerActor *memory_manager_actor, DynamicMemoryPlanner *memory_planner,
+                         const std::vector<std::vector<TensorPtr>> &input_tensors)
+      : memory_manager_actor_(memory_manager_actor), memory_planner_(memory_planner) {
+    MS_EXCEPTION_IF_NULL(memory_manager_actor_);
+    MS_EXCEPTION_IF_NULL(memory_planner_);
+    memory_planner_->BeginStep(input_tensors);
+    memory_manager_actor_->set_memory_planner(memory_planner_);
+  }
+  ~MemoryPlannerStepGuard() {
+    if (memory_planner_ == nullptr) {
+      return;
+    }
+    try {
+      EndStep(false);
+    } catch (const std::exception &e) {
+      MS_LOG(ERROR) << "End the failed step of memory planner failed: " << e.what();
+    }
+  }
+
+  void EndStep(bool is_success) {
+    if (memory_planner_ == nullptr) {
+      return;
+    }
+    memory_manager_actor_->set_memory_planner(nullptr);
+    auto memory_planner = memory_planner_;
+    memory_planner_ = nullptr;
+    memory_planner->EndStep(is_success);
+  }
+
+ private:
+  MemoryManagerActor *memory_manager_actor_;
+  DynamicMemoryPlanner *memory_planner_;
+};
 }  // namespace
 
 GraphScheduler &GraphScheduler::GetInstance() noexcept {
@@ -512,7 +573,10 @@ ActorSet *GraphScheduler::Transform(const GraphCompilerInfo &graph_compiler_info
     SchedulerHelper::CheckActorValid(actor_set.get());
   }
 
+  InitStaticSchedule(actor_set.get(), graph_compiler_info);
+  InitCostGuidedFusion(actor_set.get(), graph_compiler_info);
   Optimize(actor_set);
+  InitDynamicMemoryPlanner(actor_set.get(), graph_compiler_info);
   MS_LOG(INFO) << "Graph(" << graph_compiler_info.name_ << ") transforms actor end.";
 
 #ifdef WITH_BACKEND
@@ -605,6 +669,26 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<std::vecto
     thread_pool->SetSpinCountMaxValue();
   }
   ActorDispatcher::set_is_multi_thread_execution(actor_set->is_multi_thread_execution_);
+  // Profile the launch time of kernel actors in the warm-up step for the cost guided fusion of the next transform.
+  bool is_launch_time_profiled =
+    actor_set->is_launch_time_profiled_ && (actor_set->execution_count_ + 1 == kCostGuidedFusionProfileCount);
+  if (is_launch_time_profiled) {
+    for (auto &kernel_actor : actor_set->kernel_actors_) {
+      MS_EXCEPTION_IF_NULL(kernel_actor);
+      kernel_actor->set_is_launch_time_profiled(true);
+    }
+  }
+  // The memory manager actor serves the kernel memory by the plan of the actor set in the running.
+  std::unique_ptr<MemoryPlannerStepGuard> memory_planner_step_guard = nullptr;
+  if (actor_set->memory_planner_ != nullptr) {
+    const auto &actor = ActorMgr::GetActorMgrRef()->GetActor(memory_manager_aid_);
+    auto memory_manager_actor = dynamic_cast<MemoryManagerActor *>(actor.get());
+    memory_planner_step_guard = std::make_unique<MemoryPlannerStepGuard>(
+      memory_manager_actor, actor_set->memory_planner_.get(), input_tensors);
+  }
+  if (actor_set->static_schedule_ != nullptr) {
+    actor_set->static_schedule_->Reset();
+  }
   double start_time = GetTime();
   ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
                         &op_context, GraphExecutionStrategy::kPipeline);
@@ -626,14 +710,27 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<std::vecto
     std::condition_variable thread_blocker;
     const int64_t kTimeToWait = 2;
     (void)thread_blocker.wait_for(locker, std::chrono::seconds(kTimeToWait));
+    if (memory_planner_step_guard != nullptr) {
+      memory_planner_step_guard->EndStep(false);
+    }
     // May set exception in the wait time, need throw the exception to avoid affecting the next execution.
     MsException::Instance().CheckException();
     MS_LOG(EXCEPTION) << op_context.error_info_;
   }
+  if (memory_planner_step_guard != nullptr) {
+    memory_planner_step_guard->EndStep(true);
+  }
 
   double end_time = GetTime();
   const size_t kSecondsToMilliseconds = 1000;
   SetActorExecutionStrategy(actor_set, strategy, (end_time - start_time) * kSecondsToMilliseconds);
+  if (is_launch_time_profiled) {
+    for (auto &kernel_actor : actor_set->kernel_actors_) {
+      kernel_actor->set_is_launch_time_profiled(false);
+    }
+    CostGuidedActorFusion::RecordLaunchProfile(actor_set);
+    actor_set->is_launch_time_profiled_ = false;
+  }
 
 #ifdef WITH_BACKEND
   DoDisasterRecovery(actor_set->name_);
@@ -823,11 +920,127 @@ void GraphScheduler::Optimize(const ActorSetPtr &actor_set) const {
   auto optimizer = std::make_shared<ActorSetOptimizer>();
   MS_EXCEPTION_IF_NULL(optimizer);
   optimizer->AddPass(std::make_shared<InvalidDataArrowElimination>());
+  optimizer->AddPass(std::make_shared<StaticScheduleGeneration>());
+  optimizer->AddPass(std::make_shared<CostGuidedActorFusion>());
   optimizer->AddPass(std::make_shared<MultiActorFusion>());
   optimizer->AddPass(std::make_shared<BatchDataArrowFusion>());
   optimizer->Optimize(actor_set);
 }
 
+void GraphScheduler::InitStaticSchedule(ActorSet *const actor_set, const GraphCompilerInfo &graph_compiler_info) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  auto mode = GetStaticScheduleMode();
+  if (mode == StaticScheduleMode::kDisable) {
+    return;
+  }
+
+  // The static schedule only supports the fully static graphs on the CPU device without control flow.
+  if ((graph_compiler_info.strategy_ != GraphExecutionStrategy::kPipeline) || (debug_aid_ != nullptr) ||
+      (actor_set->control_actors_ != nullptr) || (!actor_set->copy_actors_.empty()) ||
+      (!actor_set->custom_actors_.empty()) || (!actor_set->super_kernel_actors_.empty()) ||
+      (actor_set->kernel_actors_.size() <= 1)) {
+    return;
+  }
+  if ((graph_compiler_info.control_node_parser_ != nullptr) && graph_compiler_info.control_node_parser_->IsInited()) {
+    return;
+  }
+#ifdef ENABLE_RPC_ACTOR
+  if (HaveRpcActors(actor_set)) {
+    return;
+  }
+#endif
+  for (size_t i = 0; i < graph_compiler_info.graphs_.size(); ++i) {
+    const auto &graph = graph_compiler_info.graphs_[i];
+    const auto &device_context = graph_compiler_info.device_contexts_[i];
+    MS_EXCEPTION_IF_NULL(graph);
+    MS_EXCEPTION_IF_NULL(device_context);
+    if (graph->is_dynamic_shape() || graph->is_graph_run_mode() ||
+        (device_context->GetDeviceType() != device::DeviceType::kCPU)) {
+      return;
+    }
+  }
+  for (const auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    if (common::AnfAlgo::IsDynamicShape(kernel_actor->kernel())) {
+      return;
+    }
+  }
+
+  MS_LOG(INFO) << "The actor set " << actor_set->name_
+               << " enables the static schedule, mode: " << static_cast<int>(mode);
+  actor_set->static_schedule_ = std::make_shared<StaticSchedule>(actor_set->name_, mode);
+}
+
+void GraphScheduler::InitCostGuidedFusion(ActorSet *const actor_set,
+                                          const GraphCompilerInfo &graph_compiler_info) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  if (common::GetEnv(kCostGuidedFusionEnv) != "1") {
+    return;
+  }
+
+  // The cost guided fusion only supports the kernel actors without control flow.
+  if ((graph_compiler_info.strategy_ != GraphExecutionStrategy::kPipeline) ||
+      (actor_set->static_schedule_ != nullptr) || (actor_set->control_actors_ != nullptr) ||
+      (!actor_set->custom_actors_.empty()) || (actor_set->kernel_actors_.size() <= 1)) {
+    return;
+  }
+  // The actors are fused in the optimize by the launch profile, or the launch time is profiled in the running for the
+  // next transform.
+  if (CostGuidedActorFusion::HasLaunchProfile(actor_set->name_)) {
+    MS_LOG(INFO) << "The actor set " << actor_set->name_ << " enables the cost guided fusion.";
+    actor_set->is_cost_guided_fusion_ = true;
+  } else {
+    MS_LOG(INFO) << "The actor set " << actor_set->name_ << " profiles the launch time for the cost guided fusion.";
+    actor_set->is_launch_time_profiled_ = true;
+  }
+}
+
+void GraphScheduler::InitDynamicMemoryPlanner(ActorSet *const actor_set,
+                                              const GraphCompilerInfo &graph_compiler_info) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  if (common::GetEnv(kDynamicMemoryPlanEnv) != "1") {
+    return;
+  }
+
+  // The memory plan is keyed by the input shapes, only the dynamic shape CPU graphs without control flow are planned.
+  if ((graph_compiler_info.strategy_ != GraphExecutionStrategy::kPipeline) ||
+      (actor_set->control_actors_ != nullptr) || (actor_set->kernel_actors_.empty())) {
+    return;
+  }
+  if ((graph_compiler_info.control_node_parser_ != nullptr) && graph_compiler_info.control_node_parser_->IsInited()) {
+    return;
+  }
+#ifdef ENABLE_RPC_ACTOR
+  if (HaveRpcActors(actor_set)) {
+    return;
+  }
+#endif
+  bool is_dynamic_shape = false;
+  for (size_t i = 0; i < graph_compiler_info.graphs_.size(); ++i) {
+    const auto &graph = graph_compiler_info.graphs_[i];
+    const auto &device_context = graph_compiler_info.device_contexts_[i];
+    MS_EXCEPTION_IF_NULL(graph);
+    MS_EXCEPTION_IF_NULL(device_context);
+    if (device_context->GetDeviceType() != device::DeviceType::kCPU) {
+      return;
+    }
+    is_dynamic_shape = is_dynamic_shape || graph->is_dynamic_shape();
+  }
+  if (!is_dynamic_shape) {
+    return;
+  }
+
+  const auto &kernel_actor = actor_set->kernel_actors_[0];
+  MS_EXCEPTION_IF_NULL(kernel_actor);
+  if (kernel_actor->device_contexts().empty()) {
+    return;
+  }
+  MS_LOG(INFO) << "The actor set " << actor_set->name_ << " enables the dynamic memory plan.";
+  actor_set->memory_planner_ =
+    std::make_shared<DynamicMemoryPlanner>(actor_set->name_, kernel_actor->device_contexts()[0]);
+  actor_set->memory_planner_->Init(SchedulerHelper::CollectActors(actor_set));
+}
+
 std::vector<DataSourceActorPtr> GraphScheduler::BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
                                                                      const HostTensorQueuePtr &host_queue) {
   std::vector<DataSourceActorPtr> data_source_actors;
@@ -96,6 +96,13 @@ class BACKEND_EXPORT GraphScheduler {
   void Link(ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info);
   // Optimize the actor DAG. For example, erase invalid data arrow, etc.
   void Optimize(const ActorSetPtr &actor_set) const;
+  // Enable the static schedule for the actor set of fully static CPU graphs, the schedule is generated in the optimize.
+  void InitStaticSchedule(ActorSet *const actor_set, const GraphCompilerInfo &graph_compiler_info) const;
+  // Enable the cost guided fusion for the actor set which has the launch profile, which replaces the structural fusion
+  // in the optimize, otherwise profile the launch time in the warm-up step.
+  void InitCostGuidedFusion(ActorSet *const actor_set, const GraphCompilerInfo &graph_compiler_info) const;
+  // Enable the dynamic memory planner for the actor set of dynamic shape CPU graphs.
+  void InitDynamicMemoryPlanner(ActorSet *const actor_set, const GraphCompilerInfo &graph_compiler_info) const;
 
   // The processing of actors build.
   std::vector<DataSourceActorPtr> BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
@@ -0,0 +1,422 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/optimizer/cost_guided_actor_fusion.h"
+#include <cstdio>
+#include <vector>
+#include <queue>
+#include <set>
+#include <string>
+#include <limits>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include "utils/hash_map.h"
+#include "utils/ms_utils.h"
+#include "runtime/graph_scheduler/scheduler_helper.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The max actors num in fusion actor.
+constexpr size_t kCostGuidedFusionMaxNum = 1000;
+constexpr double kSecondsToMicroseconds = 1000000;
+constexpr char kCostGuidedFusionProfileEnv[] = "MS_DEV_COST_GUIDED_ACTOR_FUSION_PROFILE";
+// The key of the dispatch cost in the launch profile, which is not the name of any actor.
+constexpr char kDispatchCostKey[] = "#dispatch_cost";
+
+// The launch time of the kernel actors and the dispatch cost between them, and the time unit is second.
+using LaunchProfile = mindspore::HashMap<std::string, double>;
+
+// Process-wide store of the launch profiles keyed by the actor set name. If MS_DEV_COST_GUIDED_ACTOR_FUSION_PROFILE is
+// set, the profiles are loaded from that file at startup and the file is rewritten with all the profiles when a new one
+// is recorded, so that the next process fuses the actors in the transform.
+class LaunchProfileStore {
+ public:
+  static LaunchProfileStore &GetInstance() {
+    static LaunchProfileStore instance;
+    return instance;
+  }
+
+  bool Get(const std::string &actor_set_name, LaunchProfile *profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = profiles_.find(actor_set_name);
+    if (iter == profiles_.end()) {
+      return false;
+    }
+    if (profile != nullptr) {
+      *profile = iter->second;
+    }
+    return true;
+  }
+
+  void Put(const std::string &actor_set_name, const LaunchProfile &profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    profiles_[actor_set_name] = profile;
+    if (file_path_.empty()) {
+      return;
+    }
+    // Rewrite the whole file by the temporary file, so the file keeps one profile per actor set and is never left
+    // partially written.
+    std::string temp_file_path = file_path_ + ".tmp";
+    {
+      std::ofstream ofs(temp_file_path, std::ios::trunc);
+      if (!ofs.is_open()) {
+        MS_LOG(WARNING) << "Open the launch profile file " << temp_file_path << " failed.";
+        return;
+      }
+      ofs.precision(std::numeric_limits<double>::max_digits10);
+      for (auto &profile_iter : profiles_) {
+        for (auto &iter : profile_iter.second) {
+          ofs << profile_iter.first << '\t' << iter.first << '\t' << iter.second << '\n';
+        }
+      }
+      if (!ofs.good()) {
+        MS_LOG(WARNING) << "Write the launch profile file " << temp_file_path << " failed.";
+        return;
+      }
+    }
+    if (std::rename(temp_file_path.c_str(), file_path_.c_str()) != 0) {
+      MS_LOG(WARNING) << "Rename the launch profile file " << temp_file_path << " to " << file_path_ << " failed.";
+    }
+  }
+
+ private:
+  LaunchProfileStore() : file_path_(common::GetEnv(kCostGuidedFusionProfileEnv)) {
+    if (file_path_.empty()) {
+      return;
+    }
+    std::ifstream ifs(file_path_);
+    if (!ifs.is_open()) {
+      return;
+    }
+    // Each line is "actor_set_name\tactor_name\tcost".
+    std::string actor_set_name;
+    std::string actor_name;
+    std::string cost;
+    while (std::getline(ifs, actor_set_name, '\t') && std::getline(ifs, actor_name, '\t') && std::getline(ifs, cost)) {
+      try {
+        profiles_[actor_set_name][actor_name] = std::stod(cost);
+      } catch (const std::exception &) {
+        MS_LOG(WARNING) << "Invalid launch profile of actor " << actor_name << " in file " << file_path_;
+      }
+    }
+    MS_LOG(INFO) << "Load the launch profiles of " << profiles_.size() << " actor sets from " << file_path_;
+  }
+  ~LaunchProfileStore() = default;
+
+  std::mutex mutex_;
+  std::string file_path_;
+  mindspore::HashMap<std::string, LaunchProfile> profiles_;
+};
+
+struct KernelActorCostInfo {
+  KernelActorCostInfo(const KernelActorPtr &actor, double cost) : actor_(actor), cost_(cost) {}
+  KernelActorPtr actor_;
+  // The launch time profiled in the warm-up step.
+  double cost_;
+  // The indexes of the input and output kernel actors which can be fused.
+  std::vector<size_t> input_indexes_;
+  std::vector<size_t> output_indexes_;
+  // The number of all the output actors, including the actors which can't be fused.
+  size_t output_actors_num_{0};
+  // The index of the only input actor, which is valid when has_only_input_ is true.
+  bool has_only_input_{false};
+  size_t only_input_index_{0};
+  size_t group_id_{0};
+  // The total cost of the actors behind this actor in the same group. These actors run inline before this actor
+  // sends the remaining outputs, so delay the actors outside of the group.
+  double inline_cost_{0};
+};
+
+struct FusionGroup {
+  std::vector<size_t> members_;
+  // The delay which the actors in front of the group can still accept by the inline running of the appending actors.
+  double slack_{std::numeric_limits<double>::max()};
+};
+
+bool IsFusionCandidate(const KernelActorPtr &kernel_actor) {
+  MS_EXCEPTION_IF_NULL(kernel_actor);
+  if ((kernel_actor->type() != KernelTransformType::kKernelActor) || (kernel_actor->parent_fusion_actor() != nullptr)) {
+    return false;
+  }
+  // The batch output data is recorded by the name of destination actor, which is changed to the fusion actor.
+  for (auto &input_data_arrow_aid : kernel_actor->input_data_arrow_aids()) {
+    MS_EXCEPTION_IF_NULL(input_data_arrow_aid.second);
+    if (TEST_FLAG(input_data_arrow_aid.second->flag_, kOutputDataFlagBatch)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Collect the cost infos of the kernel actors which can be fused, and return false if any of them isn't profiled.
+bool CollectCostInfos(const ActorSet *actor_set, const LaunchProfile &profile,
+                      std::vector<KernelActorCostInfo> *const cost_infos_ptr) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  MS_EXCEPTION_IF_NULL(cost_infos_ptr);
+  auto &cost_infos = *cost_infos_ptr;
+  mindspore::HashMap<std::string, size_t> actor_indexes;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    if (!IsFusionCandidate(kernel_actor)) {
+      continue;
+    }
+    const auto &iter = profile.find(kernel_actor->GetAID().Name());
+    if (iter == profile.end()) {
+      MS_LOG(INFO) << "The kernel actor " << kernel_actor->GetAID().Name() << " of actor set " << actor_set->name_
+                   << " isn't profiled.";
+      return false;
+    }
+    actor_indexes[kernel_actor->GetAID().Name()] = cost_infos.size();
+    (void)cost_infos.emplace_back(kernel_actor, iter->second);
+  }
+
+  for (size_t i = 0; i < cost_infos.size(); ++i) {
+    auto &cost_info = cost_infos[i];
+    const auto &actor = cost_info.actor_;
+    std::set<std::string> output_actor_names;
+    for (auto &output_data_arrow : actor->output_data_arrows()) {
+      MS_EXCEPTION_IF_NULL(output_data_arrow);
+      (void)output_actor_names.insert(output_data_arrow->to_op_id_.Name());
+    }
+    for (auto &output_control_arrow : actor->output_control_arrows()) {
+      MS_EXCEPTION_IF_NULL(output_control_arrow);
+      (void)output_actor_names.insert(output_control_arrow->to_op_id_.Name());
+    }
+    cost_info.output_actors_num_ = output_actor_names.size();
+    for (auto &output_actor_name : output_actor_names) {
+      const auto &iter = actor_indexes.find(output_actor_name);
+      if (iter != actor_indexes.end()) {
+        (void)cost_info.output_indexes_.emplace_back(iter->second);
+        (void)cost_infos[iter->second].input_indexes_.emplace_back(i);
+      }
+    }
+
+    std::set<std::string> input_actor_names;
+    for (auto &input_data_arrow_aid : actor->input_data_arrow_aids()) {
+      (void)input_actor_names.insert(input_data_arrow_aid.first.Name());
+    }
+    for (auto &input_control_arrow_aid : actor->input_control_arrow_aids()) {
+      (void)input_actor_names.insert(input_control_arrow_aid.first.Name());
+    }
+    if (input_actor_names.size() == 1) {
+      const auto &iter = actor_indexes.find(*input_actor_names.begin());
+      if (iter != actor_indexes.end()) {
+        cost_info.has_only_input_ = true;
+        cost_info.only_input_index_ = iter->second;
+      }
+    }
+  }
+  return true;
+}
+
+// Get the topological order of the kernel actors by the arrows between them.
+std::vector<size_t> GetTopologicalOrder(const std::vector<KernelActorCostInfo> &cost_infos) {
+  std::vector<size_t> input_nums(cost_infos.size());
+  std::queue<size_t> ready_indexes;
+  for (size_t i = 0; i < cost_infos.size(); ++i) {
+    input_nums[i] = cost_infos[i].input_indexes_.size();
+    if (input_nums[i] == 0) {
+      ready_indexes.push(i);
+    }
+  }
+
+  std::vector<size_t> topological_order;
+  while (!ready_indexes.empty()) {
+    auto index = ready_indexes.front();
+    ready_indexes.pop();
+    (void)topological_order.emplace_back(index);
+    for (auto output_index : cost_infos[index].output_indexes_) {
+      if (--input_nums[output_index] == 0) {
+        ready_indexes.push(output_index);
+      }
+    }
+  }
+  return topological_order;
+}
+
+std::vector<FusionGroup> GroupActorsByCost(const std::vector<size_t> &topological_order, double dispatch_cost,
+                                           std::vector<KernelActorCostInfo> *const cost_infos) {
+  MS_EXCEPTION_IF_NULL(cost_infos);
+  std::vector<FusionGroup> groups;
+  for (auto index : topological_order) {
+    auto &cost_info = (*cost_infos)[index];
+    if (cost_info.has_only_input_) {
+      auto &input_cost_info = (*cost_infos)[cost_info.only_input_index_];
+      auto &group = groups[input_cost_info.group_id_];
+      // Only the consecutive actors are fused, so the actors in the group keep the original serial execution.
+      if ((group.members_.back() == cost_info.only_input_index_) && (group.members_.size() < kCostGuidedFusionMaxNum)) {
+        // The fused actor delays the other outputs of the actors in front of it, and the delay is acceptable when it
+        // doesn't exceed the dispatch cost saved by the fusion.
+        double slack = group.slack_;
+        if (input_cost_info.output_actors_num_ > 1) {
+          slack = std::min(slack, dispatch_cost);
+        }
+        if (cost_info.cost_ <= slack) {
+          group.slack_ = slack - cost_info.cost_;
+          (void)group.members_.emplace_back(index);
+          cost_info.group_id_ = input_cost_info.group_id_;
+          continue;
+        }
+      }
+    }
+
+    cost_info.group_id_ = groups.size();
+    (void)groups.emplace_back();
+    (void)groups.back().members_.emplace_back(index);
+  }
+
+  for (auto &group : groups) {
+    double inline_cost = 0;
+    for (auto iter = group.members_.rbegin(); iter != group.members_.rend(); ++iter) {
+      (*cost_infos)[*iter].inline_cost_ = inline_cost;
+      inline_cost += (*cost_infos)[*iter].cost_;
+    }
+  }
+  return groups;
+}
+
+// Estimate the critical path of kernel actors by the launch time and the dispatch cost between the actors which are
+// not in the same group.
+double EstimateCriticalPath(const std::vector<KernelActorCostInfo> &cost_infos,
+                            const std::vector<size_t> &topological_order, double dispatch_cost, bool is_fused) {
+  std::vector<double> finish_times(cost_infos.size(), 0);
+  double critical_path = 0;
+  for (auto index : topological_order) {
+    auto &cost_info = cost_infos[index];
+    double begin_time = 0;
+    for (auto input_index : cost_info.input_indexes_) {
+      auto &input_cost_info = cost_infos[input_index];
+      double arrive_time = finish_times[input_index];
+      if (!is_fused) {
+        arrive_time += dispatch_cost;
+      } else if (input_cost_info.group_id_ != cost_info.group_id_) {
+        arrive_time += dispatch_cost + input_cost_info.inline_cost_;
+      }
+      begin_time = std::max(begin_time, arrive_time);
+    }
+    finish_times[index] = begin_time + cost_info.cost_;
+    critical_path = std::max(critical_path, finish_times[index]);
+  }
+  return critical_path;
+}
+}  // namespace
+
+bool CostGuidedActorFusion::HasLaunchProfile(const std::string &actor_set_name) {
+  return LaunchProfileStore::GetInstance().Get(actor_set_name, nullptr);
+}
+
+void CostGuidedActorFusion::RecordLaunchProfile(const ActorSet *actor_set) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  LaunchProfile profile;
+  mindspore::HashMap<std::string, KernelActor *> kernel_actors;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    profile[kernel_actor->GetAID().Name()] = kernel_actor->launch_time();
+    kernel_actors[kernel_actor->GetAID().Name()] = kernel_actor.get();
+  }
+
+  // The dispatch cost is the average time from the input actor finishing the kernel launch to the output actor
+  // beginning to run, which is saved when the two actors are fused. The actors fused by the structural fusion are
+  // excluded.
+  double total_dispatch_cost = 0;
+  size_t dispatch_num = 0;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    std::set<std::string> input_actor_names;
+    for (auto &input_data_arrow_aid : kernel_actor->input_data_arrow_aids()) {
+      (void)input_actor_names.insert(input_data_arrow_aid.first.Name());
+    }
+    for (auto &input_control_arrow_aid : kernel_actor->input_control_arrow_aids()) {
+      (void)input_actor_names.insert(input_control_arrow_aid.first.Name());
+    }
+    if (input_actor_names.size() != 1) {
+      continue;
+    }
+    const auto &iter = kernel_actors.find(*input_actor_names.begin());
+    if (iter == kernel_actors.end()) {
+      continue;
+    }
+    auto parent_fusion_actor = kernel_actor->parent_fusion_actor();
+    if ((parent_fusion_actor != nullptr) && (parent_fusion_actor == iter->second->parent_fusion_actor())) {
+      continue;
+    }
+    total_dispatch_cost += std::max(kernel_actor->run_begin_time() - iter->second->launch_end_time(), 0.0);
+    ++dispatch_num;
+  }
+  profile[kDispatchCostKey] = (dispatch_num == 0) ? 0 : (total_dispatch_cost / dispatch_num);
+  LaunchProfileStore::GetInstance().Put(actor_set->name_, profile);
+  MS_LOG(INFO) << "Record the launch profile of actor set " << actor_set->name_ << ", kernel actors num: "
+               << kernel_actors.size() << ", dispatch cost: " << profile[kDispatchCostKey] * kSecondsToMicroseconds
+               << " us.";
+}
+
+void CostGuidedActorFusion::Process(ActorSet *const actor_set, AbstractActor *const) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  if (!actor_set->is_cost_guided_fusion_) {
+    return;
+  }
+  // Fall back to the structural fusion if the cost guided fusion can't be applied.
+  actor_set->is_cost_guided_fusion_ = false;
+
+  LaunchProfile profile;
+  std::vector<KernelActorCostInfo> cost_infos;
+  if (!LaunchProfileStore::GetInstance().Get(actor_set->name_, &profile) ||
+      !CollectCostInfos(actor_set, profile, &cost_infos)) {
+    return;
+  }
+  auto topological_order = GetTopologicalOrder(cost_infos);
+  if (topological_order.size() != cost_infos.size()) {
+    MS_LOG(INFO) << "The kernel actors of actor set " << actor_set->name_ << " have the cycle arrows.";
+    return;
+  }
+  auto dispatch_cost = profile[kDispatchCostKey];
+  auto groups = GroupActorsByCost(topological_order, dispatch_cost, &cost_infos);
+  auto unfused_critical_path = EstimateCriticalPath(cost_infos, topological_order, dispatch_cost, false);
+  auto fused_critical_path = EstimateCriticalPath(cost_infos, topological_order, dispatch_cost, true);
+  MS_LOG(INFO) << "The cost guided fusion of actor set " << actor_set->name_ << ", the dispatch cost: "
+               << dispatch_cost * kSecondsToMicroseconds
+               << " us, the critical path estimate: " << unfused_critical_path * kSecondsToMicroseconds
+               << " us before fusion and " << fused_critical_path * kSecondsToMicroseconds << " us after fusion.";
+  if (fused_critical_path >= unfused_critical_path) {
+    MS_LOG(INFO) << "The cost guided fusion doesn't shorten the critical path of actor set " << actor_set->name_;
+    return;
+  }
+
+  size_t fused_actors_num = 0;
+  size_t fusion_actors_num = 0;
+  for (auto &group : groups) {
+    if (group.members_.size() <= 1) {
+      continue;
+    }
+    std::vector<AbstractActorPtr> need_fused_actors;
+    for (auto index : group.members_) {
+      (void)need_fused_actors.emplace_back(cost_infos[index].actor_);
+    }
+    auto fusion_actor = SchedulerHelper::BuildFusionActor(need_fused_actors);
+    MS_EXCEPTION_IF_NULL(fusion_actor);
+    SchedulerHelper::AddArrowForFusionActor(fusion_actor.get());
+    (void)actor_set->fusion_actors_.emplace_back(fusion_actor);
+    MS_LOG(DEBUG) << "Build fusion actor " << fusion_actor->GetAID().Name() << " with " << group.members_.size()
+                  << " kernel actors, the first kernel actor: " << need_fused_actors.front()->GetAID().Name();
+    fused_actors_num += group.members_.size();
+    ++fusion_actors_num;
+  }
+  actor_set->is_cost_guided_fusion_ = true;
+  MS_LOG(INFO) << "The cost guided fusion of actor set " << actor_set->name_ << " fuses " << fused_actors_num
+               << " kernel actors to " << fusion_actors_num << " fusion actors.";
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,46 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_COST_GUIDED_ACTOR_FUSION_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_COST_GUIDED_ACTOR_FUSION_H_
+
+#include <memory>
+#include <string>
+#include "runtime/graph_scheduler/optimizer/optimizer.h"
+
+namespace mindspore {
+namespace runtime {
+// Fuse the consecutive cheap kernel actors to the fusion actor by the launch time profiled in the warm-up step of the
+// former running, and keep the expensive independent kernel actors running concurrently. The pass runs in the transform
+// before the actors are scheduled, and the fusion is applied only when the critical path estimate of the kernel actors
+// is shorter than the unfused one, otherwise the structural fusion is used.
+class CostGuidedActorFusion : public ActorPass {
+ public:
+  CostGuidedActorFusion() : ActorPass("cost_guided_actor_fusion", false) {}
+  ~CostGuidedActorFusion() override = default;
+
+  // Whether the launch time of the kernel actors in the actor set has been profiled.
+  static bool HasLaunchProfile(const std::string &actor_set_name);
+  // Record the launch time of the kernel actors and the dispatch cost between them profiled in the warm-up step.
+  static void RecordLaunchProfile(const ActorSet *actor_set);
+
+ protected:
+  void Process(ActorSet *const actor_set, AbstractActor *const actor) override;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_COST_GUIDED_ACTOR_FUSION_H_
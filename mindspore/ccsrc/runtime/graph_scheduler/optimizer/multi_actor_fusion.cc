@@ -39,7 +39,10 @@ constexpr size_t kActorFusionMaxNum = 1000;
 
 void MultiActorFusion::Process(ActorSet *const actor_set, AbstractActor *const) {
   MS_EXCEPTION_IF_NULL(actor_set);
-  if (!actor_set->custom_actors_.empty()) {
+  // The kernel actors of static schedule don't interact by messages, so there is no need to fuse. And the actors have
+  // been fused by the cost guided fusion.
+  if ((!actor_set->custom_actors_.empty()) || (actor_set->static_schedule_ != nullptr) ||
+      actor_set->is_cost_guided_fusion_) {
     return;
   }
 
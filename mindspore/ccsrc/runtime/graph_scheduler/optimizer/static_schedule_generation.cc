@@ -0,0 +1,33 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/optimizer/static_schedule_generation.h"
+
+namespace mindspore {
+namespace runtime {
+void StaticScheduleGeneration::Process(ActorSet *const actor_set, AbstractActor *const) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  if (actor_set->static_schedule_ == nullptr) {
+    return;
+  }
+
+  if (!actor_set->static_schedule_->Build(actor_set->kernel_actors_)) {
+    MS_LOG(INFO) << "The actor set " << actor_set->name_ << " falls back to the actor messages execution.";
+    actor_set->static_schedule_ = nullptr;
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_STATIC_SCHEDULE_GENERATION_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_STATIC_SCHEDULE_GENERATION_H_
+
+#include <memory>
+#include "runtime/graph_scheduler/optimizer/optimizer.h"
+
+namespace mindspore {
+namespace runtime {
+// Generate the topological order of kernel actors for the actor set which enables the static schedule, and replace the
+// arrows between kernel actors by the order. The actor set falls back to the actor messages if generate failed.
+class StaticScheduleGeneration : public ActorPass {
+ public:
+  StaticScheduleGeneration() : ActorPass("static_schedule_generation", false) {}
+  ~StaticScheduleGeneration() override = default;
+
+ protected:
+  void Process(ActorSet *const actor_set, AbstractActor *const actor) override;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_STATIC_SCHEDULE_GENERATION_H_
@@ -345,12 +345,19 @@ void SchedulerHelper::FuseDataArrowsToBatchDataArrow(AbstractActor *const actor)
   mindspore::HashMap<std::string, size_t> to_actor_count;
   for (const auto &data_arrow : actor->output_data_arrows()) {
     MS_EXCEPTION_IF_NULL(data_arrow);
+    // The data arrow in the static schedule isn't sent.
+    if (TEST_FLAG(data_arrow->flag_, kOutputDataFlagInStaticSchedule)) {
+      continue;
+    }
     ++(to_actor_count[data_arrow->to_op_id_.Name()]);
   }
 
   // Sign and add the batch data arrow.
   for (auto &data_arrow : actor->output_data_arrows()) {
     MS_EXCEPTION_IF_NULL(data_arrow);
+    if (TEST_FLAG(data_arrow->flag_, kOutputDataFlagInStaticSchedule)) {
+      continue;
+    }
     auto &to_op_name = data_arrow->to_op_id_.Name();
     // The output data cannot be reused whose destination is stack actor, and cannot to be fused.
     if ((to_actor_count[to_op_name] > 1) && (to_op_name.find(kStackActorNameSuffix) == std::string::npos)) {
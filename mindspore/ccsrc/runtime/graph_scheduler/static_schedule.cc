@@ -0,0 +1,248 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/static_schedule.h"
+#include <queue>
+#include <algorithm>
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+#include "mindrt/src/actor/actormgr.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The arrows which are received by the kernel actor from the other kernel actors.
+struct InternalInputInfo {
+  size_t data_arrows_num_{0};
+  size_t control_arrows_num_{0};
+};
+}  // namespace
+
+bool StaticSchedule::Build(const std::vector<KernelActorPtr> &kernel_actors) {
+  if (kernel_actors.empty()) {
+    return false;
+  }
+  mindspore::HashMap<std::string, size_t> actor_indexes;
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    const auto &kernel_actor = kernel_actors[i];
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    if ((kernel_actor->type() != KernelTransformType::kKernelActor) ||
+        (kernel_actor->parent_fusion_actor() != nullptr)) {
+      MS_LOG(INFO) << "The actor set " << name_ << " doesn't support the static schedule because of the actor "
+                   << kernel_actor->GetAID().Name();
+      return false;
+    }
+    actor_indexes[kernel_actor->GetAID().Name()] = i;
+  }
+
+  // Collect the arrows between kernel actors.
+  std::vector<std::vector<size_t>> output_actor_indexes(kernel_actors.size());
+  std::vector<InternalInputInfo> internal_input_infos(kernel_actors.size());
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    for (const auto &data_arrow : kernel_actors[i]->output_data_arrows()) {
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      const auto &iter = actor_indexes.find(data_arrow->to_op_id_.Name());
+      if (iter != actor_indexes.end()) {
+        (void)output_actor_indexes[i].emplace_back(iter->second);
+        ++(internal_input_infos[iter->second].data_arrows_num_);
+      }
+    }
+    for (const auto &control_arrow : kernel_actors[i]->output_control_arrows()) {
+      MS_EXCEPTION_IF_NULL(control_arrow);
+      const auto &iter = actor_indexes.find(control_arrow->to_op_id_.Name());
+      if (iter != actor_indexes.end()) {
+        (void)output_actor_indexes[i].emplace_back(iter->second);
+        ++(internal_input_infos[iter->second].control_arrows_num_);
+      }
+    }
+  }
+
+  // The kernel actors which receive the inputs from boundary actors trigger the launch of static schedule.
+  size_t ready_actors_num = 0;
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    const auto &kernel_actor = kernel_actors[i];
+    if ((kernel_actor->input_datas_num_ < internal_input_infos[i].data_arrows_num_) ||
+        (kernel_actor->input_controls_num_ < internal_input_infos[i].control_arrows_num_)) {
+      MS_LOG(INFO) << "The inputs number of actor " << kernel_actor->GetAID().Name() << " is wrong, input datas num: "
+                   << kernel_actor->input_datas_num_ << ", input controls num: " << kernel_actor->input_controls_num_;
+      return false;
+    }
+    if ((kernel_actor->input_datas_num_ + kernel_actor->input_controls_num_) >
+        (internal_input_infos[i].data_arrows_num_ + internal_input_infos[i].control_arrows_num_)) {
+      ++ready_actors_num;
+    }
+  }
+  if (ready_actors_num == 0) {
+    MS_LOG(INFO) << "The actor set " << name_ << " has no kernel actor triggered by the boundary actors.";
+    return false;
+  }
+
+  // Compute the level of kernel actor by the topological sort, the level is the longest path from the kernel actors
+  // without internal inputs.
+  std::vector<size_t> actor_levels(kernel_actors.size(), 0);
+  std::vector<size_t> input_arrows_nums(kernel_actors.size(), 0);
+  std::queue<size_t> ready_queue;
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    input_arrows_nums[i] = internal_input_infos[i].data_arrows_num_ + internal_input_infos[i].control_arrows_num_;
+    if (input_arrows_nums[i] == 0) {
+      ready_queue.push(i);
+    }
+  }
+  size_t sorted_num = 0;
+  size_t max_level = 0;
+  while (!ready_queue.empty()) {
+    auto index = ready_queue.front();
+    ready_queue.pop();
+    ++sorted_num;
+    max_level = std::max(max_level, actor_levels[index]);
+    for (auto output_index : output_actor_indexes[index]) {
+      actor_levels[output_index] = std::max(actor_levels[output_index], actor_levels[index] + 1);
+      if (--input_arrows_nums[output_index] == 0) {
+        ready_queue.push(output_index);
+      }
+    }
+  }
+  if (sorted_num != kernel_actors.size()) {
+    MS_LOG(INFO) << "The kernel actors of actor set " << name_ << " can't be sorted topologically.";
+    return false;
+  }
+
+  // Keep the execution order of kernel graph in the same level.
+  levels_.resize(max_level + 1);
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    (void)levels_[actor_levels[i]].emplace_back(kernel_actors[i].get());
+  }
+  for (const auto &level : levels_) {
+    (void)order_.insert(order_.end(), level.begin(), level.end());
+  }
+
+  // Cut off the arrows between kernel actors which are replaced by the topological order. The input device tensors of
+  // these arrows are fetched from the output device tensors of the from actor directly.
+  for (const auto &kernel_actor : kernel_actors) {
+    for (const auto &data_arrow : kernel_actor->output_data_arrows()) {
+      const auto &iter = actor_indexes.find(data_arrow->to_op_id_.Name());
+      if (iter == actor_indexes.end()) {
+        continue;
+      }
+      SET_FLAG(data_arrow->flag_, kOutputDataFlagInStaticSchedule);
+      const auto &to_actor = kernel_actors[iter->second];
+      (void)to_actor->static_input_infos_.emplace_back(IntToSize(data_arrow->to_input_index_), kernel_actor.get(),
+                                                       IntToSize(data_arrow->from_output_index_));
+      --(to_actor->input_datas_num_);
+    }
+    for (const auto &control_arrow : kernel_actor->output_control_arrows()) {
+      const auto &iter = actor_indexes.find(control_arrow->to_op_id_.Name());
+      if (iter == actor_indexes.end()) {
+        continue;
+      }
+      SET_FLAG(control_arrow->flag_, kOutputDataFlagInStaticSchedule);
+      --(kernel_actors[iter->second]->input_controls_num_);
+    }
+  }
+  for (const auto &kernel_actor : kernel_actors) {
+    kernel_actor->static_schedule_ = this;
+  }
+
+  ready_actors_num_ = ready_actors_num;
+  remaining_ready_actors_num_ = ready_actors_num;
+  MS_LOG(INFO) << "The actor set " << name_ << " builds the static schedule, kernel actors num: " << order_.size()
+               << ", levels num: " << levels_.size() << ", ready actors num: " << ready_actors_num_;
+  return true;
+}
+
+void StaticSchedule::OnKernelActorReady(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  // The last ready kernel actor launches all the kernels, the release and acquire order makes the inputs received by
+  // the other kernel actors visible.
+  if (remaining_ready_actors_num_.fetch_sub(1, std::memory_order_acq_rel) > 1) {
+    return;
+  }
+  remaining_ready_actors_num_.store(ready_actors_num_, std::memory_order_relaxed);
+
+  // The single thread execution calls the actors directly, and launches in order to avoid the deep recursion of levels.
+  if ((mode_ == StaticScheduleMode::kByLevel) && ActorDispatcher::is_multi_thread_execution()) {
+    LaunchByLevel(context);
+  } else {
+    LaunchInOrder(context);
+  }
+}
+
+void StaticSchedule::Reset() {
+  remaining_ready_actors_num_.store(ready_actors_num_, std::memory_order_release);
+}
+
+void StaticSchedule::LaunchInOrder(OpContext<DeviceTensor> *const context) const {
+  for (auto &kernel_actor : order_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    kernel_actor->PrepareStaticLaunch(context);
+    if (IsRunningFailed(context)) {
+      return;
+    }
+    kernel_actor->OnMemoryAllocFinish(context);
+    if (IsRunningFailed(context)) {
+      return;
+    }
+  }
+}
+
+void StaticSchedule::LaunchByLevel(OpContext<DeviceTensor> *const context) const {
+  MS_EXCEPTION_IF_NULL(ActorMgr::GetActorMgrRef());
+  auto thread_pool = ActorMgr::GetActorMgrRef()->GetActorThreadPool();
+  MS_EXCEPTION_IF_NULL(thread_pool);
+  for (auto &level : levels_) {
+    // The memory allocation and free run serially, and only the kernels launch concurrently.
+    for (auto &kernel_actor : level) {
+      MS_EXCEPTION_IF_NULL(kernel_actor);
+      kernel_actor->PrepareStaticLaunch(context);
+      if (IsRunningFailed(context)) {
+        return;
+      }
+    }
+
+    if (level.size() == 1) {
+      level[0]->OnMemoryAllocFinish(context);
+      if (IsRunningFailed(context)) {
+        return;
+      }
+      continue;
+    }
+
+    std::vector<int> launch_results(level.size(), 0);
+    auto launch_func = [&level, &launch_results, context](void *, int task_id, float, float) {
+      auto actor_index = IntToSize(task_id);
+      launch_results[actor_index] = level[actor_index]->LaunchInStaticSchedule(context) ? 1 : 0;
+      return THREAD_OK;
+    };
+    if (thread_pool->ParallelLaunch(launch_func, nullptr, SizeToInt(level.size())) != THREAD_OK) {
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), "Launch the static schedule level failed: " + name_);
+    }
+    for (size_t i = 0; i < level.size(); ++i) {
+      if (launch_results[i] == 0) {
+        MS_EXCEPTION_IF_NULL(level[i]->kernel());
+        std::string error_info = "Launch kernel failed: " + level[i]->kernel()->fullname_with_scope();
+        SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+      }
+    }
+    for (auto &kernel_actor : level) {
+      kernel_actor->FinishStaticLaunch(context);
+      if (IsRunningFailed(context)) {
+        return;
+      }
+    }
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
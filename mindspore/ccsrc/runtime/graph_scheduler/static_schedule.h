@@ -0,0 +1,82 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_SCHEDULE_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_SCHEDULE_H_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include "runtime/graph_scheduler/actor/kernel_actor.h"
+
+namespace mindspore {
+namespace runtime {
+// The execution mode of static schedule.
+enum class StaticScheduleMode {
+  kDisable,  // Kernel actors are triggered by the data and control arrows.
+  kInOrder,  // Kernel actors launch one by one in the topological order.
+  kByLevel   // Kernel actors in the same topological level launch concurrently on the actor thread pool.
+};
+
+// The static schedule is used by the graph which has no control flow and dynamic shape on the CPU device. The
+// topological order of kernel actors is computed once in the graph transform, and the data and control arrows between
+// kernel actors are replaced by this order, so the kernels launch in a tight loop without the actor messages.
+// The boundary actors(data prepare, data source, output, loop count and so on) still interact with the kernel actors
+// by messages: the kernel actor which receives all the inputs from boundary actors notifies the static schedule, and
+// the last notification launches all the kernels of the graph.
+class StaticSchedule {
+ public:
+  StaticSchedule(const std::string &name, StaticScheduleMode mode)
+      : name_(name), mode_(mode), ready_actors_num_(0), remaining_ready_actors_num_(0) {}
+  ~StaticSchedule() = default;
+
+  // Compute the topological levels of kernel actors and cut off the arrows between them. Return false and keep the
+  // kernel actors unchanged if the static schedule can't be built.
+  bool Build(const std::vector<KernelActorPtr> &kernel_actors);
+
+  // Called by the kernel actor when it receives all the inputs from the boundary actors.
+  void OnKernelActorReady(OpContext<DeviceTensor> *const context);
+  // Reset the ready state at the beginning of each step, which may be left by the failed step.
+  void Reset();
+
+  const std::string &name() const { return name_; }
+  StaticScheduleMode mode() const { return mode_; }
+  const std::vector<std::vector<KernelActor *>> &levels() const { return levels_; }
+
+ private:
+  void LaunchInOrder(OpContext<DeviceTensor> *const context) const;
+  // The kernels of one level launch concurrently by the parallel loop of actor thread pool, in which the current actor
+  // thread runs the kernels too, and the next level starts after the loop.
+  void LaunchByLevel(OpContext<DeviceTensor> *const context) const;
+
+  std::string name_;
+  StaticScheduleMode mode_;
+
+  // The kernel actors grouped by the topological level, the actors of one level have no dependency on each other.
+  std::vector<std::vector<KernelActor *>> levels_;
+  // The topological order which is the concatenation of levels.
+  std::vector<KernelActor *> order_;
+
+  // The number of kernel actors which have the inputs from boundary actors.
+  size_t ready_actors_num_;
+  std::atomic<size_t> remaining_ready_actors_num_;
+};
+using StaticSchedulePtr = std::shared_ptr<StaticSchedule>;
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_SCHEDULE_H_
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/pynative/op_kernel_cache.h"
+#include "utils/ms_context.h"
+
+namespace mindspore::runtime {
+OpKernelCache &OpKernelCache::GetInstance() {
+  static OpKernelCache instance;
+  return instance;
+}
+
+// The native cpu kernel only keeps the shapes, dtypes and attrs of the op, which are the same for the same graph info.
+// The deprecated native cpu kernel keeps the node it is built from, and the kernel retrieving the output shape after
+// launch updates the node, so they are built for each graph.
+bool OpKernelCache::IsKernelShareable(const kernel::KernelModPtr &kernel_mod) {
+  return kernel_mod != nullptr && kernel_mod->GetKernelModType() == kernel::KernelModType::NativeCpuKernelMod &&
+         !kernel_mod->IsNeedRetrieveOutputShape();
+}
+
+bool OpKernelCache::IsEnabled() {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  return ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_OP_GRAPH_CACHE);
+}
+
+bool OpKernelCache::FetchKernels(const std::string &graph_info, const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (!IsEnabled()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = kernels_.find(graph_info);
+  if (iter == kernels_.end()) {
+    return false;
+  }
+  const auto &cached_kernels = iter->second;
+  const auto &execution_order = graph->execution_order();
+  if (cached_kernels.size() != execution_order.size()) {
+    MS_LOG(DEBUG) << "The kernel number of graph " << graph->graph_id() << " is " << execution_order.size()
+                  << ", but the cache of " << graph_info << " has " << cached_kernels.size();
+    return false;
+  }
+
+  for (size_t i = 0; i < execution_order.size(); ++i) {
+    const auto &node = execution_order[i];
+    MS_EXCEPTION_IF_NULL(node);
+    auto kernel_info = dynamic_cast<device::KernelInfo *>(node->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    kernel_info->set_kernel_mod(cached_kernels[i].kernel_mod_);
+    kernel_info->set_ref_map(false, cached_kernels[i].out_in_ref_map_);
+  }
+  MS_LOG(DEBUG) << "Kernel cache hit: " << graph_info;
+  return true;
+}
+
+void OpKernelCache::SaveKernels(const std::string &graph_info, const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (!IsEnabled()) {
+    return;
+  }
+  std::vector<CachedKernel> cached_kernels;
+  for (const auto &node : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(node);
+    auto kernel_info = dynamic_cast<device::KernelInfo *>(node->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    if (!IsKernelShareable(kernel_info->GetKernelModPtr())) {
+      MS_LOG(DEBUG) << "The kernel of node " << node->fullname_with_scope() << " can not be shared, skip caching "
+                    << graph_info;
+      return;
+    }
+    (void)cached_kernels.emplace_back(CachedKernel{kernel_info->GetKernelModPtr(), kernel_info->out_in_ref_map()});
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  (void)kernels_.emplace(graph_info, std::move(cached_kernels));
+}
+
+void OpKernelCache::Erase(const std::string &graph_info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  (void)kernels_.erase(graph_info);
+}
+
+void OpKernelCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  kernels_.clear();
+}
+}  // namespace mindspore::runtime
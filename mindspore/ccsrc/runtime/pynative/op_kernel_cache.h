@@ -0,0 +1,67 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_KERNEL_CACHE_H_
+#define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_KERNEL_CACHE_H_
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "utils/hash_map.h"
+#include "backend/common/session/kernel_graph.h"
+#include "runtime/device/kernel_info.h"
+#include "include/backend/visible.h"
+
+namespace mindspore::runtime {
+// Process-wide cache of the kernels built for single op graphs in PyNative mode. The key is the graph info of the op,
+// which is made up of op name, input shapes, dtypes and attrs, so identical ops in different cells are built once.
+// The cached kernel mod is shared by the graphs, so only the kernels whose state is decided by the graph info alone
+// are cached. Nothing is fetched or saved when the op graph cache of the context is disabled.
+class BACKEND_EXPORT OpKernelCache {
+ public:
+  static OpKernelCache &GetInstance();
+
+  // Set the cached kernels to the execution order of graph. Return false if the graph info is not cached.
+  bool FetchKernels(const std::string &graph_info, const KernelGraphPtr &graph);
+
+  // Save the kernels of the built graph, nothing is saved if any kernel can not be shared.
+  void SaveKernels(const std::string &graph_info, const KernelGraphPtr &graph);
+
+  static bool IsEnabled();
+
+  void Erase(const std::string &graph_info);
+
+  void Clear();
+
+ private:
+  OpKernelCache() = default;
+  ~OpKernelCache() = default;
+  DISABLE_COPY_AND_ASSIGN(OpKernelCache);
+
+  static bool IsKernelShareable(const kernel::KernelModPtr &kernel_mod);
+
+  struct CachedKernel {
+    kernel::KernelModPtr kernel_mod_;
+    OutputInputRefMap out_in_ref_map_;
+  };
+
+  mindspore::HashMap<std::string, std::vector<CachedKernel>> kernels_;
+  std::mutex mutex_;
+};
+}  // namespace mindspore::runtime
+#endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_KERNEL_CACHE_H_
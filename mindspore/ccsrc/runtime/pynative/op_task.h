@@ -23,6 +23,7 @@
 #include <queue>
 #include <map>
 #include <string>
+#include <atomic>
 #include "backend/common/session/kernel_graph.h"
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
@@ -86,10 +87,17 @@ class OpBuildTask : public OpTask {
       : OpTask(std::move(context), kBuildTask), promise_(std::move(promise)) {}
   ~OpBuildTask() override = default;
   void Run() override {}
-  void SetBuildReady(bool build_success) { promise_.set_value(build_success); }
+  // The build task may be finished by the parallel build stage before the whole batch is cleared, so only the first
+  // call takes effect.
+  void SetBuildReady(bool build_success) {
+    if (!build_ready_.exchange(true)) {
+      promise_.set_value(build_success);
+    }
+  }
 
  private:
   std::promise<bool> promise_;
+  std::atomic<bool> build_ready_{false};
 };
 
 class OpRunTask : public OpTask {
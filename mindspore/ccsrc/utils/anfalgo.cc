@@ -888,6 +888,19 @@ AnfNodePtr AnfAlgo::GetInputNode(const CNodePtr &node, size_t index) {
   return node->input(get_input_index);
 }
 
+void AnfAlgo::SetCNodePrimitiveNode(const CNodePtr &node, const AnfNodePtr &primitive_node) {
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(primitive_node);
+  if (node->func_graph() != nullptr) {
+    auto manager = node->func_graph()->manager();
+    if (manager != nullptr) {
+      manager->SetEdge(node, kAnfPrimitiveIndex, primitive_node);
+      return;
+    }
+  }
+  node->set_input(kAnfPrimitiveIndex, primitive_node);
+}
+
 void AnfAlgo::SetNodeInput(const CNodePtr &node, const AnfNodePtr &input_node, size_t index) {
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(input_node);
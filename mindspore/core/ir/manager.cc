@@ -24,6 +24,7 @@
 #include "ir/func_graph.h"
 #include "utils/convert_utils_base.h"
 #include "utils/counter.h"
+#include "utils/ms_utils.h"
 #include "utils/trace_base.h"
 #include "mindspore/core/ops/core_ops.h"
 
@@ -164,6 +165,45 @@ class InsertFrontParam : public Change {
 
 }  // namespace change
 
+namespace {
+constexpr char kCheckManagerAnalysisEnv[] = "MS_DEV_CHECK_MANAGER_ANALYSIS";
+
+bool IsSameAnalysis(const FuncGraphSet &lhs, const FuncGraphSet &rhs) {
+  return lhs.size() == rhs.size() &&
+         std::all_of(lhs.begin(), lhs.end(), [&rhs](const FuncGraphPtr &fg) { return rhs.contains(fg); });
+}
+
+bool IsSameAnalysis(const FuncGraphPtr &lhs, const FuncGraphPtr &rhs) { return lhs == rhs; }
+
+bool IsSameAnalysis(bool lhs, bool rhs) { return lhs == rhs; }
+
+// Collect the changed func graphs and the func graphs using them directly or indirectly.
+FuncGraphSet CollectAffectedFuncGraphs(const FuncGraphSet &changed_func_graphs) {
+  FuncGraphSet affected_func_graphs;
+  std::vector<FuncGraphPtr> todo(changed_func_graphs.begin(), changed_func_graphs.end());
+  while (!todo.empty()) {
+    auto fg = std::move(todo.back());
+    todo.pop_back();
+    if (fg == nullptr || affected_func_graphs.contains(fg)) {
+      continue;
+    }
+    affected_func_graphs.add(fg);
+    for (auto &item : fg->func_graph_cnodes_index()) {
+      auto user_fg = item.first->first->func_graph();
+      if (user_fg != nullptr && !affected_func_graphs.contains(user_fg)) {
+        (void)todo.emplace_back(std::move(user_fg));
+      }
+    }
+  }
+  return affected_func_graphs;
+}
+
+bool HasIntersection(const FuncGraphSet &func_graphs, const FuncGraphSet &other) {
+  return std::any_of(func_graphs.begin(), func_graphs.end(),
+                     [&other](const FuncGraphPtr &fg) { return other.contains(fg); });
+}
+}  // namespace
+
 FuncGraphManagerPtr MakeManager(const std::vector<FuncGraphPtr> &func_graphs, bool manage) {
   auto m = std::make_shared<FuncGraphManager>(func_graphs, manage);
   m->Init();
@@ -213,6 +253,8 @@ void FuncGraphManager::Reset() {
   func_graphs_ = FuncGraphSet();
   all_nodes_ = AnfNodeSet();
   node_users_ = NodeUsersMap();
+  primitive_nodes_ = PrimitiveNodesMap();
+  changed_func_graphs_ = FuncGraphSet();
   signals_ = std::make_shared<Signals>();
   func_graph_parents_total_ = std::make_shared<FuncGraphParentsTotalComputer>(this);
   func_graph_parent_ = std::make_shared<ParentComputer>(this);
@@ -233,12 +275,96 @@ void FuncGraphManager::Init() {
   }
 }
 
+void FuncGraphManager::UpdateAnalyses() const {
+  if (changed_func_graphs_.empty()) {
+    return;
+  }
+  // The analyses computed by the used func graphs total of fg only depend on the func graphs in the total, so only the
+  // func graphs using the changed func graphs are affected.
+  auto affected_func_graphs = CollectAffectedFuncGraphs(changed_func_graphs_);
+  changed_func_graphs_.clear();
+
+  // The parent is computed by the parents total of fg and the parents total of its parents.
+  FuncGraphSet parent_affected_func_graphs = affected_func_graphs;
+  const auto &parents_total_analysis = func_graph_parents_total_->func_graph_parents_total_analysis();
+  for (auto &item : func_graph_parent_->parent_analysis()) {
+    const auto &fg = item.first;
+    if (affected_func_graphs.contains(fg)) {
+      continue;
+    }
+    auto iter = parents_total_analysis.find(fg);
+    if (iter == parents_total_analysis.end() || HasIntersection(iter->second, affected_func_graphs)) {
+      parent_affected_func_graphs.add(fg);
+    }
+  }
+
+  // The children and scopes are computed by the used func graphs total of fg and their parents.
+  FuncGraphSet children_affected_func_graphs = affected_func_graphs;
+  const auto &used_total_analysis = func_graphs_used_total_->func_graph_used_total_analysis();
+  for (auto &item : children_->children_analysis()) {
+    const auto &fg = item.first;
+    if (affected_func_graphs.contains(fg)) {
+      continue;
+    }
+    auto iter = used_total_analysis.find(fg);
+    if (iter == used_total_analysis.end() || HasIntersection(iter->second, parent_affected_func_graphs)) {
+      children_affected_func_graphs.add(fg);
+    }
+  }
+  for (auto &item : scopes_->scope_analysis()) {
+    const auto &fg = item.first;
+    if (affected_func_graphs.contains(fg)) {
+      continue;
+    }
+    auto iter = used_total_analysis.find(fg);
+    if (iter == used_total_analysis.end() || HasIntersection(iter->second, parent_affected_func_graphs)) {
+      children_affected_func_graphs.add(fg);
+    }
+  }
+
+  func_graph_parents_total_->Invalidate(affected_func_graphs);
+  func_graphs_used_total_->Invalidate(affected_func_graphs);
+  recursive_->Invalidate(affected_func_graphs);
+  meta_fg_prim_total_->Invalidate(affected_func_graphs);
+  func_graph_parent_->Invalidate(parent_affected_func_graphs);
+  children_->Invalidate(children_affected_func_graphs);
+  scopes_->Invalidate(children_affected_func_graphs);
+  // The free variables total is computed for all func graphs together.
+  free_variables_total_->Reset();
+}
+
+template <typename Computer, typename Analysis>
+void FuncGraphManager::CheckAnalysis(Computer *computer, Analysis Computer::*analysis, const FuncGraphPtr &fg) const {
+  static const bool check_analysis = (common::GetEnv(kCheckManagerAnalysisEnv) == "1");
+  if (!check_analysis) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(computer);
+  auto &analysis_map = computer->*analysis;
+  auto incremental_analysis = analysis_map;
+  DepComputer *dep_computer = computer;
+  auto func_graphs_validate = dep_computer->func_graphs_validate_;
+  computer->Reset();
+  computer->Recompute(fg);
+  bool is_same = IsSameAnalysis(incremental_analysis[fg], analysis_map[fg]);
+  // Restore the incremental analysis, so the incremental update of the later changes is checked too.
+  analysis_map = std::move(incremental_analysis);
+  dep_computer->func_graphs_validate_ = std::move(func_graphs_validate);
+  if (!is_same) {
+    MS_LOG(EXCEPTION) << "The incremental analysis of func graph " << fg->ToString()
+                      << " is different from the full recompute.";
+  }
+}
+
 FuncGraphSet &FuncGraphManager::func_graph_parents_total(const FuncGraphPtr &fg) const {
   if (fg == nullptr) {
     MS_LOG(EXCEPTION) << "The parameter 'fg' should not be null.";
   }
   MS_LOG(DEBUG) << "Start func_graph_parents_total func graph " << fg->ToString();
+  UpdateAnalyses();
   func_graph_parents_total_->Recompute(fg);
+  CheckAnalysis(func_graph_parents_total_.get(), &FuncGraphParentsTotalComputer::func_graph_parents_total_analysis_,
+                fg);
   MS_LOG(DEBUG) << "End func_graph_parents func graph " << fg->ToString();
   return func_graph_parents_total_->func_graph_parents_total_analysis()[fg];
 }
@@ -247,7 +373,9 @@ FuncGraphPtr FuncGraphManager::parent(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(func_graph_parent_);
   MS_LOG(DEBUG) << "Start parents func graph " << fg->ToString();
+  UpdateAnalyses();
   func_graph_parent_->Recompute(fg);
+  CheckAnalysis(func_graph_parent_.get(), &ParentComputer::parent_analysis_, fg);
   if (func_graph_parent_->parent_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager:" << fg->ToString();
     return nullptr;
@@ -260,7 +388,9 @@ FuncGraphSet &FuncGraphManager::children(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(children_);
   MS_LOG(DEBUG) << "Start child func graph " << fg->ToString();
+  UpdateAnalyses();
   children_->Recompute(fg);
+  CheckAnalysis(children_.get(), &ChildrenComputer::children_analysis_, fg);
   return children_->children_analysis()[fg];
 }
 
@@ -268,26 +398,33 @@ FuncGraphSet &FuncGraphManager::scopes(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(scopes_);
   MS_LOG(DEBUG) << "Start scopes func graph:" << fg->ToString();
+  UpdateAnalyses();
   scopes_->Recompute(fg);
+  CheckAnalysis(scopes_.get(), &ScopeComputer::scope_analysis_, fg);
   MS_LOG(DEBUG) << "End scopes func graph:" << fg->ToString();
   return scopes_->scope_analysis()[fg];
 }
 
 FVTotalMap &FuncGraphManager::free_variables_total() const {
   MS_EXCEPTION_IF_NULL(free_variables_total_);
+  UpdateAnalyses();
   free_variables_total_->Recompute();
   return free_variables_total_->fv_total_analysis();
 }
 
 FuncGraphSet &FuncGraphManager::func_graphs_used_total(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(func_graphs_used_total_);
+  UpdateAnalyses();
   func_graphs_used_total_->Recompute(fg);
+  CheckAnalysis(func_graphs_used_total_.get(), &FuncGraphsUsedTotalComputer::func_graph_used_total_analysis_, fg);
   return func_graphs_used_total_->func_graph_used_total_analysis()[fg];
 }
 
 bool FuncGraphManager::recursive(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
+  UpdateAnalyses();
   recursive_->Recompute(fg);
+  CheckAnalysis(recursive_.get(), &RecursiveComputer::recursive_analysis_, fg);
   if (recursive_->recursive_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager: " << fg->ToString();
     return false;
@@ -316,7 +453,9 @@ std::shared_ptr<std::list<FuncGraphPtr>> FuncGraphManager::recursive_graphs(cons
 bool FuncGraphManager::func_graph_meta_fg_prim_total(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(meta_fg_prim_total_);
   MS_EXCEPTION_IF_NULL(fg);
+  UpdateAnalyses();
   meta_fg_prim_total_->Recompute(fg);
+  CheckAnalysis(meta_fg_prim_total_.get(), &FuncGraphMetaFgPrimTotalComputer::meta_fg_prim_total_analysis_, fg);
   if (meta_fg_prim_total_->meta_fg_prim_total_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager: " << fg->ToString();
     return false;
@@ -362,8 +501,10 @@ void FuncGraphManager::Clear() noexcept {
   func_graphs_.clear();
   all_nodes_.clear();
   node_users_.clear();
+  primitive_nodes_.clear();
   roots_.clear();
 
+  changed_func_graphs_.clear();
   signals_->InvalidateComputer();
 }
 
@@ -688,15 +829,28 @@ void FuncGraphManager::MoveAllCNodeDropGraph(const FuncGraphPtr &source, const F
   }
 }
 
+const AnfNodeSet &FuncGraphManager::primitive_nodes(const std::string &primitive_name) const {
+  static const AnfNodeSet empty_nodes;
+  auto iter = primitive_nodes_.find(primitive_name);
+  if (iter == primitive_nodes_.end()) {
+    return empty_nodes;
+  }
+  return iter->second;
+}
+
 void FuncGraphManager::OnEdgeAdded(const AnfNodePtr &node, int index, const AnfNodePtr &input) {
   auto fg = node->func_graph();
   if (input->isa<ValueNode>()) {
+    auto prim = GetValuePtr<Primitive>(input);
+    if (index == 0 && prim != nullptr) {
+      (void)primitive_nodes_[prim->name()].insert(node);
+    }
     fg->AddValueNode(input);
     if (IsValueNode<FuncGraph>(input)) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        changed_func_graphs_.add(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ) || IsPrimitiveCNode(node, prim::kPrimVmap) ||
@@ -705,12 +859,23 @@ void FuncGraphManager::OnEdgeAdded(const AnfNodePtr &node, int index, const AnfN
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      changed_func_graphs_.add(fg);
     }
   }
 }
 
 void FuncGraphManager::OnEdgeRemoved(const AnfNodePtr &node, int index, const AnfNodePtr &input) {
+  auto prim = GetValuePtr<Primitive>(input);
+  if (index == 0 && prim != nullptr) {
+    // The added edges are processed before the removed ones, so the node whose primitive input is replaced by another
+    // primitive of the same name stays in the index.
+    auto cnode = node->cast<CNodePtr>();
+    auto cur_prim = (cnode == nullptr || cnode->input(0) == input) ? nullptr : GetCNodePrimitive(cnode);
+    auto iter = primitive_nodes_.find(prim->name());
+    if (iter != primitive_nodes_.end() && (cur_prim == nullptr || cur_prim->name() != prim->name())) {
+      (void)iter->second.erase(node);
+    }
+  }
   auto fg = node->func_graph();
   if (fg != nullptr && input->isa<ValueNode>()) {
     fg->DropValueNode(input);
@@ -718,7 +883,7 @@ void FuncGraphManager::OnEdgeRemoved(const AnfNodePtr &node, int index, const An
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        changed_func_graphs_.add(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ) || IsPrimitiveCNode(node, prim::kPrimVmap) ||
@@ -727,7 +892,7 @@ void FuncGraphManager::OnEdgeRemoved(const AnfNodePtr &node, int index, const An
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      changed_func_graphs_.add(fg);
     }
   }
 }
@@ -740,6 +905,7 @@ void FuncGraphManager::MoveAllNodes(const FuncGraphPtr &source, const FuncGraphP
   target->CopyFuncGraphsUsed(source);
   target->CopyMetaFgPrimValueNodes(source);
   source->ClearAllManagerInfo();
+  changed_func_graphs_.clear();
   signals_->InvalidateComputer();
 }
 
@@ -781,6 +947,8 @@ void FuncGraphManager::EraseOneGraph(const FuncGraphPtr &fg) {
   if (fg->attached_mng_cnt() == 0) {
     fg->ClearAllManagerInfo();
   }
+  // The analyses of the erased func graph are out of date if it is added again.
+  changed_func_graphs_.add(fg);
 }
 
 void FuncGraphTransaction::SetParameters(FuncGraphPtr fg, const std::vector<AnfNodePtr> &params) {
@@ -57,6 +57,7 @@ using FuncGraphManagerPtr = std::shared_ptr<FuncGraphManager>;
 
 using AnfNodeIndexSet = CompactSet<std::pair<AnfNodePtr, int>>;
 using NodeUsersMap = mindspore::HashMap<AnfNodePtr, AnfNodeIndexSet, PointerHash<AnfNodePtr>>;
+using PrimitiveNodesMap = mindspore::HashMap<std::string, AnfNodeSet>;
 
 using FuncGraphSetPair = std::pair<FuncGraphPtr, FuncGraphSet>;
 using FuncGraphSetPtr = std::shared_ptr<FuncGraphSet>;
@@ -96,6 +97,14 @@ class DepComputer {
 
   void OnInvalidateComputer() { Reset(); }
 
+  // Invalidate the analysis of the given func graphs only, the others are kept.
+  void Invalidate(const FuncGraphSet &func_graphs) {
+    for (auto &fg : func_graphs) {
+      ExtraInvalidate(fg);
+      (void)func_graphs_validate_.erase(fg);
+    }
+  }
+
   void Recompute();
 
   void Recompute(const FuncGraphPtr &fg);
@@ -107,6 +116,8 @@ class DepComputer {
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
+  // subclass can erase their own member of the func graph;
+  virtual void ExtraInvalidate(const FuncGraphPtr &) {}
   // subclass do the real compute
   virtual void RealRecompute() {}
   virtual void RealRecompute(FuncGraphPtr) {}
@@ -133,6 +144,7 @@ class FuncGraphParentsTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_parents_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_parents_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -156,6 +168,7 @@ class ParentComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { parent_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)parent_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -174,6 +187,7 @@ class ChildrenComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { children_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)children_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -192,6 +206,7 @@ class ScopeComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { scope_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)scope_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -228,6 +243,7 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_used_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -255,6 +271,10 @@ class RecursiveComputer final : public DepComputer {
     recursive_analysis_.clear();
     recursive_map_.clear();
   }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override {
+    (void)recursive_analysis_.erase(fg);
+    (void)recursive_map_.erase(fg);
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -272,6 +292,7 @@ class FuncGraphMetaFgPrimTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { meta_fg_prim_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)meta_fg_prim_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -319,6 +340,9 @@ class MS_CORE_API FuncGraphManager : public std::enable_shared_from_this<FuncGra
 
   const NodeUsersMap &node_users() const { return node_users_; }
 
+  // Get the managed cnodes whose primitive input has the given name, which is updated with the primitive input edges.
+  const AnfNodeSet &primitive_nodes(const std::string &primitive_name) const;
+
   FVTotalMap &free_variables_total() const;
 
   FuncGraphSet &func_graph_parents_total(const FuncGraphPtr &fg) const;
@@ -341,6 +365,7 @@ class MS_CORE_API FuncGraphManager : public std::enable_shared_from_this<FuncGra
   // Static Analysis
   NodeUsersMap node_users_;
   AnfNodeSet all_nodes_;  // managed nodes
+  PrimitiveNodesMap primitive_nodes_;
 
   // Dynamic Analysis
   std::shared_ptr<ParentComputer> func_graph_parent_;
@@ -358,6 +383,11 @@ class MS_CORE_API FuncGraphManager : public std::enable_shared_from_this<FuncGra
   void OnEdgeAdded(const AnfNodePtr &node, int index, const AnfNodePtr &input);
   void OnEdgeRemoved(const AnfNodePtr &node, int index, const AnfNodePtr &input);
   void MoveAllNodes(const FuncGraphPtr &source, const FuncGraphPtr &target);
+  // Invalidate the analyses of the func graphs affected by the changed func graphs since the last query.
+  void UpdateAnalyses() const;
+  // Check the incremental analysis of the func graph against the full recompute in the debug mode.
+  template <typename Computer, typename Analysis>
+  void CheckAnalysis(Computer *computer, Analysis Computer::*analysis, const FuncGraphPtr &fg) const;
 
   FuncGraphSet roots_;        // Managed roots.
   FuncGraphSet func_graphs_;  // Managed func graphs.
@@ -372,6 +402,8 @@ class MS_CORE_API FuncGraphManager : public std::enable_shared_from_this<FuncGra
   std::shared_ptr<FuncGraphsUsedTotalComputer> func_graphs_used_total_;
   std::shared_ptr<RecursiveComputer> recursive_;
   std::shared_ptr<FuncGraphMetaFgPrimTotalComputer> meta_fg_prim_total_;
+  // The func graphs whose used func graphs or free variables are changed since the last query.
+  mutable FuncGraphSet changed_func_graphs_;
 
   bool is_manage_;
 };
@@ -17,6 +17,10 @@
 #include "ir/scope.h"
 namespace mindspore {
 const ScopePtr kDefaultScope = std::make_shared<Scope>("Default");
+namespace {
+// The scope stack is thread local, so the nodes can be created in the scopes of different threads concurrently.
+thread_local std::stack<ScopePtr> scope_stack_;
+}  // namespace
 
 ScopeManager &ScopeManager::GetInstance() noexcept {
   static ScopeManager instance;
@@ -79,7 +79,6 @@ class MS_CORE_API ScopeManager {
 
  private:
   ScopeManager() = default;
-  std::stack<ScopePtr> scope_stack_;
 };
 
 // ScopeGuard is a class that help generate the anf node of specified scope
@@ -17,9 +17,19 @@
 
 #include "ops/attention.h"
 #include "ops/primitive_c.h"
+#include "ops/op_utils.h"
 #include "mindapi/src/helper.h"
 
 namespace mindspore::ops {
 MIND_API_OPERATOR_IMPL(Attention, BaseOperator);
+
+void Attention::Init(const int64_t head_num) { this->set_head_num(head_num); }
+
+void Attention::set_head_num(const int64_t head_num) { (void)this->AddAttr(kHeadNum, api::MakeValue(head_num)); }
+
+int64_t Attention::get_head_num() const {
+  auto value_ptr = this->GetAttr(kHeadNum);
+  return GetValue<int64_t>(value_ptr);
+}
 REGISTER_PRIMITIVE_C(kNameAttention, Attention);
 }  // namespace mindspore::ops
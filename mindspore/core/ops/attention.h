@@ -37,7 +37,15 @@ class MIND_API Attention : public BaseOperator {
       {"output"});
   }
   /// \brief Initialize Attention op.
-  void Init() const {}
+  ///
+  /// \param[in] head_num Define the number of heads of the multi-head-attention.
+  void Init(const int64_t head_num = 1);
+  /// \brief Set head_num.
+  void set_head_num(const int64_t head_num);
+  /// \brief Get head_num.
+  ///
+  /// \return head_num.
+  int64_t get_head_num() const;
 };
 }  // namespace ops
 }  // namespace mindspore
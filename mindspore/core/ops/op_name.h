@@ -141,6 +141,7 @@ constexpr auto kNumBits = "num_bits";
 constexpr auto kNumDirections = "num_directions";
 constexpr auto kNumProj = "num_proj";
 constexpr auto kAttentionNumHeads = "attention_num_heads";
+constexpr auto kHeadNum = "head_num";
 constexpr auto kAttentionSizePerHead = "attention_size_per_head";
 constexpr auto kAttentionFromSeqLen = "attention_from_seq_len";
 constexpr auto kAttentionToSeqLen = "attention_to_seq_len";
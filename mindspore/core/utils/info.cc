@@ -100,7 +100,7 @@ bool Location::operator<(const Location &other) const {
 
 int64_t DebugInfo::get_id() const {
   // cppcheck-suppress variableScope
-  static int64_t current_id = 1;
+  static std::atomic<int64_t> current_id(1);
   if (id_ == 0) {
     id_ = current_id++;
   }
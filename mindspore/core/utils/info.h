@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_UTILS_INFO_H_
 #define MINDSPORE_CORE_UTILS_INFO_H_
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <utility>
@@ -243,7 +244,7 @@ class MS_CORE_API DebugInfo {
 
  protected:
   static int64_t gen_unique_id() {
-    static int64_t cur_unique_id = 0;
+    static std::atomic<int64_t> cur_unique_id(0);
     return cur_unique_id++;
   }
 
@@ -68,6 +68,16 @@ static const char *const kMSCacheSerializePath = "serialize_path";
 // weight path
 static const char *const kWeight = "weight";
 static const char *const kWeightPath = "weight_path";
+// resize plan cache
+static const char *const kResizeBucket = "resize_bucket";
+static const char *const kResizeBucketBoundaries = "bucket_boundaries";
+static const char *const kResizeBucketAxis = "bucket_axis";
+static const char *const kResizeBucketInputs = "bucket_inputs";
+static const char *const kResizeMaxCachedPlans = "max_cached_plans";
+// thread cost model
+static const char *const kThreadCostModel = "thread_cost_model";
+static const char *const kThreadCostModelCalibrate = "calibrate";
+static const char *const kThreadCostModelProfilePath = "profile_path";
 
 static const char *const kIsOptimized = "isOptimized";
 }  // namespace lite
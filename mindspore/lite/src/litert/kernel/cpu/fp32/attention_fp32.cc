@@ -0,0 +1,410 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32/attention_fp32.h"
+#include <cmath>
+#include "schema/model_generated.h"
+#include "src/litert/kernel_registry.h"
+#include "include/errorcode.h"
+#include "nnacl/fp32/attention_fp32.h"
+#include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/pack_fp32.h"
+
+using mindspore::kernel::KERNEL_ARCH;
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_NOT_SUPPORT;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_Attention;
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kAttentionInputSize = 7;
+constexpr size_t kCrossAttentionInputSize = 8;
+constexpr size_t kAttentionMaxInputSize = 9;
+constexpr size_t kInputQIndex = 0;
+constexpr size_t kInputKIndex = 1;
+constexpr size_t kWeightQIndex = 3;
+constexpr size_t kWeightKVIndex = 4;
+constexpr int kQKVNum = 3;
+constexpr int kKVNum = 2;
+constexpr int kActivationShapeSize = 3;
+}  // namespace
+
+AttentionCPUKernel::~AttentionCPUKernel() { FreePackedWeights(); }
+
+int AttentionCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), kAttentionInputSize);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  CHECK_NULL_RETURN(param_);
+  if (in_tensors_.size() > kAttentionMaxInputSize) {
+    MS_LOG(ERROR) << "Attention with relative position is not supported, input size: " << in_tensors_.size();
+    return RET_NOT_SUPPORT;
+  }
+  if (param_->head_num_ <= 0) {
+    MS_LOG(ERROR) << "Attention needs a positive head_num, but got " << param_->head_num_;
+    return RET_ERROR;
+  }
+  auto weight_q = in_tensors_.at(kWeightQIndex);
+  CHECK_NULL_RETURN(weight_q);
+  MS_CHECK_TRUE_MSG(weight_q->shape().size() == DIMENSION_2D, RET_ERROR, "weight of attention should be 2D.");
+  // the weight of self attention is the concatenation of the q, k and v weights: [3 * d_model, d_model]
+  is_cross_ = weight_q->shape().at(0) == weight_q->shape().at(1);
+  size_t mask_index = is_cross_ ? kAttentionMaxInputSize - 1 : kAttentionInputSize;
+  if (is_cross_) {
+    CHECK_LESS_RETURN(in_tensors_.size(), kCrossAttentionInputSize);
+  }
+  mask_tensor_ = in_tensors_.size() > mask_index ? in_tensors_.at(mask_index) : nullptr;
+#ifdef ENABLE_AVX
+  param_->row_tile_ = C6NUM;
+  param_->col_tile_ = C16NUM;
+  row_pack_fun_ = RowMajor2Col6Major;
+  col_pack_fun_ = RowMajor2Col16Major;
+#elif defined(ENABLE_ARM32)
+  param_->row_tile_ = C12NUM;
+  param_->col_tile_ = C4NUM;
+  row_pack_fun_ = RowMajor2Col12Major;
+  col_pack_fun_ = RowMajor2Col4Major;
+#elif defined(ENABLE_SSE)
+  param_->row_tile_ = C4NUM;
+  param_->col_tile_ = C8NUM;
+  row_pack_fun_ = RowMajor2Col4Major;
+  col_pack_fun_ = RowMajor2Col8Major;
+#else
+  param_->row_tile_ = C12NUM;
+  param_->col_tile_ = C8NUM;
+  row_pack_fun_ = RowMajor2Col12Major;
+  col_pack_fun_ = RowMajor2Col8Major;
+#endif
+  auto ret = PrepareWeights();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Prepare weights of attention failed.";
+    return ret;
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+float *AttentionCPUKernel::PackWeight(const lite::Tensor *weight) {
+  if (weight == nullptr || !weight->IsConst() || weight->data_type() != kNumberTypeFloat32 ||
+      weight->shape().size() != DIMENSION_2D || weight->data() == nullptr) {
+    MS_LOG(ERROR) << "Weight of attention should be a const 2D float32 tensor.";
+    return nullptr;
+  }
+  int col = weight->shape().at(0);
+  int deep = weight->shape().at(1);
+  int col_align = UP_ROUND(col, param_->col_tile_);
+  if (col_align <= 0 || deep <= 0 || INT_MUL_OVERFLOW(col_align, deep)) {
+    MS_LOG(ERROR) << "Shape of attention weight is invalid.";
+    return nullptr;
+  }
+  auto packed = reinterpret_cast<float *>(malloc(col_align * deep * sizeof(float)));
+  if (packed == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight of attention failed.";
+    return nullptr;
+  }
+  memset(packed, 0, col_align * deep * sizeof(float));
+  // the weight is [col, deep], which is the transposed right matrix
+  col_pack_fun_(reinterpret_cast<const float *>(weight->data()), packed, col, deep);
+  return packed;
+}
+
+float *AttentionCPUKernel::PackBias(const lite::Tensor *bias, int offset, int col) {
+  if (bias == nullptr || !bias->IsConst() || bias->data_type() != kNumberTypeFloat32 || bias->data() == nullptr ||
+      bias->ElementsNum() < offset + col) {
+    MS_LOG(ERROR) << "Bias of attention should be a const float32 tensor with at least " << offset + col
+                  << " elements.";
+    return nullptr;
+  }
+  int col_align = UP_ROUND(col, param_->col_tile_);
+  auto packed = reinterpret_cast<float *>(malloc(col_align * sizeof(float)));
+  if (packed == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed bias of attention failed.";
+    return nullptr;
+  }
+  memset(packed, 0, col_align * sizeof(float));
+  memcpy(packed, reinterpret_cast<const float *>(bias->data()) + offset, col * sizeof(float));
+  return packed;
+}
+
+int AttentionCPUKernel::PrepareWeights() {
+  FreePackedWeights();
+  auto weight_q = in_tensors_.at(kWeightQIndex);
+  int d_model = weight_q->shape().at(1);
+  size_t index = kWeightKVIndex;
+  packed_weight_q_ = PackWeight(weight_q);
+  MS_CHECK_TRUE_RET(packed_weight_q_ != nullptr, RET_ERROR);
+  if (is_cross_) {
+    auto weight_kv = in_tensors_.at(index++);
+    MS_CHECK_TRUE_MSG(weight_kv->shape() == std::vector<int>({kKVNum * d_model, d_model}), RET_ERROR,
+                      "Shape of weight_kv of attention is invalid.");
+    packed_weight_kv_ = PackWeight(weight_kv);
+    MS_CHECK_TRUE_RET(packed_weight_kv_ != nullptr, RET_ERROR);
+  } else {
+    MS_CHECK_TRUE_MSG(weight_q->shape().at(0) == kQKVNum * d_model, RET_ERROR,
+                      "Shape of weight_qkv of attention is invalid.");
+  }
+  auto weight_o = in_tensors_.at(index++);
+  MS_CHECK_TRUE_MSG(weight_o->shape() == std::vector<int>({d_model, d_model}), RET_ERROR,
+                    "Shape of weight_o of attention is invalid.");
+  packed_weight_o_ = PackWeight(weight_o);
+  MS_CHECK_TRUE_RET(packed_weight_o_ != nullptr, RET_ERROR);
+  auto bias_qkv = in_tensors_.at(index++);
+  if (is_cross_) {
+    packed_bias_q_ = PackBias(bias_qkv, 0, d_model);
+    packed_bias_kv_ = PackBias(bias_qkv, d_model, kKVNum * d_model);
+    MS_CHECK_TRUE_RET(packed_bias_q_ != nullptr && packed_bias_kv_ != nullptr, RET_ERROR);
+  } else {
+    packed_bias_q_ = PackBias(bias_qkv, 0, kQKVNum * d_model);
+    MS_CHECK_TRUE_RET(packed_bias_q_ != nullptr, RET_ERROR);
+  }
+  packed_bias_o_ = PackBias(in_tensors_.at(index), 0, d_model);
+  MS_CHECK_TRUE_RET(packed_bias_o_ != nullptr, RET_ERROR);
+  param_->d_model_ = d_model;
+  return RET_OK;
+}
+
+int AttentionCPUKernel::ReSize() {
+  auto input_q = in_tensors_.at(kInputQIndex);
+  auto input_k = in_tensors_.at(kInputKIndex);
+  CHECK_NULL_RETURN(input_q);
+  CHECK_NULL_RETURN(input_k);
+  auto shape_q = input_q->shape();
+  auto shape_k = input_k->shape();
+  if (shape_q.size() == DIMENSION_2D) {
+    (void)shape_q.insert(shape_q.begin(), 1);
+  }
+  if (shape_k.size() == DIMENSION_2D) {
+    (void)shape_k.insert(shape_k.begin(), 1);
+  }
+  if (shape_q.size() != kActivationShapeSize || shape_k.size() != kActivationShapeSize) {
+    MS_LOG(ERROR) << "Inputs of attention should be [batch, seq, d_model].";
+    return RET_ERROR;
+  }
+  if (input_q->data_type() != kNumberTypeFloat32 || input_k->data_type() != kNumberTypeFloat32) {
+    MS_LOG(ERROR) << "Inputs of attention should be float32.";
+    return RET_ERROR;
+  }
+  param_->batch_ = shape_q.at(0);
+  param_->q_seq_ = shape_q.at(1);
+  param_->kv_seq_ = shape_k.at(1);
+  if (shape_k.at(0) != param_->batch_ || shape_q.at(C2NUM) != param_->d_model_ ||
+      shape_k.at(C2NUM) != param_->d_model_) {
+    MS_LOG(ERROR) << "Shapes of the inputs of attention are mismatched.";
+    return RET_ERROR;
+  }
+  if (!is_cross_ && param_->kv_seq_ != param_->q_seq_) {
+    MS_LOG(ERROR) << "Sequence length of q and k should be the same for self attention.";
+    return RET_ERROR;
+  }
+  if (param_->d_model_ % param_->head_num_ != 0) {
+    MS_LOG(ERROR) << "D_model should be an integer multiple of head_num.";
+    return RET_ERROR;
+  }
+  param_->head_size_ = param_->d_model_ / param_->head_num_;
+  if (mask_tensor_ != nullptr) {
+    int mask_area = param_->q_seq_ * param_->kv_seq_;
+    if (mask_tensor_->data_type() != kNumberTypeFloat32 ||
+        (mask_tensor_->ElementsNum() != mask_area && mask_tensor_->ElementsNum() != param_->batch_ * mask_area)) {
+      MS_LOG(ERROR) << "Mask of attention should be float32 with shape [batch, q_seq, kv_seq].";
+      return RET_ERROR;
+    }
+  }
+  return RET_OK;
+}
+
+void AttentionCPUKernel::FreePackedWeights() {
+  float **packed_data[] = {&packed_weight_q_, &packed_weight_kv_, &packed_weight_o_,
+                           &packed_bias_q_,   &packed_bias_kv_,   &packed_bias_o_};
+  for (auto data : packed_data) {
+    if (*data != nullptr) {
+      free(*data);
+      *data = nullptr;
+    }
+  }
+}
+
+int AttentionCPUKernel::MallocRunBuffers() {
+  auto allocator = ms_context_->allocator;
+  CHECK_NULL_RETURN(allocator);
+  int d_model = param_->d_model_;
+  int q_rows = param_->batch_ * param_->q_seq_;
+  int kv_rows = param_->batch_ * param_->kv_seq_;
+  int max_rows = MSMAX(q_rows, kv_rows);
+  q_stride_ = is_cross_ ? d_model : kQKVNum * d_model;
+  kv_stride_ = is_cross_ ? kKVNum * d_model : kQKVNum * d_model;
+  packed_input_ = reinterpret_cast<float *>(
+    allocator->Malloc(UP_ROUND(max_rows, param_->row_tile_) * d_model * sizeof(float)));
+  q_proj_ = reinterpret_cast<float *>(allocator->Malloc(q_rows * q_stride_ * sizeof(float)));
+  context_ = reinterpret_cast<float *>(allocator->Malloc(q_rows * d_model * sizeof(float)));
+  attention_buffer_ = reinterpret_cast<float *>(
+    allocator->Malloc(thread_num_ * FlashAttentionBufferSize(param_->head_size_) * sizeof(float)));
+  if (packed_input_ == nullptr || q_proj_ == nullptr || context_ == nullptr || attention_buffer_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc run buffers of attention failed.";
+    return RET_MEMORY_FAILED;
+  }
+  if (is_cross_) {
+    kv_proj_ = reinterpret_cast<float *>(allocator->Malloc(kv_rows * kv_stride_ * sizeof(float)));
+    if (kv_proj_ == nullptr) {
+      MS_LOG(ERROR) << "Malloc run buffers of attention failed.";
+      return RET_MEMORY_FAILED;
+    }
+  } else {
+    kv_proj_ = q_proj_ + d_model;
+  }
+  return RET_OK;
+}
+
+void AttentionCPUKernel::FreeRunBuffers() {
+  auto allocator = ms_context_->allocator;
+  if (is_cross_ && kv_proj_ != nullptr) {
+    allocator->Free(kv_proj_);
+  }
+  kv_proj_ = nullptr;
+  float **buffers[] = {&packed_input_, &q_proj_, &context_, &attention_buffer_};
+  for (auto buffer : buffers) {
+    if (*buffer != nullptr) {
+      allocator->Free(*buffer);
+      *buffer = nullptr;
+    }
+  }
+}
+
+int AttentionCPUKernel::DoProjection(int task_id) {
+  int deep = param_->d_model_;
+  int row_tile = param_->row_tile_;
+  int unit = UP_DIV(UP_DIV(projection_.row_, row_tile), thread_num_) * row_tile;
+  int row_begin = task_id * unit;
+  int row_end = MSMIN(row_begin + unit, projection_.row_);
+  if (row_begin >= row_end) {
+    return RET_OK;
+  }
+  // a tile aligned slice of the packed left matrix starts at row_begin * deep
+  auto packed_input = packed_input_ + row_begin * deep;
+  row_pack_fun_(projection_.input_ + row_begin * deep, packed_input, row_end - row_begin, deep);
+  MatMulOpt(packed_input, projection_.packed_weight_, projection_.output_ + row_begin * projection_.col_,
+            projection_.packed_bias_, ActType_No, deep, row_end - row_begin, projection_.col_, projection_.col_,
+            OutType_Nhwc);
+  return RET_OK;
+}
+
+int AttentionProjectionRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<AttentionCPUKernel *>(cdata);
+  auto ret = kernel->DoProjection(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "DoProjection error task_id: " << task_id << ", ret: " << ret;
+  }
+  return ret;
+}
+
+int AttentionCPUKernel::RunProjection(const float *input, const float *packed_weight, const float *packed_bias,
+                                      float *output, int row, int col) {
+  projection_.input_ = input;
+  projection_.packed_weight_ = packed_weight;
+  projection_.packed_bias_ = packed_bias;
+  projection_.output_ = output;
+  projection_.row_ = row;
+  projection_.col_ = col;
+  auto ret = ParallelLaunch(this->ms_context_, AttentionProjectionRun, this, thread_num_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Attention projection ParallelLaunch failed, ret: " << ret;
+  }
+  return ret;
+}
+
+int AttentionCPUKernel::DoAttention(int task_id) {
+  int head_num = param_->head_num_;
+  int head_size = param_->head_size_;
+  int d_model = param_->d_model_;
+  int q_seq = param_->q_seq_;
+  int kv_seq = param_->kv_seq_;
+  int units = param_->batch_ * head_num;
+  int unit = UP_DIV(units, thread_num_);
+  int begin = task_id * unit;
+  int end = MSMIN(begin + unit, units);
+  auto buffer = attention_buffer_ + task_id * FlashAttentionBufferSize(head_size);
+  const float *mask = mask_tensor_ == nullptr ? nullptr : reinterpret_cast<const float *>(mask_tensor_->data());
+  int mask_batch_stride =
+    (mask_tensor_ == nullptr || mask_tensor_->ElementsNum() == q_seq * kv_seq) ? 0 : q_seq * kv_seq;
+  float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int i = begin; i < end; ++i) {
+    int b = i / head_num;
+    int h = i % head_num;
+    const float *q = q_proj_ + b * q_seq * q_stride_ + h * head_size;
+    const float *k = kv_proj_ + b * kv_seq * kv_stride_ + h * head_size;
+    const float *v = k + d_model;
+    float *out = context_ + b * q_seq * d_model + h * head_size;
+    FlashAttentionFp32(q, k, v, mask == nullptr ? nullptr : mask + b * mask_batch_stride, out, buffer, q_seq, kv_seq,
+                       head_size, q_stride_, kv_stride_, d_model, scale);
+  }
+  return RET_OK;
+}
+
+int AttentionRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<AttentionCPUKernel *>(cdata);
+  auto ret = kernel->DoAttention(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "DoAttention error task_id: " << task_id << ", ret: " << ret;
+  }
+  return ret;
+}
+
+int AttentionCPUKernel::Run() {
+  auto input_q = reinterpret_cast<const float *>(in_tensors_.at(kInputQIndex)->data());
+  auto input_k = reinterpret_cast<const float *>(in_tensors_.at(kInputKIndex)->data());
+  auto output = reinterpret_cast<float *>(out_tensors_.at(0)->data());
+  CHECK_NULL_RETURN(input_q);
+  CHECK_NULL_RETURN(input_k);
+  CHECK_NULL_RETURN(output);
+  if (mask_tensor_ != nullptr) {
+    CHECK_NULL_RETURN(mask_tensor_->data());
+  }
+  auto ret = MallocRunBuffers();
+  if (ret != RET_OK) {
+    FreeRunBuffers();
+    return ret;
+  }
+  int d_model = param_->d_model_;
+  int q_rows = param_->batch_ * param_->q_seq_;
+  if (is_cross_) {
+    ret = RunProjection(input_q, packed_weight_q_, packed_bias_q_, q_proj_, q_rows, d_model);
+    if (ret == RET_OK) {
+      ret = RunProjection(input_k, packed_weight_kv_, packed_bias_kv_, kv_proj_, param_->batch_ * param_->kv_seq_,
+                          kKVNum * d_model);
+    }
+  } else {
+    ret = RunProjection(input_q, packed_weight_q_, packed_bias_q_, q_proj_, q_rows, kQKVNum * d_model);
+  }
+  if (ret == RET_OK) {
+    ret = ParallelLaunch(this->ms_context_, AttentionRun, this, thread_num_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Attention ParallelLaunch failed, ret: " << ret;
+    }
+  }
+  if (ret == RET_OK) {
+    ret = RunProjection(context_, packed_weight_o_, packed_bias_o_, output, q_rows, d_model);
+  }
+  FreeRunBuffers();
+  return ret;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_Attention, LiteKernelCreator<AttentionCPUKernel>)
+}  // namespace mindspore::kernel
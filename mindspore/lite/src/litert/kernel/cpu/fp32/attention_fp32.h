@@ -0,0 +1,90 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
+
+#include <vector>
+#include "src/litert/lite_kernel.h"
+#include "nnacl/attention_parameter.h"
+
+namespace mindspore::kernel {
+using AttentionPackFun = void (*)(const float *src_ptr, float *dst_ptr, int row, int col);
+
+// y = x * w^T + b of one projection, x is [row, deep] and w is packed from [col, deep]
+struct AttentionProjection {
+  const float *input_ = nullptr;
+  const float *packed_weight_ = nullptr;
+  const float *packed_bias_ = nullptr;
+  float *output_ = nullptr;
+  int row_ = 0;
+  int col_ = 0;
+};
+
+// inputs: 0:Q 1:K 2:V 3:W_QKV 4:WO 5:B_QKV 6:BO 7:MASK(optional), Q K V are the same tensor
+// cross attention inputs: 0:Q 1:K 2:V 3:WQ 4:W_KV 5:WO 6:B_QKV 7:BO 8:MASK(optional), K V are the same tensor
+class AttentionCPUKernel : public LiteKernel {
+ public:
+  AttentionCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                     const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    param_ = reinterpret_cast<AttentionParameter *>(op_parameter_);
+  }
+  ~AttentionCPUKernel() override;
+
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoProjection(int task_id);
+  int DoAttention(int task_id);
+
+ private:
+  int PrepareWeights();
+  float *PackWeight(const lite::Tensor *weight);
+  float *PackBias(const lite::Tensor *bias, int offset, int col);
+  int RunProjection(const float *input, const float *packed_weight, const float *packed_bias, float *output, int row,
+                    int col);
+  int MallocRunBuffers();
+  void FreeRunBuffers();
+  void FreePackedWeights();
+
+  AttentionParameter *param_ = nullptr;
+  bool is_cross_ = false;
+  lite::Tensor *mask_tensor_ = nullptr;
+  AttentionPackFun row_pack_fun_ = nullptr;
+  AttentionPackFun col_pack_fun_ = nullptr;
+
+  // packed const inputs, the q, k and v weights are kept apart so that the projections can use any layout
+  float *packed_weight_q_ = nullptr;
+  float *packed_weight_kv_ = nullptr;
+  float *packed_weight_o_ = nullptr;
+  float *packed_bias_q_ = nullptr;
+  float *packed_bias_kv_ = nullptr;
+  float *packed_bias_o_ = nullptr;
+
+  // run buffers
+  float *packed_input_ = nullptr;  // left matrix of the running projection
+  float *q_proj_ = nullptr;        // [batch * q_seq, d_model], or [batch * q_seq, 3 * d_model] for self attention
+  float *kv_proj_ = nullptr;       // [batch * kv_seq, 2 * d_model], points into q_proj_ for self attention
+  float *context_ = nullptr;       // [batch * q_seq, d_model], output of the heads before the output projection
+  float *attention_buffer_ = nullptr;
+  int q_stride_ = 0;
+  int kv_stride_ = 0;
+  AttentionProjection projection_;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
@@ -19,6 +19,9 @@
 #include "include/errorcode.h"
 #include "nnacl/fp32/matmul_fp32.h"
 #include "src/litert/kernel_registry.h"
+#if defined(MSLITE_ENABLE_SPARSE_COMPUTE) && defined(ENABLE_AVX)
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_sparse_fp32.h"
+#endif
 
 using mindspore::lite::kCHWDimNumber;
 using mindspore::lite::KernelRegistrar;
@@ -48,5 +51,31 @@ int MatmulCPUKernel::Run() {
   return matmul_base_->Run();
 }
 
+#if defined(MSLITE_ENABLE_SPARSE_COMPUTE) && defined(ENABLE_AVX)
+// a constant weight pruned to enough zeros runs with the sparse kernel on x86
+kernel::LiteKernel *CpuMatmulFp32KernelCreator(const std::vector<lite::Tensor *> &inputs,
+                                               const std::vector<lite::Tensor *> &outputs, OpParameter *op_parameter,
+                                               const lite::Context *ctx, const kernel::KernelKey &desc) {
+  MS_ASSERT(op_parameter != nullptr);
+  MS_ASSERT(desc.type == schema::PrimitiveType_MatMulFusion);
+  kernel::LiteKernel *kernel = nullptr;
+  if (MatmulSparseCPUKernel::CheckSparseWeight(inputs, op_parameter)) {
+    kernel = new (std::nothrow)
+      MatmulSparseCPUKernel(op_parameter, inputs, outputs, static_cast<const lite::InnerContext *>(ctx));
+  } else {
+    kernel =
+      new (std::nothrow) MatmulCPUKernel(op_parameter, inputs, outputs, static_cast<const lite::InnerContext *>(ctx));
+  }
+  if (kernel == nullptr) {
+    MS_LOG(ERROR) << "kernel is nullptr.";
+    free(op_parameter);
+    return nullptr;
+  }
+  return kernel;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_MatMulFusion, CpuMatmulFp32KernelCreator)
+#else
 REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_MatMulFusion, LiteKernelCreator<MatmulCPUKernel>)
+#endif
 }  // namespace mindspore::kernel
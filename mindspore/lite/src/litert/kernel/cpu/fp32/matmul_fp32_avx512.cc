@@ -32,6 +32,11 @@ void MatmulFp32AVX512CPUKernel::InitGlobalVariable() {
   col_tile_ = C16NUM;
   col_min_unit_ = C64NUM;
   out_need_aligned_ = true;
+#ifdef __linux__
+  // the generated kernels store exactly col_ columns, so the output needs no aligned copy
+  use_jit_ = GemmJitAvx512Cache::GetInstance()->Enable();
+  out_need_aligned_ = !use_jit_;
+#endif
 }
 
 int MatmulFp32AVX512CPUKernel::PackMatrixAImplOpt() {
@@ -53,6 +58,12 @@ int MatmulFp32AVX512CPUKernel::ParallelRunByBatch(int task_id) const {
     float *c = output_data_ + index * params_->row_ * col_step_;
 
     auto bias = (matrix_c_.pack_ptr == nullptr) ? nullptr : matrix_c_.pack_ptr;
+#ifdef __linux__
+    if (use_jit_) {
+      GemmJitRun(jit_tiles_.front(), a, b, c, bias);
+      continue;
+    }
+#endif
     if (func_flag == 0) {
       MatMulAvx512Fp32(a, b, c, bias, params_->act_type_, params_->deep_, col_step_, params_->col_align_,
                        params_->row_);
@@ -76,7 +87,13 @@ int MatmulFp32AVX512CPUKernel::ParallelRunByRow(int task_id) const {
     return RET_OK;
   }
   const float *input = matrix_a_.pack_ptr + start_row * params_->deep_;
-  float *output = output_data_ + start_row * params_->col_align_;
+  float *output = output_data_ + start_row * col_step_;
+#ifdef __linux__
+  if (use_jit_) {
+    GemmJitRun(jit_tiles_[task_id], input, matrix_b_.pack_ptr, output, matrix_c_.pack_ptr);
+    return RET_OK;
+  }
+#endif
   if (params_->col_ == 1) {
     float bias = 0;
     if (matrix_c_.pack_ptr != nullptr) {
@@ -110,6 +127,12 @@ int MatmulFp32AVX512CPUKernel::ParallelRunByOC(int task_id) const {
     auto b = matrix_b_.pack_ptr + b_offset_[i] * params_->deep_ * params_->col_align_ + start_oc * b_stride;
     auto c = output_data_ + i * params_->row_ * col_step_ + start_oc;
     auto bias = (matrix_c_.pack_ptr == nullptr) ? nullptr : matrix_c_.pack_ptr + start_oc;
+#ifdef __linux__
+    if (use_jit_) {
+      GemmJitRun(jit_tiles_[task_id], a, b, c, bias);
+      continue;
+    }
+#endif
     if (func_flag == 0) {
       MatMulAvx512Fp32(a, b, c, bias, params_->act_type_, params_->deep_, compute_oc, params_->col_align_,
                        params_->row_);
@@ -145,5 +168,91 @@ bool MatmulFp32AVX512CPUKernel::CheckThreadCuttingByRow() {
   return MSMIN(row_num_ / row_min_unit_, op_parameter_->thread_num_) >
          MSMIN(col_step_ / col_min_unit_, op_parameter_->thread_num_);
 }
+
+#ifdef __linux__
+int MatmulFp32AVX512CPUKernel::InitGemmKernels() {
+  jit_tiles_.clear();
+  // the matrix b is not packed by RowMajor2Col64Major when col_tile_ is reset for a single row or column
+  use_jit_ = use_jit_ && col_tile_ == C16NUM;
+  if (!use_jit_) {
+    return RET_OK;
+  }
+  if (IsCuttingByBatch()) {
+    jit_tiles_.resize(1);
+    InitGemmJitTiles(params_->row_, col_step_, &jit_tiles_.front());
+  } else {
+    jit_tiles_.resize(thread_count_);
+    bool by_row = IsCuttingByRow();
+    for (int task_id = 0; task_id < thread_count_; ++task_id) {
+      int end = task_id < (thread_count_ - 1) ? split_points_[task_id + 1] : (by_row ? row_num_ : col_step_);
+      int num = end - split_points_[task_id];
+      if (num <= 0) {
+        continue;
+      }
+      if (by_row) {
+        InitGemmJitTiles(num, col_step_, &jit_tiles_[task_id]);
+      } else {
+        InitGemmJitTiles(params_->row_, num, &jit_tiles_[task_id]);
+      }
+    }
+  }
+  if (InitGemmJitFuncs() != RET_OK) {
+    MS_LOG(WARNING) << "Generate avx512 gemm kernels failed, row: " << params_->row_ << ", col: " << params_->col_
+                    << ", deep: " << params_->deep_ << ", use the static kernels instead.";
+    return FallbackFromGemmJit();
+  }
+  return RET_OK;
+}
+
+void MatmulFp32AVX512CPUKernel::InitGemmJitTiles(int row, int col, GemmJitTiles *tiles) const {
+  bool has_bias = matrix_c_.pack_ptr != nullptr;
+  GemmJitAvx512Tiles(row, col, params_->deep_, col_step_, params_->act_type_, has_bias,
+                     [tiles](const GemmJitAvx512Tile &tile) { tiles->emplace_back(GemmJitAvx512Kernel(), tile); });
+}
+
+int MatmulFp32AVX512CPUKernel::InitGemmJitFuncs() {
+  // the kernels of all tasks are fetched at once, so the generated ones share pages
+  std::vector<GemmJitAvx512Key> keys;
+  for (auto &tiles : jit_tiles_) {
+    for (auto &item : tiles) {
+      keys.push_back(item.second.key);
+    }
+  }
+  auto kernels = GemmJitAvx512Cache::GetInstance()->GetKernels(keys);
+  if (kernels.size() != keys.size()) {
+    return RET_ERROR;
+  }
+  size_t index = 0;
+  for (auto &tiles : jit_tiles_) {
+    for (auto &item : tiles) {
+      item.first = kernels[index++];
+    }
+  }
+  return RET_OK;
+}
+
+int MatmulFp32AVX512CPUKernel::FallbackFromGemmJit() {
+  jit_tiles_.clear();
+  use_jit_ = false;
+  // the static kernels store UP_ROUND(col_, C16NUM) columns, as InitParameter decides without the jit
+  out_need_aligned_ = (params_->col_ % col_tile_) != 0;
+  col_step_ = out_need_aligned_ ? params_->col_align_ : params_->col_;
+  auto ret = GetThreadCuttingPolicy();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "ThreadCuttingPolicy error!";
+    return ret;
+  }
+  return InitTmpOutBuffer();
+}
+
+void MatmulFp32AVX512CPUKernel::GemmJitRun(const GemmJitTiles &tiles, const float *a, const float *b, float *c,
+                                           const float *bias) const {
+  for (auto &item : tiles) {
+    auto &tile = item.second;
+    item.first.func(c + tile.dst_offset, a + tile.src_offset, b + tile.weight_offset,
+                    bias == nullptr ? nullptr : bias + tile.bias_offset);
+  }
+}
+#endif
 }  // namespace mindspore::kernel
 #endif
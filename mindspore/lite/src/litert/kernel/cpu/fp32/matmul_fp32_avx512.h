@@ -18,8 +18,10 @@
 #define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_AVX512_H_
 
 #ifdef ENABLE_AVX512
+#include <utility>
 #include <vector>
 #include "src/litert/kernel/cpu/fp32/matmul_fp32_base.h"
+#include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512_jit.h"
 namespace mindspore::kernel {
 class MatmulFp32AVX512CPUKernel : public MatmulFp32BaseCPUKernel {
  public:
@@ -35,6 +37,23 @@ class MatmulFp32AVX512CPUKernel : public MatmulFp32BaseCPUKernel {
   int ParallelRunByOC(int task_id) const override;
   bool CheckThreadCuttingByRow() override;
   bool SupportMulBatchCuttingByRow() { return true; }
+#ifdef __linux__
+  int InitGemmKernels() override;
+
+ protected:
+  // fetches the kernels of jit_tiles_ from the cache, overridden by the tests to fail the generation
+  virtual int InitGemmJitFuncs();
+
+ private:
+  using GemmJitTiles = std::vector<std::pair<GemmJitAvx512Kernel, GemmJitAvx512Tile>>;
+  void InitGemmJitTiles(int row, int col, GemmJitTiles *tiles) const;
+  int FallbackFromGemmJit();
+  void GemmJitRun(const GemmJitTiles &tiles, const float *a, const float *b, float *c, const float *bias) const;
+
+  bool use_jit_ = false;
+  // the tiles of each task, or of one batch if cutting by batch
+  std::vector<GemmJitTiles> jit_tiles_;
+#endif
 };
 }  // namespace mindspore::kernel
 #endif
@@ -0,0 +1,414 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(ENABLE_AVX512) && defined(__linux__)
+#include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512_jit.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+#include "nnacl/op_base.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore::kernel {
+namespace {
+constexpr int kZmmNum = 32;
+constexpr int kZmmSize = 64;
+constexpr int kFloatSize = sizeof(float);
+constexpr int kDepthUnroll = 4;
+constexpr int kTailMask = 1;
+constexpr uint32_t kSixFloatBits = 0x40C00000;  // 6.0f
+// the kernels sharing pages start at cache lines, the gaps are filled with int3
+constexpr size_t kKernelAlign = 64;
+constexpr uint8_t kInt3 = 0xCC;
+
+// the registers of the System V AMD64 ABI, the arguments are dst, src, weight and bias
+constexpr int kRax = 0;
+constexpr int kRcx = 1;  // bias
+constexpr int kRdx = 2;  // weight
+constexpr int kRsi = 6;  // src
+constexpr int kRdi = 7;  // dst
+constexpr int kR8 = 8;
+
+// Encodes the few instructions the micro-kernels need, memory operands are [base + disp] without index.
+class Avx512CodeGenerator {
+ public:
+  const std::vector<uint8_t> &code() const { return code_; }
+  size_t size() const { return code_.size(); }
+
+  // zmm = [base + disp], the lanes out of mask are zeroed
+  void VmovupsLoad(int zmm, int base, int disp, int mask) {
+    EvexMem(0x10, kMap0F, kPpNone, zmm, 0, base, disp, kZmmSize, mask, mask != 0);
+  }
+  // [base + disp] = zmm, the lanes out of mask are not written
+  void VmovupsStore(int base, int disp, int zmm, int mask) {
+    EvexMem(0x11, kMap0F, kPpNone, zmm, 0, base, disp, kZmmSize, mask, false);
+  }
+  // zmm = broadcast([base + disp])
+  void Vbroadcastss(int zmm, int base, int disp) {
+    EvexMem(0x18, kMap0F38, kPp66, zmm, 0, base, disp, kFloatSize, 0, false);
+  }
+  // dst += src0 * src1
+  void Vfmadd231ps(int dst, int src0, int src1) { EvexReg(0xB8, kMap0F38, kPp66, dst, src0, src1); }
+  void Vpxord(int dst, int src0, int src1) { EvexReg(0xEF, kMap0F, kPp66, dst, src0, src1); }
+  void Vmaxps(int dst, int src0, int src1) { EvexReg(0x5F, kMap0F, kPpNone, dst, src0, src1); }
+  void Vminps(int dst, int src0, int src1) { EvexReg(0x5D, kMap0F, kPpNone, dst, src0, src1); }
+  void Vpbroadcastd(int zmm, int gpr) { EvexReg(0x7C, kMap0F38, kPp66, zmm, 0, gpr); }
+  void MovImm32(int gpr, uint32_t imm) {
+    if (gpr >= C8NUM) {
+      Emit(0x41);
+    }
+    Emit(0xB8 + (gpr & C7NUM));
+    Emit32(imm);
+  }
+  void Kmovw(int k, int gpr) {
+    Emit(0xC5);
+    Emit(0xF8);
+    Emit(0x92);
+    Emit(0xC0 | (k << C3NUM) | gpr);
+  }
+  void AddImm32(int gpr, int32_t imm) {
+    Emit(0x48 | (gpr >> C3NUM));
+    Emit(0x81);
+    Emit(0xC0 | (gpr & C7NUM));
+    Emit32(static_cast<uint32_t>(imm));
+  }
+  void Dec(int gpr) {
+    Emit(0x48 | (gpr >> C3NUM));
+    Emit(0xFF);
+    Emit(0xC8 | (gpr & C7NUM));
+  }
+  void Jnz(size_t target) {
+    Emit(0x0F);
+    Emit(0x85);
+    Emit32(static_cast<uint32_t>(static_cast<int32_t>(target - (size() + C4NUM))));
+  }
+  void Vzeroupper() {
+    Emit(0xC5);
+    Emit(0xF8);
+    Emit(0x77);
+  }
+  void Ret() { Emit(0xC3); }
+
+ private:
+  static constexpr int kMap0F = 1;
+  static constexpr int kMap0F38 = 2;
+  static constexpr int kPpNone = 0;
+  static constexpr int kPp66 = 1;
+
+  void Emit(int byte) { code_.push_back(static_cast<uint8_t>(byte)); }
+  void Emit32(uint32_t value) {
+    for (int i = 0; i < C4NUM; ++i) {
+      Emit((value >> (i * C8NUM)) & 0xFF);
+    }
+  }
+  // 512-bit EVEX prefix, rm_ext is the bit 4 of a register operand in rm, which takes the place of X
+  void EvexPrefix(int map, int pp, int reg, int vvvv, int rm, bool rm_ext, int mask, bool zeroing) {
+    Emit(0x62);
+    Emit(((reg & C8NUM) ? 0 : 0x80) | (rm_ext ? 0 : 0x40) | ((rm & C8NUM) ? 0 : 0x20) | ((reg & C16NUM) ? 0 : 0x10) |
+         map);
+    Emit(((~vvvv & 0xF) << C3NUM) | 0x04 | pp);
+    Emit((zeroing ? 0x80 : 0) | 0x40 | ((vvvv & C16NUM) ? 0 : 0x08) | mask);
+  }
+  void EvexReg(int opcode, int map, int pp, int reg, int vvvv, int rm) {
+    EvexPrefix(map, pp, reg, vvvv, rm, (rm & C16NUM) != 0, 0, false);
+    Emit(opcode);
+    Emit(0xC0 | ((reg & C7NUM) << C3NUM) | (rm & C7NUM));
+  }
+  // disp8 is scaled by the size of the memory operand
+  void EvexMem(int opcode, int map, int pp, int reg, int vvvv, int base, int disp, int disp_scale, int mask,
+               bool zeroing) {
+    MS_ASSERT((base & C7NUM) != C4NUM);  // rsp and r12 need SIB
+    EvexPrefix(map, pp, reg, vvvv, base, false, mask, zeroing);
+    Emit(opcode);
+    int modrm = ((reg & C7NUM) << C3NUM) | (base & C7NUM);
+    constexpr int kDisp8Max = 127;
+    constexpr int kDisp8Min = -128;
+    if (disp == 0 && (base & C7NUM) != C5NUM) {
+      Emit(modrm);
+    } else if (disp % disp_scale == 0 && disp / disp_scale <= kDisp8Max && disp / disp_scale >= kDisp8Min) {
+      Emit(0x40 | modrm);
+      Emit(disp / disp_scale);
+    } else {
+      Emit(0x80 | modrm);
+      Emit32(static_cast<uint32_t>(disp));
+    }
+  }
+
+  std::vector<uint8_t> code_;
+};
+
+// the accumulators, the weights of a depth and the broadcast src share the 32 registers
+int MaxRowBlock(int col) {
+  int col_num = UP_DIV(col, C16NUM);
+  return MSMIN(C12NUM, (kZmmNum - col_num - 1) / col_num);
+}
+
+bool KeyValid(const GemmJitAvx512Key &key) {
+  if (key.row <= 0 || key.row > MaxRowBlock(key.col) || key.col <= 0 || key.col > C64NUM || key.depth <= 0 ||
+      key.weight_stride < UP_ROUND(key.col, C16NUM)) {
+    return false;
+  }
+  // the displacements are int32
+  constexpr int64_t kMaxDisp = std::numeric_limits<int32_t>::max();
+  return static_cast<int64_t>(key.row) * key.src_stride * kFloatSize < kMaxDisp &&
+         static_cast<int64_t>(key.row) * key.dst_stride * kFloatSize < kMaxDisp &&
+         static_cast<int64_t>(kDepthUnroll) * key.weight_stride * kFloatSize < kMaxDisp;
+}
+
+std::vector<uint8_t> GenerateGemmKernel(const GemmJitAvx512Key &key) {
+  Avx512CodeGenerator gen;
+  int col_num = UP_DIV(key.col, C16NUM);
+  int col_tail = key.col % C16NUM;
+  auto acc = [col_num](int r, int c) { return r * col_num + c; };
+  auto weight = [col_num](int c) { return kZmmNum - col_num + c; };
+  auto mask = [col_num, col_tail](int c) { return (c == col_num - 1 && col_tail != 0) ? kTailMask : 0; };
+  if (col_tail != 0) {
+    gen.MovImm32(kRax, (1u << col_tail) - 1);
+    gen.Kmovw(kTailMask, kRax);
+  }
+
+  for (int r = 0; r < key.row; ++r) {
+    for (int c = 0; c < col_num; ++c) {
+      if (key.accumulate) {
+        gen.VmovupsLoad(acc(r, c), kRdi, (r * key.dst_stride + c * C16NUM) * kFloatSize, mask(c));
+      } else if (key.has_bias) {
+        gen.VmovupsLoad(acc(r, c), kRcx, c * C16NUM * kFloatSize, mask(c));
+      } else {
+        gen.Vpxord(acc(r, c), acc(r, c), acc(r, c));
+      }
+    }
+  }
+
+  // one load of src per row rather than per fma, or the loads outnumber the fma
+  int broadcast = kZmmNum - col_num - 1;
+  auto compute = [&gen, &key, col_num, broadcast, &acc, &weight](int unroll) {
+    for (int u = 0; u < unroll; ++u) {
+      for (int c = 0; c < col_num; ++c) {
+        gen.VmovupsLoad(weight(c), kRdx, (u * key.weight_stride + c * C16NUM) * kFloatSize, 0);
+      }
+      for (int r = 0; r < key.row; ++r) {
+        gen.Vbroadcastss(broadcast, kRsi, (r * key.src_stride + u) * kFloatSize);
+        for (int c = 0; c < col_num; ++c) {
+          gen.Vfmadd231ps(acc(r, c), weight(c), broadcast);
+        }
+      }
+    }
+  };
+  int loop_num = key.depth / kDepthUnroll;
+  if (loop_num > 0) {
+    gen.MovImm32(kR8, loop_num);
+    size_t loop_begin = gen.size();
+    compute(kDepthUnroll);
+    gen.AddImm32(kRsi, kDepthUnroll * kFloatSize);
+    gen.AddImm32(kRdx, kDepthUnroll * key.weight_stride * kFloatSize);
+    gen.Dec(kR8);
+    gen.Jnz(loop_begin);
+  }
+  compute(key.depth % kDepthUnroll);
+
+  if (key.act_type == ActType_Relu || key.act_type == ActType_Relu6) {
+    int zero = kZmmNum - 1;
+    int six = kZmmNum - C2NUM;
+    gen.Vpxord(zero, zero, zero);
+    if (key.act_type == ActType_Relu6) {
+      gen.MovImm32(kRax, kSixFloatBits);
+      gen.Vpbroadcastd(six, kRax);
+    }
+    for (int i = 0; i < key.row * col_num; ++i) {
+      gen.Vmaxps(i, i, zero);
+      if (key.act_type == ActType_Relu6) {
+        gen.Vminps(i, i, six);
+      }
+    }
+  }
+  for (int r = 0; r < key.row; ++r) {
+    for (int c = 0; c < col_num; ++c) {
+      gen.VmovupsStore(kRdi, (r * key.dst_stride + c * C16NUM) * kFloatSize, acc(r, c), mask(c));
+    }
+  }
+  gen.Vzeroupper();
+  gen.Ret();
+  return gen.code();
+}
+
+// executable pages holding a copy of code, nullptr if failed
+void *MapExecutable(const std::vector<uint8_t> &code, size_t *map_size) {
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  *map_size = UP_ROUND(MSMAX(code.size(), static_cast<size_t>(1)), page_size);
+  void *buffer = mmap(nullptr, *map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffer == MAP_FAILED) {
+    MS_LOG(ERROR) << "mmap for gemm jit kernel failed.";
+    return nullptr;
+  }
+  if (!code.empty()) {
+    (void)memcpy(buffer, code.data(), code.size());
+  }
+  if (mprotect(buffer, *map_size, PROT_READ | PROT_EXEC) != 0) {
+    MS_LOG(WARNING) << "executable memory is not allowed for gemm jit kernel.";
+    (void)munmap(buffer, *map_size);
+    return nullptr;
+  }
+  return buffer;
+}
+}  // namespace
+
+bool GemmJitAvx512Key::operator<(const GemmJitAvx512Key &other) const {
+  return std::tie(row, col, depth, src_stride, weight_stride, dst_stride, accumulate, has_bias, act_type) <
+         std::tie(other.row, other.col, other.depth, other.src_stride, other.weight_stride, other.dst_stride,
+                  other.accumulate, other.has_bias, other.act_type);
+}
+
+void GemmJitAvx512Tiles(int row, int col, int depth, int dst_stride, int act_type, bool has_bias,
+                        const std::function<void(const GemmJitAvx512Tile &)> &visit) {
+  if (act_type != ActType_Relu && act_type != ActType_Relu6) {
+    act_type = ActType_No;
+  }
+  GemmJitAvx512Tile tile;
+  for (int k = 0; k < depth; k += C1500NUM) {
+    int depth_block = MSMIN(C1500NUM, depth - k);
+    for (int col_index = 0; col_index < col; col_index += C64NUM) {
+      int col_block = MSMIN(C64NUM, col - col_index);
+      int weight_stride = UP_ROUND(col_block, C16NUM);
+      int row_block_num = UP_DIV(row, MaxRowBlock(col_block));
+      int row_index = 0;
+      for (int i = 0; i < row_block_num; ++i) {
+        int row_block = row / row_block_num + (i < row % row_block_num ? 1 : 0);
+        tile.key.row = row_block;
+        tile.key.col = col_block;
+        tile.key.depth = depth_block;
+        tile.key.src_stride = depth;
+        tile.key.weight_stride = weight_stride;
+        tile.key.dst_stride = dst_stride;
+        tile.key.accumulate = k > 0;
+        tile.key.has_bias = k == 0 && has_bias;
+        tile.key.act_type = k + depth_block >= depth ? act_type : ActType_No;
+        tile.dst_offset = static_cast<size_t>(row_index) * dst_stride + col_index;
+        tile.src_offset = static_cast<size_t>(row_index) * depth + k;
+        tile.weight_offset = static_cast<size_t>(col_index) * depth + static_cast<size_t>(k) * weight_stride;
+        tile.bias_offset = col_index;
+        visit(tile);
+        row_index += row_block;
+      }
+    }
+  }
+}
+
+GemmJitAvx512Cache *GemmJitAvx512Cache::GetInstance() {
+  static GemmJitAvx512Cache instance;
+  return &instance;
+}
+
+GemmJitAvx512CodePages::~GemmJitAvx512CodePages() {
+  if (buffer_ != nullptr) {
+    (void)munmap(buffer_, size_);
+    buffer_ = nullptr;
+  }
+}
+
+bool GemmJitAvx512Cache::Enable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (enable_ < 0) {
+    size_t map_size = 0;
+    void *buffer = MapExecutable({}, &map_size);
+    enable_ = buffer != nullptr ? 1 : 0;
+    if (buffer != nullptr) {
+      (void)munmap(buffer, map_size);
+    }
+  }
+  return enable_ == 1;
+}
+
+std::vector<GemmJitAvx512Kernel> GemmJitAvx512Cache::GetKernels(const std::vector<GemmJitAvx512Key> &keys) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<GemmJitAvx512Kernel> kernels(keys.size());
+  // the indexes in keys of each kernel to generate
+  std::map<GemmJitAvx512Key, std::vector<size_t>> missing_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto iter = kernels_.find(keys[i]);
+    if (iter == kernels_.end()) {
+      missing_keys[keys[i]].push_back(i);
+      continue;
+    }
+    lru_keys_.splice(lru_keys_.begin(), lru_keys_, iter->second.lru_iter);
+    kernels[i] = iter->second.kernel;
+  }
+  if (missing_keys.empty()) {
+    return kernels;
+  }
+
+  std::vector<uint8_t> code;
+  std::vector<size_t> offsets;
+  for (auto &item : missing_keys) {
+    auto &key = item.first;
+    if (!KeyValid(key)) {
+      MS_LOG(ERROR) << "invalid gemm jit kernel, row: " << key.row << ", col: " << key.col << ", depth: " << key.depth;
+      return {};
+    }
+    code.resize(UP_ROUND(code.size(), kKernelAlign), kInt3);
+    offsets.push_back(code.size());
+    auto kernel_code = GenerateGemmKernel(key);
+    (void)code.insert(code.end(), kernel_code.begin(), kernel_code.end());
+  }
+  size_t map_size = 0;
+  void *buffer = MapExecutable(code, &map_size);
+  if (buffer == nullptr) {
+    return {};
+  }
+  auto pages = std::make_shared<GemmJitAvx512CodePages>(buffer, map_size);
+  size_t index = 0;
+  for (auto &item : missing_keys) {
+    GemmJitAvx512Kernel kernel;
+    kernel.func = reinterpret_cast<GemmJitAvx512Func>(static_cast<uint8_t *>(buffer) + offsets[index++]);
+    kernel.pages = pages;
+    for (auto i : item.second) {
+      kernels[i] = kernel;
+    }
+    lru_keys_.push_front(item.first);
+    kernels_[item.first] = {kernel, lru_keys_.begin()};
+  }
+  EvictKernels();
+  return kernels;
+}
+
+GemmJitAvx512Kernel GemmJitAvx512Cache::GetKernel(const GemmJitAvx512Key &key) {
+  auto kernels = GetKernels({key});
+  return kernels.empty() ? GemmJitAvx512Kernel() : kernels.front();
+}
+
+void GemmJitAvx512Cache::set_max_kernel_num(size_t max_kernel_num) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_kernel_num_ = max_kernel_num;
+  EvictKernels();
+}
+
+size_t GemmJitAvx512Cache::kernel_num() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return kernels_.size();
+}
+
+void GemmJitAvx512Cache::EvictKernels() {
+  // the pages of the evicted kernels live on while the matmul kernels hold them
+  while (kernels_.size() > max_kernel_num_) {
+    (void)kernels_.erase(lru_keys_.back());
+    lru_keys_.pop_back();
+  }
+}
+}  // namespace mindspore::kernel
+#endif
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_AVX512_JIT_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_AVX512_JIT_H_
+
+#if defined(ENABLE_AVX512) && defined(__linux__)
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mindspore::kernel {
+// dst[row x col] = act(src[row x depth] * weight[depth x UP_ROUND(col, 16)] + bias), dst and src are row-major, weight
+// is a panel of the matrix b packed by RowMajor2Col64Major.
+using GemmJitAvx512Func = void (*)(float *dst, const float *src, const float *weight, const float *bias);
+
+struct GemmJitAvx512Key {
+  int row = 0;
+  int col = 0;
+  int depth = 0;
+  int src_stride = 0;
+  int weight_stride = 0;
+  int dst_stride = 0;
+  bool accumulate = false;  // add to dst instead of bias, for the depth blocks after the first one
+  bool has_bias = false;
+  int act_type = 0;  // only applied after the last depth block
+
+  bool operator<(const GemmJitAvx512Key &other) const;
+};
+
+struct GemmJitAvx512Tile {
+  GemmJitAvx512Key key;
+  size_t dst_offset = 0;
+  size_t src_offset = 0;
+  size_t weight_offset = 0;
+  size_t bias_offset = 0;
+};
+
+// Visits the tiles of dst[row x col] in the order of MatMulAvx512Fp32. Unlike MatMulAvx512Fp32, the rows are split
+// evenly and col is not aligned to 16, so there is no tail of a single row and no aligned output to copy back.
+void GemmJitAvx512Tiles(int row, int col, int depth, int dst_stride, int act_type, bool has_bias,
+                        const std::function<void(const GemmJitAvx512Tile &)> &visit);
+
+// Executable pages holding the code of the kernels generated together, never writable once executable. They are
+// unmapped when none of their kernels is referenced.
+class GemmJitAvx512CodePages {
+ public:
+  GemmJitAvx512CodePages(void *buffer, size_t size) : buffer_(buffer), size_(size) {}
+  ~GemmJitAvx512CodePages();
+
+ private:
+  void *buffer_ = nullptr;
+  size_t size_ = 0;
+};
+using GemmJitAvx512CodePagesPtr = std::shared_ptr<GemmJitAvx512CodePages>;
+
+struct GemmJitAvx512Kernel {
+  GemmJitAvx512Func func = nullptr;
+  // keeps func executable after the kernel is evicted from the cache
+  GemmJitAvx512CodePagesPtr pages;
+};
+
+constexpr size_t kGemmJitAvx512MaxKernelNum = 1024;
+
+// Generates the micro-kernels at runtime, each one is specialized for its key and shared by the whole process. The
+// least recently used kernels are evicted once the cache holds more than max_kernel_num kernels.
+class GemmJitAvx512Cache {
+ public:
+  static GemmJitAvx512Cache *GetInstance();
+  // false if the system forbids executable memory
+  bool Enable();
+  // the kernels of keys in order, the ones not cached are generated into the same pages; empty if any kernel can not
+  // be generated
+  std::vector<GemmJitAvx512Kernel> GetKernels(const std::vector<GemmJitAvx512Key> &keys);
+  // func is nullptr if the kernel can not be generated
+  GemmJitAvx512Kernel GetKernel(const GemmJitAvx512Key &key);
+  void set_max_kernel_num(size_t max_kernel_num);
+  size_t kernel_num();
+
+ private:
+  struct CacheEntry {
+    GemmJitAvx512Kernel kernel;
+    std::list<GemmJitAvx512Key>::iterator lru_iter;
+  };
+
+  GemmJitAvx512Cache() = default;
+  ~GemmJitAvx512Cache() = default;
+  void EvictKernels();
+
+  std::mutex mutex_;
+  int enable_ = -1;
+  size_t max_kernel_num_ = kGemmJitAvx512MaxKernelNum;
+  // the most recently used key is at the front
+  std::list<GemmJitAvx512Key> lru_keys_;
+  std::map<GemmJitAvx512Key, CacheEntry> kernels_;
+};
+}  // namespace mindspore::kernel
+#endif
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_AVX512_JIT_H_
@@ -42,10 +42,7 @@ int MatmulRun(void *cdata, int task_id, float, float) {
 
 MatmulFp32BaseCPUKernel::~MatmulFp32BaseCPUKernel() {
   // packed const-matrix will be delete by framework.
-  if (out_need_aligned_ && output_data_ != nullptr) {
-    free(output_data_);
-    output_data_ = nullptr;
-  }
+  FreeTmpOutBuffer();
   if (matrix_c_.pack_ptr != nullptr) {
     free(matrix_c_.pack_ptr);
     matrix_c_.pack_ptr = nullptr;
@@ -460,6 +457,11 @@ int MatmulFp32BaseCPUKernel::ReSize() {
     MS_LOG(ERROR) << "InitTmpOutBuffer error!";
     return ret;
   }
+  ret = InitGemmKernels();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "InitGemmKernels error!";
+    return ret;
+  }
   return RET_OK;
 }
 
@@ -602,11 +604,18 @@ int MatmulFp32BaseCPUKernel::InitParameter() {
   return RET_OK;
 }
 
+void MatmulFp32BaseCPUKernel::FreeTmpOutBuffer() {
+  // output_data_ may still point at the output tensor if the last run failed
+  if (output_data_owned_ && output_data_ != nullptr) {
+    free(output_data_);
+  }
+  output_data_ = nullptr;
+  output_data_owned_ = false;
+}
+
 int MatmulFp32BaseCPUKernel::InitTmpOutBuffer() {
+  FreeTmpOutBuffer();
   if (out_need_aligned_) {
-    if (output_data_ != nullptr) {
-      free(output_data_);
-    }
     // avx need to malloc dst aligned to C8NUM
     // avx512 need to malloc dst aligned to C16NUM
     int out_channel = params_->col_;
@@ -617,6 +626,7 @@ int MatmulFp32BaseCPUKernel::InitTmpOutBuffer() {
       MS_LOG(ERROR) << "malloc tmp output data failed.";
       return RET_NULL_PTR;
     }
+    output_data_owned_ = true;
   }
   return RET_OK;
 }
@@ -79,15 +79,21 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   void FreePackedMatrixA();
   void FreePackedMatrixB();
   int InitParameter();
-  int InitTmpOutBuffer();
-  int GetThreadCuttingPolicy();
   virtual bool CheckThreadCuttingByRow();
+  // called at the end of ReSize, once the thread cutting is decided
+  virtual int InitGemmKernels() { return RET_OK; }
   void GetThreadCuttingInfoByRow();
   void InitShapeA();
   void InitShapeB();
   int InitBroadcastParams();
 
  protected:
+  int InitTmpOutBuffer();
+  void FreeTmpOutBuffer();
+  int GetThreadCuttingPolicy();
+  bool IsCuttingByBatch() const { return parallel_fun_ == &MatmulFp32BaseCPUKernel::ParallelRunByBatch; }
+  bool IsCuttingByRow() const { return parallel_fun_ == &MatmulFp32BaseCPUKernel::ParallelRunByRow; }
+
   MatMulParameter *params_ = nullptr;
   GemmIsNotPackFun gemmIsNotPackFun = nullptr;
   int a_batch_ = 1;
@@ -103,6 +109,8 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   int col_min_unit_{1};
   int thread_count_ = 0;
   float *output_data_ = nullptr;
+  // whether output_data_ is the aligned buffer malloced by InitTmpOutBuffer, or borrowed from the output tensor in Run
+  bool output_data_owned_ = false;
   bool out_need_aligned_ = false;
   int col_step_ = 0;
   std::vector<int> split_points_;
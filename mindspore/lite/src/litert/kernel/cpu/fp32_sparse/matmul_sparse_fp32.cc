@@ -15,6 +15,7 @@
  */
 
 #include "src/litert/kernel/cpu/fp32_sparse/matmul_sparse_fp32.h"
+#include <cmath>
 #include <cstdlib>
 #include <cstdio>
 #include <cstdarg>
@@ -26,6 +27,7 @@
 #include "nnacl/fp32/matmul_fp32.h"
 #include "nnacl/fp32_sparse/matmul_sparse_x1_fp32.h"
 #include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
 
 using mindspore::lite::KernelRegistrar;
 using mindspore::lite::RET_ERROR;
@@ -43,7 +45,7 @@ void MatmulSparseCPUKernel::InitParameter() {
   auto a_shape = in_tensors_.at(0)->shape();
   int a_batch = 1;
   constexpr size_t batch_matmul_split = -2;
-  for (size_t i = 0; i < a_shape.size() + batch_matmul_axis; ++i) {
+  for (size_t i = 0; i < a_shape.size() + batch_matmul_split; ++i) {
     a_batch *= a_shape[i];
   }
   params_->batch = a_batch;
@@ -61,7 +63,7 @@ void MatmulSparseCPUKernel::InitParameter() {
   for (size_t i = 0; i < b_shape.size() + batch_matmul_split; ++i) {
     b_batch *= b_shape[i];
   }
-  MS_ASSERT(a_batch == b_batch);
+  MS_ASSERT(a_batch == b_batch || b_batch == 1);
   constexpr size_t right_row_axis_transpose = -2;
   constexpr size_t right_row_axis_not_transpose = -1;
   constexpr size_t right_col_axis_transpose = -1;
@@ -80,7 +82,7 @@ void MatmulSparseCPUKernel::InitParameter() {
   }
   constexpr int perm_1 = 2;
   auto area = params_->row_ * params_->deep_;
-  trans_param_.num_axes_ = kNumIntThree;
+  trans_param_.num_axes_ = DIMENSION_3D;
   trans_param_.perm_[kFirstDimIdx] = 0;
   trans_param_.perm_[kSecondDimIdx] = perm_1;
   trans_param_.perm_[kThirdDimIdx] = 1;
@@ -96,15 +98,81 @@ namespace {
 constexpr float kFpPrecision = 1e-6;
 constexpr size_t kBlockSize = 8;
 constexpr size_t bias_tensor_index = 2;
+constexpr size_t weight_dim_num = 2;
+// the 1x16 blocks are used when this ratio of their values are non-zeros, else the weight is compressed by column
+constexpr float kBlockDensity = 0.5f;
+// the least ratio of zero blocks or zeros to be faster than the dense kernel, measured on avx2 and avx512
+constexpr float kBlockSparseRatio = 0.5f;
+constexpr float kCsrSparseRatio = 0.85f;
+
+struct NonZeroCount {
+  size_t non_zeros = 0;
+  size_t non_zero_blocks = 0;
+};
+
+// count the non-zeros and the non-zero 1x16 blocks along the columns of w[deep, col]
+NonZeroCount CountNonZeros(const float *weight, int deep, int col, bool transpose) {
+  NonZeroCount count;
+  for (int b = 0; b < UP_DIV(col, C16NUM); b++) {
+    for (int d = 0; d < deep; d++) {
+      size_t block_non_zeros = 0;
+      for (int c = b * C16NUM; c < MSMIN(col, (b + 1) * C16NUM); c++) {
+        auto value = transpose ? weight[c * deep + d] : weight[d * col + c];
+        block_non_zeros += std::fabs(value) > kFpPrecision ? 1 : 0;
+      }
+      count.non_zeros += block_non_zeros;
+      count.non_zero_blocks += block_non_zeros > 0 ? 1 : 0;
+    }
+  }
+  return count;
+}
+
+bool IsBlockSparse(const NonZeroCount &count) {
+  return count.non_zeros >= kBlockDensity * count.non_zero_blocks * C16NUM;
+}
+
+int MatmulSparseRun(void *cdata, int task_id, float, float) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<MatmulSparseCPUKernel *>(cdata);
+  auto ret = kernel->DoSparseMatmul(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MatmulSparseRun error task_id[" << task_id << "] error_code[" << ret << "]";
+  }
+  return ret;
+}
 }  // namespace
 
+bool MatmulSparseCPUKernel::CheckSparseWeight(const std::vector<lite::Tensor *> &inputs, const OpParameter *parameter) {
+  if (parameter == nullptr || parameter->is_train_session_ || inputs.size() < kInputSize1 ||
+      reinterpret_cast<const MatMulParameter *>(parameter)->a_transpose_) {
+    return false;
+  }
+  auto weight = inputs.at(kWeightIndex);
+  if (inputs.at(kInputIndex)->IsConst() || !weight->IsConst() || weight->data_type() != kNumberTypeFloat32 ||
+      weight->data() == nullptr || weight->shape().size() != weight_dim_num) {
+    return false;
+  }
+  if (inputs.size() == kInputSize2 &&
+      (!inputs.at(kBiasIndex)->IsConst() || inputs.at(kBiasIndex)->data_type() != kNumberTypeFloat32)) {
+    return false;
+  }
+  auto transpose = reinterpret_cast<const MatMulParameter *>(parameter)->b_transpose_;
+  int deep = weight->shape().at(transpose ? 1 : 0);
+  int col = weight->shape().at(transpose ? 0 : 1);
+  auto count = CountNonZeros(reinterpret_cast<const float *>(weight->data()), deep, col, transpose);
+  if (IsBlockSparse(count)) {
+    return count.non_zero_blocks <= (1.0f - kBlockSparseRatio) * deep * UP_DIV(col, C16NUM);
+  }
+  return count.non_zeros <= (1.0f - kCsrSparseRatio) * deep * col;
+}
+
 int kernel::MatmulSparseCPUKernel::PrepareWeight() {
   auto weight_data = reinterpret_cast<float *>(in_tensors_.at(1)->data());
   MS_ASSERT(weight_data != nullptr);
   sparsity_weight_ = new SparsityWeight;
   size_t non_zeros = 0;
   for (int i = 0; i < in_tensors_.at(1)->ElementsNum(); i++) {
-    if (weight_data[i] > kFpPrecision) {
+    if (std::fabs(weight_data[i]) > kFpPrecision) {
       non_zeros++;
     }
   }
@@ -121,7 +189,7 @@ int kernel::MatmulSparseCPUKernel::PrepareWeight() {
   for (int j = 0; j < params_->col_; j++) {
     for (int i = 0; i < params_->deep_; i++) {
       auto cur_data = weight_data[i * params_->col_ + j];
-      if (cur_data > kFpPrecision) {
+      if (std::fabs(cur_data) > kFpPrecision) {
         sparsity_weight_->data[weight_data_index++] = cur_data;
         sparsity_weight_->act_stride[act_stride_index++] = i * kBlockSize * sizeof(float);
         (*(sparsity_weight_->non_zero_num + j))++;
@@ -133,26 +201,87 @@ int kernel::MatmulSparseCPUKernel::PrepareWeight() {
 
 int MatmulSparseCPUKernel::PrepareBias() {
   constexpr size_t has_bias_tensor_num = 3;
+  // padded with zeros to the 1x16 blocks of the x86 kernels
+  auto bias_size = UP_ROUND(params_->col_, C16NUM);
+  bias_pack_ = reinterpret_cast<float *>(malloc(bias_size * static_cast<int>(sizeof(float))));
+  if (bias_pack_ == nullptr) {
+    MS_LOG(ERROR) << "malloc bias_ptr_ failed";
+    return RET_ERROR;
+  }
+  memset(bias_pack_, 0, bias_size * sizeof(float));
   if (in_tensors_.size() == has_bias_tensor_num) {
     auto bias_tensor = in_tensors_[bias_tensor_index];
     if (bias_tensor->ElementsNum() != params_->col_) {
       MS_LOG(ERROR) << "Not support broadcast bias data now";
       return lite::RET_NOT_SUPPORT;
     }
-    // malloc addr need to aligned to 32 bytes
-    bias_pack_ = reinterpret_cast<float *>(malloc(params_->col_align_ * static_cast<int>(sizeof(float))));
-    if (bias_pack_ == nullptr) {
-      MS_LOG(ERROR) << "malloc bias_ptr_ failed";
-      return RET_ERROR;
+    CHECK_NULL_RETURN(bias_tensor->data());
+    memcpy(bias_pack_, bias_tensor->data(), params_->col_ * sizeof(float));
+  }
+  return RET_OK;
+}
+
+int MatmulSparseCPUKernel::PrepareCompressedWeight() {
+  auto weight = reinterpret_cast<const float *>(in_tensors_.at(1)->data());
+  CHECK_NULL_RETURN(weight);
+  int deep = params_->deep_;
+  int col = params_->col_;
+  auto weight_at = [this, weight, deep, col](int d, int c) {
+    return params_->b_transpose_ ? weight[c * deep + d] : weight[d * col + c];
+  };
+  int col_block = UP_DIV(col, C16NUM);
+  auto count = CountNonZeros(weight, deep, col, params_->b_transpose_);
+  auto &compressed = compressed_weight_;
+  compressed.is_block = IsBlockSparse(count);
+  compressed.data.clear();
+  compressed.index.clear();
+  if (compressed.is_block) {
+    compressed.offset.assign(col_block + 1, 0);
+    compressed.index.reserve(count.non_zero_blocks);
+    compressed.data.reserve(count.non_zero_blocks * C16NUM);
+    for (int b = 0; b < col_block; b++) {
+      for (int d = 0; d < deep; d++) {
+        bool is_zero = true;
+        for (int c = b * C16NUM; c < MSMIN(col, (b + 1) * C16NUM); c++) {
+          is_zero = is_zero && std::fabs(weight_at(d, c)) <= kFpPrecision;
+        }
+        if (is_zero) {
+          continue;
+        }
+        compressed.index.push_back(d);
+        for (int c = b * C16NUM; c < (b + 1) * C16NUM; c++) {
+          compressed.data.push_back(c < col ? weight_at(d, c) : 0.0f);
+        }
+      }
+      compressed.offset[b + 1] = compressed.index.size();
+    }
+  } else {
+    compressed.offset.assign(col + 1, 0);
+    compressed.index.reserve(count.non_zeros);
+    compressed.data.reserve(count.non_zeros);
+    for (int c = 0; c < col; c++) {
+      for (int d = 0; d < deep; d++) {
+        auto value = weight_at(d, c);
+        if (std::fabs(value) > kFpPrecision) {
+          compressed.data.push_back(value);
+          compressed.index.push_back(d * C16NUM);
+        }
+      }
+      compressed.offset[c + 1] = compressed.index.size();
     }
   }
+  sparse_func_ = compressed.is_block ? SparseMatMulBlockFp32 : SparseMatMulCsrFp32;
+#ifdef ENABLE_AVX512
+  AVX512_HARDWARE_SELF_AWARENESS_BEGIN
+  sparse_func_ = compressed.is_block ? SparseMatMulBlockAvx512Fp32 : SparseMatMulCsrAvx512Fp32;
+  AVX512_HARDWARE_SELF_AWARENESS_END
+#endif
+  MS_LOG(INFO) << name_ << " weight non-zeros: " << count.non_zeros << "/" << deep * col
+               << ", format: " << (compressed.is_block ? "1x16 block" : "csr");
   return RET_OK;
 }
 
 int MatmulSparseCPUKernel::Prepare() {
-  if (!InferShapeDone()) {
-    return RET_ERROR;
-  }
   if (params_ == nullptr) {
     MS_LOG(ERROR) << "Params is nullptr";
     return RET_ERROR;
@@ -161,6 +290,10 @@ int MatmulSparseCPUKernel::Prepare() {
     MS_LOG(ERROR) << "Only support Activation X filter now";
     return RET_ERROR;
   }
+#ifdef ENABLE_ARM64
+  if (!InferShapeDone()) {
+    return RET_ERROR;
+  }
   InitParameter();
   matrix_a_pack_size_ = params_->batch * params_->row_align_ * params_->deep_;
   if (params_->batch != 1) {
@@ -190,6 +323,29 @@ int MatmulSparseCPUKernel::Prepare() {
     return ret;
   }
   return RET_OK;
+#else
+  auto b_shape = in_tensors_.at(1)->shape();
+  if (params_->a_transpose_ || b_shape.size() != weight_dim_num) {
+    MS_LOG(ERROR) << "Only support a 2D weight without a transpose now";
+    return lite::RET_NOT_SUPPORT;
+  }
+  params_->deep_ = params_->b_transpose_ ? b_shape[1] : b_shape[0];
+  params_->col_ = params_->b_transpose_ ? b_shape[0] : b_shape[1];
+  auto ret = PrepareCompressedWeight();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "PrepareCompressedWeight failed";
+    return ret;
+  }
+  ret = PrepareBias();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "PrepareBias failed";
+    return ret;
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+#endif
 }
 
 int MatmulSparseCPUKernel::PackInput() {
@@ -211,12 +367,42 @@ int MatmulSparseCPUKernel::PackInput() {
   return RET_OK;
 }
 
-int MatmulSparseCPUKernel::ReSize() { return RET_ERROR; }
+int MatmulSparseCPUKernel::ReSize() {
+#ifdef ENABLE_ARM64
+  return RET_ERROR;
+#else
+  auto a_shape = in_tensors_.at(0)->shape();
+  if (a_shape.empty() || a_shape.back() != params_->deep_) {
+    MS_LOG(ERROR) << "The depth of the input doesn't match the weight";
+    return RET_ERROR;
+  }
+  row_ = in_tensors_.at(0)->ElementsNum() / params_->deep_;
+  // threads are split by the columns of csr or the block columns
+  int task_num = static_cast<int>(compressed_weight_.offset.size()) - 1;
+  thread_count_ = MSMAX(1, MSMIN(op_parameter_->thread_num_, task_num));
+  thread_stride_ = UP_DIV(task_num, thread_count_);
+  return RET_OK;
+#endif
+}
+
+int MatmulSparseCPUKernel::DoSparseMatmul(int task_id) {
+  int task_num = static_cast<int>(compressed_weight_.offset.size()) - 1;
+  int start = task_id * thread_stride_;
+  int end = MSMIN(task_num, start + thread_stride_);
+  if (start >= end) {
+    return RET_OK;
+  }
+  auto input = compressed_weight_.is_block ? reinterpret_cast<const float *>(in_tensors_.at(0)->data()) : a_pack_;
+  auto output = reinterpret_cast<float *>(out_tensors_.front()->data());
+  sparse_func_(input, compressed_weight_.data.data(), compressed_weight_.index.data(),
+               compressed_weight_.offset.data(), bias_pack_, output, params_->act_type_, row_, params_->deep_,
+               params_->col_, start, end);
+  return RET_OK;
+}
 
 int MatmulSparseCPUKernel::RunInstrinsics() {
 #ifndef ENABLE_ARM64
-  MS_LOG(ERROR) << "Only support aarch64 now";
-  return lite::RET_NOT_SUPPORT;
+  return Run();
 #else
   auto ret = PackInput();
   if (ret != RET_OK) {
@@ -306,8 +492,24 @@ int MatmulSparseCPUKernel::RunInstrinsics() {
 
 int MatmulSparseCPUKernel::Run() {
 #ifndef ENABLE_ARM64
-  MS_LOG(ERROR) << "Only support aarch64 now";
-  return lite::RET_NOT_SUPPORT;
+  CHECK_NULL_RETURN(sparse_func_);
+  CHECK_NULL_RETURN(in_tensors_.at(0)->data());
+  CHECK_NULL_RETURN(out_tensors_.front()->data());
+  if (!compressed_weight_.is_block) {
+    a_pack_ = reinterpret_cast<float *>(
+      ms_context_->allocator->Malloc(UP_ROUND(row_, C16NUM) * params_->deep_ * static_cast<int>(sizeof(float))));
+    if (a_pack_ == nullptr) {
+      MS_LOG(ERROR) << "Malloc input pack buffer failed";
+      return RET_ERROR;
+    }
+    RowMajor2Col16Major(reinterpret_cast<const float *>(in_tensors_.at(0)->data()), a_pack_, row_, params_->deep_);
+  }
+  auto ret = ParallelLaunch(ms_context_, MatmulSparseRun, this, thread_count_);
+  if (a_pack_ != nullptr) {
+    ms_context_->allocator->Free(a_pack_);
+    a_pack_ = nullptr;
+  }
+  return ret;
 #else
   auto ret = PackInput();
   if (ret != RET_OK) {
@@ -328,6 +530,8 @@ int MatmulSparseCPUKernel::Run() {
 }
 
 MatmulSparseCPUKernel::~MatmulSparseCPUKernel() {
+  free(bias_pack_);
+  bias_pack_ = nullptr;
   if (this->sparsity_weight_ == nullptr) {
     return;
   }
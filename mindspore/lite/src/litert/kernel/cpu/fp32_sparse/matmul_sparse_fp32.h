@@ -21,6 +21,7 @@
 #include "nnacl/matmul_parameter.h"
 #include "src/litert/lite_kernel.h"
 #include "nnacl/fp32/transpose_fp32.h"
+#include "nnacl/fp32_sparse/matmul_sparse_fp32.h"
 
 namespace mindspore::kernel {
 struct SparsityWeight {
@@ -30,6 +31,14 @@ struct SparsityWeight {
   uint32_t *non_zero_num;
 };
 
+// weight of the x86 kernels, see nnacl/fp32_sparse/matmul_sparse_fp32.h for the csr and block formats
+struct CompressedWeight {
+  bool is_block = false;
+  std::vector<float> data;
+  std::vector<uint32_t> index;
+  std::vector<uint32_t> offset;
+};
+
 using MatrixPackFun = void (*)(const float *src_ptr, float *dst_ptr, int row, int col);
 
 class MatmulSparseCPUKernel : public LiteKernel {
@@ -44,12 +53,17 @@ class MatmulSparseCPUKernel : public LiteKernel {
   int ReSize() override;
   int Run() override;
   int RunInstrinsics();
+  int DoSparseMatmul(int task_id);
+
+  // whether the constant weight has enough zeros to run faster with this kernel than the dense one
+  static bool CheckSparseWeight(const std::vector<lite::Tensor *> &inputs, const OpParameter *parameter);
 
  private:
   void InitParameter();
   int PackInput();
   int PrepareWeight();
   int PrepareBias();
+  int PrepareCompressedWeight();
 
   MatMulParameter *params_ = nullptr;
   TransposeParameter trans_param_{};
@@ -57,6 +71,11 @@ class MatmulSparseCPUKernel : public LiteKernel {
   float *a_pack_ = nullptr;
   size_t matrix_a_pack_size_ = 0;
   float *bias_pack_ = nullptr;
+  CompressedWeight compressed_weight_;
+  SparseMatMulFp32Func sparse_func_ = nullptr;
+  int row_ = 0;
+  int thread_count_ = 1;
+  int thread_stride_ = 0;
 };
 }  // namespace mindspore::kernel
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_SPARSE_FP32_H_
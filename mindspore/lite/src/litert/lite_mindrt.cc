@@ -20,6 +20,7 @@
 #include "mindrt/include/mindrt.hpp"
 #include "src/litert/kernel_exec_util.h"
 #include "src/common/tensor_util.h"
+#include "src/common/utils.h"
 #include "src/common/common.h"
 #include "src/litert/inner_allocator.h"
 #include "src/litert/kernel/cpu/base/partial_fusion.h"
@@ -36,8 +37,15 @@ void LiteOpActor::RunOpData(OpData<lite::Tensor> *inputs, OpContext<lite::Tensor
 
   InitInputData();
 
+  bool record_time = ctx_->inter_op_parallel_num_ > 1;
+  if (record_time) {
+    run_begin_time_ = GetTimeUs();
+  }
   auto ret = kernel_->Execute(*(reinterpret_cast<const KernelCallBack *>(context->kernel_call_back_before_)),
                               *(reinterpret_cast<const KernelCallBack *>(context->kernel_call_back_after_)));
+  if (record_time) {
+    run_end_time_ = GetTimeUs();
+  }
   input_op_datas_.erase(op_uuid);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "run kernel failed, name: " << kernel_->name();
@@ -66,6 +66,13 @@ class LiteOpActor : public OpActor<lite::Tensor> {
  public:
   void AddResultIndex(size_t index);
   const kernel::KernelExec *GetKernel() { return kernel_; }
+  // the time of the last run in us, recorded in inter-op parallel mode to measure the overlap of the branches
+  uint64_t run_begin_time() const { return run_begin_time_; }
+  uint64_t run_end_time() const { return run_end_time_; }
+  void ResetRunTime() {
+    run_begin_time_ = 0;
+    run_end_time_ = 0;
+  }
   // call this function after CompileArrow
   virtual std::set<kernel::KernelExec *> GetPartialKernels() const {
     if (partial_node_ == nullptr) {
@@ -109,6 +116,8 @@ class LiteOpActor : public OpActor<lite::Tensor> {
   kernel::KernelExec *partial_node_ = nullptr;
   kernel::KernelExec *call_node_ = nullptr;
   bool support_fp16_ = false;
+  uint64_t run_begin_time_ = 0;
+  uint64_t run_end_time_ = 0;
 };
 
 int MindrtInit();
@@ -16,6 +16,7 @@
 
 #include "src/litert/lite_session.h"
 #include <set>
+#include <algorithm>
 #include "src/litert/pack_weight_manager.h"
 #include "src/litert/runtime_pass.h"
 #if defined(LINUX_RUNTIME)
@@ -36,6 +37,7 @@
 #include "src/litert/lite_model.h"
 #include "src/litert/weight_decoder.h"
 #include "src/litert/runtime_allocator.h"
+#include "src/litert/thread_cost_model.h"
 #include "src/litert/kernel_exec_util.h"
 #ifndef CUSTOM_KERNEL_REGISTRY_CLIP
 #include "src/registry/register_kernel_impl.h"
@@ -579,6 +581,18 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
 
+  ret = resize_plan_cache_.Init(config_info_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init resize plan cache failed.";
+    is_running_.store(false);
+    return ret;
+  }
+  std::vector<std::vector<int>> input_dims;
+  for (auto input : inputs_) {
+    input_dims.push_back(input->shape());
+  }
+  CacheResizePlan(input_dims);
+
   is_running_.store(false);
 #if defined(LINUX_RUNTIME)
   (void)malloc_trim(0);
@@ -874,6 +888,13 @@ int LiteSession::Init(InnerContext *context) {
     return ret;
   }
 
+  ret = InitThreadCostModel(context_, config_info_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init thread cost model failed.";
+    is_running_.store(false);
+    return ret;
+  }
+
   ret = DelegateInit();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Init delegate failed.";
@@ -1083,6 +1104,64 @@ int LiteSession::ReSizeKernels(const std::vector<kernel::KernelExec *> &kernels,
   return RET_OK;
 }
 
+bool LiteSession::IsInputsShapeUnchanged(const std::vector<std::vector<int>> &dims) const {
+  if (dims.size() != inputs_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (inputs_[i]->shape() != dims[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LiteSession::CacheResizePlan(const std::vector<std::vector<int>> &dims) {
+  if (!resize_plan_cache_.enable() || is_train_session_ || is_control_flow_) {
+    return;
+  }
+  ResizePlan plan;
+  auto add_tensors = [&plan](const std::vector<Tensor *> &tensors) {
+    for (auto tensor : tensors) {
+      if (!tensor->IsConst()) {
+        plan.tensor_shapes[tensor] = tensor->shape();
+      }
+    }
+  };
+  for (auto subgraph : kernels_) {
+    // delegate and gpu subgraphs keep their own states of the shapes
+    if (subgraph->desc().arch != kernel::KERNEL_ARCH::kCPU) {
+      return;
+    }
+    add_tensors(subgraph->in_tensors());
+    add_tensors(subgraph->out_tensors());
+    for (auto node : reinterpret_cast<kernel::SubGraphKernel *>(subgraph)->nodes()) {
+      add_tensors(node->in_tensors());
+      add_tensors(node->out_tensors());
+    }
+  }
+  for (auto &item : plan.tensor_shapes) {
+    // the shapes are decided while running, or the elements of tensor lists are not recorded
+    auto &shape = item.second;
+    if (item.first->data_type() == kObjectTypeTensorType ||
+        std::any_of(shape.begin(), shape.end(), [](int dim) { return dim < 0; })) {
+      return;
+    }
+  }
+  if (runtime_allocator_ != nullptr && !runtime_allocator_->GetOffsetMap().empty()) {
+    plan.tensor_offsets = runtime_allocator_->GetOffsetMap();
+    plan.total_size = runtime_allocator_->total_size();
+  }
+  resize_plan_cache_.Insert(dims, std::move(plan));
+}
+
+bool LiteSession::MatchResizePlan(const ResizePlan &plan) const {
+  return std::all_of(plan.tensor_shapes.begin(), plan.tensor_shapes.end(),
+                     [](const std::pair<Tensor *const, std::vector<int>> &item) {
+                       return item.first->shape() == item.second;
+                     });
+}
+
 void LiteSession::SynIsolateInOutputDataType() {
   for (auto &tensor_map : isolate_input_map_) {
     auto dst_tensor = tensor_map.second;
@@ -1161,11 +1240,17 @@ int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
     MS_LOG(ERROR) << "Not support multi-threading";
     return RET_ERROR;
   }
+  // shapes of one bucket share the plan of the padded shape, and the callers fill the padded inputs
+  auto bucket_dims = resize_plan_cache_.PadToBucket(inputs, dims);
+  if (resize_plan_cache_.enable() && inputs == inputs_ && IsInputsShapeUnchanged(bucket_dims)) {
+    is_running_.store(false);
+    return RET_OK;
+  }
   std::vector<std::vector<int>> old_dims;
   for (size_t i = 0; i < inputs_.size(); ++i) {
     old_dims.push_back(inputs_[i]->shape());
   }
-  auto ret = ResizeInputs(inputs, dims);
+  auto ret = ResizeInputs(inputs, bucket_dims);
   if (ret != RET_OK) {
     ResetInputsShape(old_dims);
     is_running_.store(false);
@@ -1183,7 +1268,13 @@ int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
     return ret;
   }
 
-  if (RuntimeAllocatorInit() != RET_OK) {
+  // the allocator plan only depends on the inferred shapes, so it is reused if they are the same as the cached ones
+  auto plan = resize_plan_cache_.Find(bucket_dims);
+  if (plan != nullptr && !MatchResizePlan(*plan)) {
+    plan = nullptr;
+  }
+  ret = plan != nullptr ? RuntimeAllocatorRestore(*plan) : RuntimeAllocatorInit();
+  if (ret != RET_OK) {
     MS_LOG(ERROR) << "Runtime allocator in resize failed.";
     is_running_.store(false);
     return RET_ERROR;
@@ -1194,6 +1285,9 @@ int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
     MS_LOG(ERROR) << "GraphOptimizePass failed.";
     return RET_ERROR;
   }
+  if (plan == nullptr) {
+    CacheResizePlan(bucket_dims);
+  }
 
   is_running_.store(false);
 #if defined(LINUX_RUNTIME)
@@ -1268,6 +1362,16 @@ int LiteSession::InitExecutor() {
   return RET_OK;
 }
 
+float LiteSession::GetBranchOverlap() const {
+#ifdef ENABLE_MINDRT
+  auto executor = dynamic_cast<MindrtExecutor *>(executor_);
+  if (executor != nullptr) {
+    return executor->branch_overlap();
+  }
+#endif
+  return 0.0f;
+}
+
 int LiteSession::RuntimeAllocatorValid() {
 #ifdef ENABLE_ARM32
   MS_LOG(DEBUG) << "Not support runtime allocator in arm32.";
@@ -1439,6 +1543,19 @@ int LiteSession::RuntimeAllocatorInit() {
   return RET_OK;
 }
 
+int LiteSession::RuntimeAllocatorRestore(const ResizePlan &plan) {
+  if (runtime_allocator_ == nullptr || plan.tensor_offsets.empty()) {
+    return RuntimeAllocatorInit();
+  }
+  runtime_allocator_->Clear(context_->allocator);
+  for (auto &item : plan.tensor_offsets) {
+    item.first->set_allocator(runtime_allocator_);
+    runtime_allocator_->SetDataOffset(item.first, item.second);
+  }
+  runtime_allocator_->set_total_size(plan.total_size);
+  return RuntimeAllocatorSetData();
+}
+
 int LiteSession::RuntimeAllocatorSetData() {
   void *data = runtime_allocator_->MallocOptData();
   if (data == nullptr) {
@@ -27,6 +27,7 @@
 #include "src/litert/lite_model.h"
 #include "src/litert/inner_context.h"
 #include "src/litert/runtime_allocator.h"
+#include "src/litert/resize_plan_cache.h"
 #include "schema/model_generated.h"
 #include "src/litert/executor.h"
 #include "src/tensor.h"
@@ -72,6 +73,9 @@ class LiteSession {
     config_info_ = config_info;
   }
   const std::vector<Tensor *> &GetTensors() const { return this->tensors_; }
+  // The busy time of the branches divided by the time of the graph in the last run, only measured in inter-op
+  // parallel mode, 0 if it is not measured.
+  float GetBranchOverlap() const;
 
   virtual int Train() { return mindspore::lite::RET_ERROR; }
   virtual bool IsTrain() { return false; }
@@ -161,6 +165,13 @@ class LiteSession {
   virtual int RuntimeAllocatorValid();
   RuntimeAllocatorPtr runtime_allocator_ = nullptr;
 
+ private:
+  bool IsInputsShapeUnchanged(const std::vector<std::vector<int>> &dims) const;
+  void CacheResizePlan(const std::vector<std::vector<int>> &dims);
+  bool MatchResizePlan(const ResizePlan &plan) const;
+  int RuntimeAllocatorRestore(const ResizePlan &plan);
+  ResizePlanCache resize_plan_cache_;
+
  protected:
   InnerContext *context_ = nullptr;
   mindspore::Context *ms_context_ = nullptr;
@@ -15,6 +15,7 @@
  */
 #include "src/litert/mindrt_executor.h"
 #include <algorithm>
+#include <limits>
 #include <list>
 #include <queue>
 #include <memory>
@@ -300,6 +301,26 @@ void MindrtExecutor::FreeOutputTensor() {
   return;
 }
 
+void MindrtExecutor::UpdateBranchOverlap() {
+  uint64_t busy_time = 0;
+  uint64_t begin_time = std::numeric_limits<uint64_t>::max();
+  uint64_t end_time = 0;
+  for (auto &actor : op_actors_) {
+    if (actor->run_end_time() == 0) {
+      continue;
+    }
+    busy_time += actor->run_end_time() - actor->run_begin_time();
+    begin_time = std::min(begin_time, actor->run_begin_time());
+    end_time = std::max(end_time, actor->run_end_time());
+  }
+  if (end_time <= begin_time) {
+    return;
+  }
+  branch_overlap_ = static_cast<float>(busy_time) / static_cast<float>(end_time - begin_time);
+  MS_LOG(INFO) << "Branches are busy for " << busy_time << "us in " << (end_time - begin_time)
+               << "us, branch overlap: " << branch_overlap_;
+}
+
 int MindrtExecutor::Run(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
                         const std::vector<kernel::KernelExec *> &kernels, const KernelCallBack &before,
                         const KernelCallBack &after) {
@@ -312,11 +333,20 @@ int MindrtExecutor::Run(const std::vector<Tensor *> &in_tensors, const std::vect
 
   FreeOutputTensor();
 
+  bool inter_op_parallel = ctx_->inter_op_parallel_num_ > 1;
+  if (inter_op_parallel) {
+    for (auto &actor : op_actors_) {
+      actor->ResetRunTime();
+    }
+  }
   auto ret = MindrtRun<Tensor>(input_data_, &output_data_, &before, &after, actor_mgr_);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "MindrtRun failed";
     return ret;
   }
+  if (inter_op_parallel) {
+    UpdateBranchOverlap();
+  }
 
   ret = TransferGraphOutput();
   if (ret != RET_OK) {
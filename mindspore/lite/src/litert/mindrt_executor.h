@@ -45,9 +45,14 @@ class MindrtExecutor : public Executor {
 
   int Resize(const std::vector<mindspore::lite::Tensor *> &inputs, const std::vector<std::vector<int>> &dims) override;
 
+  // busy time of all the branches divided by the time of the graph in the last run, only measured in inter-op
+  // parallel mode. 1.0 means the branches ran one after another.
+  float branch_overlap() const { return branch_overlap_; }
+
  private:
   int TransferGraphOutput();
   void FreeOutputTensor();
+  void UpdateBranchOverlap();
   std::unordered_map<void *, std::set<std::pair<AID, size_t>>> BuildReceiverMap();
 
  protected:
@@ -62,6 +67,7 @@ class MindrtExecutor : public Executor {
   std::unordered_map<Tensor *, Tensor *> *isolate_output_map_;
   std::unordered_map<Tensor *, Tensor *> *isolate_input_map_;
   std::shared_ptr<ActorMgr> actor_mgr_;
+  float branch_overlap_ = 0.0f;
 };
 
 }  // namespace mindspore::lite
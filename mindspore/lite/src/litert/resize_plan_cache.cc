@@ -0,0 +1,147 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/resize_plan_cache.h"
+#include <algorithm>
+#include <utility>
+#include "include/errorcode.h"
+#include "src/common/common.h"
+#include "src/common/log_adapter.h"
+#include "src/common/utils.h"
+
+namespace mindspore {
+namespace lite {
+int ResizePlanCache::Init(const std::map<std::string, std::map<std::string, std::string>> *config_info) {
+  Clear();
+  enable_ = false;
+  bucket_boundaries_.clear();
+  bucket_inputs_.clear();
+  if (config_info == nullptr) {
+    return RET_OK;
+  }
+  auto section_iter = config_info->find(kResizeBucket);
+  if (section_iter == config_info->end()) {
+    return RET_OK;
+  }
+  auto &section = section_iter->second;
+
+  auto boundaries_iter = section.find(kResizeBucketBoundaries);
+  if (boundaries_iter != section.end()) {
+    for (auto &item : Tokenize(boundaries_iter->second, ",")) {
+      auto boundary = GenericParseValue<int>(item);
+      if (boundary.IsNone() || boundary.Get() <= 0 ||
+          (!bucket_boundaries_.empty() && boundary.Get() <= bucket_boundaries_.back())) {
+        MS_LOG(ERROR) << kResizeBucketBoundaries << " should be ascending positive integers, but got "
+                      << boundaries_iter->second;
+        return RET_INPUT_PARAM_INVALID;
+      }
+      bucket_boundaries_.push_back(boundary.Get());
+    }
+  }
+
+  auto inputs_iter = section.find(kResizeBucketInputs);
+  if (inputs_iter != section.end()) {
+    for (auto &item : Tokenize(inputs_iter->second, ",")) {
+      (void)bucket_inputs_.insert(item);
+    }
+  }
+  if (!bucket_boundaries_.empty() && bucket_inputs_.empty()) {
+    MS_LOG(ERROR) << kResizeBucketInputs << " should be set to the names of the padded inputs if "
+                  << kResizeBucketBoundaries << " is set.";
+    return RET_INPUT_PARAM_INVALID;
+  }
+
+  auto axis_iter = section.find(kResizeBucketAxis);
+  if (axis_iter != section.end()) {
+    auto axis = GenericParseValue<int>(axis_iter->second);
+    if (axis.IsNone() || axis.Get() < 0) {
+      MS_LOG(ERROR) << kResizeBucketAxis << " should be a non-negative integer, but got " << axis_iter->second;
+      return RET_INPUT_PARAM_INVALID;
+    }
+    bucket_axis_ = axis.Get();
+  }
+
+  auto plan_num_iter = section.find(kResizeMaxCachedPlans);
+  if (plan_num_iter != section.end()) {
+    auto plan_num = GenericParseValue<size_t>(plan_num_iter->second);
+    if (plan_num.IsNone() || plan_num.Get() == 0) {
+      MS_LOG(ERROR) << kResizeMaxCachedPlans << " should be a positive integer, but got " << plan_num_iter->second;
+      return RET_INPUT_PARAM_INVALID;
+    }
+    max_plan_num_ = plan_num.Get();
+  }
+  enable_ = true;
+  return RET_OK;
+}
+
+InputShapes ResizePlanCache::PadToBucket(const std::vector<Tensor *> &inputs, const InputShapes &dims) const {
+  if (!enable_ || bucket_boundaries_.empty() || inputs.size() != dims.size()) {
+    return dims;
+  }
+  auto bucket_dims = dims;
+  for (size_t i = 0; i < bucket_dims.size(); ++i) {
+    auto &shape = bucket_dims[i];
+    if (inputs[i] == nullptr || bucket_inputs_.find(inputs[i]->tensor_name()) == bucket_inputs_.end() ||
+        static_cast<int>(shape.size()) <= bucket_axis_) {
+      continue;
+    }
+    auto &dim = shape[bucket_axis_];
+    auto iter = std::lower_bound(bucket_boundaries_.begin(), bucket_boundaries_.end(), dim);
+    if (dim > 0 && iter != bucket_boundaries_.end()) {
+      dim = *iter;
+    }
+  }
+  return bucket_dims;
+}
+
+const ResizePlan *ResizePlanCache::Find(const InputShapes &dims) {
+  if (!enable_) {
+    return nullptr;
+  }
+  auto iter = plans_.find(dims);
+  if (iter == plans_.end()) {
+    return nullptr;
+  }
+  auto used_iter = std::find(used_list_.begin(), used_list_.end(), dims);
+  if (used_iter != used_list_.end()) {
+    used_list_.splice(used_list_.begin(), used_list_, used_iter);
+  }
+  return &iter->second;
+}
+
+void ResizePlanCache::Insert(const InputShapes &dims, ResizePlan plan) {
+  if (!enable_) {
+    return;
+  }
+  auto used_iter = std::find(used_list_.begin(), used_list_.end(), dims);
+  if (used_iter != used_list_.end()) {
+    used_list_.splice(used_list_.begin(), used_list_, used_iter);
+  } else {
+    used_list_.push_front(dims);
+  }
+  plans_[dims] = std::move(plan);
+  while (plans_.size() > max_plan_num_) {
+    (void)plans_.erase(used_list_.back());
+    used_list_.pop_back();
+  }
+}
+
+void ResizePlanCache::Clear() {
+  plans_.clear();
+  used_list_.clear();
+}
+}  // namespace lite
+}  // namespace mindspore
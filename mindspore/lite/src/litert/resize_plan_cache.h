@@ -0,0 +1,74 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_RESIZE_PLAN_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_RESIZE_PLAN_CACHE_H_
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "src/tensor.h"
+
+namespace mindspore {
+namespace lite {
+using InputShapes = std::vector<std::vector<int>>;
+
+// The runtime allocator plan of the input shapes. The kernels write shape dependent states into their parameters
+// while inferring, so Resize still infers the shapes, and the plan is only reused if the inferred shapes are the
+// same as tensor_shapes.
+struct ResizePlan {
+  // inferred shapes of the tensors used by the kernels
+  std::unordered_map<Tensor *, std::vector<int>> tensor_shapes;
+  // offsets in the runtime allocator, empty if the runtime allocator is not used
+  std::unordered_map<Tensor *, size_t> tensor_offsets;
+  size_t total_size = 0;
+};
+
+// Caches the resize plans of the input shapes seen before, the input shapes can be padded to buckets so that
+// shapes of the same bucket share one plan. Configured by the section "resize_bucket" of the config file:
+//   bucket_boundaries: ascending sizes, dim bucket_axis of each bucket input is padded up to the first boundary not
+//                      less than it. Dims greater than the last boundary are kept. No padding if it is not set.
+//   bucket_inputs: names of the inputs to pad, separated by ",". Required if bucket_boundaries is set.
+//   bucket_axis: the padded axis, 1 by default, which is the sequence length of NLP models.
+//   max_cached_plans: the plan of the least recently used shapes is dropped if more shapes are seen.
+class ResizePlanCache {
+ public:
+  ResizePlanCache() = default;
+  ~ResizePlanCache() = default;
+
+  int Init(const std::map<std::string, std::map<std::string, std::string>> *config_info);
+  bool enable() const { return enable_; }
+  InputShapes PadToBucket(const std::vector<Tensor *> &inputs, const InputShapes &dims) const;
+  const ResizePlan *Find(const InputShapes &dims);
+  void Insert(const InputShapes &dims, ResizePlan plan);
+  void Clear();
+
+ private:
+  bool enable_ = false;
+  int bucket_axis_ = 1;
+  std::vector<int> bucket_boundaries_;
+  std::set<std::string> bucket_inputs_;
+  size_t max_plan_num_ = 8;
+  std::map<InputShapes, ResizePlan> plans_;
+  // the most recently used shapes are at the front
+  std::list<InputShapes> used_list_;
+};
+}  // namespace lite
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_RESIZE_PLAN_CACHE_H_
@@ -44,6 +44,8 @@ class RuntimeAllocator : public Allocator {
   void FreeTensorData(lite::Tensor *tensor);
   void *MallocOptData();
   const std::unordered_map<lite::Tensor *, size_t> &GetOffsetMap() const { return offset_map_; }
+  size_t total_size() const { return total_size_; }
+  void set_total_size(size_t total_size) { total_size_ = total_size; }
   void Clear(AllocatorPtr default_allocator);
 
  private:
@@ -21,6 +21,8 @@
 #include <iterator>
 #include <vector>
 #include <queue>
+#include <cmath>
+#include <numeric>
 #include "src/tensor.h"
 #include "schema/ops_generated.h"
 #include "schema/model_generated.h"
@@ -30,6 +32,7 @@
 #include "nnacl/pooling_parameter.h"
 #include "include/model.h"
 #include "nnacl/base/conv_common_base.h"
+#include "nnacl/matmul_parameter.h"
 
 namespace {
 constexpr const int kMaxDepth = 2048;
@@ -44,6 +47,31 @@ size_t CommConvMul(std::vector<int> weight_shape, std::vector<int> output_shape)
   return cost;
 }
 
+/* every branch gets one thread, the others are split by cost with the largest remainder method */
+std::vector<int> SplitThreadsByCost(const std::vector<size_t> &costs, int max_thread) {
+  std::vector<int> thread_nums(costs.size(), 1);
+  size_t total_cost = std::accumulate(costs.begin(), costs.end(), static_cast<size_t>(0));
+  int spare_thread = max_thread - static_cast<int>(costs.size());
+  if (spare_thread <= 0 || total_cost == 0) {
+    return thread_nums;
+  }
+  std::vector<std::pair<double, size_t>> remainders;
+  for (size_t i = 0; i < costs.size(); i++) {
+    double quota = static_cast<double>(spare_thread) * costs[i] / total_cost;
+    double thread_num = std::floor(quota);
+    thread_nums[i] += static_cast<int>(thread_num);
+    remainders.emplace_back(quota - thread_num, i);
+  }
+  int left_thread = max_thread - std::accumulate(thread_nums.begin(), thread_nums.end(), 0);
+  std::sort(remainders.begin(), remainders.end(), [](const auto &a, const auto &b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  });
+  for (int i = 0; i < left_thread && i < static_cast<int>(remainders.size()); i++) {
+    thread_nums[remainders[i].second]++;
+  }
+  return thread_nums;
+}
+
 size_t WinogradConvMul() {
   /* winograd conv */
   return 0;
@@ -1128,6 +1156,114 @@ void SearchSubGraph::InsertNodeBegin(uint32_t index, Subgraph *subgraph, std::ve
   return;
 }
 
+SearchSubGraph::CostModel SearchSubGraph::CalculateOperatorCost(const LiteGraph::Node *node) {
+  CostModel cost;
+  if (node->output_indices_.empty()) {
+    return cost;
+  }
+  int64_t output_num = src_tensors_->at(node->output_indices_.front())->ElementsNum();
+  if (output_num <= 0) {
+    /* shape is unknown before running */
+    cost.io_cost_ = 1;
+    return cost;
+  }
+  auto type = GetPrimitiveType(node->primitive_, SCHEMA_VERSION::SCHEMA_CUR);
+  auto param_iter = op_parameters_->find(node->output_indices_.front());
+  if (param_iter != op_parameters_->end() && node->input_indices_.size() > 1) {
+    auto weight_shape = src_tensors_->at(node->input_indices_.at(1))->shape();
+    if (type == schema::PrimitiveType_Conv2DFusion && weight_shape.size() == DIMENSION_4D &&
+        src_tensors_->at(node->output_indices_.front())->shape().size() == DIMENSION_4D) {
+      return CalculateConv2DFusion(node);
+    }
+    if ((type == schema::PrimitiveType_MatMulFusion || type == schema::PrimitiveType_FullConnection) &&
+        weight_shape.size() >= DIMENSION_2D) {
+      auto param = reinterpret_cast<MatMulParameter *>(param_iter->second);
+      int deep = param->b_transpose_ ? weight_shape.back() : weight_shape.at(weight_shape.size() - DIMENSION_2D);
+      if (deep > 0) {
+        cost.mul_cost_ = static_cast<size_t>(output_num) * static_cast<size_t>(deep);
+        return cost;
+      }
+    }
+  }
+  /* other operators are bound by the data they write */
+  cost.io_cost_ = static_cast<size_t>(output_num);
+  return cost;
+}
+
+void SearchSubGraph::InitOperatorThreadNum(std::vector<Subgraph> *sub_graphs) {
+  size_t sub_num = sub_graphs->size();
+  int max_thread = context_->thread_num_ > kOperatorMaxThreadNum ? kOperatorMaxThreadNum : context_->thread_num_;
+  if (sub_num < kDefaultSubGraphSize || max_thread <= 1) {
+    return;
+  }
+
+  std::vector<size_t> costs(sub_num, 0);
+  std::unordered_map<uint32_t, size_t> node_sub_index;
+  for (size_t i = 0; i < sub_num; i++) {
+    Subgraph &subgraph = sub_graphs->at(i);
+    subgraph.cost_.empty();
+    for (uint32_t node_index : subgraph.nodes_) {
+      subgraph.cost_ = subgraph.cost_ + CalculateOperatorCost(model_->graph_.all_nodes_[node_index]);
+      node_sub_index[node_index] = i;
+    }
+    costs[i] = MSMAX(subgraph.cost_.mul_cost_ + subgraph.cost_.io_cost_, 1);
+  }
+
+  /* a branch never runs at the same time as the branches it depends on, directly or not */
+  std::vector<std::vector<bool>> depend(sub_num, std::vector<bool>(sub_num, false));
+  for (size_t i = 0; i < sub_num; i++) {
+    for (uint32_t node_index : sub_graphs->at(i).nodes_) {
+      for (uint32_t input : model_->graph_.all_nodes_[node_index]->input_indices_) {
+        for (uint32_t pre_node : tensors_[input].out_nodes_) {
+          auto iter = node_sub_index.find(pre_node);
+          if (iter != node_sub_index.end() && iter->second != i) {
+            depend[i][iter->second] = true;
+          }
+        }
+      }
+    }
+  }
+  for (size_t k = 0; k < sub_num; k++) {
+    for (size_t i = 0; i < sub_num; i++) {
+      if (!depend[i][k]) {
+        continue;
+      }
+      for (size_t j = 0; j < sub_num; j++) {
+        depend[i][j] = depend[i][j] || depend[k][j];
+      }
+    }
+  }
+
+  /* every branch and the heaviest branches which can run with it share the threads, a branch takes its smallest share
+   * among these groups, so the branches of any group never take more than max_thread together */
+  size_t group_size = static_cast<size_t>(MSMIN(MSMAX(context_->inter_op_parallel_num_, 1), max_thread));
+  std::vector<int> thread_nums(sub_num, max_thread);
+  for (size_t i = 0; i < sub_num; i++) {
+    std::vector<size_t> group = {i};
+    for (size_t j = 0; j < sub_num; j++) {
+      if (j != i && !depend[i][j] && !depend[j][i]) {
+        group.push_back(j);
+      }
+    }
+    std::sort(group.begin() + 1, group.end(),
+              [&costs](size_t a, size_t b) { return costs[a] > costs[b] || (costs[a] == costs[b] && a < b); });
+    if (group.size() > group_size) {
+      group.resize(group_size);
+    }
+    std::vector<size_t> group_costs;
+    (void)std::transform(group.begin(), group.end(), std::back_inserter(group_costs),
+                         [&costs](size_t index) { return costs[index]; });
+    auto group_thread_nums = SplitThreadsByCost(group_costs, max_thread);
+    for (size_t k = 0; k < group.size(); k++) {
+      thread_nums[group[k]] = MSMIN(thread_nums[group[k]], group_thread_nums[k]);
+    }
+  }
+  for (size_t i = 0; i < sub_num; i++) {
+    sub_graphs->at(i).thread_ = static_cast<size_t>(thread_nums[i]);
+    MS_LOG(INFO) << "Branch " << i << " cost: " << costs[i] << ", thread num: " << thread_nums[i];
+  }
+}
+
 void SearchSubGraph::SubGraphSplitByOperator() {
   if (!ValidInParallel()) {
     return;
@@ -1157,6 +1293,7 @@ void SearchSubGraph::SubGraphSplitByOperator() {
       sub_graphs_.push_back(std::move(subgraph));
     }
   }
+  InitOperatorThreadNum(&sub_graphs_);
   ConvertSubGraphToModel(&sub_graphs_);
 }
 }  // namespace mindspore::lite
@@ -129,6 +129,10 @@ class SearchSubGraph {
                                   uint32_t root_node_index);
   const schema::Primitive *CreatePartialPrimitive(int64_t subgraph_index);
 
+ private: /* split by operator */
+  CostModel CalculateOperatorCost(const LiteGraph::Node *node);
+  void InitOperatorThreadNum(std::vector<Subgraph> *sub_graphs);
+
  private: /* public cost-model func  */
   CostModel CalculateConv2DFusion(const LiteGraph::Node *node);
   void dfs(int i, int n, int current_sum, int except_value, int *min_value, std::vector<bool> *tmp_group,
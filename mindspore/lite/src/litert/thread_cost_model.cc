@@ -15,13 +15,94 @@
  */
 
 #include "src/litert/thread_cost_model.h"
-#include <map>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "src/common/common.h"
+#include "src/common/config_file.h"
 #include "src/common/log_util.h"
+#include "src/common/utils.h"
 #include "src/litert/inner_context.h"
 #include "thread/threadpool.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/arithmetic_self_fp32.h"
+#include "nnacl/fp32/div_fp32.h"
+#include "nnacl/fp32/mul_fp32.h"
+#include "nnacl/fp32/sub_fp32.h"
 
 namespace mindspore::lite {
-const std::map<int32_t, float> kernel_compute_cost_map_ = {
+namespace {
+constexpr int kCalibrateDataNum = 64 * 1024;  // 64k : about the element num of the tables below
+constexpr int kCalibrateLoopCount = 64;
+constexpr float kMinCost = 0.001f;
+constexpr float kParallelOverheadRatio = 10.0f;  // 10 : the launch overhead is at most a tenth of a thread's work
+constexpr float kLeakyReluAlpha = 0.2f;
+constexpr char kKernelComputeCost[] = "kernel_compute_cost";
+constexpr char kPerUnitLoadCost[] = "per_unit_load_cost";
+constexpr char kPerUnitStoreCost[] = "per_unit_store_cost";
+constexpr char kThreadStartupCost[] = "thread_startup_cost";
+constexpr char kSingleThreadCost[] = "single_thread_cost";
+constexpr char kParallelThreadCost[] = "parallel_thread_cost";
+constexpr char kLaunchThreadNum[] = "launch_thread_num";
+
+// serializes the calibration. The sessions of the process read the published models by std::atomic_load, which is
+// not lock-free for a shared_ptr: libstdc++ takes one of its internal mutexes for the copy of the pointer.
+std::mutex cost_model_mutex;
+
+using ElementFunc = std::function<void(const float *, const float *, float *, int)>;
+
+// the kernels of these types run one nnacl function per element with load 1 and store 1
+const std::vector<std::pair<int32_t, ElementFunc>> &ElementKernelBenchmarks() {
+  static const std::vector<std::pair<int32_t, ElementFunc>> benchmarks = {
+    {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU),
+     [](const float *in0, const float *, float *out, int size) { (void)Fp32Relu(in0, size, out); }},
+    {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU6),
+     [](const float *in0, const float *, float *out, int size) { (void)Fp32Relu6(in0, size, out); }},
+    {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_LEAKY_RELU),
+     [](const float *in0, const float *, float *out, int size) { (void)LRelu(in0, size, out, kLeakyReluAlpha); }},
+    {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_TANH),
+     [](const float *in0, const float *, float *out, int size) { (void)Tanh(in0, size, out); }},
+    {TC_TYPE(schema::PrimitiveType_Sqrt, 0),
+     [](const float *in0, const float *, float *out, int size) { (void)ElementSqrt(in0, out, size); }},
+    {TC_TYPE(schema::PrimitiveType_MulFusion, schema::ActivationType_RELU), ElementMulRelu},
+    {TC_TYPE(schema::PrimitiveType_MulFusion, schema::ActivationType_RELU6), ElementMulRelu6},
+    {TC_TYPE(schema::PrimitiveType_MulFusion, schema::ActivationType_NO_ACTIVATION), ElementMul},
+    {TC_TYPE(schema::PrimitiveType_AddFusion, schema::ActivationType_RELU), ElementAddRelu},
+    {TC_TYPE(schema::PrimitiveType_AddFusion, schema::ActivationType_RELU6), ElementAddRelu6},
+    {TC_TYPE(schema::PrimitiveType_AddFusion, schema::ActivationType_NO_ACTIVATION), ElementAdd},
+    {TC_TYPE(schema::PrimitiveType_SubFusion, schema::ActivationType_RELU), ElementSubRelu},
+    {TC_TYPE(schema::PrimitiveType_SubFusion, schema::ActivationType_RELU6), ElementSubRelu6},
+    {TC_TYPE(schema::PrimitiveType_SubFusion, schema::ActivationType_NO_ACTIVATION), ElementSub},
+    {TC_TYPE(schema::PrimitiveType_DivFusion, schema::ActivationType_RELU), ElementDivRelu},
+    {TC_TYPE(schema::PrimitiveType_DivFusion, schema::ActivationType_RELU6), ElementDivRelu6},
+    {TC_TYPE(schema::PrimitiveType_DivFusion, schema::ActivationType_NO_ACTIVATION), ElementDiv},
+    {TC_TYPE(schema::PrimitiveType_RealDiv, schema::ActivationType_RELU), ElementDivRelu},
+    {TC_TYPE(schema::PrimitiveType_RealDiv, schema::ActivationType_RELU6), ElementDivRelu6},
+    {TC_TYPE(schema::PrimitiveType_RealDiv, schema::ActivationType_NO_ACTIVATION), ElementDiv},
+  };
+  return benchmarks;
+}
+
+// average time of run in nanoseconds
+float MeasureTime(const std::function<void()> &run) {
+  run();  // warm up the cache
+  auto start = GetTimeUs();
+  for (int i = 0; i < kCalibrateLoopCount; ++i) {
+    run();
+  }
+  constexpr float kNsPerUs = 1000.0f;
+  return static_cast<float>(GetTimeUs() - start) * kNsPerUs / kCalibrateLoopCount;
+}
+}  // namespace
+
+const std::map<int32_t, float> kDefaultKernelComputeCost = {
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU), 1.806f},        // dataNum about 100k
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU6), 1.806f},       // dataNum about 100k
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_LEAKY_RELU), 1.806f},  // dataNum about 100k
@@ -65,15 +146,29 @@ const std::map<int32_t, float> kernel_compute_cost_map_ = {
   {TC_TYPE(schema::PrimitiveType_OneHot, 0), 136.562f},           // dataNum about 1.5k
 };
 
-float ThreadCostModel::per_unit_load_cost_ = 1.0 / 64 * 11;   // 64: L2 cache size, 11 : L2 cache latency on Haswell
-float ThreadCostModel::per_unit_store_cost_ = 1.0 / 64 * 11;  // 64: L2 cache size, 11 : L2 cache latency on Haswell
-int64_t ThreadCostModel::per_unit_compute_num_ = 1;           // 1 : per unit compute num
+ThreadCostModel::ThreadCostModel()
+    : kernel_compute_cost_map_(kDefaultKernelComputeCost),
+      per_unit_load_cost_(1.0 / 64 * 11),   // 64: L2 cache size, 11 : L2 cache latency on Haswell
+      per_unit_store_cost_(1.0 / 64 * 11),  // 64: L2 cache size, 11 : L2 cache latency on Haswell
+      per_unit_compute_num_(1),             // 1 : per unit compute num
+      thread_startup_cost_(100000.0f),      // 100000 : thread startup inherent cost
+      single_thread_cost_(100000.0f),       // 100000 : Minimum cost of single-threaded
+      parallel_thread_cost_(40000.0f),      // 40000 : Minimum cost of per thread in parallel-thread
+      launch_thread_num_(0) {}
+
+namespace {
+// the models read by UpdateThreadNum keyed by their launch thread num, the map is replaced as a whole by
+// std::atomic_store and never modified in place
+using ThreadCostModels = std::map<int, std::shared_ptr<const ThreadCostModel>>;
+std::shared_ptr<const ThreadCostModels> thread_cost_models = std::make_shared<const ThreadCostModels>();
 
-float ThreadCostModel::thread_startup_cost_ = 100000.0f;  // 100000 : thread startup inherent cost
-float ThreadCostModel::single_thread_cost_ = 100000.0f;   // 100000 : Minimum cost of single-threaded
-float ThreadCostModel::parallel_thread_cost_ = 40000.0f;  // 40000 : Minimum cost of per thread in parallel-thread
+const ThreadCostModel &DefaultThreadCostModel() {
+  static const ThreadCostModel default_model;
+  return default_model;
+}
+}  // namespace
 
-int ThreadCostModel::GetOptimalThreadNum(const ThreadCostContext *thread_cost_context, const int thread_num) {
+int ThreadCostModel::GetOptimalThreadNum(const ThreadCostContext *thread_cost_context, const int thread_num) const {
   const int64_t max_oversharding_factor = 4;
 
   int64_t block_size = MSVALID(max_oversharding_factor * thread_num, ThreadBlockSize(thread_cost_context),
@@ -103,31 +198,257 @@ int ThreadCostModel::GetOptimalThreadNum(const ThreadCostContext *thread_cost_co
   return block_count;
 }
 
-int ThreadNumUpdateStrategy(const ThreadCostContext *thread_cost_context, int task_num) {
+int ThreadNumUpdateStrategy(const ThreadCostModel &thread_cost_model, const ThreadCostContext *thread_cost_context,
+                            int task_num) {
   if (task_num <= 1) {
     return task_num;
   }
 
   if (thread_cost_context != nullptr) {
-    if (ThreadCostModel::ThreadNum(thread_cost_context) <= 1) {
+    if (thread_cost_model.ThreadNum(thread_cost_context) <= 1) {
       return 1;
     }
-    int opt_thread = static_cast<int>(ThreadCostModel::ParallelDegree(thread_cost_context));
+    int opt_thread = static_cast<int>(thread_cost_model.ParallelDegree(thread_cost_context));
     task_num = MSVALID(1, opt_thread, task_num);
     task_num = MSMIN(task_num, thread_cost_context->total_unit_num_);
   }
   return task_num;
 }
 
+int ThreadCostModel::Calibrate(const InnerContext *context) {
+  CHECK_NULL_RETURN(context);
+  std::vector<float> in0(kCalibrateDataNum);
+  std::vector<float> in1(kCalibrateDataNum);
+  std::vector<float> out(kCalibrateDataNum);
+  for (int i = 0; i < kCalibrateDataNum; ++i) {
+    // positive and away from zero for sqrt and div
+    in0[i] = 1.0f + static_cast<float>(i % 97) / 97;
+    in1[i] = 1.0f + static_cast<float>(i % 89) / 89;
+  }
+  // the libc memset and memcpy are vectorized like the kernels, whatever the optimization of this file
+  float store_time = MeasureTime([&out]() { (void)memset(out.data(), 0, kCalibrateDataNum * sizeof(float)); });
+  float copy_time =
+    MeasureTime([&in0, &out]() { (void)memcpy(out.data(), in0.data(), kCalibrateDataNum * sizeof(float)); });
+  float per_unit_store_cost = MSMAX(kMinCost, store_time / kCalibrateDataNum);
+  float per_unit_load_cost = MSMAX(kMinCost, (copy_time - store_time) / kCalibrateDataNum);
+
+  std::vector<float> ratios;
+  std::map<int32_t, float> compute_costs;
+  for (auto &benchmark : ElementKernelBenchmarks()) {
+    auto &run = benchmark.second;
+    float time =
+      MeasureTime([&run, &in0, &in1, &out]() { run(in0.data(), in1.data(), out.data(), kCalibrateDataNum); });
+    float cost = time / kCalibrateDataNum - per_unit_load_cost - per_unit_store_cost;
+    // the cost of a bandwidth-bound kernel is clamped, which says nothing about the scale of the others
+    if (cost > kMinCost) {
+      ratios.push_back(cost / kDefaultKernelComputeCost.at(benchmark.first));
+    }
+    compute_costs[benchmark.first] = MSMAX(kMinCost, cost);
+  }
+  const auto &default_model = DefaultThreadCostModel();
+  float scale = (per_unit_load_cost + per_unit_store_cost) /
+                (default_model.per_unit_load_cost_ + default_model.per_unit_store_cost_);
+  if (!ratios.empty()) {
+    std::nth_element(ratios.begin(), ratios.begin() + ratios.size() / C2NUM, ratios.end());
+    scale = ratios.at(ratios.size() / C2NUM);
+  }
+  for (auto &item : kernel_compute_cost_map_) {
+    auto iter = compute_costs.find(item.first);
+    item.second = iter != compute_costs.end() ? iter->second : MSMAX(kMinCost, item.second * scale);
+  }
+
+  per_unit_load_cost_ = per_unit_load_cost;
+  per_unit_store_cost_ = per_unit_store_cost;
+  // the thread costs are scaled like the compute costs, unless the launch is measured with more than one thread
+  thread_startup_cost_ *= scale;
+  single_thread_cost_ *= scale;
+  parallel_thread_cost_ *= scale;
+  MS_LOG(INFO) << "calibrated thread cost model, load: " << per_unit_load_cost_ << "ns, store: " << per_unit_store_cost_
+               << "ns, compute scale: " << scale
+               << ", bandwidth-bound kernels: " << compute_costs.size() - ratios.size();
+  return CalibrateLaunch(context);
+}
+
+int ThreadCostModel::CalibrateLaunch(const InnerContext *context) {
+  CHECK_NULL_RETURN(context);
+  int task_num = context->thread_num_;
+  launch_thread_num_ = task_num;
+  if (task_num <= 1) {
+    return RET_OK;
+  }
+  auto empty_task = [](void *, int, float, float) { return RET_OK; };
+  float launch_time = MeasureTime(
+    [context, &empty_task, task_num]() { (void)ParallelLaunch(context, empty_task, nullptr, task_num); });
+  launch_time = MSMAX(kMinCost, launch_time);
+  // the startup and single-thread costs keep their ratios to the parallel cost
+  float thread_scale = kParallelOverheadRatio * launch_time / parallel_thread_cost_;
+  thread_startup_cost_ *= thread_scale;
+  single_thread_cost_ *= thread_scale;
+  parallel_thread_cost_ *= thread_scale;
+  MS_LOG(INFO) << "calibrated thread cost model, launch " << task_num << " threads: " << launch_time << "ns";
+  return RET_OK;
+}
+
+int ThreadCostModel::LoadProfile(const std::string &path) {
+  std::map<std::string, std::map<std::string, std::string>> profile;
+  auto ret = GetAllSectionInfoFromConfigFile(path, &profile);
+  if (ret != RET_OK) {
+    MS_LOG(WARNING) << "read thread cost profile failed: " << path;
+    return ret;
+  }
+  auto model_iter = profile.find(kThreadCostModel);
+  if (model_iter == profile.end()) {
+    MS_LOG(WARNING) << "no section " << kThreadCostModel << " in thread cost profile: " << path;
+    return RET_ERROR;
+  }
+  std::map<std::string, float> model_costs = {{kPerUnitLoadCost, 0.0f},
+                                              {kPerUnitStoreCost, 0.0f},
+                                              {kThreadStartupCost, 0.0f},
+                                              {kSingleThreadCost, 0.0f},
+                                              {kParallelThreadCost, 0.0f}};
+  for (auto &item : model_costs) {
+    auto iter = model_iter->second.find(item.first);
+    if (iter == model_iter->second.end()) {
+      MS_LOG(WARNING) << "no " << item.first << " in thread cost profile: " << path;
+      return RET_ERROR;
+    }
+    auto cost = GenericParseValue<float>(iter->second);
+    if (cost.IsNone() || cost.Get() <= 0.0f) {
+      MS_LOG(WARNING) << item.first << " should be a positive number in thread cost profile: " << path;
+      return RET_ERROR;
+    }
+    item.second = cost.Get();
+  }
+  auto thread_num_iter = model_iter->second.find(kLaunchThreadNum);
+  if (thread_num_iter == model_iter->second.end()) {
+    MS_LOG(WARNING) << "no " << kLaunchThreadNum << " in thread cost profile: " << path;
+    return RET_ERROR;
+  }
+  auto launch_thread_num = GenericParseValue<int>(thread_num_iter->second);
+  if (launch_thread_num.IsNone() || launch_thread_num.Get() <= 0) {
+    MS_LOG(WARNING) << kLaunchThreadNum << " should be a positive integer in thread cost profile: " << path;
+    return RET_ERROR;
+  }
+  std::map<int32_t, float> compute_costs;
+  auto kernel_iter = profile.find(kKernelComputeCost);
+  if (kernel_iter != profile.end()) {
+    for (auto &item : kernel_iter->second) {
+      auto kernel_type = GenericParseValue<int32_t>(item.first);
+      auto cost = GenericParseValue<float>(item.second);
+      if (kernel_type.IsNone() || cost.IsNone() || cost.Get() <= 0.0f) {
+        MS_LOG(WARNING) << "invalid kernel compute cost " << item.first << "=" << item.second
+                        << " in thread cost profile: " << path;
+        return RET_ERROR;
+      }
+      compute_costs[kernel_type.Get()] = cost.Get();
+    }
+  }
+
+  per_unit_load_cost_ = model_costs.at(kPerUnitLoadCost);
+  per_unit_store_cost_ = model_costs.at(kPerUnitStoreCost);
+  thread_startup_cost_ = model_costs.at(kThreadStartupCost);
+  single_thread_cost_ = model_costs.at(kSingleThreadCost);
+  parallel_thread_cost_ = model_costs.at(kParallelThreadCost);
+  launch_thread_num_ = launch_thread_num.Get();
+  for (auto &item : compute_costs) {
+    kernel_compute_cost_map_[item.first] = item.second;
+  }
+  return RET_OK;
+}
+
+int ThreadCostModel::SaveProfile(const std::string &path) const {
+  std::ofstream ofs(path);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "open thread cost profile failed: " << path;
+    return RET_ERROR;
+  }
+  // enough digits to load the same costs back
+  ofs.precision(std::numeric_limits<float>::max_digits10);
+  ofs << "[" << kThreadCostModel << "]\n";
+  ofs << kPerUnitLoadCost << "=" << per_unit_load_cost_ << "\n";
+  ofs << kPerUnitStoreCost << "=" << per_unit_store_cost_ << "\n";
+  ofs << kThreadStartupCost << "=" << thread_startup_cost_ << "\n";
+  ofs << kSingleThreadCost << "=" << single_thread_cost_ << "\n";
+  ofs << kParallelThreadCost << "=" << parallel_thread_cost_ << "\n";
+  ofs << kLaunchThreadNum << "=" << launch_thread_num_ << "\n";
+  ofs << "# key: TC_TYPE(primitive_type, activation_type)\n";
+  ofs << "[" << kKernelComputeCost << "]\n";
+  for (auto &item : kernel_compute_cost_map_) {
+    ofs << item.first << "=" << item.second << "\n";
+  }
+  ofs.close();
+  return ofs.fail() ? RET_ERROR : RET_OK;
+}
+
+int InitThreadCostModel(const InnerContext *context,
+                        const std::map<std::string, std::map<std::string, std::string>> *config_info) {
+  if (config_info == nullptr) {
+    return RET_OK;
+  }
+  auto section_iter = config_info->find(kThreadCostModel);
+  if (section_iter == config_info->end()) {
+    return RET_OK;
+  }
+  CHECK_NULL_RETURN(context);
+  auto &section = section_iter->second;
+  auto calibrate_iter = section.find(kThreadCostModelCalibrate);
+  bool calibrate = calibrate_iter != section.end() && calibrate_iter->second == "true";
+  auto path_iter = section.find(kThreadCostModelProfilePath);
+  std::string profile_path = path_iter != section.end() ? path_iter->second : "";
+  if (!calibrate && profile_path.empty()) {
+    return RET_OK;
+  }
+
+  int thread_num = context->thread_num_;
+  std::lock_guard<std::mutex> lock(cost_model_mutex);
+  auto models = std::atomic_load(&thread_cost_models);
+  if (models->find(thread_num) != models->end()) {
+    return RET_OK;
+  }
+  auto model = std::make_shared<ThreadCostModel>();
+  bool save_profile = false;
+  int ret = RET_OK;
+  if (!models->empty()) {
+    // the compute costs are calibrated once per process, only the thread costs depend on the thread num
+    *model = *models->begin()->second;
+    ret = model->CalibrateLaunch(context);
+  } else if (!calibrate && model->LoadProfile(profile_path) == RET_OK) {
+    MS_LOG(INFO) << "load thread cost profile: " << profile_path;
+    if (model->launch_thread_num_ != thread_num) {
+      ret = model->CalibrateLaunch(context);
+      save_profile = true;
+    }
+  } else {
+    ret = model->Calibrate(context);
+    save_profile = !profile_path.empty();
+  }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "calibrate thread cost model failed.";
+    return ret;
+  }
+  auto new_models = std::make_shared<ThreadCostModels>(*models);
+  (*new_models)[thread_num] = model;
+  std::atomic_store(&thread_cost_models, std::shared_ptr<const ThreadCostModels>(new_models));
+  if (save_profile && model->SaveProfile(profile_path) != RET_OK) {
+    MS_LOG(WARNING) << "save thread cost profile failed: " << profile_path;
+  }
+  return RET_OK;
+}
+
 int UpdateThreadNum(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num, int64_t unit_num,
                     int thread_num) {
-  if (kernel_compute_cost_map_.count(kernel_type) > 0) {
+  auto models = std::atomic_load(&thread_cost_models);
+  // the kernels of the parallel branches run fewer threads than their session, whose model is the nearest
+  auto model_iter = models->lower_bound(thread_num);
+  const auto &model = model_iter != models->end() ? *model_iter->second : DefaultThreadCostModel();
+  auto iter = model.kernel_compute_cost_map_.find(kernel_type);
+  if (iter != model.kernel_compute_cost_map_.end()) {
     lite::ThreadCostContext thread_cost_context;
-    thread_cost_context.per_unit_compute_cost_ = kernel_compute_cost_map_.at(kernel_type);
+    thread_cost_context.per_unit_compute_cost_ = iter->second;
     thread_cost_context.per_unit_load_num_ = per_unit_load_num;
     thread_cost_context.per_unit_store_num_ = per_unit_store_num;
     thread_cost_context.total_unit_num_ = unit_num;
-    return ThreadNumUpdateStrategy(&thread_cost_context, thread_num);
+    return ThreadNumUpdateStrategy(model, &thread_cost_context, thread_num);
   }
   return thread_num;
 }
@@ -18,11 +18,16 @@
 #define MINDSPORE_LITE_SRC_RUNTIME_THREAD_COST_MODEL_H_
 
 #include <stdint.h>
+#include <map>
+#include <string>
 #include "nnacl/op_base.h"
 #include "include/api/context.h"
+#include "include/errorcode.h"
 #include "schema/ops_generated.h"
 
 namespace mindspore::lite {
+class InnerContext;
+
 typedef struct ThreadCostContext {
   int64_t total_unit_num_;
   int64_t per_unit_load_num_;
@@ -35,52 +40,77 @@ typedef struct ThreadCostContext {
 #define TC_TYPE(primitive_type, activation_type) (TC_PTYPE(primitive_type) + TC_ATYPE(activation_type))
 
 struct ThreadCostModel {
-  static float UnitCost(const ThreadCostContext *thread_cost_context) {
+  ThreadCostModel();
+
+  float UnitCost(const ThreadCostContext *thread_cost_context) const {
     return per_unit_load_cost_ * thread_cost_context->per_unit_load_num_ +
            per_unit_store_cost_ * thread_cost_context->per_unit_store_num_ +
            thread_cost_context->per_unit_compute_cost_ * per_unit_compute_num_;
   }
 
-  static float TotalCost(const ThreadCostContext *thread_cost_context) {
+  float TotalCost(const ThreadCostContext *thread_cost_context) const {
     return thread_cost_context->total_unit_num_ * UnitCost(thread_cost_context);
   }
 
   // ThreadNum assesses parallel thread num. Value of 1.0 means ideal parallel task size. Values < 1.0 mean that task
   // granularity needs to be increased to mitigate parallelization overheads.
-  static float ParallelDegree(const ThreadCostContext *thread_cost_context) {
+  float ParallelDegree(const ThreadCostContext *thread_cost_context) const {
     return TotalCost(thread_cost_context) / parallel_thread_cost_;
   }
 
-  static int ThreadNum(const ThreadCostContext *thread_cost_context) {
+  int ThreadNum(const ThreadCostContext *thread_cost_context) const {
     return MSMAX(1,
                  static_cast<int>((TotalCost(thread_cost_context) - thread_startup_cost_) / single_thread_cost_ + 0.9));
   }
 
-  static int64_t ThreadBlockSize(const ThreadCostContext *thread_cost_context) {
+  int64_t ThreadBlockSize(const ThreadCostContext *thread_cost_context) const {
     return static_cast<int64_t>(parallel_thread_cost_ / UnitCost(thread_cost_context));
   }
-  static int GetOptimalThreadNum(const ThreadCostContext *thread_cost_context, const int thread_num);
+  int GetOptimalThreadNum(const ThreadCostContext *thread_cost_context, const int thread_num) const;
+
+  // Calibrate micro-benchmarks the host and refits the costs below in nanoseconds, the compute costs of the
+  // element-wise kernels are measured and the others are scaled by the median ratio of measured to default.
+  // CalibrateLaunch refits only the thread costs by launching the thread num of the context.
+  // LoadProfile keeps the costs unchanged if the profile is invalid.
+  int Calibrate(const InnerContext *context);
+  int CalibrateLaunch(const InnerContext *context);
+  int LoadProfile(const std::string &path);
+  int SaveProfile(const std::string &path) const;
 
-  static float per_unit_load_cost_;      // per unit load cost
-  static float per_unit_store_cost_;     // per unit store cost
-  static int64_t per_unit_compute_num_;  // per unit compute num
+  std::map<int32_t, float> kernel_compute_cost_map_;  // per unit compute cost of each TC_TYPE
 
-  static float thread_startup_cost_;   // thread startup inherent cost
-  static float single_thread_cost_;    // Minimum cost of single-threaded
-  static float parallel_thread_cost_;  // Minimum cost of per thread in parallel-thread
+  float per_unit_load_cost_;      // per unit load cost
+  float per_unit_store_cost_;     // per unit store cost
+  int64_t per_unit_compute_num_;  // per unit compute num
+
+  float thread_startup_cost_;   // thread startup inherent cost
+  float single_thread_cost_;    // Minimum cost of single-threaded
+  float parallel_thread_cost_;  // Minimum cost of per thread in parallel-thread
+  int launch_thread_num_;       // thread num the thread costs are measured with, 0 for the default costs
 };
 
 float GetKernelComputeCost(int32_t kernel_type);
-int ThreadNumUpdateStrategy(const ThreadCostContext *thread_cost_context, int task_num);
+int ThreadNumUpdateStrategy(const ThreadCostModel &thread_cost_model, const ThreadCostContext *thread_cost_context,
+                            int task_num);
 
 #ifdef DYNAMIC_THREAD_DISTRIBUTE
 int UpdateThreadNum(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num, int64_t unit_num,
                     int thread_num);
+// Configured by the section "thread_cost_model" of the config file:
+//   calibrate: "true" to micro-benchmark the host, the model is calibrated once per process and thread num.
+//   profile_path: the profile to load, it is calibrated and saved there if the file can not be loaded or is measured
+//   with another thread num.
+int InitThreadCostModel(const InnerContext *context,
+                        const std::map<std::string, std::map<std::string, std::string>> *config_info);
 #else
 inline int UpdateThreadNum(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num, int64_t unit_num,
                            int thread_num) {
   return thread_num;
 }
+inline int InitThreadCostModel(const InnerContext *context,
+                               const std::map<std::string, std::map<std::string, std::string>> *config_info) {
+  return RET_OK;
+}
 #endif
 }  // namespace mindspore::lite
 
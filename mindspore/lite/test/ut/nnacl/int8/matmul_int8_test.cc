@@ -0,0 +1,326 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/errorcode.h"
+#include "nnacl/int8/fixed_point.h"
+#include "nnacl/int8/matmul_int8.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx512_int8.h"
+#endif
+#if defined(ENABLE_AVX) || defined(ENABLE_AVX512)
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+namespace mindspore {
+class MatMulInt8OptTest : public mindspore::CommonTest {
+ public:
+  MatMulInt8OptTest() {}
+};
+
+namespace {
+constexpr int kDataRandom = 0;
+constexpr int kDataMin = 1;
+constexpr int kDataMax = 2;
+constexpr int kDataAlternate = 3;
+
+struct MatMulInt8TestQuant {
+  std::vector<int32_t> multiplier;
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+  std::vector<int32_t> filter_zp;
+  int32_t out_zp = 0;
+};
+
+// row-major int8 data, with either random values or the extreme values of int8
+std::vector<int8_t> MakeInt8Data(int size, int mode, std::mt19937 *gen) {
+  std::uniform_int_distribution<int> dist(INT8_MIN, INT8_MAX);
+  std::vector<int8_t> data(size);
+  for (int i = 0; i < size; ++i) {
+    if (mode == kDataMin) {
+      data[i] = INT8_MIN;
+    } else if (mode == kDataMax) {
+      data[i] = INT8_MAX;
+    } else if (mode == kDataAlternate) {
+      data[i] = i % C2NUM == 0 ? INT8_MIN : INT8_MAX;
+    } else {
+      data[i] = static_cast<int8_t>(dist(*gen));
+    }
+  }
+  return data;
+}
+
+MatMulInt8TestQuant MakeQuant(int col, bool per_channel, std::mt19937 *gen) {
+  std::uniform_int_distribution<int32_t> multiplier_dist(1 << 30, INT32_MAX);
+  std::uniform_int_distribution<int32_t> shift_dist(-14, -8);
+  std::uniform_int_distribution<int32_t> zp_dist(INT8_MIN, INT8_MAX);
+  MatMulInt8TestQuant quant;
+  int num = per_channel ? col : 1;
+  for (int i = 0; i < num; ++i) {
+    quant.multiplier.push_back(multiplier_dist(*gen));
+    quant.left_shift.push_back(0);
+    quant.right_shift.push_back(shift_dist(*gen));
+    quant.filter_zp.push_back(zp_dist(*gen));
+  }
+  quant.out_zp = zp_dist(*gen);
+  return quant;
+}
+
+int32_t RowSum(const std::vector<int8_t> &a, int r, int deep) {
+  int32_t sum = 0;
+  for (int d = 0; d < deep; ++d) {
+    sum += a[r * deep + d];
+  }
+  return sum;
+}
+
+// the scalar loop of MatmulInt8Opt: row4x16-major * row16x4-major => (int8)row-major
+void MatmulInt8OptRef(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                      const int32_t *a_sums, const int32_t *bias, int mini, int maxi, int out_zp,
+                      const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift, size_t stride,
+                      size_t filter_peroc, const int32_t *filter_zp) {
+  for (int r = 0; r < row; r++) {
+    for (int c = 0; c < col; c++) {
+      int r4div = r / C4NUM, r4mod = r % C4NUM;
+      int c4div = c / C4NUM, c4mod = c % C4NUM;
+      int32_t value = 0;
+      for (int d = 0; d < deep16; d++) {
+        int d16div = d / C16NUM, d16mod = d % C16NUM;
+        int64_t ai = r4div * deep16 * C4NUM + d16div * C4NUM * C16NUM + r4mod * C16NUM + d16mod;
+        int64_t bi = c4div * deep16 * C4NUM + d16div * C4NUM * C16NUM + c4mod * C16NUM + d16mod;
+        value = value + a[ai] * b[bi];
+      }
+      value -= filter_peroc ? a_sums[r] * filter_zp[c] : a_sums[r];
+      value += bias[c];
+      size_t quant_index = filter_peroc ? c : 0;
+      value = MultiplyByQuantizedMultiplier(value, multiplier[quant_index], left_shift[quant_index],
+                                            right_shift[quant_index]) +
+              out_zp;
+      value = MSMIN(maxi, value);
+      value = MSMAX(mini, value);
+      dst[r * stride + c] = (int8_t)value;
+    }
+  }
+}
+
+// the scalar loop of MatMulInt8_8x8_r: row8x4-major * row4x8-major => (int8)row-major
+void MatMulInt8_8x8_rRef(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                         size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                         const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                         int32_t maxi, size_t per_channel) {
+  for (size_t r = 0; r < row; r++) {
+    for (size_t c = 0; c < col; c++) {
+      size_t r8div = r / C8NUM, r8mod = r % C8NUM;
+      size_t c8div = c / C8NUM, c8mod = c % C8NUM;
+      int32_t value = 0;
+      for (size_t d = 0; d < deep_4; d++) {
+        size_t d4div = d / C4NUM, d4mod = d % C4NUM;
+        size_t ai = r8div * deep_4 * C8NUM + d4div * C8NUM * C4NUM + r8mod * C4NUM + d4mod;
+        size_t bi = c8div * deep_4 * C8NUM + d4div * C8NUM * C4NUM + c8mod * C4NUM + d4mod;
+        value = value + a[ai] * b[bi];
+      }
+      value -= per_channel ? input_sum[c8div * UP_ROUND(row, C8NUM) * C8NUM + r * C8NUM + c8mod] : input_sum[r];
+      value += bias[c];
+      size_t quant_index = per_channel ? c : 0;
+      value = MultiplyByQuantizedMultiplier(value, multiplier[quant_index], left_shift[quant_index],
+                                            right_shift[quant_index]) +
+              output_zp;
+      value = MSMIN(maxi, value);
+      value = MSMAX(mini, value);
+      dst[r * stride + c] = (int8_t)value;
+    }
+  }
+}
+
+void RunMatmulInt8Opt(int row, int col, int deep, bool per_channel, int mode, std::mt19937 *gen) {
+  int row4 = UP_ROUND(row, C4NUM);
+  int col4 = UP_ROUND(col, C4NUM);
+  int deep16 = UP_ROUND(deep, C16NUM);
+  auto a = MakeInt8Data(row * deep, mode, gen);
+  auto b = MakeInt8Data(col * deep, mode, gen);
+  std::vector<int8_t> pack_a(row4 * deep16, 0);
+  std::vector<int8_t> pack_b(col4 * deep16, 0);
+  RowMajor2Row16x4MajorInt8(a.data(), pack_a.data(), row, deep);
+  RowMajor2Row16x4MajorInt8(b.data(), pack_b.data(), col, deep);
+
+  auto quant = MakeQuant(col, per_channel, gen);
+  std::vector<int32_t> a_sums(row4, 0);
+  for (int r = 0; r < row; ++r) {
+    a_sums[r] = per_channel ? RowSum(a, r, deep) : RowSum(a, r, deep) * quant.filter_zp[0];
+  }
+  std::vector<int32_t> bias(col4, 0);
+  for (int c = 0; c < col; ++c) {
+    bias[c] = static_cast<int32_t>((*gen)() % 20001) - 10000;
+  }
+  // the output is written with a stride wider than col
+  size_t stride = col + 3;
+  std::vector<int8_t> dst(row * stride, 0);
+  std::vector<int8_t> expect(row * stride, 0);
+  MatmulInt8Opt(pack_a.data(), pack_b.data(), dst.data(), row, col, deep16, a_sums.data(), bias.data(), INT8_MIN,
+                INT8_MAX, quant.out_zp, quant.multiplier.data(), quant.left_shift.data(), quant.right_shift.data(),
+                stride, per_channel, quant.filter_zp.data());
+  MatmulInt8OptRef(pack_a.data(), pack_b.data(), expect.data(), row, col, deep16, a_sums.data(), bias.data(), INT8_MIN,
+                   INT8_MAX, quant.out_zp, quant.multiplier.data(), quant.left_shift.data(), quant.right_shift.data(),
+                   stride, per_channel, quant.filter_zp.data());
+  ASSERT_EQ(dst, expect) << "row: " << row << ", col: " << col << ", deep: " << deep;
+}
+
+void RunMatMulInt8_8x8_r(int row, int col, int deep, bool per_channel, int mode, std::mt19937 *gen) {
+  int row8 = UP_ROUND(row, C8NUM);
+  int col8 = UP_ROUND(col, C8NUM);
+  int deep4 = UP_ROUND(deep, C4NUM);
+  auto a = MakeInt8Data(row * deep, mode, gen);
+  auto b = MakeInt8Data(col * deep, mode, gen);
+  std::vector<int8_t> pack_a(row8 * deep4, 0);
+  std::vector<int8_t> pack_b(col8 * deep4, 0);
+  RowMajor2Row8x4MajorInt8(a.data(), pack_a.data(), row, deep);
+  RowMajor2Row8x4MajorInt8(b.data(), pack_b.data(), col, deep);
+
+  auto quant = MakeQuant(col, per_channel, gen);
+  // per channel, the input sums are laid out as [col8 / 8][row8][8]
+  std::vector<int32_t> input_sum(per_channel ? col8 * row8 : row8, 0);
+  for (int r = 0; r < row; ++r) {
+    int32_t sum = RowSum(a, r, deep);
+    if (!per_channel) {
+      input_sum[r] = sum * quant.filter_zp[0];
+      continue;
+    }
+    for (int c = 0; c < col; ++c) {
+      input_sum[c / C8NUM * row8 * C8NUM + r * C8NUM + c % C8NUM] = sum * quant.filter_zp[c];
+    }
+  }
+  std::vector<int32_t> bias(col8, 0);
+  for (int c = 0; c < col; ++c) {
+    bias[c] = static_cast<int32_t>((*gen)() % 20001) - 10000;
+  }
+  size_t stride = col + 5;
+  std::vector<int8_t> dst(row * stride, 0);
+  std::vector<int8_t> expect(row * stride, 0);
+  MatMulInt8_8x8_r(pack_a.data(), pack_b.data(), dst.data(), row, col, deep4, stride, input_sum.data(), bias.data(),
+                   quant.left_shift.data(), quant.right_shift.data(), quant.multiplier.data(), quant.out_zp, INT8_MIN,
+                   INT8_MAX, per_channel);
+  MatMulInt8_8x8_rRef(pack_a.data(), pack_b.data(), expect.data(), row, col, deep4, stride, input_sum.data(),
+                      bias.data(), quant.left_shift.data(), quant.right_shift.data(), quant.multiplier.data(),
+                      quant.out_zp, INT8_MIN, INT8_MAX, per_channel);
+  ASSERT_EQ(dst, expect) << "row: " << row << ", col: " << col << ", deep: " << deep;
+}
+
+#if defined(ENABLE_AVX) || defined(ENABLE_AVX512)
+using MatMulInt8TestBlockFunc = void (*)(const int8_t *a, const int8_t *b, size_t deep, int32_t *dst);
+
+// compare one int32 block with the sum of products: tile x tile of a row-tile-major layout whose deep block is unit
+void CheckInt8Block(MatMulInt8TestBlockFunc block_func, int tile, int unit, int deep, int mode, std::mt19937 *gen) {
+  auto a = MakeInt8Data(tile * deep, mode, gen);
+  auto b = MakeInt8Data(tile * deep, mode == kDataAlternate ? kDataMax : mode, gen);
+  std::vector<int32_t> dst(tile * tile, 0);
+  block_func(a.data(), b.data(), deep, dst.data());
+  for (int r = 0; r < tile; ++r) {
+    for (int c = 0; c < tile; ++c) {
+      int32_t expect = 0;
+      for (int d = 0; d < deep; ++d) {
+        int offset = d / unit * tile * unit + d % unit;
+        expect += a[offset + r * unit] * b[offset + c * unit];
+      }
+      ASSERT_EQ(dst[r * tile + c], expect) << "deep: " << deep << ", row: " << r << ", col: " << c;
+    }
+  }
+}
+#endif
+}  // namespace
+
+/// Feature: the int8 matmul of MatmulInt8Opt.
+/// Description: odd rows, columns and depths, per-tensor and per-channel quantization, random and extreme int8 data.
+/// Expectation: the output is the same as the scalar loop.
+TEST_F(MatMulInt8OptTest, MatmulInt8OptSameAsScalar) {
+#if defined(ENABLE_AVX) || defined(ENABLE_AVX512)
+  // the vnni blocks are taken only if they are supported
+  (void)IntelX86CpuInfoInit();
+#endif
+  std::mt19937 gen(1);
+  for (int mode : {kDataRandom, kDataMin, kDataMax, kDataAlternate}) {
+    for (bool per_channel : {false, true}) {
+      for (int row : {1, 3, 5, 13}) {
+        for (int col : {1, 7, 9, 33}) {
+          for (int deep : {1, 15, 17, 100}) {
+            RunMatmulInt8Opt(row, col, deep, per_channel, mode, &gen);
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Feature: the int8 matmul of MatMulInt8_8x8_r.
+/// Description: odd rows, columns and depths, per-tensor and per-channel quantization, random and extreme int8 data.
+/// Expectation: the output is the same as the scalar loop.
+TEST_F(MatMulInt8OptTest, MatMulInt8_8x8_rSameAsScalar) {
+#if defined(ENABLE_AVX) || defined(ENABLE_AVX512)
+  // the vnni blocks are taken only if they are supported
+  (void)IntelX86CpuInfoInit();
+#endif
+  std::mt19937 gen(2);
+  for (int mode : {kDataRandom, kDataMin, kDataMax, kDataAlternate}) {
+    for (bool per_channel : {false, true}) {
+      for (int row : {1, 7, 9, 19}) {
+        for (int col : {1, 5, 11, 17}) {
+          for (int deep : {1, 3, 5, 99}) {
+            RunMatMulInt8_8x8_r(row, col, deep, per_channel, mode, &gen);
+          }
+        }
+      }
+    }
+  }
+}
+
+#ifdef ENABLE_AVX
+/// Feature: the avx2 blocks of the x86 int8 matmul.
+/// Description: compute the 4x4 and 8x8 int32 blocks with random and extreme int8 data.
+/// Expectation: the blocks are the exact sums of products.
+TEST_F(MatMulInt8OptTest, Avx2Blocks) {
+  std::mt19937 gen(3);
+  for (int mode : {kDataRandom, kDataMin, kDataMax, kDataAlternate}) {
+    for (int deep : {C16NUM, C3NUM * C16NUM, C64NUM * C16NUM}) {
+      CheckInt8Block(MatMulInt8Block4x4_AVX2, C4NUM, C16NUM, deep, mode, &gen);
+    }
+    for (int deep : {C4NUM, C3NUM * C4NUM, C256NUM * C4NUM}) {
+      CheckInt8Block(MatMulInt8Block8x8_AVX2, C8NUM, C4NUM, deep, mode, &gen);
+    }
+  }
+}
+#endif
+
+#ifdef ENABLE_AVX512
+/// Feature: the avx512-vnni blocks of the x86 int8 matmul.
+/// Description: compute the 4x4 and 8x8 int32 blocks with random and extreme int8 data, the input offset by 128 must
+/// be compensated exactly.
+/// Expectation: the blocks are the exact sums of products.
+TEST_F(MatMulInt8OptTest, Avx512VnniBlocks) {
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512Vnni_Support()) {
+    return;
+  }
+  std::mt19937 gen(4);
+  for (int mode : {kDataRandom, kDataMin, kDataMax, kDataAlternate}) {
+    for (int deep : {C16NUM, C3NUM * C16NUM, C64NUM * C16NUM}) {
+      CheckInt8Block(MatMulInt8Block4x4Avx512Vnni, C4NUM, C16NUM, deep, mode, &gen);
+    }
+    for (int deep : {C4NUM, C3NUM * C4NUM, C256NUM * C4NUM}) {
+      CheckInt8Block(MatMulInt8Block8x8Avx512Vnni, C8NUM, C4NUM, deep, mode, &gen);
+    }
+  }
+}
+#endif
+}  // namespace mindspore
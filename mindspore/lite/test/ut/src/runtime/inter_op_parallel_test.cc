@@ -0,0 +1,170 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include "common/common_test.h"
+#include "schema/inner/model_generated.h"
+#include "src/litert/lite_session.h"
+#include "src/litert/sub_graph_kernel.h"
+#include "ir/dtype/type_id.h"
+
+namespace mindspore {
+namespace {
+constexpr int kBatch = 32;
+constexpr int kChannel = 256;
+constexpr int kThreadNum = 4;
+constexpr int kInterOpParallelNum = 2;
+}  // namespace
+
+class InterOpParallelTest : public mindspore::CommonTest {
+ public:
+  InterOpParallelTest() = default;
+};
+
+// Two branches read the same input: a MatMul of kBatch x kChannel x kChannel and an Abs of kBatch x kChannel.
+lite::Model *BuildTwoBranchModel() {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  meta_graph->version = Version();
+
+  auto matmul = std::make_unique<schema::CNodeT>();
+  matmul->inputIndex = {0, 1};
+  matmul->outputIndex = {2};
+  matmul->primitive = std::make_unique<schema::PrimitiveT>();
+  matmul->primitive->value.type = schema::PrimitiveType_MatMulFusion;
+  auto matmul_primitive = new schema::MatMulFusionT;
+  matmul_primitive->transpose_b = true;
+  matmul->primitive->value.value = matmul_primitive;
+  matmul->name = "matmul";
+
+  auto abs = std::make_unique<schema::CNodeT>();
+  abs->inputIndex = {0};
+  abs->outputIndex = {3};
+  abs->primitive = std::make_unique<schema::PrimitiveT>();
+  abs->primitive->value.type = schema::PrimitiveType_Abs;
+  abs->primitive->value.value = new schema::AbsT;
+  abs->name = "abs";
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = lite::NodeType_Parameter;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {kBatch, kChannel};
+  input->offset = -1;
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = lite::NodeType_ValueNode;
+  weight->format = schema::Format_NHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {kChannel, kChannel};
+  weight->data.resize(kChannel * kChannel * sizeof(float), 0);
+  weight->offset = -1;
+  auto matmul_output = std::make_unique<schema::TensorT>();
+  matmul_output->nodeType = lite::NodeType_Parameter;
+  matmul_output->format = schema::Format_NHWC;
+  matmul_output->dataType = TypeId::kNumberTypeFloat32;
+  matmul_output->dims = {kBatch, kChannel};
+  matmul_output->offset = -1;
+  auto abs_output = std::make_unique<schema::TensorT>();
+  abs_output->nodeType = lite::NodeType_Parameter;
+  abs_output->format = schema::Format_NHWC;
+  abs_output->dataType = TypeId::kNumberTypeFloat32;
+  abs_output->dims = {kBatch, kChannel};
+  abs_output->offset = -1;
+
+  meta_graph->nodes.emplace_back(std::move(matmul));
+  meta_graph->nodes.emplace_back(std::move(abs));
+  meta_graph->allTensors.emplace_back(std::move(input));
+  meta_graph->allTensors.emplace_back(std::move(weight));
+  meta_graph->allTensors.emplace_back(std::move(matmul_output));
+  meta_graph->allTensors.emplace_back(std::move(abs_output));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2, 3};
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  schema::FinishMetaGraphBuffer(builder, offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+  return lite::Model::Import(content, size);
+}
+
+std::unique_ptr<lite::LiteSession> CreateInterOpParallelSession() {
+  auto context = new lite::InnerContext();
+  context->thread_num_ = kThreadNum;
+  context->inter_op_parallel_num_ = kInterOpParallelNum;
+  auto session = std::make_unique<lite::LiteSession>();
+  if (session->Init(context) != lite::RET_OK) {
+    return nullptr;
+  }
+  return session;
+}
+
+std::map<std::string, int> GetNodeThreadNum(const lite::LiteSession &session) {
+  std::map<std::string, int> node_thread_num;
+  for (auto kernel : session.get_kernels()) {
+    auto sub_graph = reinterpret_cast<kernel::SubGraphKernel *>(kernel);
+    for (auto node : sub_graph->nodes()) {
+      node_thread_num[node->name()] = node->op_parameter()->thread_num_;
+    }
+  }
+  return node_thread_num;
+}
+
+/// Feature: split the threads among the branches which run at the same time.
+/// Description: compile a graph of a heavy MatMul branch and a light Abs branch with 2 inter-op parallel branches.
+/// Expectation: each branch is a subgraph, the Abs runs on one thread and the MatMul takes the others.
+TEST_F(InterOpParallelTest, InitOperatorThreadNum) {
+  std::unique_ptr<lite::Model> model(BuildTwoBranchModel());
+  ASSERT_NE(model, nullptr);
+  auto session = CreateInterOpParallelSession();
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(session->CompileGraph(model.get()), lite::RET_OK);
+
+  EXPECT_EQ(session->get_kernels().size(), kInterOpParallelNum);
+  auto node_thread_num = GetNodeThreadNum(*session);
+  ASSERT_EQ(node_thread_num.count("matmul"), 1);
+  ASSERT_EQ(node_thread_num.count("abs"), 1);
+  EXPECT_EQ(node_thread_num["matmul"], kThreadNum - 1);
+  EXPECT_EQ(node_thread_num["abs"], 1);
+  EXPECT_LE(node_thread_num["matmul"] + node_thread_num["abs"], kThreadNum);
+}
+
+/// Feature: measure the overlap of the branches run by the inter-op parallel executor.
+/// Description: run the graph of two branches with 2 inter-op parallel branches.
+/// Expectation: the branch overlap is unset before running and measured after running.
+TEST_F(InterOpParallelTest, UpdateBranchOverlap) {
+  std::unique_ptr<lite::Model> model(BuildTwoBranchModel());
+  ASSERT_NE(model, nullptr);
+  auto session = CreateInterOpParallelSession();
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(session->CompileGraph(model.get()), lite::RET_OK);
+  EXPECT_EQ(session->GetBranchOverlap(), 0.0f);
+
+  for (auto input : session->GetInputs()) {
+    auto data = reinterpret_cast<float *>(input->MutableData());
+    ASSERT_NE(data, nullptr);
+    for (int i = 0; i < input->ElementsNum(); i++) {
+      data[i] = static_cast<float>(i % kChannel) - kChannel / 2;
+    }
+  }
+  ASSERT_EQ(session->RunGraph(), lite::RET_OK);
+  EXPECT_GT(session->GetBranchOverlap(), 0.0f);
+  EXPECT_LE(session->GetBranchOverlap(), static_cast<float>(kInterOpParallelNum));
+}
+}  // namespace mindspore
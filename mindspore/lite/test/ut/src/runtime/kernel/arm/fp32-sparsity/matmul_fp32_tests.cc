@@ -190,7 +190,7 @@ TEST_F(TestSPMMFp32Accuracy, DenseMatmul) {
   ASSERT_EQ(lite::RET_OK, ctx.Init());
 
   auto *matmul = new kernel::MatmulCPUKernel(reinterpret_cast<OpParameter *>(mvm_parameter), inputs, outputs, &ctx);
-  ASSERT_EQ(lite::RET_OK, matmul->Init());
+  ASSERT_EQ(lite::RET_OK, matmul->Prepare());
 
   ret = inputs.front()->MallocData();
   ASSERT_EQ(ret, lite::RET_OK);
@@ -227,7 +227,7 @@ TEST_F(TestSPMMFp32Accuracy, SparsityMatmul) {
 
   auto *matmul =
     new kernel::MatmulSparseCPUKernel(reinterpret_cast<OpParameter *>(mvm_parameter), inputs, outputs, &ctx);
-  ASSERT_EQ(lite::RET_OK, matmul->Init());
+  ASSERT_EQ(lite::RET_OK, matmul->Prepare());
 
   ret = inputs.front()->MallocData();
   ASSERT_EQ(ret, lite::RET_OK);
@@ -310,7 +310,7 @@ class TestSPMMFp32Performance : public TestSPMMFp32 {
 
     auto *matmul =
       new kernel::MatmulSparseCPUKernel(reinterpret_cast<OpParameter *>(mvm_parameter), inputs, outputs, &ctx);
-    if (lite::RET_OK != matmul->Init()) {
+    if (lite::RET_OK != matmul->Prepare()) {
       return false;
     }
 
@@ -376,7 +376,7 @@ TEST_F(TestSPMMFp32Performance, DenseMatmul) {
   ASSERT_EQ(lite::RET_OK, ctx.Init());
 
   auto *matmul = new kernel::MatmulCPUKernel(reinterpret_cast<OpParameter *>(mvm_parameter), inputs, outputs, &ctx);
-  ASSERT_EQ(lite::RET_OK, matmul->Init());
+  ASSERT_EQ(lite::RET_OK, matmul->Prepare());
 
   ret = inputs.front()->MallocData();
   ASSERT_EQ(ret, lite::RET_OK);
@@ -0,0 +1,213 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "src/common/utils.h"
+#include "nnacl/matmul_parameter.h"
+#include "src/litert/inner_context.h"
+#include "src/litert/kernel/cpu/fp32/matmul_fp32.h"
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_sparse_fp32.h"
+
+namespace mindspore {
+using mindspore::lite::Tensor;
+
+class TestSparseMatmulX86Fp32 : public mindspore::CommonTest {
+ public:
+  TestSparseMatmulX86Fp32() = default;
+
+  void SetUp() override {
+    ctx_ = std::make_shared<lite::InnerContext>();
+    ctx_->thread_num_ = kThreadNum;
+    ASSERT_EQ(lite::RET_OK, ctx_->Init());
+  }
+
+  void TearDown() override {
+    for (auto tensor : tensors_) {
+      delete tensor;
+    }
+    tensors_.clear();
+  }
+
+  Tensor *CreateTensor(const std::vector<int> &shape, const std::vector<float> &data, bool is_const) {
+    auto tensor = new Tensor(kNumberTypeFloat32, shape, mindspore::NHWC,
+                             is_const ? lite::Category::CONST_TENSOR : lite::Category::VAR);
+    tensors_.push_back(tensor);
+    if (is_const) {
+      tensor->MallocData();
+      memcpy(tensor->MutableData(), data.data(), data.size() * sizeof(float));
+    }
+    return tensor;
+  }
+
+  // w[deep, col] with the given ratio of zeros, which are dropped by 1x16 blocks along the columns if by_block
+  std::vector<float> SparseWeight(int deep, int col, float sparsity, bool by_block) {
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> keep(0.0f, 1.0f);
+    std::vector<float> weight(deep * col, 0.0f);
+    for (int d = 0; d < deep; ++d) {
+      bool keep_block = true;
+      for (int c = 0; c < col; ++c) {
+        if (c % C16NUM == 0) {
+          keep_block = keep(generator_) >= sparsity;
+        }
+        if (by_block ? keep_block : keep(generator_) >= sparsity) {
+          weight[d * col + c] = value(generator_);
+        }
+      }
+    }
+    return weight;
+  }
+
+  std::vector<float> RandomData(size_t size) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = distribution(generator_);
+    }
+    return data;
+  }
+
+  static MatMulParameter *CreateParameter(bool b_transpose, ActType act_type) {
+    auto param = reinterpret_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+    memset(param, 0, sizeof(MatMulParameter));
+    param->op_parameter_.type_ = schema::PrimitiveType_MatMulFusion;
+    param->op_parameter_.thread_num_ = kThreadNum;
+    param->b_transpose_ = b_transpose;
+    param->has_bias_ = true;
+    param->act_type_ = act_type;
+    return param;
+  }
+
+  // run the dense and the sparse kernel on the same inputs and return the sparse output and the dense output
+  void RunBoth(const std::vector<int> &input_shape, const std::vector<float> &weight, int col, bool b_transpose,
+               ActType act_type, std::vector<float> *sparse_output, std::vector<float> *dense_output) {
+    int deep = input_shape.back();
+    std::vector<float> weight_data(weight);
+    if (b_transpose) {
+      for (int d = 0; d < deep; ++d) {
+        for (int c = 0; c < col; ++c) {
+          weight_data[c * deep + d] = weight[d * col + c];
+        }
+      }
+    }
+    auto weight_shape = b_transpose ? std::vector<int>{col, deep} : std::vector<int>{deep, col};
+    auto output_shape = input_shape;
+    output_shape.back() = col;
+    auto input = CreateTensor(input_shape, {}, false);
+    std::vector<Tensor *> inputs = {input, CreateTensor(weight_shape, weight_data, true),
+                                    CreateTensor({col}, RandomData(col), true)};
+    auto input_data = RandomData(input->ElementsNum());
+    for (auto output : {sparse_output, dense_output}) {
+      auto output_tensor = CreateTensor(output_shape, {}, false);
+      auto param = reinterpret_cast<OpParameter *>(CreateParameter(b_transpose, act_type));
+      kernel::LiteKernel *kernel = nullptr;
+      if (output == sparse_output) {
+        kernel = new kernel::MatmulSparseCPUKernel(param, inputs, {output_tensor}, ctx_.get());
+      } else {
+        kernel = new kernel::MatmulCPUKernel(param, inputs, {output_tensor}, ctx_.get());
+      }
+      ASSERT_EQ(kernel->Prepare(), lite::RET_OK);
+      input->MallocData();
+      memcpy(input->MutableData(), input_data.data(), input_data.size() * sizeof(float));
+      output_tensor->MallocData();
+      ASSERT_EQ(kernel->Run(), lite::RET_OK);
+      auto output_data = reinterpret_cast<float *>(output_tensor->data());
+      output->assign(output_data, output_data + output_tensor->ElementsNum());
+      input->FreeData();
+      delete kernel;
+    }
+  }
+
+ protected:
+  static constexpr int kThreadNum = 2;
+  std::shared_ptr<lite::InnerContext> ctx_;
+  std::vector<Tensor *> tensors_;
+  std::mt19937 generator_{1};
+};
+
+TEST_F(TestSparseMatmulX86Fp32, CsrAccuracy) {
+  int deep = 75, col = 37;
+  auto weight = SparseWeight(deep, col, 0.9f, false);
+  std::vector<float> sparse_output;
+  std::vector<float> dense_output;
+  RunBoth({2, 21, deep}, weight, col, false, ActType_No, &sparse_output, &dense_output);
+  ASSERT_EQ(0, CompareOutputData(sparse_output.data(), dense_output.data(), dense_output.size(), 1e-4));
+  RunBoth({70, deep}, weight, col, true, ActType_Relu6, &sparse_output, &dense_output);
+  ASSERT_EQ(0, CompareOutputData(sparse_output.data(), dense_output.data(), dense_output.size(), 1e-4));
+  auto inputs = std::vector<Tensor *>{CreateTensor({1, deep}, {}, false), CreateTensor({deep, col}, weight, true)};
+  auto param = CreateParameter(false, ActType_No);
+  ASSERT_TRUE(kernel::MatmulSparseCPUKernel::CheckSparseWeight(inputs, reinterpret_cast<OpParameter *>(param)));
+  free(param);
+}
+
+TEST_F(TestSparseMatmulX86Fp32, BlockAccuracy) {
+  int deep = 64, col = 56;
+  auto weight = SparseWeight(deep, col, 0.7f, true);
+  std::vector<float> sparse_output;
+  std::vector<float> dense_output;
+  RunBoth({13, deep}, weight, col, false, ActType_Relu, &sparse_output, &dense_output);
+  ASSERT_EQ(0, CompareOutputData(sparse_output.data(), dense_output.data(), dense_output.size(), 1e-4));
+  RunBoth({3, 3, deep}, weight, col, true, ActType_No, &sparse_output, &dense_output);
+  ASSERT_EQ(0, CompareOutputData(sparse_output.data(), dense_output.data(), dense_output.size(), 1e-4));
+}
+
+TEST_F(TestSparseMatmulX86Fp32, CompareWithDense) {
+  // a fully connected layer of a ranking model
+  int row = 64, deep = 1024, col = 1024;
+  for (bool by_block : {false, true}) {
+    for (float sparsity : {0.5f, 0.7f, 0.8f, 0.9f, 0.95f}) {
+      auto weight = SparseWeight(deep, col, sparsity, by_block);
+      auto input = CreateTensor({row, deep}, {}, false);
+      std::vector<Tensor *> inputs = {input, CreateTensor({deep, col}, weight, true),
+                                      CreateTensor({col}, RandomData(col), true)};
+      auto output_tensor = CreateTensor({row, col}, {}, false);
+      std::vector<float> costs;
+      for (bool sparse : {false, true}) {
+        auto param = reinterpret_cast<OpParameter *>(CreateParameter(false, ActType_No));
+        kernel::LiteKernel *kernel = nullptr;
+        if (sparse) {
+          kernel = new kernel::MatmulSparseCPUKernel(param, inputs, {output_tensor}, ctx_.get());
+        } else {
+          kernel = new kernel::MatmulCPUKernel(param, inputs, {output_tensor}, ctx_.get());
+        }
+        ASSERT_EQ(kernel->Prepare(), lite::RET_OK);
+        input->MallocData();
+        output_tensor->MallocData();
+        ASSERT_EQ(kernel->Run(), lite::RET_OK);
+        constexpr int kLoopCount = 20;
+        auto start_time = lite::GetTimeUs();
+        for (int i = 0; i < kLoopCount; ++i) {
+          ASSERT_EQ(kernel->Run(), lite::RET_OK);
+        }
+        costs.push_back(static_cast<float>(lite::GetTimeUs() - start_time) / kLoopCount);
+        input->FreeData();
+        delete kernel;
+      }
+      auto param = CreateParameter(false, ActType_No);
+      std::cout << (by_block ? "1x16 block" : "random") << " sparsity: " << sparsity << ", dense: " << costs[0]
+                << "us, sparse: " << costs[1] << "us, use sparse kernel: "
+                << kernel::MatmulSparseCPUKernel::CheckSparseWeight(inputs, reinterpret_cast<OpParameter *>(param))
+                << std::endl;
+      free(param);
+    }
+  }
+}
+}  // namespace mindspore
+#endif
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "src/common/utils.h"
+#include "schema/model_generated.h"
+#include "nnacl/attention_parameter.h"
+#include "src/litert/inner_context.h"
+#include "src/litert/kernel/cpu/fp32/attention_fp32.h"
+
+namespace mindspore {
+using mindspore::lite::Tensor;
+
+class TestAttentionFp32 : public mindspore::CommonTest {
+ public:
+  TestAttentionFp32() = default;
+
+  void SetUp() override {
+    ctx_ = std::make_shared<lite::InnerContext>();
+    ctx_->thread_num_ = kThreadNum;
+    ASSERT_EQ(lite::RET_OK, ctx_->Init());
+  }
+
+  void TearDown() override {
+    for (auto tensor : tensors_) {
+      delete tensor;
+    }
+    tensors_.clear();
+  }
+
+  Tensor *CreateTensor(const std::vector<int> &shape, const std::vector<float> &data, bool is_const) {
+    auto tensor = new Tensor(kNumberTypeFloat32, shape, mindspore::NHWC,
+                             is_const ? lite::Category::CONST_TENSOR : lite::Category::VAR);
+    tensor->MallocData();
+    if (!data.empty()) {
+      memcpy(tensor->MutableData(), data.data(), data.size() * sizeof(float));
+    }
+    tensors_.push_back(tensor);
+    return tensor;
+  }
+
+  std::vector<float> RandomData(size_t size, float scale = 1.0f) {
+    std::uniform_real_distribution<float> distribution(-scale, scale);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = distribution(generator_);
+    }
+    return data;
+  }
+
+  // y = x * w^T + b
+  static std::vector<float> Dense(const std::vector<float> &x, const float *w, const float *b, int row, int col,
+                                  int deep) {
+    std::vector<float> y(row * col);
+    for (int i = 0; i < row; ++i) {
+      for (int c = 0; c < col; ++c) {
+        float sum = b[c];
+        for (int d = 0; d < deep; ++d) {
+          sum += x[i * deep + d] * w[c * deep + d];
+        }
+        y[i * col + c] = sum;
+      }
+    }
+    return y;
+  }
+
+  // unfused attention: projections, softmax(q * k^T / sqrt(head_size) + (1 - mask) * -10000) * v, output projection
+  static std::vector<float> Reference(const std::vector<float> &x_q, const std::vector<float> &x_kv,
+                                      const std::vector<float> &w_q, const std::vector<float> &w_kv,
+                                      const std::vector<float> &w_o, const std::vector<float> &b_qkv,
+                                      const std::vector<float> &b_o, const std::vector<float> &mask, int batch,
+                                      int q_seq, int kv_seq, int head_num, int d_model) {
+    int head_size = d_model / head_num;
+    auto q = Dense(x_q, w_q.data(), b_qkv.data(), batch * q_seq, d_model, d_model);
+    auto kv = Dense(x_kv, w_kv.data(), b_qkv.data() + d_model, batch * kv_seq, 2 * d_model, d_model);
+    std::vector<float> context(batch * q_seq * d_model);
+    std::vector<float> logits(kv_seq);
+    for (int b = 0; b < batch; ++b) {
+      for (int h = 0; h < head_num; ++h) {
+        for (int i = 0; i < q_seq; ++i) {
+          const float *cur_q = q.data() + (b * q_seq + i) * d_model + h * head_size;
+          float max_logit = -1e30f;
+          for (int j = 0; j < kv_seq; ++j) {
+            const float *cur_k = kv.data() + (b * kv_seq + j) * 2 * d_model + h * head_size;
+            float logit = 0.0f;
+            for (int d = 0; d < head_size; ++d) {
+              logit += cur_q[d] * cur_k[d];
+            }
+            logit /= std::sqrt(static_cast<float>(head_size));
+            if (!mask.empty()) {
+              logit += (1.0f - mask[(b * q_seq + i) * kv_seq + j]) * -10000.0f;
+            }
+            logits[j] = logit;
+            max_logit = std::max(max_logit, logit);
+          }
+          float sum = 0.0f;
+          for (auto &logit : logits) {
+            logit = std::exp(logit - max_logit);
+            sum += logit;
+          }
+          for (int d = 0; d < head_size; ++d) {
+            float value = 0.0f;
+            for (int j = 0; j < kv_seq; ++j) {
+              value += logits[j] * kv[(b * kv_seq + j) * 2 * d_model + d_model + h * head_size + d];
+            }
+            context[(b * q_seq + i) * d_model + h * head_size + d] = value / sum;
+          }
+        }
+      }
+    }
+    return Dense(context, w_o.data(), b_o.data(), batch * q_seq, d_model, d_model);
+  }
+
+  kernel::AttentionCPUKernel *CreateKernel(const std::vector<Tensor *> &inputs, Tensor *output, int head_num) {
+    auto param = reinterpret_cast<AttentionParameter *>(malloc(sizeof(AttentionParameter)));
+    memset(param, 0, sizeof(AttentionParameter));
+    param->op_parameter_.type_ = schema::PrimitiveType_Attention;
+    param->head_num_ = head_num;
+    return new kernel::AttentionCPUKernel(reinterpret_cast<OpParameter *>(param), inputs, {output}, ctx_.get());
+  }
+
+ protected:
+  static constexpr int kThreadNum = 2;
+  std::shared_ptr<lite::InnerContext> ctx_;
+  std::vector<Tensor *> tensors_;
+  std::mt19937 generator_{1};
+};
+
+TEST_F(TestAttentionFp32, SelfAttentionWithMask) {
+  int batch = 2, seq = 37, head_num = 4, d_model = 32;
+  auto x = RandomData(batch * seq * d_model);
+  auto w_q = RandomData(d_model * d_model, 0.2f);
+  auto w_kv = RandomData(2 * d_model * d_model, 0.2f);
+  auto w_o = RandomData(d_model * d_model, 0.2f);
+  auto b_qkv = RandomData(3 * d_model);
+  auto b_o = RandomData(d_model);
+  std::vector<float> mask(batch * seq * seq, 1.0f);
+  for (int i = 0; i < seq; ++i) {
+    mask[(seq + i) * seq + seq - 1] = 0.0f;
+  }
+  std::vector<float> w_qkv(w_q);
+  w_qkv.insert(w_qkv.end(), w_kv.begin(), w_kv.end());
+  auto input = CreateTensor({batch, seq, d_model}, x, false);
+  std::vector<Tensor *> inputs = {input,
+                                  input,
+                                  input,
+                                  CreateTensor({3 * d_model, d_model}, w_qkv, true),
+                                  CreateTensor({d_model, d_model}, w_o, true),
+                                  CreateTensor({3 * d_model}, b_qkv, true),
+                                  CreateTensor({d_model}, b_o, true),
+                                  CreateTensor({batch, seq, seq}, mask, false)};
+  auto output = CreateTensor({batch, seq, d_model}, {}, false);
+  auto kernel = CreateKernel(inputs, output, head_num);
+  ASSERT_EQ(kernel->Prepare(), lite::RET_OK);
+  ASSERT_EQ(kernel->Run(), lite::RET_OK);
+  auto expect = Reference(x, x, w_q, w_kv, w_o, b_qkv, b_o, mask, batch, seq, seq, head_num, d_model);
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(output->data()), expect.data(), output->ElementsNum(),
+                                 1e-3));
+  delete kernel;
+}
+
+TEST_F(TestAttentionFp32, CrossAttention) {
+  int batch = 1, q_seq = 5, kv_seq = 150, head_num = 2, d_model = 24;
+  auto x_q = RandomData(batch * q_seq * d_model);
+  auto x_kv = RandomData(batch * kv_seq * d_model);
+  auto w_q = RandomData(d_model * d_model, 0.2f);
+  auto w_kv = RandomData(2 * d_model * d_model, 0.2f);
+  auto w_o = RandomData(d_model * d_model, 0.2f);
+  auto b_qkv = RandomData(3 * d_model);
+  auto b_o = RandomData(d_model);
+  auto input_kv = CreateTensor({batch, kv_seq, d_model}, x_kv, false);
+  std::vector<Tensor *> inputs = {CreateTensor({batch, q_seq, d_model}, x_q, false),
+                                  input_kv,
+                                  input_kv,
+                                  CreateTensor({d_model, d_model}, w_q, true),
+                                  CreateTensor({2 * d_model, d_model}, w_kv, true),
+                                  CreateTensor({d_model, d_model}, w_o, true),
+                                  CreateTensor({3 * d_model}, b_qkv, true),
+                                  CreateTensor({d_model}, b_o, true)};
+  auto output = CreateTensor({batch, q_seq, d_model}, {}, false);
+  auto kernel = CreateKernel(inputs, output, head_num);
+  ASSERT_EQ(kernel->Prepare(), lite::RET_OK);
+  ASSERT_EQ(kernel->Run(), lite::RET_OK);
+  auto expect = Reference(x_q, x_kv, w_q, w_kv, w_o, b_qkv, b_o, {}, batch, q_seq, kv_seq, head_num, d_model);
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(output->data()), expect.data(), output->ElementsNum(),
+                                 1e-3));
+  delete kernel;
+}
+
+TEST_F(TestAttentionFp32, BertBasePerformance) {
+  // one attention layer of bert-base: 12 heads, d_model 768
+  int batch = 1, head_num = 12, d_model = 768;
+  auto w_qkv = RandomData(3 * d_model * d_model, 0.05f);
+  auto w_o = RandomData(d_model * d_model, 0.05f);
+  auto b_qkv = RandomData(3 * d_model);
+  auto b_o = RandomData(d_model);
+  for (int seq : {128, 384}) {
+    auto input = CreateTensor({batch, seq, d_model}, RandomData(batch * seq * d_model), false);
+    std::vector<Tensor *> inputs = {input,
+                                    input,
+                                    input,
+                                    CreateTensor({3 * d_model, d_model}, w_qkv, true),
+                                    CreateTensor({d_model, d_model}, w_o, true),
+                                    CreateTensor({3 * d_model}, b_qkv, true),
+                                    CreateTensor({d_model}, b_o, true)};
+    auto output = CreateTensor({batch, seq, d_model}, {}, false);
+    auto kernel = CreateKernel(inputs, output, head_num);
+    ASSERT_EQ(kernel->Prepare(), lite::RET_OK);
+    ASSERT_EQ(kernel->Run(), lite::RET_OK);
+    constexpr int kLoopCount = 10;
+    auto start_time = lite::GetTimeUs();
+    for (int i = 0; i < kLoopCount; ++i) {
+      ASSERT_EQ(kernel->Run(), lite::RET_OK);
+    }
+    auto time_dur = lite::GetTimeUs() - start_time;
+    std::cout << "Fused attention of bert-base, seq: " << seq << ", threads: " << kThreadNum << ", "
+              << (static_cast<float>(time_dur) / kLoopCount / 1000) << "ms" << std::endl;
+    delete kernel;
+  }
+}
+}  // namespace mindspore
@@ -0,0 +1,264 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(ENABLE_AVX512) && defined(__linux__)
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/errorcode.h"
+#include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512.h"
+#include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512_jit.h"
+#include "src/litert/inner_context.h"
+#include "src/tensor.h"
+
+namespace mindspore {
+class TestMatMulAvx512JitFp32 : public mindspore::CommonTest {
+ public:
+  TestMatMulAvx512JitFp32() {}
+};
+
+// dst[row x col] = act(src[row x depth] * weight[col x depth]^T + bias)
+void MatMulAvx512JitRef(const std::vector<float> &src, const std::vector<float> &weight, const std::vector<float> &bias,
+                        std::vector<float> *dst, int row, int col, int depth, int act_type) {
+  for (int r = 0; r < row; ++r) {
+    for (int c = 0; c < col; ++c) {
+      float value = bias.empty() ? 0.0f : bias[c];
+      for (int d = 0; d < depth; ++d) {
+        value += src[r * depth + d] * weight[c * depth + d];
+      }
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        value = value < 0.0f ? 0.0f : value;
+      }
+      if (act_type == ActType_Relu6) {
+        value = value > 6.0f ? 6.0f : value;
+      }
+      (*dst)[r * col + c] = value;
+    }
+  }
+}
+
+void MatMulAvx512JitRun(int row, int col, int depth, int act_type, bool has_bias) {
+  int col_align = UP_ROUND(col, C16NUM);
+  std::vector<float> src(row * depth);
+  std::vector<float> weight(col * depth);
+  std::vector<float> bias(has_bias ? col : 0);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<float>(static_cast<int>(i * 7 % 13) - 6) / 8;
+  }
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(static_cast<int>(i * 5 % 11) - 5) / 16;
+  }
+  for (size_t i = 0; i < bias.size(); ++i) {
+    bias[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  std::vector<float> pack_weight(col_align * depth, 0.0f);
+  RowMajor2Col64Major(weight.data(), pack_weight.data(), col, depth);
+  std::vector<float> pack_bias(col_align, 0.0f);
+  std::copy(bias.begin(), bias.end(), pack_bias.begin());
+
+  std::vector<float> dst(row * col, 0.0f);
+  auto cache = kernel::GemmJitAvx512Cache::GetInstance();
+  kernel::GemmJitAvx512Tiles(row, col, depth, col, act_type, has_bias, [&](const kernel::GemmJitAvx512Tile &tile) {
+    auto kernel = cache->GetKernel(tile.key);
+    ASSERT_NE(kernel.func, nullptr);
+    kernel.func(dst.data() + tile.dst_offset, src.data() + tile.src_offset, pack_weight.data() + tile.weight_offset,
+                pack_bias.data() + tile.bias_offset);
+  });
+  std::vector<float> expect(row * col, 0.0f);
+  MatMulAvx512JitRef(src, weight, bias, &expect, row, col, depth, act_type);
+  ASSERT_EQ(0, CommonTest::CompareOutputData(dst.data(), expect.data(), row * col, 0.001));
+}
+
+TEST_F(TestMatMulAvx512JitFp32, OddShapes) {
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512_Support() ||
+      !kernel::GemmJitAvx512Cache::GetInstance()->Enable()) {
+    return;
+  }
+  MatMulAvx512JitRun(1, 1, 1, ActType_No, false);
+  MatMulAvx512JitRun(13, 100, 37, ActType_Relu, true);
+  MatMulAvx512JitRun(7, 17, 64, ActType_No, true);
+  MatMulAvx512JitRun(25, 200, 3, ActType_Relu6, false);
+  MatMulAvx512JitRun(50, 33, 1601, ActType_Relu6, true);
+}
+
+TEST_F(TestMatMulAvx512JitFp32, SharedPages) {
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512_Support() ||
+      !kernel::GemmJitAvx512Cache::GetInstance()->Enable()) {
+    return;
+  }
+  std::vector<kernel::GemmJitAvx512Key> keys;
+  kernel::GemmJitAvx512Tiles(29, 150, 2000, 150, ActType_Relu, true,
+                             [&keys](const kernel::GemmJitAvx512Tile &tile) { keys.push_back(tile.key); });
+  auto kernels = kernel::GemmJitAvx512Cache::GetInstance()->GetKernels(keys);
+  ASSERT_EQ(kernels.size(), keys.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    ASSERT_NE(kernels[i].func, nullptr);
+    ASSERT_EQ(kernels[i].pages, kernels.front().pages);
+    for (size_t j = 0; j < i; ++j) {
+      bool same_key = !(keys[i] < keys[j]) && !(keys[j] < keys[i]);
+      ASSERT_EQ(same_key, kernels[i].func == kernels[j].func);
+    }
+  }
+}
+
+TEST_F(TestMatMulAvx512JitFp32, EvictLeastRecentlyUsed) {
+  auto cache = kernel::GemmJitAvx512Cache::GetInstance();
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512_Support() || !cache->Enable()) {
+    return;
+  }
+  const size_t max_kernel_num = 4;
+  cache->set_max_kernel_num(max_kernel_num);
+  ASSERT_LE(cache->kernel_num(), max_kernel_num);
+  kernel::GemmJitAvx512Key key;
+  key.row = 1;
+  key.col = C16NUM;
+  key.depth = 1;
+  key.src_stride = 1;
+  key.weight_stride = C16NUM;
+  key.dst_stride = C16NUM;
+  auto first = cache->GetKernel(key);
+  ASSERT_NE(first.func, nullptr);
+  for (int depth = 2; depth < 10; ++depth) {
+    auto other_key = key;
+    other_key.depth = depth;
+    ASSERT_NE(cache->GetKernel(other_key).func, nullptr);
+    ASSERT_LE(cache->kernel_num(), max_kernel_num);
+  }
+  // the evicted kernel is still executable by its holder, and is generated again when asked
+  std::vector<float> src = {2.0f};
+  std::vector<float> weight(C16NUM, 3.0f);
+  std::vector<float> dst(C16NUM, 0.0f);
+  first.func(dst.data(), src.data(), weight.data(), nullptr);
+  ASSERT_EQ(dst, std::vector<float>(C16NUM, 6.0f));
+  auto second = cache->GetKernel(key);
+  ASSERT_NE(second.func, nullptr);
+  ASSERT_NE(second.pages, first.pages);
+  cache->set_max_kernel_num(kernel::kGemmJitAvx512MaxKernelNum);
+}
+
+// fails the generation of the kernels when asked, to run the kernel by the static fallback
+class MatmulFp32AVX512TestKernel : public kernel::MatmulFp32AVX512CPUKernel {
+ public:
+  MatmulFp32AVX512TestKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                             const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx,
+                             bool fail_jit)
+      : MatmulFp32AVX512CPUKernel(parameter, inputs, outputs, ctx), fail_jit_(fail_jit) {}
+  ~MatmulFp32AVX512TestKernel() override = default;
+
+  bool cutting_by_batch() const { return IsCuttingByBatch(); }
+  bool cutting_by_row() const { return IsCuttingByRow(); }
+  bool out_need_aligned() const { return out_need_aligned_; }
+
+ protected:
+  int InitGemmJitFuncs() override { return fail_jit_ ? RET_ERROR : MatmulFp32AVX512CPUKernel::InitGemmJitFuncs(); }
+
+ private:
+  bool fail_jit_;
+};
+
+enum MatmulAvx512Cutting { kCuttingByBatch, kCuttingByRow, kCuttingByOC };
+
+// out[batch x row x col] = in[batch x row x depth] * weight[batch x col x depth]^T + bias, by two threads
+void MatmulAvx512KernelRun(int batch, int row, int col, int depth, bool has_bias, bool fail_jit,
+                           MatmulAvx512Cutting cutting) {
+  std::vector<float> src(batch * row * depth);
+  std::vector<float> weight(batch * col * depth);
+  std::vector<float> bias(has_bias ? col : 0);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<float>(static_cast<int>(i * 7 % 13) - 6) / 8;
+  }
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(static_cast<int>(i * 5 % 11) - 5) / 16;
+  }
+  for (size_t i = 0; i < bias.size(); ++i) {
+    bias[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  auto new_tensor = [](const std::vector<int> &shape, const std::vector<float> &data) {
+    auto tensor = new lite::Tensor(kNumberTypeFloat32, shape, mindspore::NHWC, lite::Category::CONST_TENSOR);
+    EXPECT_EQ(tensor->MallocData(), lite::RET_OK);
+    if (!data.empty()) {
+      memcpy(tensor->MutableData(), data.data(), data.size() * sizeof(float));
+    }
+    return tensor;
+  };
+  std::vector<lite::Tensor *> inputs = {new_tensor({batch, row, depth}, src), new_tensor({batch, col, depth}, weight)};
+  if (has_bias) {
+    inputs.push_back(new_tensor({col}, bias));
+  }
+  std::vector<lite::Tensor *> outputs = {new_tensor({batch, row, col}, {})};
+  auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  ASSERT_NE(param, nullptr);
+  memset(param, 0, sizeof(MatMulParameter));
+  param->op_parameter_.thread_num_ = C2NUM;
+  param->b_transpose_ = true;
+  param->act_type_ = ActType_No;
+  lite::InnerContext ctx;
+  ctx.thread_num_ = C2NUM;
+  ASSERT_EQ(lite::RET_OK, ctx.Init());
+  auto kernel = new MatmulFp32AVX512TestKernel(reinterpret_cast<OpParameter *>(param), inputs, outputs, &ctx, fail_jit);
+  ASSERT_EQ(kernel->MatmulPrepare(), lite::RET_OK);
+  ASSERT_EQ(kernel->cutting_by_batch(), cutting == kCuttingByBatch);
+  ASSERT_EQ(kernel->cutting_by_row(), cutting == kCuttingByRow);
+  // the static kernels store the aligned columns, which are copied to the output
+  ASSERT_EQ(kernel->out_need_aligned(), fail_jit && col % C16NUM != 0);
+
+  std::vector<float> expect(batch * row * col, 0.0f);
+  for (int b = 0; b < batch; ++b) {
+    std::vector<float> batch_src(src.begin() + b * row * depth, src.begin() + (b + 1) * row * depth);
+    std::vector<float> batch_weight(weight.begin() + b * col * depth, weight.begin() + (b + 1) * col * depth);
+    std::vector<float> batch_expect(row * col, 0.0f);
+    MatMulAvx512JitRef(batch_src, batch_weight, bias, &batch_expect, row, col, depth, ActType_No);
+    std::copy(batch_expect.begin(), batch_expect.end(), expect.begin() + b * row * col);
+  }
+  // the second run after resizing reuses or reallocates the output buffer of the first one
+  for (int i = 0; i < C2NUM; ++i) {
+    if (i > 0) {
+      ASSERT_EQ(kernel->MatmulReSize(), lite::RET_OK);
+    }
+    memset(outputs.front()->MutableData(), 0, expect.size() * sizeof(float));
+    ASSERT_EQ(kernel->Run(), lite::RET_OK);
+    auto dst = static_cast<float *>(outputs.front()->MutableData());
+    ASSERT_EQ(0, CommonTest::CompareOutputData(dst, expect.data(), expect.size(), 0.001));
+  }
+  delete kernel;
+  for (auto tensor : inputs) {
+    delete tensor;
+  }
+  delete outputs.front();
+}
+
+TEST_F(TestMatMulAvx512JitFp32, KernelCutting) {
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512_Support() ||
+      !kernel::GemmJitAvx512Cache::GetInstance()->Enable()) {
+    return;
+  }
+  MatmulAvx512KernelRun(4, 5, 33, 37, true, false, kCuttingByBatch);
+  MatmulAvx512KernelRun(1, 64, 33, 37, true, false, kCuttingByRow);
+  MatmulAvx512KernelRun(1, 5, 200, 37, true, false, kCuttingByOC);
+  MatmulAvx512KernelRun(1, 5, 200, 37, false, false, kCuttingByOC);
+}
+
+TEST_F(TestMatMulAvx512JitFp32, KernelFallback) {
+  if (IntelX86CpuInfoInit() != NNACL_OK || !X86_Avx512_Support() ||
+      !kernel::GemmJitAvx512Cache::GetInstance()->Enable()) {
+    return;
+  }
+  MatmulAvx512KernelRun(4, 5, 33, 37, true, true, kCuttingByBatch);
+  MatmulAvx512KernelRun(1, 64, 33, 37, true, true, kCuttingByRow);
+  MatmulAvx512KernelRun(1, 5, 200, 37, true, true, kCuttingByOC);
+}
+}  // namespace mindspore
+#endif
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "schema/inner/model_generated.h"
+#include "src/litert/lite_session.h"
+#include "src/litert/resize_plan_cache.h"
+#include "ir/dtype/type_id.h"
+
+namespace mindspore {
+using ConfigInfo = std::map<std::string, std::map<std::string, std::string>>;
+namespace {
+constexpr int kBatch = 2;
+
+std::unique_ptr<schema::TensorT> CreateTensor(lite::NodeType node_type, TypeId data_type, std::vector<int> dims) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = node_type;
+  tensor->format = schema::Format_NHWC;
+  tensor->dataType = data_type;
+  tensor->dims = dims;
+  tensor->offset = -1;
+  return tensor;
+}
+
+std::unique_ptr<schema::TensorT> CreateConstTensor(const std::vector<int> &value) {
+  auto tensor = CreateTensor(lite::NodeType_ValueNode, kNumberTypeInt32, {static_cast<int>(value.size())});
+  tensor->data.resize(value.size() * sizeof(int));
+  memcpy(tensor->data.data(), value.data(), tensor->data.size());
+  return tensor;
+}
+
+// The StridedSlice drops the first column and the Split halves the columns, both write the sliced ranges into their
+// parameters while inferring.
+lite::Model *BuildSliceSplitModel() {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  meta_graph->version = Version();
+
+  auto strided_slice = std::make_unique<schema::CNodeT>();
+  strided_slice->inputIndex = {0, 1, 2, 3};
+  strided_slice->outputIndex = {4};
+  strided_slice->primitive = std::make_unique<schema::PrimitiveT>();
+  strided_slice->primitive->value.type = schema::PrimitiveType_StridedSlice;
+  auto strided_slice_primitive = new schema::StridedSliceT;
+  strided_slice_primitive->end_mask = 2;
+  strided_slice->primitive->value.value = strided_slice_primitive;
+  strided_slice->name = "strided_slice";
+
+  auto split = std::make_unique<schema::CNodeT>();
+  split->inputIndex = {0};
+  split->outputIndex = {5, 6};
+  split->primitive = std::make_unique<schema::PrimitiveT>();
+  split->primitive->value.type = schema::PrimitiveType_Split;
+  auto split_primitive = new schema::SplitT;
+  split_primitive->output_num = 2;
+  split_primitive->axis = 1;
+  split->primitive->value.value = split_primitive;
+  split->name = "split";
+
+  auto input = CreateTensor(lite::NodeType_Parameter, kNumberTypeFloat32, {kBatch, 8});
+  input->name = "input";
+  meta_graph->nodes.emplace_back(std::move(strided_slice));
+  meta_graph->nodes.emplace_back(std::move(split));
+  meta_graph->allTensors.emplace_back(std::move(input));
+  meta_graph->allTensors.emplace_back(CreateConstTensor({0, 1}));
+  meta_graph->allTensors.emplace_back(CreateConstTensor({kBatch, 1}));
+  meta_graph->allTensors.emplace_back(CreateConstTensor({1, 1}));
+  for (int i = 0; i < 3; ++i) {
+    meta_graph->allTensors.emplace_back(CreateTensor(lite::NodeType_Parameter, kNumberTypeFloat32, {}));
+  }
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {4, 5, 6};
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  schema::FinishMetaGraphBuffer(builder, offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+  return lite::Model::Import(content, size);
+}
+
+std::unique_ptr<lite::LiteSession> CreateSession(lite::Model *model, const ConfigInfo *config_info) {
+  auto session = std::make_unique<lite::LiteSession>();
+  session->SetConfigInfo(config_info);
+  if (session->Init(new lite::InnerContext()) != lite::RET_OK || session->CompileGraph(model) != lite::RET_OK) {
+    return nullptr;
+  }
+  return session;
+}
+
+// resizes the session to [kBatch, seq_len], runs it and returns the outputs
+std::vector<std::vector<float>> ResizeAndRun(lite::LiteSession *session, int seq_len) {
+  auto inputs = session->GetInputs();
+  std::vector<std::vector<int>> dims = {{kBatch, seq_len}};
+  if (session->Resize(inputs, dims) != lite::RET_OK) {
+    return {};
+  }
+  auto data = reinterpret_cast<float *>(inputs[0]->MutableData());
+  for (int i = 0; i < inputs[0]->ElementsNum(); i++) {
+    data[i] = static_cast<float>(i);
+  }
+  if (session->RunGraph() != lite::RET_OK) {
+    return {};
+  }
+  std::vector<std::vector<float>> outputs;
+  for (auto &name : session->GetOutputTensorNames()) {
+    auto output = session->GetOutputByTensorName(name);
+    auto output_data = reinterpret_cast<float *>(output->data());
+    outputs.emplace_back(output_data, output_data + output->ElementsNum());
+  }
+  return outputs;
+}
+}  // namespace
+
+class ResizePlanCacheTest : public mindspore::CommonTest {
+ public:
+  ResizePlanCacheTest() = default;
+};
+
+TEST_F(ResizePlanCacheTest, DisabledWithoutConfig) {
+  lite::ResizePlanCache cache;
+  ConfigInfo config_info;
+  ASSERT_EQ(cache.Init(&config_info), lite::RET_OK);
+  ASSERT_FALSE(cache.enable());
+  lite::InputShapes dims = {{1, 37, 768}};
+  lite::Tensor input;
+  ASSERT_EQ(cache.PadToBucket({&input}, dims), dims);
+  cache.Insert(dims, lite::ResizePlan());
+  ASSERT_EQ(cache.Find(dims), nullptr);
+}
+
+TEST_F(ResizePlanCacheTest, PadToBucket) {
+  lite::ResizePlanCache cache;
+  ConfigInfo config_info = {{"resize_bucket", {{"bucket_boundaries", "16,32,64,128"}}}};
+  ASSERT_EQ(cache.Init(&config_info), lite::RET_INPUT_PARAM_INVALID);
+  config_info["resize_bucket"]["bucket_inputs"] = "ids,embedding,long_ids,scalar";
+  ASSERT_EQ(cache.Init(&config_info), lite::RET_OK);
+  ASSERT_TRUE(cache.enable());
+  std::vector<std::string> names = {"ids", "embedding", "long_ids", "scalar", "mask"};
+  std::vector<lite::Tensor> inputs(names.size());
+  std::vector<lite::Tensor *> input_ptrs;
+  for (size_t i = 0; i < names.size(); ++i) {
+    inputs[i].set_tensor_name(names[i]);
+    input_ptrs.push_back(&inputs[i]);
+  }
+  // the mask is not a bucket input, so it keeps its shape
+  lite::InputShapes dims = {{1, 37}, {1, 16, 768}, {1, 200}, {4}, {1, 37, 37}};
+  lite::InputShapes expect = {{1, 64}, {1, 16, 768}, {1, 200}, {4}, {1, 37, 37}};
+  ASSERT_EQ(cache.PadToBucket(input_ptrs, dims), expect);
+
+  config_info["resize_bucket"]["bucket_axis"] = "0";
+  ASSERT_EQ(cache.Init(&config_info), lite::RET_OK);
+  expect = {{16, 37}, {16, 16, 768}, {16, 200}, {16}, {1, 37, 37}};
+  ASSERT_EQ(cache.PadToBucket(input_ptrs, dims), expect);
+
+  config_info["resize_bucket"]["bucket_boundaries"] = "32,16";
+  ASSERT_EQ(cache.Init(&config_info), lite::RET_INPUT_PARAM_INVALID);
+}
+
+TEST_F(ResizePlanCacheTest, DropLeastRecentlyUsed) {
+  lite::ResizePlanCache cache;
+  ConfigInfo config_info = {{"resize_bucket", {{"max_cached_plans", "2"}}}};
+  ASSERT_EQ(cache.Init(&config_info), lite::RET_OK);
+  lite::InputShapes dims0 = {{1, 16}};
+  lite::InputShapes dims1 = {{1, 32}};
+  lite::InputShapes dims2 = {{1, 64}};
+  lite::ResizePlan plan;
+  plan.total_size = 16;
+  cache.Insert(dims0, plan);
+  plan.total_size = 32;
+  cache.Insert(dims1, plan);
+  ASSERT_NE(cache.Find(dims0), nullptr);
+  ASSERT_EQ(cache.Find(dims0)->total_size, 16);
+  plan.total_size = 64;
+  cache.Insert(dims2, plan);
+  ASSERT_NE(cache.Find(dims0), nullptr);
+  ASSERT_EQ(cache.Find(dims1), nullptr);
+  ASSERT_EQ(cache.Find(dims2)->total_size, 64);
+}
+
+/// Feature: reuse the resize plans of the shapes seen before.
+/// Description: resize a session of StridedSlice and Split from shape A to B and back to A through the cache.
+/// Expectation: the outputs are the same as a session without the cache resized to the same shapes.
+TEST_F(ResizePlanCacheTest, ResizeBackThroughCache) {
+  std::unique_ptr<lite::Model> cached_model(BuildSliceSplitModel());
+  ASSERT_NE(cached_model, nullptr);
+  std::unique_ptr<lite::Model> model(BuildSliceSplitModel());
+  ASSERT_NE(model, nullptr);
+  ConfigInfo config_info = {{"resize_bucket", {{"max_cached_plans", "4"}}}};
+  auto cached_session = CreateSession(cached_model.get(), &config_info);
+  ASSERT_NE(cached_session, nullptr);
+  auto session = CreateSession(model.get(), nullptr);
+  ASSERT_NE(session, nullptr);
+
+  for (int seq_len : {8, 16, 8, 16}) {
+    auto expect = ResizeAndRun(session.get(), seq_len);
+    ASSERT_EQ(expect.size(), 3);
+    EXPECT_EQ(expect[0].size(), kBatch * (seq_len - 1));
+    EXPECT_EQ(expect[1].size(), kBatch * seq_len / 2);
+    EXPECT_EQ(ResizeAndRun(cached_session.get(), seq_len), expect) << "seq_len: " << seq_len;
+  }
+}
+}  // namespace mindspore
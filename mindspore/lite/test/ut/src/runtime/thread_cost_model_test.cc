@@ -0,0 +1,179 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/litert/inner_context.h"
+#include "src/litert/thread_cost_model.h"
+
+namespace mindspore {
+namespace {
+constexpr char kProfilePath[] = "./thread_cost_model_test.ini";
+constexpr int kCalibrateThreadNum = 4;
+constexpr int kUncalibratedThreadNum = 64;
+
+void WriteProfile(const std::string &content) {
+  std::ofstream ofs(kProfilePath);
+  ofs << content;
+}
+
+void ExpectSameModel(const lite::ThreadCostModel &expect, const lite::ThreadCostModel &model) {
+  EXPECT_EQ(model.per_unit_load_cost_, expect.per_unit_load_cost_);
+  EXPECT_EQ(model.per_unit_store_cost_, expect.per_unit_store_cost_);
+  EXPECT_EQ(model.thread_startup_cost_, expect.thread_startup_cost_);
+  EXPECT_EQ(model.single_thread_cost_, expect.single_thread_cost_);
+  EXPECT_EQ(model.parallel_thread_cost_, expect.parallel_thread_cost_);
+  EXPECT_EQ(model.launch_thread_num_, expect.launch_thread_num_);
+  EXPECT_EQ(model.kernel_compute_cost_map_, expect.kernel_compute_cost_map_);
+}
+
+int DefaultThreadNum(int32_t kernel_type, int64_t unit_num, int thread_num) {
+  const lite::ThreadCostModel default_model;
+  lite::ThreadCostContext thread_cost_context;
+  thread_cost_context.per_unit_compute_cost_ = default_model.kernel_compute_cost_map_.at(kernel_type);
+  thread_cost_context.per_unit_load_num_ = 1;
+  thread_cost_context.per_unit_store_num_ = 1;
+  thread_cost_context.total_unit_num_ = unit_num;
+  return lite::ThreadNumUpdateStrategy(default_model, &thread_cost_context, thread_num);
+}
+}  // namespace
+
+class ThreadCostModelTest : public mindspore::CommonTest {
+ public:
+  ThreadCostModelTest() = default;
+  void TearDown() override { (void)std::remove(kProfilePath); }
+};
+
+/// Feature: save and load the thread cost profile.
+/// Description: save a model whose costs all differ from the defaults, then load the profile into a default model.
+/// Expectation: the loaded model has exactly the saved costs.
+TEST_F(ThreadCostModelTest, ProfileRoundTrip) {
+  lite::ThreadCostModel saved;
+  saved.per_unit_load_cost_ = 0.0123f;
+  saved.per_unit_store_cost_ = 0.0456f;
+  saved.thread_startup_cost_ = 1234.567f;
+  saved.single_thread_cost_ = 2345.678f;
+  saved.parallel_thread_cost_ = 345.6789f;
+  saved.launch_thread_num_ = kCalibrateThreadNum;
+  for (auto &item : saved.kernel_compute_cost_map_) {
+    item.second /= 3;
+  }
+  ASSERT_EQ(saved.SaveProfile(kProfilePath), lite::RET_OK);
+
+  lite::ThreadCostModel loaded;
+  ASSERT_EQ(loaded.LoadProfile(kProfilePath), lite::RET_OK);
+  ExpectSameModel(saved, loaded);
+}
+
+/// Feature: reject the invalid thread cost profiles.
+/// Description: load the profiles which miss the file, the section, a cost or the launch thread num, or have a cost
+/// which is not a positive number, a launch thread num which is not positive, or a kernel type which is not an integer.
+/// Expectation: every load fails and keeps the default costs.
+TEST_F(ThreadCostModelTest, RejectInvalidProfile) {
+  const lite::ThreadCostModel expect;
+  lite::ThreadCostModel model;
+  EXPECT_EQ(model.LoadProfile(kProfilePath), lite::RET_ERROR);
+  ExpectSameModel(expect, model);
+
+  const std::string model_costs =
+    "per_unit_load_cost=0.5\nper_unit_store_cost=0.5\nthread_startup_cost=100\nsingle_thread_cost=100\n";
+  const std::string thread_num = "launch_thread_num=4\n";
+  std::vector<std::string> invalid_profiles = {
+    "[kernel_compute_cost]\n1=2\n",
+    "[thread_cost_model]\n" + model_costs + thread_num,
+    "[thread_cost_model]\n" + model_costs + thread_num + "parallel_thread_cost=0\n",
+    "[thread_cost_model]\n" + model_costs + thread_num + "parallel_thread_cost=-40\n",
+    "[thread_cost_model]\n" + model_costs + thread_num + "parallel_thread_cost=fast\n",
+    "[thread_cost_model]\n" + model_costs + "parallel_thread_cost=40\n",
+    "[thread_cost_model]\n" + model_costs + "parallel_thread_cost=40\nlaunch_thread_num=0\n",
+    "[thread_cost_model]\n" + model_costs + thread_num + "parallel_thread_cost=40\n[kernel_compute_cost]\nrelu=2\n",
+    "[thread_cost_model]\n" + model_costs + thread_num + "parallel_thread_cost=40\n[kernel_compute_cost]\n1=-2\n",
+  };
+  for (auto &profile : invalid_profiles) {
+    WriteProfile(profile);
+    EXPECT_EQ(model.LoadProfile(kProfilePath), lite::RET_ERROR) << profile;
+    ExpectSameModel(expect, model);
+  }
+
+  WriteProfile("[thread_cost_model]\n" + model_costs + thread_num + "parallel_thread_cost=40\n");
+  ASSERT_EQ(model.LoadProfile(kProfilePath), lite::RET_OK);
+  EXPECT_EQ(model.parallel_thread_cost_, 40.0f);
+  EXPECT_EQ(model.launch_thread_num_, kCalibrateThreadNum);
+  EXPECT_EQ(model.kernel_compute_cost_map_, expect.kernel_compute_cost_map_);
+}
+
+/// Feature: calibrate the thread cost model on the host.
+/// Description: calibrate a model with a thread pool of 4 threads.
+/// Expectation: all costs are positive, the expensive kernels still cost more than the cheap ones, whether measured or
+/// scaled, and the thread costs keep their default ratios.
+TEST_F(ThreadCostModelTest, Calibrate) {
+  lite::InnerContext context;
+  context.thread_num_ = kCalibrateThreadNum;
+  ASSERT_EQ(context.Init(), lite::RET_OK);
+  const lite::ThreadCostModel default_model;
+  lite::ThreadCostModel model;
+  ASSERT_EQ(model.Calibrate(&context), lite::RET_OK);
+  EXPECT_EQ(model.launch_thread_num_, kCalibrateThreadNum);
+  EXPECT_GT(model.per_unit_load_cost_, 0.0f);
+  EXPECT_GT(model.per_unit_store_cost_, 0.0f);
+  EXPECT_GT(model.parallel_thread_cost_, 0.0f);
+  for (auto &item : model.kernel_compute_cost_map_) {
+    EXPECT_GT(item.second, 0.0f) << item.first;
+  }
+  auto cost = [&model](int32_t kernel_type) { return model.kernel_compute_cost_map_.at(kernel_type); };
+  // measured: tanh computes an exponent per element, relu only compares it
+  EXPECT_GT(cost(TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_TANH)),
+            cost(TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU)));
+  // scaled from the defaults
+  EXPECT_GT(cost(TC_TYPE(schema::PrimitiveType_Softmax, 0)), cost(TC_TYPE(schema::PrimitiveType_Stack, 0)));
+  EXPECT_GT(cost(TC_TYPE(schema::PrimitiveType_Stack, 0)), cost(TC_TYPE(schema::PrimitiveType_Fill, 0)));
+  const float ratio_error = 1e-3;
+  EXPECT_NEAR(model.thread_startup_cost_ / model.parallel_thread_cost_,
+              default_model.thread_startup_cost_ / default_model.parallel_thread_cost_, ratio_error);
+  EXPECT_NEAR(model.single_thread_cost_ / model.parallel_thread_cost_,
+              default_model.single_thread_cost_ / default_model.parallel_thread_cost_, ratio_error);
+}
+
+/// Feature: calibrate the thread cost model of the process by the config.
+/// Description: calibrate the model for 4 threads, and decide the thread num of relu over the unit nums for 4 threads
+/// and for a thread num above all calibrated ones.
+/// Expectation: the calibrated model changes some decisions for 4 threads, and the defaults decide for the other.
+TEST_F(ThreadCostModelTest, CalibrateUpdateThreadNum) {
+  lite::InnerContext context;
+  context.thread_num_ = kCalibrateThreadNum;
+  ASSERT_EQ(context.Init(), lite::RET_OK);
+  std::map<std::string, std::map<std::string, std::string>> config_info = {
+    {"thread_cost_model", {{"calibrate", "true"}}}};
+  ASSERT_EQ(lite::InitThreadCostModel(&context, &config_info), lite::RET_OK);
+
+  auto relu = TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU);
+  bool changed = false;
+  const int64_t max_unit_num = 1 << 26;
+  for (int64_t unit_num = 1; unit_num <= max_unit_num; unit_num *= 2) {
+    int thread_num = lite::UpdateThreadNum(relu, 1, 1, unit_num, kCalibrateThreadNum);
+    EXPECT_GE(thread_num, 1);
+    EXPECT_LE(thread_num, kCalibrateThreadNum);
+    changed = changed || thread_num != DefaultThreadNum(relu, unit_num, kCalibrateThreadNum);
+    EXPECT_EQ(lite::UpdateThreadNum(relu, 1, 1, unit_num, kUncalibratedThreadNum),
+              DefaultThreadNum(relu, unit_num, kUncalibratedThreadNum));
+  }
+  EXPECT_TRUE(changed);
+}
+}  // namespace mindspore
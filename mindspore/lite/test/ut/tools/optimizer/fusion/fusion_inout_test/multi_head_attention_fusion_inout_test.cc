@@ -0,0 +1,324 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define USE_DEPRECATED_API
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "test/ut/tools/optimizer/fusion/fusion_inout_test/fusion_inout_test.h"
+#include "tools/optimizer/fusion/multi_head_attention_fusion.h"
+#include "tools/optimizer/common/gllo_utils.h"
+#include "tools/common/tensor_util.h"
+#include "plugin/device/cpu/kernel/nnacl/op_base.h"
+#include "nnacl/attention_parameter.h"
+#include "ops/attention.h"
+#include "ops/op_name.h"
+#include "ops/expand_dims.h"
+#include "ops/real_div.h"
+#include "ops/reshape.h"
+#include "ops/softmax.h"
+#include "ops/transpose.h"
+#include "ops/fusion/add_fusion.h"
+#include "ops/fusion/mat_mul_fusion.h"
+#include "ops/fusion/mul_fusion.h"
+#include "ops/fusion/sub_fusion.h"
+#include "src/litert/inner_context.h"
+#include "src/litert/kernel/cpu/fp32/attention_fp32.h"
+
+namespace mindspore {
+namespace {
+constexpr int kBatch = 2;
+constexpr int kSeq = 7;
+constexpr int kHeadNum = 2;
+constexpr int kHeadSize = 4;
+constexpr int kDModel = kHeadNum * kHeadSize;
+constexpr int kThreadNum = 2;
+}  // namespace
+
+// Converts the unfused bert self attention with mask into the Attention node, then runs the node by the cpu kernel
+// and compares the result with the computation of the unfused graph.
+class MultiHeadAttentionFusionInoutTest : public FusionInoutTest {
+ public:
+  MultiHeadAttentionFusionInoutTest() = default;
+
+ protected:
+  void InitPass() override { this->pass_ = std::make_shared<opt::MultiHeadAttentionFusion>(); }
+
+  void InitGraph() override {
+    this->graph_ = std::make_shared<FuncGraph>();
+    MS_CHECK_TRUE_MSG(graph_ != nullptr, , "Create FuncGraph failed");
+    input_ = AddParameter(graph_, 0, {kBatch, kSeq, kDModel}, kNumberTypeFloat32, "input");
+    mask_ = AddParameter(graph_, 0, {kBatch, kSeq, kSeq}, kNumberTypeFloat32, "mask");
+    auto q_embedding = AddEmbedding(weight_q_, bias_q_, "q", {0, 2, 1, 3});
+    auto q = AddOp(std::make_shared<ops::RealDiv>(), {q_embedding, AddConst({div_value_}, {1}, "q_div")}, "q_div");
+    auto k_embedding = AddEmbedding(weight_k_, bias_k_, "k", {0, 2, 3, 1});
+    auto k = AddOp(std::make_shared<ops::RealDiv>(), {k_embedding, AddConst({div_value_}, {1}, "k_div")}, "k_div");
+    auto v = AddEmbedding(weight_v_, bias_v_, "v", {0, 2, 1, 3});
+    auto expand_dims = AddOp(std::make_shared<ops::ExpandDims>(), {mask_, AddIntConst({1}, {1}, "axis")}, "expand");
+    auto sub = AddOp(std::make_shared<ops::SubFusion>(), {AddConst({mask_sub_value_}, {1}, "one"), expand_dims}, "sub");
+    auto mul = AddOp(std::make_shared<ops::MulFusion>(), {sub, AddConst({mask_mul_value_}, {1}, "neg_inf")}, "mul");
+    auto logits = AddOp(std::make_shared<ops::MatMulFusion>(), {q, k}, "logits");
+    auto add = AddOp(std::make_shared<ops::AddFusion>(), {mul, logits}, "add");
+    auto reshape1 = AddReshape(add, {kBatch * kHeadNum, kSeq, kSeq}, "reshape1");
+    auto softmax = AddOp(std::make_shared<ops::Softmax>(), {reshape1}, "softmax");
+    auto reshape2 = AddReshape(softmax, {kBatch, kHeadNum, kSeq, kSeq}, "reshape2");
+    auto context = AddOp(std::make_shared<ops::MatMulFusion>(), {reshape2, v}, "context");
+    auto transpose = AddOp(std::make_shared<ops::Transpose>(), {context, AddIntConst({0, 2, 1, 3}, {4}, "perm")},
+                           "context_transpose");
+    auto reshape3 = AddReshape(transpose, {kBatch, kSeq, kDModel}, "reshape3");
+    auto output = AddDense(reshape3, weight_o_, bias_o_, "output");
+    if (AddReturn(graph_, {output}) == nullptr) {
+      this->graph_ = nullptr;
+    }
+  }
+
+  AnfNodePtr AddConst(const std::vector<float> &data, const std::vector<int64_t> &shape, const std::string &name) {
+    auto parameter = graph_->add_parameter();
+    auto tensor_info = lite::CreateTensorInfo(data.data(), data.size() * sizeof(float), shape, kNumberTypeFloat32);
+    parameter->set_abstract(tensor_info->ToAbstract());
+    parameter->set_default_param(tensor_info);
+    parameter->set_name(name);
+    return parameter;
+  }
+
+  AnfNodePtr AddIntConst(const std::vector<int> &data, const std::vector<int64_t> &shape, const std::string &name) {
+    auto parameter = graph_->add_parameter();
+    auto tensor_info = lite::CreateTensorInfo(data.data(), data.size() * sizeof(int), shape, kNumberTypeInt32);
+    parameter->set_abstract(tensor_info->ToAbstract());
+    parameter->set_default_param(tensor_info);
+    parameter->set_name(name);
+    return parameter;
+  }
+
+  CNodePtr AddOp(const std::shared_ptr<ops::BaseOperator> &op, const std::vector<AnfNodePtr> &inputs,
+                 const std::string &name) {
+    std::vector<AnfNodePtr> node_inputs = {NewValueNode(op->GetPrim())};
+    node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto cnode = graph_->NewCNode(node_inputs);
+    cnode->set_fullname_with_scope(name);
+    return cnode;
+  }
+
+  CNodePtr AddReshape(const AnfNodePtr &input, const std::vector<int> &shape, const std::string &name) {
+    return AddOp(std::make_shared<ops::Reshape>(),
+                 {input, AddIntConst(shape, {static_cast<int64_t>(shape.size())}, name + "_shape")}, name);
+  }
+
+  // y = x * w^T + b
+  CNodePtr AddDense(const AnfNodePtr &input, const std::vector<float> &weight, const std::vector<float> &bias,
+                    const std::string &name) {
+    auto matmul = std::make_shared<ops::MatMulFusion>();
+    matmul->Init(false, true);
+    auto weight_param = AddConst(weight, {kDModel, kDModel}, name + "_weight");
+    return AddOp(matmul, {input, weight_param, AddConst(bias, {kDModel}, name + "_bias")}, name);
+  }
+
+  CNodePtr AddEmbedding(const std::vector<float> &weight, const std::vector<float> &bias, const std::string &name,
+                        const std::vector<int> &perm) {
+    auto dense = AddDense(input_, weight, bias, name);
+    auto reshape = AddReshape(dense, {kBatch, kSeq, kHeadNum, kHeadSize}, name + "_reshape");
+    return AddOp(std::make_shared<ops::Transpose>(), {reshape, AddIntConst(perm, {4}, name + "_perm")},
+                 name + "_transpose");
+  }
+
+  std::vector<float> RandomData(size_t size, float scale) {
+    std::uniform_real_distribution<float> distribution(-scale, scale);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = distribution(generator_);
+    }
+    return data;
+  }
+
+  static std::vector<float> Dense(const std::vector<float> &x, const std::vector<float> &w,
+                                  const std::vector<float> &b, int row) {
+    std::vector<float> y(row * kDModel);
+    for (int i = 0; i < row; ++i) {
+      for (int c = 0; c < kDModel; ++c) {
+        float sum = b[c];
+        for (int d = 0; d < kDModel; ++d) {
+          sum += x[i * kDModel + d] * w[c * kDModel + d];
+        }
+        y[i * kDModel + c] = sum;
+      }
+    }
+    return y;
+  }
+
+  // The computation of the unfused graph.
+  std::vector<float> Reference() const {
+    int rows = kBatch * kSeq;
+    auto q = Dense(input_data_, weight_q_, bias_q_, rows);
+    auto k = Dense(input_data_, weight_k_, bias_k_, rows);
+    auto v = Dense(input_data_, weight_v_, bias_v_, rows);
+    std::vector<float> context(rows * kDModel);
+    std::vector<float> logits(kSeq);
+    for (int b = 0; b < kBatch; ++b) {
+      for (int h = 0; h < kHeadNum; ++h) {
+        for (int i = 0; i < kSeq; ++i) {
+          float max_logit = -1e30f;
+          for (int j = 0; j < kSeq; ++j) {
+            float logit = 0.0f;
+            const float *cur_q = q.data() + (b * kSeq + i) * kDModel + h * kHeadSize;
+            const float *cur_k = k.data() + (b * kSeq + j) * kDModel + h * kHeadSize;
+            for (int d = 0; d < kHeadSize; ++d) {
+              logit += cur_q[d] * cur_k[d];
+            }
+            logit = logit / std::sqrt(static_cast<float>(kHeadSize)) +
+                    (mask_sub_value_ - mask_data_[(b * kSeq + i) * kSeq + j]) * mask_mul_value_;
+            logits[j] = logit;
+            max_logit = std::max(max_logit, logit);
+          }
+          float sum = 0.0f;
+          for (auto &logit : logits) {
+            logit = std::exp(logit - max_logit);
+            sum += logit;
+          }
+          for (int d = 0; d < kHeadSize; ++d) {
+            float value = 0.0f;
+            for (int j = 0; j < kSeq; ++j) {
+              value += logits[j] * v[(b * kSeq + j) * kDModel + h * kHeadSize + d];
+            }
+            context[(b * kSeq + i) * kDModel + h * kHeadSize + d] = value / sum;
+          }
+        }
+      }
+    }
+    return Dense(context, weight_o_, bias_o_, rows);
+  }
+
+  // Run the fused Attention node by the cpu kernel, with the inputs of the graph and the constants of the converter.
+  std::vector<float> RunAttention(const CNodePtr &attention) {
+    auto ctx = std::make_shared<lite::InnerContext>();
+    ctx->thread_num_ = kThreadNum;
+    EXPECT_EQ(lite::RET_OK, ctx->Init());
+    std::vector<lite::Tensor *> inputs;
+    for (size_t i = 1; i < attention->size(); ++i) {
+      auto input = attention->input(i);
+      const std::vector<float> *data = nullptr;
+      std::vector<int> shape;
+      auto category = lite::Category::VAR;
+      if (input == input_) {
+        data = &input_data_;
+        shape = {kBatch, kSeq, kDModel};
+      } else if (input == mask_) {
+        data = &mask_data_;
+        shape = {kBatch, kSeq, kSeq};
+      } else {
+        auto tensor_info = opt::GetTensorInfo(input);
+        EXPECT_NE(tensor_info, nullptr);
+        for (auto dim : tensor_info->shape()) {
+          shape.push_back(static_cast<int>(dim));
+        }
+        auto values = reinterpret_cast<float *>(tensor_info->data_c());
+        const_data_.emplace_back(values, values + tensor_info->DataSize());
+        data = &const_data_.back();
+        category = lite::Category::CONST_TENSOR;
+      }
+      auto tensor = new lite::Tensor(kNumberTypeFloat32, shape, mindspore::NHWC, category);
+      tensor->MallocData();
+      memcpy(tensor->MutableData(), data->data(), data->size() * sizeof(float));
+      inputs.push_back(tensor);
+    }
+    auto output = new lite::Tensor(kNumberTypeFloat32, {kBatch, kSeq, kDModel}, mindspore::NHWC, lite::Category::VAR);
+    output->MallocData();
+    auto prim = GetValueNode<PrimitivePtr>(attention->input(0));
+    auto param = reinterpret_cast<AttentionParameter *>(malloc(sizeof(AttentionParameter)));
+    memset(param, 0, sizeof(AttentionParameter));
+    param->op_parameter_.type_ = schema::PrimitiveType_Attention;
+    param->head_num_ = static_cast<int>(GetValue<int64_t>(prim->GetAttr(ops::kHeadNum)));
+    auto kernel =
+      new kernel::AttentionCPUKernel(reinterpret_cast<OpParameter *>(param), inputs, {output}, ctx.get());
+    EXPECT_EQ(kernel->Prepare(), lite::RET_OK);
+    EXPECT_EQ(kernel->Run(), lite::RET_OK);
+    auto output_data = reinterpret_cast<float *>(output->data());
+    std::vector<float> result(output_data, output_data + output->ElementsNum());
+    delete kernel;
+    // the input of q, k and v is the same tensor
+    std::sort(inputs.begin(), inputs.end());
+    inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+    for (auto tensor : inputs) {
+      delete tensor;
+    }
+    delete output;
+    return result;
+  }
+
+  void InitData() {
+    input_data_ = RandomData(kBatch * kSeq * kDModel, 1.0f);
+    mask_data_ = std::vector<float>(kBatch * kSeq * kSeq, 1.0f);
+    for (int i = 0; i < kSeq; ++i) {
+      mask_data_[(kSeq + i) * kSeq + kSeq - 1] = 0.0f;
+    }
+    std::vector<float> *weights[] = {&weight_q_, &weight_k_, &weight_v_, &weight_o_};
+    for (auto weight : weights) {
+      *weight = RandomData(kDModel * kDModel, 0.3f);
+    }
+    std::vector<float> *biases[] = {&bias_q_, &bias_k_, &bias_v_, &bias_o_};
+    for (auto bias : biases) {
+      *bias = RandomData(kDModel, 1.0f);
+    }
+  }
+
+  ParameterPtr input_{nullptr};
+  ParameterPtr mask_{nullptr};
+  float mask_sub_value_{1.0f};
+  float mask_mul_value_{-10000.0f};
+  // q * k^T is divided by sqrt(head_size), half of the scale is applied to both q and k.
+  float div_value_{std::sqrt(std::sqrt(static_cast<float>(kHeadSize)))};
+  std::vector<float> input_data_;
+  std::vector<float> mask_data_;
+  std::vector<float> weight_q_, weight_k_, weight_v_, weight_o_;
+  std::vector<float> bias_q_, bias_k_, bias_v_, bias_o_;
+  std::vector<std::vector<float>> const_data_;
+  std::mt19937 generator_{1};
+};
+
+TEST_F(MultiHeadAttentionFusionInoutTest, test) {
+  InitData();
+  ASSERT_EQ(DoTest(), true);
+  auto attention = graph_->get_return()->input(1)->cast<CNodePtr>();
+  ASSERT_NE(attention, nullptr);
+  ASSERT_TRUE(opt::CheckPrimitiveType(attention, std::make_shared<Primitive>(ops::kNameAttention)));
+  // q, k, v, weight_qkv, weight_o, bias_qkv, bias_o and mask
+  ASSERT_EQ(attention->size(), 9);
+  auto expect = Reference();
+  auto output = RunAttention(attention);
+  ASSERT_EQ(0, CommonTest::CompareOutputData(output.data(), expect.data(), output.size(), 1e-3));
+}
+
+TEST_F(MultiHeadAttentionFusionInoutTest, test_unsupported_mask) {
+  InitData();
+  // the kernel only supports the mask of (1 - mask) * -10000
+  mask_mul_value_ = -1e9f;
+  ASSERT_EQ(DoTest(), true);
+  auto output = graph_->get_return()->input(1)->cast<CNodePtr>();
+  ASSERT_NE(output, nullptr);
+  ASSERT_TRUE(opt::CheckPrimitiveType(output, prim::kPrimMatMulFusion));
+}
+
+TEST_F(MultiHeadAttentionFusionInoutTest, test_unsupported_scale) {
+  InitData();
+  // the kernel only supports the logits scaled by 1 / sqrt(head_size)
+  div_value_ = std::sqrt(static_cast<float>(kHeadSize));
+  ASSERT_EQ(DoTest(), true);
+  auto output = graph_->get_return()->input(1)->cast<CNodePtr>();
+  ASSERT_NE(output, nullptr);
+  ASSERT_TRUE(opt::CheckPrimitiveType(output, prim::kPrimMatMulFusion));
+}
+}  // namespace mindspore
@@ -22,6 +22,7 @@
 #include <deque>
 #include <map>
 #include <tuple>
+#include <algorithm>
 #include "nnacl/op_base.h"
 #include "src/common/log_adapter.h"
 #include "tools/converter/optimizer_manager.h"
@@ -235,6 +236,16 @@ int AnfTransform::RunFusionPass(const FuncGraphPtr &old_graph, const std::shared
                                     std::make_shared<opt::FullconnectedAddFusion>(),
                                     std::make_shared<opt::TensorDotFusion>(),
                                     std::make_shared<opt::MatMulActivationFusion>(param)};
+  // The fused Attention only has a cpu kernel of the lite runtime. It matches the embeddings whose bias has been fused
+  // into MatMul.
+  if (!param->train_model && param->export_mindir != kMindIR && param->device.find("Ascend") == std::string::npos) {
+    auto iter = std::find_if(fusions.begin(), fusions.end(),
+                             [](const opt::PassPtr &pass) { return pass->name() == "MatMulAddFusion"; });
+    if (iter != fusions.end()) {
+      ++iter;
+    }
+    (void)fusions.insert(iter, std::make_shared<opt::MultiHeadAttentionFusion>());
+  }
   for (size_t index = 0; index < fusions.size(); index++) {
     auto pass_ptr = fusions.at(index);
     auto pass_name = pass_ptr->name();
@@ -16,6 +16,7 @@
 
 #define USE_DEPRECATED_API
 #include "tools/optimizer/fusion/multi_head_attention_fusion.h"
+#include <cmath>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -27,34 +28,39 @@ namespace mindspore::opt {
 namespace {
 const auto &p1 = std::placeholders::_1;
 const size_t kWeightShapeSize = 2;
+// The fused attention kernel adds (1 - mask) * -10000 to the logits, as the bert attention mask does.
+constexpr float kMaskSubValue = 1.0f;
+constexpr float kMaskMulValue = -10000.0f;
+// The fused attention kernel scales q * k^T by 1 / sqrt(head_size).
+constexpr float kConstValueRelativeEps = 1e-6f;
 }  // namespace
 
 namespace {
-VectorRef DefineEmbedding(const BaseRef &input, const BaseRef &weight, const BaseRef &bias, bool test_div = false) {
+// the embedding is divided by div_value if it is set
+VectorRef DefineEmbedding(const BaseRef &input, const BaseRef &weight, const BaseRef &bias,
+                          const VarPtr &div_value = nullptr, const VarPtr &reshape_shape = nullptr) {
   auto is_matmul = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
   MS_CHECK_TRUE_RET(is_matmul != nullptr, {});
   auto dense = VectorRef({is_matmul, input, weight, bias});
   auto is_reshape = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimReshape));
   MS_CHECK_TRUE_RET(is_reshape != nullptr, {});
-  auto var1 = std::make_shared<Var>();
+  auto var1 = reshape_shape != nullptr ? reshape_shape : std::make_shared<Var>();
   MS_CHECK_TRUE_RET(var1 != nullptr, {});
   auto reshape = VectorRef({is_reshape, dense, var1});
   auto is_transpose = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimTranspose));
   MS_CHECK_TRUE_RET(is_transpose != nullptr, {});
   auto var2 = std::make_shared<Var>();
   auto transpose = VectorRef({is_transpose, reshape, var2});
-  if (test_div) {
+  if (div_value != nullptr) {
     auto is_div = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimRealDiv));
     MS_CHECK_TRUE_RET(is_div != nullptr, {});
-    auto var3 = std::make_shared<Var>();
-    MS_CHECK_TRUE_RET(var3 != nullptr, {});
-    auto div = VectorRef({is_div, transpose, var3});
+    auto div = VectorRef({is_div, transpose, div_value});
     return div;
   }
   return transpose;
 }
 
-VectorRef DefineMask(const BaseRef &mask_input) {
+VectorRef DefineMask(const BaseRef &mask_input, const BaseRef &sub_value, const BaseRef &mul_value) {
   auto is_expand_dims = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimExpandDims));
   MS_CHECK_TRUE_RET(is_expand_dims != nullptr, {});
   auto var1 = std::make_shared<Var>();
@@ -62,30 +68,45 @@ VectorRef DefineMask(const BaseRef &mask_input) {
   auto expand_dims = VectorRef({is_expand_dims, mask_input, var1});
   auto is_sub = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimSubFusion));
   MS_CHECK_TRUE_RET(is_sub != nullptr, {});
-  auto var2 = std::make_shared<Var>();
-  MS_CHECK_TRUE_RET(var2 != nullptr, {});
-  auto sub = VectorRef({is_sub, var2, expand_dims});
+  auto sub = VectorRef({is_sub, sub_value, expand_dims});
   auto is_mul = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMulFusion));
   MS_CHECK_TRUE_RET(is_mul != nullptr, {});
-  auto var3 = std::make_shared<Var>();
-  MS_CHECK_TRUE_RET(var3 != nullptr, {});
-  return VectorRef({is_mul, sub, var3});
+  return VectorRef({is_mul, sub, mul_value});
+}
+
+bool GetConstScalar(const AnfNodePtr &node, float *value) {
+  auto tensor = GetTensorInfo(node);
+  if (tensor == nullptr || tensor->data_type() != kNumberTypeFloat32 || tensor->DataSize() != 1 ||
+      tensor->data_c() == nullptr) {
+    return false;
+  }
+  *value = *reinterpret_cast<float *>(tensor->data_c());
+  return true;
+}
+
+bool IsNearlyEqual(float value, float expect) {
+  return std::fabs(value - expect) <= kConstValueRelativeEps * std::fabs(expect);
+}
+
+bool IsConstScalar(const AnfNodePtr &node, float expect) {
+  float value = 0.0f;
+  return GetConstScalar(node, &value) && IsNearlyEqual(value, expect);
 }
 }  // namespace
 
 VectorRef MultiHeadAttentionFusion::DefineMPWithMaskPattern(bool cross, bool mask) const {
   VectorRef k_embedding, v_embedding;
-  auto q_embedding = DefineEmbedding(input_q_, weight_q_, bias_q_, true);
+  auto q_embedding = DefineEmbedding(input_q_, weight_q_, bias_q_, div_q_);
   MS_CHECK_TRUE_RET(!q_embedding.empty(), {});
   if (!cross) {
-    k_embedding = DefineEmbedding(input_q_, weight_k_, bias_k_, true);
+    k_embedding = DefineEmbedding(input_q_, weight_k_, bias_k_, div_k_, reshape_k_);
     MS_CHECK_TRUE_RET(!k_embedding.empty(), {});
-    v_embedding = DefineEmbedding(input_q_, weight_v_, bias_v_);
+    v_embedding = DefineEmbedding(input_q_, weight_v_, bias_v_, nullptr, reshape_v_);
     MS_CHECK_TRUE_RET(!v_embedding.empty(), {});
   } else {
-    k_embedding = DefineEmbedding(input_k_, weight_k_, bias_k_, true);
+    k_embedding = DefineEmbedding(input_k_, weight_k_, bias_k_, div_k_, reshape_k_);
     MS_CHECK_TRUE_RET(!k_embedding.empty(), {});
-    v_embedding = DefineEmbedding(input_k_, weight_v_, bias_v_);
+    v_embedding = DefineEmbedding(input_k_, weight_v_, bias_v_, nullptr, reshape_v_);
     MS_CHECK_TRUE_RET(!v_embedding.empty(), {});
   }
   auto is_matmul1 = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
@@ -99,7 +120,7 @@ VectorRef MultiHeadAttentionFusion::DefineMPWithMaskPattern(bool cross, bool mas
   if (mask) {
     auto is_add = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimAddFusion));
     MS_CHECK_TRUE_RET(is_add != nullptr, {});
-    auto mask = DefineMask(mask_);
+    auto mask = DefineMask(mask_, mask_sub_value_, mask_mul_value_);
     MS_CHECK_TRUE_RET(!mask.empty(), {});
     auto add = VectorRef({is_add, mask, matmul1});
     reshape1 = VectorRef({is_reshape1, add, var1});
@@ -135,17 +156,17 @@ VectorRef MultiHeadAttentionFusion::DefineMPWithMaskPattern(bool cross, bool mas
 
 VectorRef MultiHeadAttentionFusion::DefineMPWithMaskPatternPA(bool cross) const {
   VectorRef k_embedding, v_embedding;
-  auto q_embedding = DefineEmbedding(input_q_, weight_q_, bias_q_, true);
+  auto q_embedding = DefineEmbedding(input_q_, weight_q_, bias_q_, div_q_);
   MS_CHECK_TRUE_RET(!q_embedding.empty(), {});
   if (!cross) {
-    k_embedding = DefineEmbedding(input_q_, weight_k_, bias_k_, true);
+    k_embedding = DefineEmbedding(input_q_, weight_k_, bias_k_, div_k_, reshape_k_);
     MS_CHECK_TRUE_RET(!k_embedding.empty(), {});
-    v_embedding = DefineEmbedding(input_q_, weight_v_, bias_v_);
+    v_embedding = DefineEmbedding(input_q_, weight_v_, bias_v_, nullptr, reshape_v_);
     MS_CHECK_TRUE_RET(!v_embedding.empty(), {});
   } else {
-    k_embedding = DefineEmbedding(input_k_, weight_k_, bias_k_, true);
+    k_embedding = DefineEmbedding(input_k_, weight_k_, bias_k_, div_k_, reshape_k_);
     MS_CHECK_TRUE_RET(!k_embedding.empty(), {});
-    v_embedding = DefineEmbedding(input_k_, weight_v_, bias_v_);
+    v_embedding = DefineEmbedding(input_k_, weight_v_, bias_v_, nullptr, reshape_v_);
     MS_CHECK_TRUE_RET(!v_embedding.empty(), {});
   }
   auto is_matmul1 = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
@@ -155,7 +176,7 @@ VectorRef MultiHeadAttentionFusion::DefineMPWithMaskPatternPA(bool cross) const
   MS_CHECK_TRUE_RET(var1 != nullptr, {});
   auto is_add = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimAddFusion));
   MS_CHECK_TRUE_RET(is_add != nullptr, {});
-  auto mask = DefineMask(mask_);
+  auto mask = DefineMask(mask_, mask_sub_value_, mask_mul_value_);
   MS_CHECK_TRUE_RET(!mask.empty(), {});
   auto add = VectorRef({is_add, mask, matmul1});
   auto is_softmax = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimSoftmax));
@@ -249,6 +270,14 @@ bool MultiHeadAttentionFusion::Init() const {
 
   mask_ = std::make_shared<Var>();
   MS_CHECK_TRUE_RET(mask_ != nullptr, false);
+  mask_sub_value_ = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(mask_sub_value_ != nullptr, false);
+  mask_mul_value_ = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(mask_mul_value_ != nullptr, false);
+  div_q_ = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(div_q_ != nullptr, false);
+  div_k_ = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(div_k_ != nullptr, false);
 
   reshape_k_ = std::make_shared<Var>();
   MS_CHECK_TRUE_RET(reshape_k_ != nullptr, false);
@@ -315,6 +344,26 @@ STATUS GetIntParameterData(const ParameterPtr &param_ptr, std::vector<int> *resu
   return RET_OK;
 }
 
+bool MultiHeadAttentionFusion::CheckScale(const EquivPtr &equiv) const {
+  MS_ASSERT(equiv != nullptr);
+  float div_q = 0.0f;
+  float div_k = 0.0f;
+  if (!GetConstScalar(utils::cast<AnfNodePtr>((*equiv)[div_q_]), &div_q) ||
+      !GetConstScalar(utils::cast<AnfNodePtr>((*equiv)[div_k_]), &div_k)) {
+    return false;
+  }
+  if (!utils::isa<ParameterPtr>((*equiv)[reshape_k_])) {
+    return false;
+  }
+  std::vector<int> shape_k;
+  if (GetIntParameterData(utils::cast<ParameterPtr>((*equiv)[reshape_k_]), &shape_k) != RET_OK || shape_k.empty() ||
+      shape_k.back() <= 0) {
+    return false;
+  }
+  // the embedding is reshaped to [batch, seq, head_num, head_size], and both q and k are divided
+  return IsNearlyEqual(div_q * div_k, std::sqrt(static_cast<float>(shape_k.back())));
+}
+
 std::shared_ptr<ops::Attention> MultiHeadAttentionFusion::BuildAttentionPrim(const EquivPtr &equiv) const {
   MS_ASSERT(equiv != nullptr);
   auto attention_prim = std::make_shared<ops::Attention>();
@@ -350,6 +399,8 @@ std::shared_ptr<ops::Attention> MultiHeadAttentionFusion::BuildAttentionPrim(con
     MS_LOG(ERROR) << "Shape k or shape v is invalid.";
     return nullptr;
   }
+  // the embedding is reshaped to [batch, seq, head_num, head_size] before the heads are transposed out.
+  attention_prim->Init(shape_k.at(shape_k.size() - kWeightShapeSize));
   return attention_prim;
 }
 
@@ -358,7 +409,17 @@ CNodePtr MultiHeadAttentionFusion::CreateMaskedMultiHeadAttentionNode(const Func
                                                                       bool cross, bool mask) const {
   MS_ASSERT(func_graph != nullptr);
   MS_ASSERT(equiv != nullptr);
-  auto attention_prim = std::make_shared<ops::Attention>();
+  if (mask && (!IsConstScalar(utils::cast<AnfNodePtr>((*equiv)[mask_sub_value_]), kMaskSubValue) ||
+               !IsConstScalar(utils::cast<AnfNodePtr>((*equiv)[mask_mul_value_]), kMaskMulValue))) {
+    MS_LOG(INFO) << "The attention mask of " << base_name << " is not (1 - mask) * -10000, which is not fused.";
+    return nullptr;
+  }
+  if (!CheckScale(equiv)) {
+    MS_LOG(INFO) << "The attention logits of " << base_name << " are not scaled by 1 / sqrt(head_size), which is not "
+                 << "fused.";
+    return nullptr;
+  }
+  auto attention_prim = BuildAttentionPrim(equiv);
   if (attention_prim == nullptr) {
     MS_LOG(ERROR) << "Build attention primitive failed.";
     return nullptr;
@@ -372,6 +433,8 @@ CNodePtr MultiHeadAttentionFusion::CreateMaskedMultiHeadAttentionNode(const Func
 
   if (cross) {
     input_k = utils::cast<AnfNodePtr>((*equiv)[input_k_]);
+    // the cross patterns also match the self attention, whose q, k and v share the input.
+    cross = input_k != input_q;
   }
   // auto input_v = utils::cast<AnfNodePtr>((*equiv)[input_v_]);
 
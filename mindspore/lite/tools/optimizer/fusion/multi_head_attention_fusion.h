@@ -43,6 +43,8 @@ class MultiHeadAttentionFusion : public MultiplePatternProcessPass {
 
   // create multi-head-attention without mask
   virtual std::shared_ptr<ops::Attention> BuildAttentionPrim(const EquivPtr &equiv) const;
+  // whether q * k^T is scaled by 1 / sqrt(head_size) as the fused kernel does
+  bool CheckScale(const EquivPtr &equiv) const;
 
  private:
   // define patterns
@@ -75,6 +77,12 @@ class MultiHeadAttentionFusion : public MultiplePatternProcessPass {
   mutable VarPtr bias_o_{nullptr};
 
   mutable VarPtr mask_{nullptr};
+  // the constants of the masking ops: Mul(Sub(mask_sub_value, ExpandDims(mask)), mask_mul_value)
+  mutable VarPtr mask_sub_value_{nullptr};
+  mutable VarPtr mask_mul_value_{nullptr};
+  // the divisors of q and k: RealDiv(q, div_q), RealDiv(k, div_k)
+  mutable VarPtr div_q_{nullptr};
+  mutable VarPtr div_k_{nullptr};
 
   mutable VarPtr reshape_k_{nullptr};
   mutable VarPtr reshape_v_{nullptr};
@@ -0,0 +1,172 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import re
+import time
+import tempfile
+import multiprocessing
+import numpy as np
+import pytest
+from mindspore import context, ops, nn, Tensor
+
+
+class NetBranches(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.relu = ops.ReLU()
+        self.add = ops.Add()
+        self.matmul = ops.MatMul()
+
+    def construct(self, input_x, input_y):
+        output1 = self.relu(input_x)
+        output2 = self.matmul(input_y, input_y)
+        output3 = self.matmul(input_y, input_y)
+        for _ in range(50):
+            output1 = self.add(output1, 1)
+        output2 = self.matmul(output2, input_y)
+        output3 = self.matmul(output3, input_y)
+        return output1, output2 + output3
+
+
+def run_step_latency(inputs, expect_outputs, is_cost_guided_fusion, profile_file, log_file, result_queue):
+    """Run the net in a new process and put the average step latency in milliseconds after the warm-up step."""
+    if log_file is not None:
+        log_fd = os.open(log_file, os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+        os.dup2(log_fd, 2)
+    if is_cost_guided_fusion:
+        os.environ['MS_DEV_COST_GUIDED_ACTOR_FUSION'] = "1"
+        os.environ['MS_DEV_COST_GUIDED_ACTOR_FUSION_PROFILE'] = profile_file
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    net = NetBranches()
+    total_time = 0
+    total_count = 0
+    for i in range(100):
+        time1 = time.time()
+        outputs = net(*[Tensor(x) for x in inputs])
+        time2 = time.time()
+        # The launch time is profiled in the step 30 when the actor set has no launch profile.
+        if i >= 30:
+            total_count += 1
+            total_time += (time2 - time1) * 1000
+        for output, expect_output in zip(outputs, expect_outputs):
+            assert np.allclose(output.asnumpy(), expect_output)
+    result_queue.put(total_time / total_count)
+
+
+def run_in_process(inputs, expect_outputs, is_cost_guided_fusion, profile_file, log_file=None):
+    """The graph ids and actor names of the net are the same in the new processes, which match the launch profile. The
+    info logs of the new process are written to the log file if it is given."""
+    ctx = multiprocessing.get_context("spawn")
+    result_queue = ctx.Queue()
+    process = ctx.Process(target=run_step_latency,
+                          args=(inputs, expect_outputs, is_cost_guided_fusion, profile_file, log_file, result_queue))
+    # The log level is read when the new process imports mindspore.
+    log_envs = {'GLOG_v': '1', 'GLOG_logtostderr': '1'} if log_file is not None else {}
+    old_envs = {key: os.environ.get(key) for key in log_envs}
+    os.environ.update(log_envs)
+    try:
+        process.start()
+    finally:
+        for key, value in old_envs.items():
+            if value is None:
+                os.environ.pop(key)
+            else:
+                os.environ[key] = value
+    process.join()
+    assert process.exitcode == 0
+    return result_queue.get()
+
+
+def write_profile(profile, profile_file, launch_time, dispatch_cost):
+    """Write the recorded launch profile with the given launch time of all the kernels and the dispatch cost."""
+    with open(profile_file, "w") as f:
+        for actor_set_name, actor_name, _ in profile:
+            cost = dispatch_cost if actor_name == "#dispatch_cost" else launch_time
+            f.write("{}\t{}\t{}\n".format(actor_set_name, actor_name, cost))
+
+
+def get_fused_actors_num(log_file):
+    """Get the number of kernel actors fused by the cost guided fusion from the info logs, 0 if the fusion isn't
+    applied."""
+    with open(log_file) as f:
+        logs = f.read()
+    fused_nums = re.findall(r"The cost guided fusion of actor set \S+ fuses (\d+) kernel actors", logs)
+    assert len(fused_nums) <= 1
+    if not fused_nums:
+        assert "doesn't shorten the critical path" in logs
+        return 0
+    return int(fused_nums[0])
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cost_guided_actor_fusion():
+    """
+    Feature: Cost guided actor fusion.
+    Description: Run the net with the cheap serial kernels and the expensive concurrent kernels by the structural
+        fusion, then profile the launch time in one process and fuse the kernel actors by the profile in the
+        transform of the next process.
+    Expectation: The launch profile is recorded, and the value and shape of outputs are the expected values.
+    """
+    input_x = np.ones(2).astype(np.float32)
+    input_y = np.random.rand(256, 256).astype(np.float32) / 256
+    expect_y = np.matmul(np.matmul(input_y, input_y), input_y)
+    expect = (np.array([51, 51]), expect_y * 2)
+    profile_file = os.path.join(tempfile.mkdtemp(), "launch_profile.txt")
+    structural_fusion_time = run_in_process((input_x, input_y), expect, False, profile_file)
+    profile_time = run_in_process((input_x, input_y), expect, True, profile_file)
+    assert os.path.exists(profile_file)
+    cost_guided_fusion_time = run_in_process((input_x, input_y), expect, True, profile_file)
+    print("structural fusion avg_time:", structural_fusion_time, ", profile avg_time:", profile_time,
+          ", cost guided fusion avg_time:", cost_guided_fusion_time)
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cost_guided_actor_fusion_by_profile():
+    """
+    Feature: Cost guided actor fusion.
+    Description: Record the launch profile of the net, then rewrite the launch time of the kernels and the dispatch cost
+        in the profile, and fuse the kernel actors by the rewritten profiles in the new processes.
+    Expectation: The serial Add kernel actors are fused when the dispatch cost dominates the launch time, and no actor
+        is fused when the dispatch cost is zero.
+    """
+    input_x = np.ones(2).astype(np.float32)
+    input_y = np.random.rand(256, 256).astype(np.float32) / 256
+    expect_y = np.matmul(np.matmul(input_y, input_y), input_y)
+    expect = (np.array([51, 51]), expect_y * 2)
+    temp_dir = tempfile.mkdtemp()
+    profile_file = os.path.join(temp_dir, "launch_profile.txt")
+    run_in_process((input_x, input_y), expect, True, profile_file)
+    with open(profile_file) as f:
+        profile = [line.rstrip("\n").split("\t") for line in f if line.strip()]
+    assert any("Add" in actor_name for _, actor_name, _ in profile)
+
+    # The chain of Add kernels is the critical path when all the kernels are cheap.
+    cheap_profile_file = os.path.join(temp_dir, "cheap_launch_profile.txt")
+    write_profile(profile, cheap_profile_file, 1e-7, 1e-5)
+    cheap_log_file = os.path.join(temp_dir, "cheap.log")
+    run_in_process((input_x, input_y), expect, True, cheap_profile_file, cheap_log_file)
+
+    free_dispatch_profile_file = os.path.join(temp_dir, "free_dispatch_launch_profile.txt")
+    write_profile(profile, free_dispatch_profile_file, 1e-7, 0)
+    free_dispatch_log_file = os.path.join(temp_dir, "free_dispatch.log")
+    run_in_process((input_x, input_y), expect, True, free_dispatch_profile_file, free_dispatch_log_file)
+
+    # The 50 serial Add kernels are fused at least.
+    assert get_fused_actors_num(cheap_log_file) >= 50
+    assert get_fused_actors_num(free_dispatch_log_file) == 0
@@ -0,0 +1,74 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import os
+import numpy as np
+import pytest
+import mindspore
+from mindspore import context, ops, nn, Tensor
+
+
+class NetDynamicShape(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.relu = ops.ReLU()
+        self.add = ops.Add()
+        self.mul = ops.Mul()
+
+    def construct(self, input_x, input_y):
+        output = self.relu(input_x)
+        for _ in range(10):
+            output = self.add(output, input_y)
+            output = self.mul(output, 0.5)
+        return output, self.relu(input_y)
+
+
+def run_multi_shapes(shapes, is_dynamic_memory_plan):
+    """Run the dynamic shape net with the alternate input shapes and check the outputs."""
+    if is_dynamic_memory_plan:
+        os.environ['MS_DEV_DYNAMIC_MEMORY_PLAN'] = "1"
+    try:
+        net = NetDynamicShape()
+        dynamic_input = Tensor(shape=[None, None], dtype=mindspore.float32)
+        net.set_inputs(dynamic_input, dynamic_input)
+        for _ in range(5):
+            for shape in shapes:
+                input_x_np = np.random.randn(*shape).astype(np.float32)
+                input_y_np = np.random.randn(*shape).astype(np.float32)
+                expect = np.maximum(input_x_np, 0)
+                for _ in range(10):
+                    expect = (expect + input_y_np) * 0.5
+                outputs = net(Tensor(input_x_np), Tensor(input_y_np))
+                assert outputs[0].shape == shape
+                assert np.allclose(outputs[0].asnumpy(), expect, 1e-4, 1e-4)
+                assert np.allclose(outputs[1].asnumpy(), np.maximum(input_y_np, 0))
+    finally:
+        os.environ.pop('MS_DEV_DYNAMIC_MEMORY_PLAN', None)
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_dynamic_memory_plan():
+    """
+    Feature: Dynamic memory plan.
+    Description: Run the dynamic shape net with the alternate input shapes, the kernel memory is recorded in the first
+        step of each shape and served by the memory plan in the following steps.
+    Expectation: The value and shape of outputs are the expected values.
+    """
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    shapes = [(2, 3), (16, 32), (2, 3), (128, 64)]
+    run_multi_shapes(shapes, False)
+    run_multi_shapes(shapes, True)
@@ -0,0 +1,126 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import time
+import numpy as np
+import pytest
+import mindspore
+from mindspore import context, ops, nn, Tensor
+
+
+class NetSerial(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.relu = ops.ReLU()
+        self.add = ops.Add()
+
+    def construct(self, input_x):
+        output = self.relu(input_x)
+        for _ in range(200):
+            output = self.add(output, 1)
+        return output
+
+
+class NetBranches(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.relu = ops.ReLU()
+        self.add = ops.Add()
+
+    def construct(self, input_x1, input_x2, input_x3, input_x4):
+        output1 = self.relu(input_x1)
+        output2 = self.relu(input_x2)
+        output3 = self.relu(input_x3)
+        output4 = self.relu(input_x4)
+        for _ in range(50):
+            output1 = self.add(output1, 1)
+            output2 = self.add(output2, 1)
+            output3 = self.add(output3, 1)
+            output4 = self.add(output4, 1)
+        output = output1 + output2 + output3 + output4
+        return output
+
+
+def run_steps(net_class, inputs_list, schedule_mode):
+    """Run the net with the static schedule mode step by step, return the outputs and the average step latency in
+    milliseconds."""
+    os.environ['MS_DEV_STATIC_SCHEDULE'] = schedule_mode
+    try:
+        net = net_class()
+        outputs = []
+        total_time = 0
+        total_count = 0
+        for i, inputs in enumerate(inputs_list):
+            time1 = time.time()
+            outputs.append(net(*inputs).asnumpy())
+            time2 = time.time()
+            if i > 1:
+                total_count += 1
+                total_time += (time2 - time1) * 1000
+    finally:
+        os.environ.pop('MS_DEV_STATIC_SCHEDULE')
+    return outputs, total_time / total_count
+
+
+def compare_with_default_schedule(net_name, net_class, inputs, expect_func):
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    # The first step uses the given inputs, and the others use the random inputs.
+    np.random.seed(1)
+    inputs_list = [inputs]
+    for _ in range(199):
+        inputs_list.append(tuple(Tensor(np.random.randn(*x.shape).astype(np.float32)) for x in inputs))
+    actor_outputs, actor_time = run_steps(net_class, inputs_list, "0")
+    in_order_outputs, in_order_time = run_steps(net_class, inputs_list, "1")
+    by_level_outputs, by_level_time = run_steps(net_class, inputs_list, "2")
+    assert len(actor_outputs) == len(in_order_outputs) == len(by_level_outputs) == len(inputs_list)
+    for step_inputs, actor_output, in_order_output, by_level_output in zip(inputs_list, actor_outputs,
+                                                                            in_order_outputs, by_level_outputs):
+        expect_output = expect_func(*(x.asnumpy() for x in step_inputs))
+        assert np.allclose(actor_output, expect_output, rtol=1e-5, atol=1e-5)
+        assert actor_output.shape == in_order_output.shape == by_level_output.shape
+        assert np.array_equal(actor_output, in_order_output)
+        assert np.array_equal(actor_output, by_level_output)
+    print(net_name + " actor avg_time:", actor_time, ", static schedule in order avg_time:", in_order_time,
+          ", static schedule by level avg_time:", by_level_time)
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_static_schedule_serial():
+    """
+    Feature: Static schedule of kernel actors.
+    Description: Run the serial net by the actor messages and the static schedule, and compare the step latency.
+    Expectation: The outputs of the actor messages are equal to the numpy results, and the outputs of the static
+        schedule are equal to the outputs of the actor messages in every step.
+    """
+    input_x = Tensor(np.ones(2), mindspore.float32)
+    compare_with_default_schedule("serial", NetSerial, (input_x,), lambda x: np.maximum(x, 0) + 200)
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_static_schedule_branches():
+    """
+    Feature: Static schedule of kernel actors.
+    Description: Run the net with concurrent branches by the actor messages and the static schedule, and compare the
+        step latency.
+    Expectation: The outputs of the actor messages are equal to the numpy results, and the outputs of the static
+        schedule are equal to the outputs of the actor messages in every step.
+    """
+    input_x = Tensor(np.ones(2), mindspore.float32)
+    compare_with_default_schedule("branches", NetBranches, (input_x, input_x, input_x, input_x),
+                                  lambda *xs: sum(np.maximum(x, 0) + 50 for x in xs))
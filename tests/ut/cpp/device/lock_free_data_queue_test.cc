@@ -0,0 +1,141 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/data_queue/blocking_queue.h"
+#include "runtime/data_queue/lock_free_data_queue.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The ring data queue without the lock, which is protected by the mutex of blocking queue.
+class RingDataQueue : public DataQueue {
+ public:
+  explicit RingDataQueue(const size_t capacity) : DataQueue(capacity, nullptr), slots_(capacity) {}
+  ~RingDataQueue() override = default;
+
+  BlockQueueStatus_T Push(std::vector<DataQueueItem> data) override {
+    slots_[tail_] = data;
+    tail_ = (tail_ + 1) % capacity_;
+    ++size_;
+    return SUCCESS;
+  }
+  BlockQueueStatus_T Front(std::vector<DataQueueItem> *data) const override {
+    for (auto &item : slots_[head_]) {
+      host_release_(item.data_ptr_, item.worker_id_);
+    }
+    *data = slots_[head_];
+    return SUCCESS;
+  }
+  BlockQueueStatus_T Pop() override {
+    head_ = (head_ + 1) % capacity_;
+    --size_;
+    return SUCCESS;
+  }
+  bool Destroy() override { return true; }
+
+ private:
+  std::vector<std::vector<DataQueueItem>> slots_;
+};
+
+// Push the items by one thread and pop them by another thread, return the number of items per second.
+double RunProducerConsumer(const std::shared_ptr<DataQueue> &data_queue, size_t item_num,
+                           std::atomic<size_t> *release_num) {
+  BlockingQueue queue;
+  (void)queue.Create(data_queue);
+  queue.RegisterRelease([release_num](void *, int32_t) { ++(*release_num); });
+  std::vector<int64_t> values(item_num);
+  auto start_time = std::chrono::steady_clock::now();
+  std::thread producer([&queue, &values]() {
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = SizeToLong(i);
+      DataQueueItem item;
+      item.data_ptr_ = &values[i];
+      item.data_len_ = sizeof(int64_t);
+      std::vector<DataQueueItem> data = {item};
+      while (queue.Push(data, 0) == TIMEOUT) {
+      }
+    }
+  });
+  bool is_ordered = true;
+  for (size_t i = 0; i < item_num; ++i) {
+    std::vector<DataQueueItem> data;
+    if (queue.Front(&data) != SUCCESS || data.size() != 1 ||
+        *static_cast<int64_t *>(data[0].data_ptr_) != SizeToLong(i)) {
+      is_ordered = false;
+    }
+    (void)queue.Pop();
+  }
+  producer.join();
+  auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  EXPECT_TRUE(is_ordered);
+  return item_num / cost;
+}
+}  // namespace
+
+class TestLockFreeDataQueue : public UT::Common {
+ public:
+  TestLockFreeDataQueue() = default;
+};
+
+/// Feature: Lock free data queue.
+/// Description: Push and pop the items of lock free data queue by the single producer and single consumer.
+/// Expectation: The items are popped in the pushed order and the release callback is called for each item.
+TEST_F(TestLockFreeDataQueue, test_single_producer_single_consumer) {
+  const size_t capacity = 2;
+  const size_t item_num = 10000;
+  auto data_queue = std::make_shared<LockFreeDataQueue>(capacity, nullptr);
+  ASSERT_TRUE(data_queue->IsEmpty());
+  std::atomic<size_t> release_num(0);
+  (void)RunProducerConsumer(data_queue, item_num, &release_num);
+  EXPECT_EQ(item_num, release_num);
+  EXPECT_TRUE(data_queue->IsEmpty());
+}
+
+/// Feature: Benchmark of the data queue throughput.
+/// Description: Push and pop the items by the lock free data queue and the data queue locked by the blocking queue.
+/// Expectation: All the items are popped in order, and the lock free data queue is not slower than the locked one
+/// beyond the tolerance of the timing noise.
+TEST_F(TestLockFreeDataQueue, test_data_queue_throughput) {
+  const size_t capacity = 16;
+  const size_t item_num = 200000;
+  // The best of several rounds is compared to reduce the noise of the thread scheduling.
+  const size_t round_num = 3;
+  const double tolerance = 0.5;
+  std::atomic<size_t> release_num(0);
+  double locked_throughput = 0;
+  double lock_free_throughput = 0;
+  for (size_t i = 0; i < round_num; ++i) {
+    locked_throughput = std::max(
+      locked_throughput, RunProducerConsumer(std::make_shared<RingDataQueue>(capacity), item_num, &release_num));
+    lock_free_throughput =
+      std::max(lock_free_throughput,
+               RunProducerConsumer(std::make_shared<LockFreeDataQueue>(capacity, nullptr), item_num, &release_num));
+  }
+  EXPECT_EQ(item_num * 2 * round_num, release_num);
+  MS_LOG(INFO) << "The throughput of locked data queue: " << locked_throughput
+               << " items/s, lock free data queue: " << lock_free_throughput << " items/s";
+  EXPECT_GT(locked_throughput, 0);
+  EXPECT_GT(lock_free_throughput, locked_throughput * tolerance);
+}
+}  // namespace device
+}  // namespace mindspore
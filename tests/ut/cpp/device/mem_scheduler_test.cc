@@ -14,8 +14,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
 #include <vector>
 #include <map>
+#include <utility>
 #include "common/common_test.h"
 #include "runtime/device/memory_scheduler.h"
 namespace mindspore::device {
@@ -35,7 +40,12 @@ class MemoryManagerStub : public MemoryManager {
     if (device_virtual_count_ >= kDeviceMemSize) {
       return nullptr;
     }
-    auto ret = device_mem_.data() + device_virtual_count_;
+    // Use the first free slot, so that the memory in use is never handed out twice.
+    size_t slot = 0;
+    while (device_mem_size_.count(device_mem_.data() + slot) != 0) {
+      ++slot;
+    }
+    auto ret = device_mem_.data() + slot;
     ++device_virtual_count_;
     device_mem_size_.emplace(ret, mem_size);
     return ret;
@@ -55,8 +65,15 @@ class MemoryManagerStub : public MemoryManager {
     if (device_virtual_count_ + total_size > kDeviceMemSize) {
       return ret;
     }
+    // Find the first free slots which are continuous.
+    size_t start = 0;
+    for (size_t end = 0; end - start < size_list.size(); ++end) {
+      if (device_mem_size_.count(device_mem_.data() + end) != 0) {
+        start = end + 1;
+      }
+    }
     for (const auto &size : size_list) {
-      auto ptr = device_mem_.data() + device_virtual_count_;
+      auto ptr = device_mem_.data() + start + ret.size();
       device_mem_size_.emplace(ptr, size);
       ret.emplace_back(ptr);
       ++device_virtual_count_;
@@ -64,19 +81,48 @@ class MemoryManagerStub : public MemoryManager {
     return ret;
   }
 
-  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override {}
+  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override {
+    (void)memcpy(device_ptr, host_ptr, mem_size);
+    swap_in_streams_.emplace_back(stream);
+  }
 
-  void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) override {}
+  void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) override {
+    (void)memcpy(host_ptr, device_ptr, mem_size);
+  }
 
  protected:
   uint8_t *MallocStaticMem(size_t size, bool communication_mem, uint32_t graph_id) { return nullptr; }
 
+ public:
+  // The streams of the swap in in the issued order.
+  std::vector<void *> swap_in_streams_;
+
  private:
   std::vector<uint8_t> device_mem_;
   size_t device_virtual_count_{0};
   std::map<void *, size_t> device_mem_size_;
 };
 
+// The event which records the order of waiting and recording, e.g. "record kernel_event" and "wait prefetch_event".
+class DeviceEventStub : public DeviceEvent {
+ public:
+  DeviceEventStub(const std::string &name, std::vector<std::pair<std::string, void *>> *trace)
+      : name_(name), trace_(trace) {}
+  void WaitEvent() override { trace_->emplace_back("wait " + name_, wait_stream_); }
+  void RecordEvent() override { trace_->emplace_back("record " + name_, record_stream_); }
+  bool NeedWait() override { return false; }
+  void SyncEvent() override {}
+  void ElapsedTime(float *cost_time, const DeviceEvent *other) override {}
+  void set_wait_stream(void *stream) override { wait_stream_ = stream; }
+  void set_record_stream(void *stream) override { record_stream_ = stream; }
+
+ private:
+  std::string name_;
+  std::vector<std::pair<std::string, void *>> *trace_;
+  void *wait_stream_{nullptr};
+  void *record_stream_{nullptr};
+};
+
 class TestMemScheduler : public UT::Common {
  public:
   TestMemScheduler() {}
@@ -104,8 +150,7 @@ class TestMemScheduler : public UT::Common {
     scheduler->set_need_record_event(false);
   }
 
-  void Run(const std::shared_ptr<MemScheduler> &scheduler) {
-    void *stream = nullptr;
+  void Run(const std::shared_ptr<MemScheduler> &scheduler, void *stream = nullptr) {
     scheduler->Reset();
     scheduler->Update();
     for (auto index : init_tensors_) {
@@ -121,6 +166,38 @@ class TestMemScheduler : public UT::Common {
       scheduler->PostCompute(stream);
     }
   }
+
+  // Each step checks the value of the tensors used before and writes the tensors used for the first time, so the
+  // data is kept through the swap out, swap in and prefetch.
+  void RunAndCheckData(const std::shared_ptr<MemScheduler> &scheduler, void *stream, uint8_t run_id) {
+    scheduler->Reset();
+    scheduler->Update();
+    std::vector<bool> written(used_tensor_num_, false);
+    std::vector<uint8_t> expect_values(used_tensor_num_, 0);
+    scheduler->ClearMemNeedInit();
+    for (auto index : init_tensors_) {
+      tensor_datas_[index] = static_cast<uint8_t>(run_id * used_tensor_num_ + index + 1);
+      expect_values[index] = tensor_datas_[index];
+      written[index] = true;
+      scheduler->AddMemNeedInit(tensor_keys_.data() + index);
+      scheduler->Init(tensor_keys_.data() + index, tensor_datas_.data() + index, 1, kMemPriorityHigh);
+    }
+    for (size_t i = 0; i < total_step_; ++i) {
+      scheduler->PreCompute(stream);
+      for (auto j : step_used_tensors_[i]) {
+        auto addr = static_cast<uint8_t *>(scheduler->GetOrMalloc(tensor_keys_.data() + j, 1));
+        ASSERT_NE(addr, nullptr);
+        if (written[j]) {
+          ASSERT_EQ(*addr, expect_values[j]) << "step " << i << ", tensor " << j;
+        } else {
+          expect_values[j] = static_cast<uint8_t>(run_id * used_tensor_num_ + j + 1);
+          *addr = expect_values[j];
+          written[j] = true;
+        }
+      }
+      scheduler->PostCompute(stream);
+    }
+  }
 };
 
 /// Feature: MemSchedulerManager
@@ -183,6 +260,114 @@ TEST_F(TestMemScheduler, test_mem_scheduler) {
   Run(scheduler);
 }
 
+/// Feature: MemScheduler prefetch
+/// Description: Run MemScheduler with the stream which enables the prefetch and the offload by next use distance
+/// Expectation: the data of each tensor is kept, and the memory used in the next steps is prefetched and hit
+TEST_F(TestMemScheduler, test_mem_scheduler_prefetch) {
+  MemSchedulerManager mem_scheduler_manager;
+  auto scheduler = mem_scheduler_manager.GetOrCreateMemScheduler(0);
+  ASSERT_NE(scheduler, nullptr);
+  std::shared_ptr<MemHandler> mem_handler = std::make_shared<MemHandler>(std::make_shared<MemoryManagerStub>());
+  ASSERT_NE(mem_handler, nullptr);
+  scheduler->SetMemHandler(mem_handler);
+
+  // input data
+  used_tensor_num_ = 10;
+  total_step_ = 8;
+  std::vector<uint8_t> tensor_keys(used_tensor_num_, 0);
+  std::vector<uint8_t> tensor_datas(used_tensor_num_, 0);
+  std::vector<size_t> init_tensors = {0, 2, 4};
+  std::vector<std::vector<size_t>> step_used_tensors = {{0, 1},    {1, 2, 3}, {3, 4, 5}, {5, 6},
+                                                        {4, 6, 7}, {3, 7, 8}, {2, 8, 9}, {1, 9}};
+  tensor_keys_.swap(tensor_keys);
+  tensor_datas_.swap(tensor_datas);
+  init_tensors_.swap(init_tensors);
+  step_used_tensors_.swap(step_used_tensors);
+  scheduler->SetTotalStep(total_step_);
+
+  // record
+  Record(scheduler);
+  // optimize
+  scheduler->Optimize();
+  // run with the fake stream for several times, tensor 1 is swapped out after step 1, and it is prefetched after
+  // step 6 with the memory of tensor 3 and 7 freed by step 5, which is hit by step 7
+  uint8_t stream = 0;
+  for (uint8_t run_id = 0; run_id < 3; ++run_id) {
+    RunAndCheckData(scheduler, &stream, run_id);
+    const auto &statistics = scheduler->statistics();
+    ASSERT_GT(statistics.prefetch_count_, 0);
+    ASSERT_EQ(statistics.prefetch_count_, 1);
+    ASSERT_EQ(statistics.prefetch_hit_count_, 1);
+    const auto &step_statistics = scheduler->step_statistics();
+    ASSERT_EQ(step_statistics.size(), total_step_);
+    ASSERT_EQ(step_statistics[6].prefetch_count_, 1);
+    ASSERT_EQ(step_statistics[7].prefetch_hit_count_, 1);
+  }
+}
+
+/// Feature: MemScheduler prefetch on the copy stream
+/// Description: Run MemScheduler with the copy stream and the events which synchronize it with the kernel stream
+/// Expectation: the prefetch is issued on the copy stream after waiting for the kernels launched before, and the
+/// kernel of the next step waits for the prefetch before using the memory
+TEST_F(TestMemScheduler, test_mem_scheduler_prefetch_copy_stream) {
+  MemSchedulerManager mem_scheduler_manager;
+  auto scheduler = mem_scheduler_manager.GetOrCreateMemScheduler(0);
+  ASSERT_NE(scheduler, nullptr);
+  auto memory_manager = std::make_shared<MemoryManagerStub>();
+  scheduler->SetMemHandler(std::make_shared<MemHandler>(memory_manager));
+  uint8_t stream = 0;
+  uint8_t copy_stream = 0;
+  std::vector<std::pair<std::string, void *>> trace;
+  scheduler->SetPrefetchStream(&copy_stream, std::make_shared<DeviceEventStub>("kernel_event", &trace),
+                               std::make_shared<DeviceEventStub>("prefetch_event", &trace));
+
+  // input data
+  used_tensor_num_ = 10;
+  total_step_ = 8;
+  std::vector<uint8_t> tensor_keys(used_tensor_num_, 0);
+  std::vector<uint8_t> tensor_datas(used_tensor_num_, 0);
+  std::vector<size_t> init_tensors = {0, 2, 4};
+  std::vector<std::vector<size_t>> step_used_tensors = {{0, 1},    {1, 2, 3}, {3, 4, 5}, {5, 6},
+                                                        {4, 6, 7}, {3, 7, 8}, {2, 8, 9}, {1, 9}};
+  tensor_keys_.swap(tensor_keys);
+  tensor_datas_.swap(tensor_datas);
+  init_tensors_.swap(init_tensors);
+  step_used_tensors_.swap(step_used_tensors);
+  scheduler->SetTotalStep(total_step_);
+
+  // record
+  Record(scheduler);
+  // optimize
+  scheduler->Optimize();
+  for (uint8_t run_id = 0; run_id < 3; ++run_id) {
+    trace.clear();
+    memory_manager->swap_in_streams_.clear();
+    RunAndCheckData(scheduler, &stream, run_id);
+    const auto &statistics = scheduler->statistics();
+    ASSERT_EQ(statistics.prefetch_count_, 1);
+    ASSERT_EQ(statistics.prefetch_hit_count_, 1);
+    // Only the prefetch is issued on the copy stream.
+    ASSERT_EQ(std::count(memory_manager->swap_in_streams_.begin(), memory_manager->swap_in_streams_.end(),
+                         static_cast<void *>(&copy_stream)),
+              1);
+    // The kernel event is recorded on the kernel stream before each launch and waited by the copy stream before the
+    // prefetch, the prefetch event is recorded on the copy stream once and waited by the kernel stream of step 7.
+    std::vector<std::pair<std::string, void *>> prefetch_trace;
+    std::copy_if(trace.begin(), trace.end(), std::back_inserter(prefetch_trace),
+                 [](const auto &item) { return item.first.find("prefetch_event") != std::string::npos; });
+    std::vector<std::pair<std::string, void *>> expect_prefetch_trace = {{"record prefetch_event", &copy_stream},
+                                                                         {"wait prefetch_event", &stream}};
+    ASSERT_EQ(prefetch_trace, expect_prefetch_trace);
+    auto record_iter = std::find(trace.begin(), trace.end(), expect_prefetch_trace[0]);
+    ASSERT_NE(record_iter, trace.begin());
+    ASSERT_EQ(*(record_iter - 1), std::make_pair(std::string("wait kernel_event"), static_cast<void *>(&copy_stream)));
+    ASSERT_EQ(std::count(trace.begin(), trace.end(),
+                         std::make_pair(std::string("record kernel_event"), static_cast<void *>(&stream))),
+              total_step_);
+    ASSERT_EQ(trace.back(), std::make_pair(std::string("record kernel_event"), static_cast<void *>(&stream)));
+  }
+}
+
 /// Feature: MemScheduler
 /// Description: Test MemScheduler interface
 /// Expectation: MemScheduler GetOrMalloc return valid ptr
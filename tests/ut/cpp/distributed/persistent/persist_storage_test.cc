@@ -16,6 +16,10 @@
 
 #include "common/common_test.h"
 
+#include <dirent.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <map>
 #include <vector>
@@ -27,13 +31,36 @@
 namespace mindspore {
 namespace distributed {
 namespace persistent {
+namespace {
+// The storages in the tests only create files in the folder.
+void RemoveStorageDir(const std::string &dir_path) {
+  DIR *dir = opendir(dir_path.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string file_name = entry->d_name;
+    if (file_name != "." && file_name != "..") {
+      (void)std::remove((dir_path + "/" + file_name).c_str());
+    }
+  }
+  (void)closedir(dir);
+  (void)rmdir(dir_path.c_str());
+}
+}  // namespace
+
 class TestPersistStorage : public UT::Common {
  public:
   TestPersistStorage() = default;
   virtual ~TestPersistStorage() = default;
 
   void SetUp() override {}
-  void TearDown() override {}
+  void TearDown() override {
+    for (const auto &storage_dir : {"./storage", "./async_log_storage", "./async_log_storage_recovery"}) {
+      RemoveStorageDir(storage_dir);
+    }
+  }
 };
 
 /// Feature: test parameter persistent storage and resotre.
@@ -98,6 +125,120 @@ TEST_F(TestPersistStorage, test_embedding_storage) {
     EXPECT_EQ(data[i], embdding_table_data->at(i));
   }
 }
+
+/// Feature: test parameter persistent storage with asynchronous log segments.
+/// Description: Persist the Embedding table and its dirty rows many times with small chunks and segments, so that the
+/// log segments are rolled and compacted, then restore it by a new storage.
+/// Expectation: The content after persistent recovery is consistent with expectations.
+TEST_F(TestPersistStorage, test_embedding_async_log_storage) {
+  int vocab = 1000;
+  int emb_dim = 16;
+  int total_dim = vocab * emb_dim;
+
+  std::shared_ptr<std::vector<int>> embedding_shape = std::make_shared<std::vector<int>>();
+  embedding_shape->push_back(vocab);
+  embedding_shape->push_back(emb_dim);
+  auto data_ptr = std::make_shared<std::vector<int>>(total_dim, 1);
+  PersistentData<int> embedding_table(data_ptr, embedding_shape);
+
+  std::string storage_file_path = "./async_log_storage";
+  if (!distributed::storage::FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    distributed::storage::FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto ret = FileUtils::GetRealPath(storage_file_path.c_str());
+  if (!ret.has_value()) {
+    MS_LOG(EXCEPTION) << "Cannot get real path of persistent storage file for parameter.";
+  }
+
+  // Each chunk contains 16 rows and each segment contains at most 4 chunks.
+  std::map<std::string, std::string> config_map;
+  config_map[distributed::storage::kFileStoragePath] = ret.value();
+  config_map[distributed::storage::kStorageType] = distributed::storage::kAsyncLogFileStorage;
+  config_map[distributed::storage::kMaxBlockLength] = std::to_string(16 * emb_dim * sizeof(int));
+  config_map[distributed::storage::kMaxSegmentLength] = std::to_string(4 * 16 * emb_dim * sizeof(int) + 256);
+  embedding_table.Initialize(config_map);
+  EXPECT_NO_THROW(embedding_table.Persist(distributed::storage::DirtyInfo()));
+
+  for (int step = 0; step < 20; step++) {
+    distributed::storage::DirtyInfo dirty_info;
+    for (int row = step; row < vocab; row += 7) {
+      dirty_info.push_back(row);
+      for (int i = 0; i < emb_dim; i++) {
+        (*data_ptr)[row * emb_dim + i] = step * vocab + row;
+      }
+    }
+    EXPECT_NO_THROW(embedding_table.Persist(dirty_info));
+  }
+  EXPECT_NO_THROW(embedding_table.Flush());
+
+  auto restored_data_ptr = std::make_shared<std::vector<int>>(total_dim, 0);
+  PersistentData<int> restored_table(restored_data_ptr, embedding_shape);
+  restored_table.Initialize(config_map);
+  EXPECT_NO_THROW(restored_table.Restore());
+  EXPECT_EQ(*data_ptr, *restored_data_ptr);
+}
+
+/// Feature: test the recovery of asynchronous log segments.
+/// Description: Persist a new Embedding table into a folder with the stale log segments of another table, then restore
+/// it, and restore it again after corrupting the payload of a record.
+/// Expectation: The new table supersedes the stale segments, and the corrupted record fails the restoration.
+TEST_F(TestPersistStorage, test_embedding_async_log_storage_recovery) {
+  int vocab = 100;
+  int emb_dim = 8;
+  int total_dim = vocab * emb_dim;
+  std::shared_ptr<std::vector<int>> embedding_shape = std::make_shared<std::vector<int>>();
+  embedding_shape->push_back(vocab);
+  embedding_shape->push_back(emb_dim);
+
+  std::string storage_file_path = "./async_log_storage_recovery";
+  if (!distributed::storage::FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    distributed::storage::FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto ret = FileUtils::GetRealPath(storage_file_path.c_str());
+  if (!ret.has_value()) {
+    MS_LOG(EXCEPTION) << "Cannot get real path of persistent storage file for parameter.";
+  }
+  std::map<std::string, std::string> config_map;
+  config_map[distributed::storage::kFileStoragePath] = ret.value();
+  config_map[distributed::storage::kStorageType] = distributed::storage::kAsyncLogFileStorage;
+  config_map[distributed::storage::kMaxBlockLength] = std::to_string(16 * emb_dim * sizeof(int));
+
+  for (int value = 1; value <= 2; value++) {
+    auto data_ptr = std::make_shared<std::vector<int>>(total_dim, value);
+    PersistentData<int> embedding_table(data_ptr, embedding_shape);
+    embedding_table.Initialize(config_map);
+    EXPECT_NO_THROW(embedding_table.Persist(distributed::storage::DirtyInfo()));
+    EXPECT_NO_THROW(embedding_table.Flush());
+  }
+  auto restored_data_ptr = std::make_shared<std::vector<int>>(total_dim, 0);
+  PersistentData<int> restored_table(restored_data_ptr, embedding_shape);
+  restored_table.Initialize(config_map);
+  EXPECT_NO_THROW(restored_table.Restore());
+  EXPECT_EQ(*restored_data_ptr, std::vector<int>(total_dim, 2));
+
+  // Flip the last byte of the segment, which belongs to the payload of its last record. Every persistence writes one
+  // segment here, so the segment of the restored table is one of the first few ones.
+  const size_t max_segment_id = 8;
+  std::string segment_prefix = ret.value() + "/" + distributed::storage::kLogSegmentFilePrefix;
+  std::string segment_file_name;
+  for (size_t segment_id = 0; segment_id < max_segment_id && segment_file_name.empty(); segment_id++) {
+    if (distributed::storage::FileIOUtils::IsFileOrDirExist(segment_prefix + std::to_string(segment_id))) {
+      segment_file_name = segment_prefix + std::to_string(segment_id);
+    }
+  }
+  ASSERT_FALSE(segment_file_name.empty());
+  std::fstream segment(segment_file_name, std::ios::in | std::ios::out | std::ios::binary);
+  segment.seekg(-1, std::ios::end);
+  char last_byte = static_cast<char>(segment.get());
+  segment.seekp(-1, std::ios::end);
+  segment.put(static_cast<char>(last_byte ^ 1));
+  segment.close();
+
+  auto corrupted_data_ptr = std::make_shared<std::vector<int>>(total_dim, 0);
+  PersistentData<int> corrupted_table(corrupted_data_ptr, embedding_shape);
+  corrupted_table.Initialize(config_map);
+  EXPECT_ANY_THROW(corrupted_table.Restore());
+}
 }  // namespace persistent
 }  // namespace distributed
 }  // namespace mindspore
@@ -16,10 +16,14 @@
 
 #include <sys/resource.h>
 #include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <dirent.h>
 #include <atomic>
 #include <string>
 #include <thread>
+#include <chrono>
+#include <vector>
 #include <csignal>
 
 #include <gtest/gtest.h>
@@ -27,6 +31,8 @@
 #include "distributed/rpc/tcp/tcp_server.h"
 #include "distributed/rpc/tcp/tcp_client.h"
 #include "distributed/rpc/tcp/constants.h"
+#include "distributed/rpc/tcp/vectored_message.h"
+#include "distributed/rpc/tcp/recv_buffer_pool.h"
 #include "common/common_test.h"
 
 namespace mindspore {
@@ -328,6 +334,63 @@ TEST_F(TCPTest, SendLargeMessages) {
   server->Finalize();
 }
 
+/// Feature: test sharding connections across multiple event loops.
+/// Description: start a socket server with several event loops and send messages to it from several clients.
+/// Expectation: the server received all the messages and the event loop statistics record the received bytes.
+TEST_F(TCPTest, SendMessagesWithMultipleEventLoops) {
+  Init();
+
+  // Start the tcp server.
+  size_t event_loop_num = 4;
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>(false, event_loop_num);
+  bool ret = server->Initialize();
+  ASSERT_TRUE(ret);
+
+  server->SetMessageHandler([](MessageBase *const message) -> MessageBase *const {
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+  auto server_url = server->GetIP() + ":" + std::to_string(server->GetPort());
+
+  // Start the tcp clients and send messages.
+  auto client_url = "127.0.0.1:1234";
+  size_t client_num = 4;
+  size_t msg_cnt = 10;
+  size_t body_size = 0;
+  std::vector<std::unique_ptr<TCPClient>> clients;
+  for (size_t i = 0; i < client_num; ++i) {
+    auto client = std::make_unique<TCPClient>();
+    ASSERT_TRUE(client->Initialize());
+    ASSERT_TRUE(client->Connect(server_url));
+    for (size_t j = 0; j < msg_cnt; ++j) {
+      auto message = CreateMessage(server_url, client_url);
+      body_size += message->body.size();
+      client->SendAsync(std::move(message));
+    }
+    clients.push_back(std::move(client));
+  }
+
+  // Wait timeout: 10s
+  WaitForDataMsg(client_num * msg_cnt, 10);
+  EXPECT_EQ(client_num * msg_cnt, GetDataMsgNum());
+
+  // The receive and send event loops are both reported.
+  auto statistics = server->GetEventLoopStatistics();
+  EXPECT_EQ(event_loop_num * 2, statistics.size());
+  size_t recv_bytes = 0;
+  for (size_t i = 0; i < event_loop_num; ++i) {
+    recv_bytes += statistics[i].bytes;
+  }
+  EXPECT_EQ(body_size, recv_bytes);
+
+  // Destroy
+  for (auto &client : clients) {
+    client->Disconnect(server_url);
+    client->Finalize();
+  }
+  server->Finalize();
+}
+
 /// Feature: test delete invalid tcp connection used in connection pool in tcp client when some socket error happened.
 /// Description: start a socket server and tcp client pair and stop the tcp server.
 /// Expectation: the connection from the tcp client to the tcp server will be deleted automatically.
@@ -388,6 +451,185 @@ TEST_F(TCPTest, DeleteInvalidConnectionForTcpClient) {
     ASSERT_TRUE(disconnected);
   }
 }
+
+/// Feature: test sending the vectored message.
+/// Description: send a message made up of several segments which refer to the memory of the caller, and a segment
+/// owned by the message.
+/// Expectation: the server receives the contiguous body of all segments, and the completion callback is called once.
+TEST_F(TCPTest, SendVectoredMessage) {
+  Init();
+
+  // Start the tcp server with the receive buffer pool.
+  RecvBufferPool pool;
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(pool.allocate_cb());
+  ASSERT_TRUE(ret);
+
+  std::string received_body;
+  server->SetMessageHandler([&received_body, &pool](MessageBase *const message) -> MessageBase *const {
+    received_body.assign(static_cast<char *>(message->data), message->size);
+    (void)pool.Free(message->data);
+    delete message;
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+
+  // Start the tcp client.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+
+  auto server_url = server->GetIP() + ":" + std::to_string(server->GetPort());
+  client->Connect(server_url);
+
+  std::string segment1(100, 'A');
+  std::string segment2(2000, 'B');
+  std::string segment3(30, 'C');
+  std::vector<MessageSegment> segments = {{const_cast<char *>(segment1.data()), segment1.size()}};
+  std::atomic<int> completion_num(0);
+  std::atomic<bool> send_success(false);
+  auto message = std::make_unique<VectoredMessage>(AID("client", client_url), AID("server", server_url), "testname",
+                                                   std::move(segments), [&](bool success) {
+                                                     send_success = success;
+                                                     ++completion_num;
+                                                   });
+  message->AddSegment(const_cast<char *>(segment2.data()), segment2.size());
+  message->AddOwnedSegment(std::string(segment3));
+  client->SendAsync(std::move(message));
+
+  // Wait timeout: 5s
+  WaitForDataMsg(1, 5);
+  // The completion callback is called by the send event loop, which may be later than the server receives the message.
+  const int retry_num = 50;
+  for (int i = 0; i < retry_num && completion_num == 0; ++i) {
+    usleep(100000);
+  }
+
+  // Check result
+  EXPECT_EQ(1, GetDataMsgNum());
+  EXPECT_EQ(1, completion_num);
+  EXPECT_TRUE(send_success);
+  EXPECT_EQ(segment1 + segment2 + segment3, received_body);
+
+  // Destroy
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
+/// Feature: test the receive buffer pool.
+/// Description: allocate and free buffers of similar sizes repeatedly.
+/// Expectation: the freed buffers are reused by the later allocation.
+TEST_F(TCPTest, RecvBufferPoolReuse) {
+  RecvBufferPool pool;
+  ASSERT_TRUE(pool.Register(5000, 1));
+  EXPECT_EQ(8192, pool.cached_bytes());
+
+  void *buffer1 = pool.Allocate(6000);
+  ASSERT_NE(nullptr, buffer1);
+  EXPECT_EQ(1, pool.hit_count());
+  EXPECT_EQ(0, pool.cached_bytes());
+
+  void *buffer2 = pool.Allocate(100);
+  ASSERT_NE(nullptr, buffer2);
+  EXPECT_EQ(1, pool.miss_count());
+
+  EXPECT_TRUE(pool.Free(buffer1));
+  EXPECT_TRUE(pool.Free(buffer2));
+  EXPECT_FALSE(pool.Free(buffer2));
+
+  void *buffer3 = pool.Allocate(8000);
+  EXPECT_EQ(buffer1, buffer3);
+  EXPECT_EQ(2, pool.hit_count());
+  EXPECT_TRUE(pool.Free(buffer3));
+}
+
+/// Feature: benchmark of the tcp throughput between two local processes.
+/// Description: the child process receives large messages and the parent sends the vectored messages of tensors.
+/// Expectation: all the messages are received, and the throughput is printed.
+TEST_F(TCPTest, VectoredMessageThroughput) {
+  Init();
+  const size_t msg_cnt = 100;
+  const size_t segment_num = 8;
+  const size_t segment_size = 1 << 20;
+  auto server_url = "127.0.0.1:8082";
+
+  // The child process writes one byte to the pipe once its server is able to handle the messages, so that the parent
+  // does not connect before the server starts.
+  int ready_pipe[2];
+  ASSERT_EQ(0, pipe(ready_pipe));
+  pid_t pid = fork();
+  ASSERT_LE(0, pid);
+  if (pid == 0) {
+    (void)close(ready_pipe[0]);
+    RecvBufferPool pool;
+    (void)pool.Register(segment_num * segment_size, 2);
+    std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+    if (!server->Initialize(server_url, pool.allocate_cb())) {
+      _exit(1);
+    }
+    server->SetMessageHandler([&pool](MessageBase *const message) -> MessageBase *const {
+      (void)pool.Free(message->data);
+      delete message;
+      IncrDataMsgNum(1);
+      return NULL_MSG;
+    });
+    char ready = 1;
+    if (write(ready_pipe[1], &ready, sizeof(ready)) != sizeof(ready)) {
+      _exit(1);
+    }
+    (void)close(ready_pipe[1]);
+    bool received = WaitForDataMsg(msg_cnt, 60);
+    server->Finalize();
+    _exit(received ? 0 : 1);
+  }
+
+  // The read returns without data if the child exits before its server starts.
+  (void)close(ready_pipe[1]);
+  char ready = 0;
+  bool server_ready = read(ready_pipe[0], &ready, sizeof(ready)) == sizeof(ready);
+  (void)close(ready_pipe[0]);
+  int status = 0;
+  if (!server_ready) {
+    (void)waitpid(pid, &status, 0);
+  }
+  ASSERT_TRUE(server_ready);
+
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  bool connected = client->Initialize() && client->Connect(server_url);
+  if (!connected) {
+    (void)kill(pid, SIGKILL);
+    (void)waitpid(pid, &status, 0);
+  }
+  ASSERT_TRUE(connected);
+
+  std::vector<std::vector<char>> tensors(segment_num, std::vector<char>(segment_size, 'T'));
+  std::atomic<size_t> completion_num(0);
+  auto start_time = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < msg_cnt; ++i) {
+    std::vector<MessageSegment> segments;
+    for (auto &tensor : tensors) {
+      (void)segments.emplace_back(MessageSegment{tensor.data(), tensor.size()});
+    }
+    auto message = std::make_unique<VectoredMessage>(AID("client", client_url), AID("server", server_url), "tensors",
+                                                     std::move(segments), [&](bool) { ++completion_num; });
+    (void)client->SendSync(std::move(message));
+  }
+  auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  MS_LOG(INFO) << "Sent " << msg_cnt << " messages of " << segment_num * segment_size << " bytes in " << cost
+               << "s, throughput: " << msg_cnt * segment_num * segment_size / cost / (1 << 20) << "MB/s";
+  EXPECT_EQ(msg_cnt, completion_num);
+
+  // Disconnect before the child exits, otherwise the client handles the closed connection at the same time.
+  client->Disconnect(server_url);
+  client->Finalize();
+
+  (void)waitpid(pid, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
@@ -22,6 +22,7 @@
 #include "frontend/operator/ops.h"
 #include "utils/log_adapter.h"
 #include "include/common/debug/draw.h"
+#include "include/common/utils/utils.h"
 #include "utils/label.h"
 
 namespace mindspore {
@@ -762,4 +763,87 @@ TEST_F(TestManager, test_set_edge) {
   ASSERT_EQ(mgr->node_users()[t].front().first, get_item);
 }
 
+/// Feature: Primitive nodes index of manager.
+/// Description: Replace the cnode of one primitive with the cnode of another primitive.
+/// Expectation: The primitive nodes of manager are updated with the replacement.
+TEST_F(TestManager, test_primitive_nodes) {
+  FuncGraphPtr fg = std::make_shared<FuncGraph>();
+  auto x = fg->add_parameter();
+  auto y = fg->add_parameter();
+  auto add = fg->NewCNode({NewValueNode(prim::kPrimScalarAdd), x, y});
+  auto mul = fg->NewCNode({NewValueNode(prim::kPrimScalarMul), add, y});
+  fg->set_output(mul);
+
+  auto mgr = Manage(fg);
+  ASSERT_NE(mgr, nullptr);
+  ASSERT_EQ(mgr->primitive_nodes(prim::kPrimScalarAdd->name()).size(), 1);
+  ASSERT_TRUE(mgr->primitive_nodes(prim::kPrimScalarAdd->name()).contains(add));
+  ASSERT_EQ(mgr->primitive_nodes(prim::kPrimScalarMul->name()).size(), 1);
+  ASSERT_TRUE(mgr->primitive_nodes(prim::kPrimScalarSub->name()).empty());
+
+  auto sub = fg->NewCNode({NewValueNode(prim::kPrimScalarSub), x, y});
+  (void)mgr->Replace(add, sub);
+  ASSERT_TRUE(mgr->primitive_nodes(prim::kPrimScalarAdd->name()).empty());
+  ASSERT_EQ(mgr->primitive_nodes(prim::kPrimScalarSub->name()).size(), 1);
+  ASSERT_TRUE(mgr->primitive_nodes(prim::kPrimScalarSub->name()).contains(sub));
+  ASSERT_EQ(mgr->primitive_nodes(prim::kPrimScalarMul->name()).size(), 1);
+}
+
+/// Feature: Primitive nodes index of manager.
+/// Description: Set the primitive input of a cnode to a clone of its primitive, then to another primitive.
+/// Expectation: The cnode stays indexed by the name of its current primitive.
+TEST_F(TestManager, test_primitive_nodes_set_edge) {
+  FuncGraphPtr fg = std::make_shared<FuncGraph>();
+  auto x = fg->add_parameter();
+  auto y = fg->add_parameter();
+  auto add = fg->NewCNode({NewValueNode(prim::kPrimScalarAdd), x, y});
+  fg->set_output(add);
+
+  auto mgr = Manage(fg);
+  ASSERT_NE(mgr, nullptr);
+  auto cloned_prim = std::make_shared<Primitive>(*prim::kPrimScalarAdd);
+  mgr->SetEdge(add, kAnfPrimitiveIndex, NewValueNode(cloned_prim));
+  ASSERT_EQ(mgr->primitive_nodes(prim::kPrimScalarAdd->name()).size(), 1);
+  ASSERT_TRUE(mgr->primitive_nodes(prim::kPrimScalarAdd->name()).contains(add));
+
+  mgr->SetEdge(add, kAnfPrimitiveIndex, NewValueNode(prim::kPrimScalarSub));
+  ASSERT_TRUE(mgr->primitive_nodes(prim::kPrimScalarAdd->name()).empty());
+  ASSERT_TRUE(mgr->primitive_nodes(prim::kPrimScalarSub->name()).contains(add));
+}
+
+/// Feature: incremental analyses of func graph manager.
+/// Description: change the graph called by the root graph and the free variable used by the inner graph.
+/// Expectation: the used func graphs total and the parent are updated after the changes.
+TEST_F(TestManager, test_incremental_analyses) {
+  FuncGraphPtr inner = std::make_shared<FuncGraph>();
+  FuncGraphPtr root = std::make_shared<FuncGraph>();
+  auto x = root->add_parameter();
+  auto y = inner->add_parameter();
+  auto inner_add = inner->NewCNode({NewValueNode(prim::kPrimScalarAdd), x, y});
+  inner->set_output(inner_add);
+  auto call = root->NewCNode({NewValueNode(inner), x});
+  root->set_output(call);
+
+  auto mgr = Manage(root);
+  ASSERT_NE(mgr, nullptr);
+  ASSERT_TRUE(mgr->func_graphs_used_total(root).contains(inner));
+  ASSERT_EQ(mgr->parent(inner), root);
+  ASSERT_TRUE(mgr->children(root).contains(inner));
+
+  // The inner graph does not use the free variable of the root graph after the edge is changed.
+  mgr->SetEdge(inner_add, 1, y);
+  ASSERT_EQ(mgr->parent(inner), nullptr);
+  ASSERT_TRUE(mgr->children(root).empty());
+  ASSERT_TRUE(mgr->func_graphs_used_total(root).contains(inner));
+
+  // The root graph calls another graph after the call node is replaced.
+  FuncGraphPtr other = std::make_shared<FuncGraph>();
+  auto z = other->add_parameter();
+  other->set_output(other->NewCNode({NewValueNode(prim::kPrimScalarMul), z, z}));
+  auto new_call = root->NewCNode({NewValueNode(other), x});
+  (void)mgr->Replace(call, new_call);
+  ASSERT_TRUE(mgr->func_graphs_used_total(root).contains(other));
+  ASSERT_FALSE(mgr->func_graphs_used_total(root).contains(inner));
+  ASSERT_EQ(mgr->parent(other), nullptr);
+}
 }  // namespace mindspore
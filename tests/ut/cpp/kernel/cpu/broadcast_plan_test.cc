@@ -0,0 +1,101 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class BroadcastPlanTest : public UT::Common {
+ public:
+  BroadcastPlanTest() = default;
+
+  // Check the result of BroadcastPlan against BroadcastIterator, the output is computed in two parts.
+  void CheckWithIterator(const ShapeVector &shape_a, const ShapeVector &shape_b, const ShapeVector &output_shape) {
+    auto size_a = SizeOf(shape_a);
+    auto size_b = SizeOf(shape_b);
+    auto output_size = SizeOf(output_shape);
+    std::vector<int> input_a(size_a);
+    std::vector<int> input_b(size_b);
+    for (size_t i = 0; i < size_a; ++i) {
+      input_a[i] = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < size_b; ++i) {
+      input_b[i] = static_cast<int>(i * kScale);
+    }
+    auto op = [](int x, int y) { return x + y; };
+
+    std::vector<int> expect(output_size);
+    BroadcastIterator iter(shape_a, shape_b, output_shape);
+    iter.SetPos(0);
+    for (size_t i = 0; i < output_size; ++i) {
+      expect[i] = op(input_a[iter.GetInputPosA()], input_b[iter.GetInputPosB()]);
+      iter.GenNextPos();
+    }
+
+    std::vector<int> output(output_size);
+    BroadcastPlan plan(shape_a, shape_b, output_shape);
+    size_t middle = output_size / 3;
+    plan.Compute(input_a.data(), input_b.data(), output.data(), 0, middle, op);
+    plan.Compute(input_a.data(), input_b.data(), output.data(), middle, output_size, op);
+    EXPECT_EQ(output, expect);
+
+    // Split the rows in the middle as well.
+    std::vector<int> split_output(output_size);
+    for (size_t start = 0; start < output_size; start += kSplitSize) {
+      plan.Compute(input_a.data(), input_b.data(), split_output.data(), start,
+                   std::min(start + kSplitSize, output_size), op);
+    }
+    EXPECT_EQ(split_output, expect);
+  }
+
+ private:
+  static constexpr int kScale = 1000;
+  static constexpr size_t kSplitSize = 7;
+};
+
+/// Feature: broadcast plan of cpu kernels.
+/// Description: collapse the dimensions of the inputs with different broadcast patterns.
+/// Expectation: the patterns are classified correctly.
+TEST_F(BroadcastPlanTest, test_broadcast_pattern) {
+  EXPECT_EQ(BroadcastPlan({2, 3, 4}, {2, 3, 4}, {2, 3, 4}).pattern(), BroadcastPlan::Pattern::kSameShape);
+  EXPECT_EQ(BroadcastPlan({2, 3, 4}, {1}, {2, 3, 4}).pattern(), BroadcastPlan::Pattern::kScalar);
+  EXPECT_EQ(BroadcastPlan({2, 3, 4}, {3, 4}, {2, 3, 4}).pattern(), BroadcastPlan::Pattern::kRow);
+  EXPECT_EQ(BroadcastPlan({2, 3, 4}, {2, 3, 1}, {2, 3, 4}).pattern(), BroadcastPlan::Pattern::kColumn);
+  EXPECT_EQ(BroadcastPlan({2, 3, 4}, {2, 1, 4}, {2, 3, 4}).pattern(), BroadcastPlan::Pattern::kGeneral);
+  EXPECT_EQ(BroadcastPlan({2, 1, 4}, {1}, {2, 3, 4}).pattern(), BroadcastPlan::Pattern::kGeneral);
+  EXPECT_EQ(BroadcastPlan({1, 1}, {1}, {1, 1}).pattern(), BroadcastPlan::Pattern::kScalar);
+  EXPECT_EQ(BroadcastPlan({2, 3, 4}, {3, 4}, {2, 3, 4}).shape(), ShapeVector({2, 12}));
+}
+
+/// Feature: broadcast plan of cpu kernels.
+/// Description: compute the element-wise add of the inputs with different broadcast patterns.
+/// Expectation: the results are the same as BroadcastIterator.
+TEST_F(BroadcastPlanTest, test_broadcast_compute) {
+  CheckWithIterator({2, 3, 4}, {2, 3, 4}, {2, 3, 4});
+  CheckWithIterator({1}, {2, 3, 4}, {2, 3, 4});
+  CheckWithIterator({2, 3, 4}, {4}, {2, 3, 4});
+  CheckWithIterator({2, 3, 1}, {2, 3, 4}, {2, 3, 4});
+  CheckWithIterator({2, 1, 4, 1}, {3, 1, 5}, {2, 3, 4, 5});
+  CheckWithIterator({5, 1, 7}, {1, 6, 1}, {5, 6, 7});
+  CheckWithIterator({2, 1, 4}, {1}, {2, 3, 4});
+  CheckWithIterator({3, 4}, {2, 1, 1}, {2, 3, 4});
+  CheckWithIterator({1}, {1}, {1});
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Each block size is timed by 5 runs.
+constexpr size_t kSearchAvgCount = 5;
+constexpr size_t kKernelThreadNum = 2;
+constexpr size_t kLargeCount = 4096;
+constexpr size_t kSmallCount = 100;
+}  // namespace
+
+class ParallelSearchTest : public UT::Common {
+ public:
+  ParallelSearchTest() = default;
+
+  void SetUp() override { pool_ = ThreadPool::CreateThreadPool(kKernelThreadNum); }
+  void TearDown() override {
+    delete pool_;
+    pool_ = nullptr;
+  }
+
+  ThreadPool *pool_{nullptr};
+};
+
+/// Feature: search the block size of ParallelLaunchAutoSearch.
+/// Description: launch two tasks with different counts alternately by one search info, as the kernels calling
+/// ParallelLaunchAutoSearch several times in one Launch do.
+/// Expectation: each task keeps its own search, both searches finish and every element is computed.
+TEST_F(ParallelSearchTest, interleaved_tasks_search_independently) {
+  ASSERT_NE(pool_, nullptr);
+  ParallelSearchInfo search_info;
+  std::vector<float> large(kLargeCount, 0);
+  std::vector<float> small(kSmallCount, 0);
+  auto large_task = [&large](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      large[i] += 1;
+    }
+  };
+  auto small_task = [&small](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      small[i] += 1;
+    }
+  };
+
+  const size_t launch_times = 100;
+  for (size_t i = 0; i < launch_times; ++i) {
+    ParallelLaunchAutoSearch(large_task, kLargeCount, this, &search_info, pool_);
+    ParallelLaunchAutoSearch(small_task, kSmallCount, this, &search_info, pool_);
+  }
+
+  ASSERT_EQ(search_info.search_states.size(), 2);
+  for (const auto &iter : search_info.search_states) {
+    EXPECT_GE(iter.second.search_count, kSearchAvgCount * search_info.max_pow);
+    EXPECT_LT(iter.second.best_pow, search_info.max_pow);
+  }
+  EXPECT_EQ(large, std::vector<float>(kLargeCount, launch_times));
+  EXPECT_EQ(small, std::vector<float>(kSmallCount, launch_times));
+}
+
+/// Feature: search the block size of ParallelLaunchAutoSearch.
+/// Description: launch one task with counts of two buckets alternately.
+/// Expectation: each bucket keeps its own search.
+TEST_F(ParallelSearchTest, count_buckets_search_independently) {
+  ASSERT_NE(pool_, nullptr);
+  ParallelSearchInfo search_info;
+  std::vector<float> data(kLargeCount, 0);
+  auto task = [&data](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      data[i] += 1;
+    }
+  };
+
+  const size_t launch_times = 100;
+  for (size_t i = 0; i < launch_times; ++i) {
+    ParallelLaunchAutoSearch(task, kLargeCount, this, &search_info, pool_);
+    ParallelLaunchAutoSearch(task, kSmallCount, this, &search_info, pool_);
+  }
+
+  ASSERT_EQ(search_info.search_states.size(), 2);
+  for (const auto &iter : search_info.search_states) {
+    EXPECT_GE(iter.second.search_count, kSearchAvgCount * search_info.max_pow);
+  }
+  for (size_t i = 0; i < kLargeCount; ++i) {
+    EXPECT_EQ(data[i], i < kSmallCount ? 2 * launch_times : launch_times);
+  }
+}
+
+/// Feature: share the searched block size by the process-wide tuning cache.
+/// Description: search by one kernel, then launch the same task by another kernel with the same name.
+/// Expectation: the second kernel reuses the searched result without searching again, while another kernel name
+/// starts a new search.
+TEST_F(ParallelSearchTest, cache_reuses_searched_result) {
+  ASSERT_NE(pool_, nullptr);
+  std::vector<float> data(kLargeCount, 0);
+  auto task = [&data](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      data[i] += 1;
+    }
+  };
+
+  ParallelSearchInfo first_info;
+  first_info.kernel_name = "ParallelSearchTestKernel";
+  const size_t launch_times = 100;
+  for (size_t i = 0; i < launch_times; ++i) {
+    ParallelLaunchAutoSearch(task, kLargeCount, this, &first_info, pool_);
+  }
+  ASSERT_EQ(first_info.search_states.size(), 1);
+  const auto &first_state = first_info.search_states.begin()->second;
+  ASSERT_GE(first_state.search_count, kSearchAvgCount * first_info.max_pow);
+
+  ParallelSearchInfo second_info;
+  second_info.kernel_name = "ParallelSearchTestKernel";
+  ParallelLaunchAutoSearch(task, kLargeCount, this, &second_info, pool_);
+  ASSERT_EQ(second_info.search_states.size(), 1);
+  const auto &second_state = second_info.search_states.begin()->second;
+  EXPECT_EQ(second_state.cache_key, first_state.cache_key);
+  EXPECT_EQ(second_state.best_pow, first_state.best_pow);
+  EXPECT_GE(second_state.search_count, kSearchAvgCount * second_info.max_pow);
+
+  ParallelSearchInfo other_info;
+  other_info.kernel_name = "ParallelSearchTestOtherKernel";
+  ParallelLaunchAutoSearch(task, kLargeCount, this, &other_info, pool_);
+  ASSERT_EQ(other_info.search_states.size(), 1);
+  EXPECT_EQ(other_info.search_states.begin()->second.search_count, 1);
+  EXPECT_EQ(data, std::vector<float>(kLargeCount, launch_times + 2));
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <map>
 #include <vector>
 #include "common/common_test.h"
 #include "plugin/device/cpu/kernel/sparse_optimizer_cpu_kernel.h"
@@ -25,6 +26,44 @@ class CommonUtilTest : public UT::Common {
   CommonUtilTest() = default;
 };
 
+namespace {
+// Reduce the gradient with one value per index by thread_num buckets, and compare with the sum of a std::map.
+void CheckBucketReduceSparseGradient(const std::vector<int64_t> &indices, size_t max_index, size_t thread_num) {
+  size_t size = indices.size();
+  std::vector<float> grad(size);
+  std::map<int64_t, float> expect;
+  for (size_t i = 0; i < size; ++i) {
+    grad[i] = static_cast<float>(i % 17);
+    if (indices[i] >= 0 && static_cast<size_t>(indices[i]) < max_index) {
+      expect[indices[i]] += grad[i];
+    }
+  }
+  std::vector<int64_t> unique_indices(size);
+  std::vector<float> summed_grad(size);
+  std::vector<int64_t> tmp_indices(size);
+  std::vector<float> tmp_grad(size);
+  SparseGradient<int64_t> unique_grad({summed_grad.data(), unique_indices.data(), size});
+  SparseGradient<int64_t> workspace_grad({tmp_grad.data(), tmp_indices.data(), size});
+  SparseGradient<int64_t> input_grad({grad.data(), const_cast<int64_t *>(indices.data()), size});
+
+  ReduceSparseGradientParam<int64_t> param;
+  param.input_grad_ = &input_grad;
+  param.workspace_grad_ = &workspace_grad;
+  param.output_grad_ = &unique_grad;
+  param.max_index_ = max_index;
+  param.value_stride_ = 1;
+  SparseOptimizerCpuKernelMod::BucketReduceSparseGradient(param, thread_num);
+
+  ASSERT_EQ(unique_grad.indices_size_, expect.size());
+  size_t i = 0;
+  for (const auto &item : expect) {
+    EXPECT_EQ(unique_grad.indices_[i], item.first);
+    EXPECT_EQ(unique_grad.value_[i], item.second);
+    ++i;
+  }
+}
+}  // namespace
+
 TEST_F(CommonUtilTest, BucketReduceSparseGradient1) {
   // The indices is a vector and the grad is a tensor with shape (6, 2)
   /* 0
@@ -130,5 +169,68 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
     EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
   }
 }
+
+TEST_F(CommonUtilTest, BucketReduceSparseGradient3) {
+  // The indices is a vector with invalid indices and the grad is a tensor with shape (8, 1)
+  std::vector<int64_t> indices{5, -1, 2, 5, 7, 2, 9, 0};
+  std::vector<float> grad{0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<int64_t> unique_indices(8);
+  std::vector<float> summed_grad(8);
+  std::vector<int64_t> tmp_indices(8);
+  std::vector<float> tmp_grad(8);
+  SparseGradient<int64_t> unique_grad({summed_grad.data(), unique_indices.data(), 8});
+  SparseGradient<int64_t> workspace_grad({tmp_grad.data(), tmp_indices.data(), 8});
+  SparseGradient<int64_t> input_grad({grad.data(), indices.data(), 8});
+
+  ReduceSparseGradientParam<int64_t> param;
+  param.input_grad_ = &input_grad;
+  param.workspace_grad_ = &workspace_grad;
+  param.output_grad_ = &unique_grad;
+  param.max_index_ = 8;
+  param.value_stride_ = 1;
+  SparseOptimizerCpuKernelMod::BucketReduceSparseGradient(param);
+
+  // The unique indices are sorted.
+  EXPECT_EQ(unique_grad.indices_size_, 4);
+  std::vector<int64_t> expect_indices({0, 2, 5, 7});
+  std::vector<float> expect_value({7, 7, 3, 4});
+  for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+    EXPECT_EQ(unique_grad.indices_[i], expect_indices[i]);
+    EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
+  }
+}
+
+/// Feature: reduce sparse gradients by buckets.
+/// Description: the indices spread over a range wider than 2^32, so the buckets are wider than the sort key offset.
+/// Expectation: the buckets fall back to sorting the positions, and the output is unique, sorted and summed.
+TEST_F(CommonUtilTest, BucketReduceSparseGradientWideBuckets) {
+  const int64_t max_index = static_cast<int64_t>(1) << 40;
+  std::vector<int64_t> indices;
+  for (int64_t i = 0; i < 200; ++i) {
+    indices.push_back((i % 23) * (max_index / 23) + i % 3);
+  }
+  indices.push_back(-1);
+  indices.push_back(max_index);
+  CheckBucketReduceSparseGradient(indices, static_cast<size_t>(max_index), 1);
+  CheckBucketReduceSparseGradient(indices, static_cast<size_t>(max_index), 2);
+  CheckBucketReduceSparseGradient(indices, static_cast<size_t>(max_index), 4);
+}
+
+/// Feature: reduce sparse gradients by buckets.
+/// Description: most of the indices are a few hot low ids, the rest spread over a large range, and they are reduced
+/// by several buckets.
+/// Expectation: the output is unique, sorted and summed with any number of buckets.
+TEST_F(CommonUtilTest, BucketReduceSparseGradientSkewed) {
+  const size_t max_index = 100000;
+  std::vector<int64_t> indices;
+  for (int64_t i = 0; i < 4000; ++i) {
+    indices.push_back(i % 10 == 0 ? (i * 7919) % static_cast<int64_t>(max_index) : i % 3);
+  }
+  for (size_t thread_num : {2, 3, 8, 16}) {
+    CheckBucketReduceSparseGradient(indices, max_index, thread_num);
+  }
+  // all of the indices are one hot id
+  CheckBucketReduceSparseGradient(std::vector<int64_t>(100, 5), max_index, 8);
+}
 }  // namespace kernel
 }  // namespace mindspore
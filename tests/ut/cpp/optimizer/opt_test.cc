@@ -80,6 +80,23 @@ class TestOptOpt : public UT::Common {
     AnfNodePtr v_{nullptr};
   };
 
+  // P(P(x)) -> P(x), which keeps no state and can be matched on the func graphs concurrently.
+  class StatelessIdempotentEliminater : public OptimizerCaller {
+   public:
+    AnfNodePtr operator()(const OptimizerPtr &, const AnfNodePtr &node) override {
+      auto cnode = dyn_cast<CNode>(node);
+      if (!IsPrimitiveCNode(node, P) || cnode->size() != 2 || !IsPrimitiveCNode(cnode->input(1), P) ||
+          node->func_graph() == nullptr) {
+        return nullptr;
+      }
+      auto input = cnode->input(1)->cast<CNodePtr>();
+      if (input->size() != 2) {
+        return nullptr;
+      }
+      return node->func_graph()->NewCNode({NewValueNode(P), input->input(1)});
+    }
+  };
+
   void SetUp() {
     elim_Z = MakeSubstitution(std::make_shared<irpass::ArithmeticSimplify>(), "elim_Z", prim::kPrimScalarAdd);
     elim_R = MakeSubstitution(std::make_shared<irpass::PrimEliminater>(R), "elim_R", R);
@@ -213,6 +230,67 @@ TEST_F(TestOptOpt, CSE) {
   ASSERT_EQ(manager2->all_nodes().size(), 12);
 }
 
+namespace {
+AnfNodePtr NewPrimChain(const FuncGraphPtr &fg, const PrimitivePtr &prim, AnfNodePtr node, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    node = fg->NewCNode({NewValueNode(prim), node});
+  }
+  return node;
+}
+
+// root(x) = (fg1(x), fg2(x)), fg1(y) = (a, inner()) where a = P(P(P(P(y)))) and inner uses the free variable a by
+// P(P(a)), fg2(z) = P(P(P(z))).
+FuncGraphPtr MakeChainsGraph(const PrimitivePtr &prim) {
+  constexpr size_t kOuterChainLength = 4;
+  constexpr size_t kInnerChainLength = 2;
+  constexpr size_t kOtherChainLength = 3;
+  auto fg1 = std::make_shared<FuncGraph>();
+  auto a = NewPrimChain(fg1, prim, fg1->add_parameter(), kOuterChainLength);
+  auto inner = std::make_shared<FuncGraph>();
+  inner->set_output(NewPrimChain(inner, prim, a, kInnerChainLength));
+  fg1->set_output(fg1->NewCNode({NewValueNode(prim::kPrimMakeTuple), a, fg1->NewCNode({NewValueNode(inner)})}));
+
+  auto fg2 = std::make_shared<FuncGraph>();
+  fg2->set_output(NewPrimChain(fg2, prim, fg2->add_parameter(), kOtherChainLength));
+
+  auto root = std::make_shared<FuncGraph>();
+  auto x = root->add_parameter();
+  root->set_output(root->NewCNode({NewValueNode(prim::kPrimMakeTuple), root->NewCNode({NewValueNode(fg1), x}),
+                                   root->NewCNode({NewValueNode(fg2), x})}));
+  return root;
+}
+}  // namespace
+
+/// Feature: apply the local substitutions to the func graphs in parallel.
+/// Description: eliminate the chains of an idempotent primitive serially and in parallel, where the result of the inner
+/// func graph uses the node replaced in its parent func graph.
+/// Expectation: the parallel mode eliminates all the chains as the serial mode does.
+TEST_F(TestOptOpt, ParallelLocalSubstitutions) {
+  auto idempotent = MakeSubstitution(std::make_shared<StatelessIdempotentEliminater>(), "stateless_idempotent_P", P);
+  idempotent->is_local_ = true;
+  SubstitutionList transform(std::vector<SubstitutionPtr>({idempotent}));
+  auto root = MakeChainsGraph(P);
+  auto run = [&root, &transform](const std::string &parallel) {
+    FuncGraphPtr fg = BasicClone(root);
+    OptimizerPtr optimizer = std::make_shared<Optimizer>("ut_test", std::make_shared<pipeline::Resource>());
+    (void)common::SetEnv("MS_DEV_PARALLEL_SUBSTITUTION", parallel.c_str());
+    EXPECT_TRUE(transform(fg, optimizer));
+    (void)common::SetEnv("MS_DEV_PARALLEL_SUBSTITUTION", "");
+    return fg;
+  };
+  auto serial_fg = run("0");
+  auto parallel_fg = run("1");
+
+  for (auto &node : TopoSort(parallel_fg->get_return(), SuccDeeperSimple, AlwaysInclude)) {
+    if (IsPrimitiveCNode(node, P)) {
+      ASSERT_FALSE(IsPrimitiveCNode(node->cast<CNodePtr>()->input(1), P));
+    }
+  }
+  equiv_graph.clear();
+  equiv_node.clear();
+  ASSERT_TRUE(Isomorphic(serial_fg, parallel_fg, &equiv_graph, &equiv_node));
+}
+
 size_t TupleArgAndParamSum(const FuncGraphPtr &func_graph) {
   // Check tuple params and tuple args.
   auto all_nodes = TopoSort(func_graph->return_node(), SuccDeeperSimple, AlwaysInclude);
@@ -163,5 +163,31 @@ TEST_F(TestEdgeCostModel, test_EdgeEliminationSetNewCost) {
   new_edge->EdgeEliminationSetNewCost(matmul1, edges, matmul5);
 }
 
+TEST_F(TestEdgeCostModel, test_InitEdgeCost_shared_redistribution_cost) {
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  std::shared_ptr<Edge> edge_m4_m2 = std::make_shared<Edge>(edge_name, matmul4, matmul2, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  matmul4->GenerateStrategies(0);
+  Edge::ClearRedistributionCostCache();
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(edge_m4_m2->InitEdgeCost(), SUCCESS);
+
+  // matmul1 and matmul4 have the same shapes, so the two edges have the same redistribution costs.
+  auto get_costs = [](const std::map<CostPtrKey, CostPtrList> &cost_map) {
+    std::vector<double> costs;
+    for (auto &item : cost_map) {
+      costs.push_back(item.second[0]->communication_cost_);
+    }
+    std::sort(costs.begin(), costs.end());
+    return costs;
+  };
+  auto cost_map_1 = edge_m1_m2->GetCostMap();
+  auto cost_map_2 = edge_m4_m2->GetCostMap();
+  ASSERT_EQ(get_costs(cost_map_1), get_costs(cost_map_2));
+  ASSERT_NE(cost_map_1.begin()->second[0], cost_map_2.begin()->second[0]);
+}
+
 }  // namespace parallel
 }  // namespace mindspore
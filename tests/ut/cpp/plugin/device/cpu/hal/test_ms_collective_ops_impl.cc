@@ -0,0 +1,145 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "distributed/cluster/topology/compute_graph_node.h"
+#include "distributed/cluster/topology/meta_server_node.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_topo.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "utils/ms_utils.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestMSCollectiveOpsImpl : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+// Run AllReduce with a small message(recursive doubling) and a large message(pipelined ring) on total_node_num
+// in-process ranks, and check that every rank gets the element-wise sum of the data of all ranks.
+template <typename T>
+void RunAllReduceSum(size_t total_node_num, const std::string &server_port) {
+  std::string server_host = "127.0.0.1";
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerHost, server_host.c_str());
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerPort, server_port.c_str());
+
+  std::vector<std::shared_ptr<distributed::cluster::topology::ComputeGraphNode>> cgns;
+  distributed::cluster::topology::MetaServerNode msn("meta_server_node", "scheduler", total_node_num);
+  ASSERT_TRUE(msn.Initialize());
+
+  for (size_t i = 0; i < total_node_num; ++i) {
+    auto cgn = std::make_shared<distributed::cluster::topology::ComputeGraphNode>(
+      "compute_graph_node_" + std::to_string(i + 1), "worker");
+    ASSERT_TRUE(cgn->Initialize());
+    cgns.push_back(cgn);
+  }
+
+  size_t interval = 1;
+  size_t retry = 30;
+  while (((msn.GetAliveNodeNum() != total_node_num) ||
+          (msn.TopologyState() != distributed::cluster::topology::TopoState::kInitialized)) &&
+         (retry-- > 0)) {
+    sleep(interval);
+  }
+  ASSERT_EQ(distributed::cluster::topology::TopoState::kInitialized, msn.TopologyState());
+
+  // Create the topo nodes and the collective ops.
+  std::vector<std::shared_ptr<TopologyNode>> topo_nodes;
+  std::vector<std::shared_ptr<MSCollectiveOpsImpl>> collective_ops;
+  for (size_t i = 0; i < total_node_num; ++i) {
+    auto node = std::make_shared<TopologyNode>(total_node_num, cgns[i]);
+    topo_nodes.push_back(node);
+    node->Initialize();
+  }
+  for (size_t i = 0; i < total_node_num; ++i) {
+    ASSERT_TRUE(topo_nodes[i]->Initialized());
+    auto ops = std::make_shared<MSCollectiveOpsImpl>(topo_nodes[i]);
+    ASSERT_TRUE(ops->Initialize());
+    collective_ops.push_back(ops);
+  }
+
+  // The sums are small integers, which are exact in every tested data type.
+  const size_t modulus = 7;
+  std::vector<size_t> counts = {16, 3 * kRingAllReduceSliceSize / sizeof(T) + 1};
+  for (auto count : counts) {
+    std::vector<std::vector<T>> outputs(total_node_num, std::vector<T>(count, T(0)));
+    std::vector<std::thread> threads;
+    std::vector<int> results(total_node_num, 0);
+    for (size_t i = 0; i < total_node_num; ++i) {
+      threads.emplace_back([&, i]() {
+        std::vector<T> input(count);
+        for (size_t j = 0; j < count; ++j) {
+          input[j] = T(static_cast<float>(j % modulus + i));
+        }
+        results[i] = collective_ops[i]->AllReduce<T>("test", input.data(), outputs[i].data(), count);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    for (size_t i = 0; i < total_node_num; ++i) {
+      ASSERT_TRUE(results[i]);
+      for (size_t j = 0; j < count; ++j) {
+        float expect = static_cast<float>(total_node_num * (j % modulus) + total_node_num * (total_node_num - 1) / 2);
+        ASSERT_EQ(expect, static_cast<float>(outputs[i][j]));
+      }
+    }
+  }
+
+  // Destroy the topo nodes.
+  for (size_t i = 0; i < total_node_num; ++i) {
+    topo_nodes[i]->Finalize();
+  }
+  for (auto &cgn : cgns) {
+    cgn->Finalize();
+  }
+  retry = 30;
+  while ((msn.GetAliveNodeNum() > 0 || msn.TopologyState() != distributed::cluster::topology::TopoState::kFinished) &&
+         retry-- > 0) {
+    sleep(interval);
+  }
+  msn.Finalize();
+}
+
+/// Feature: test the AllReduce algorithms of cpu collective communication.
+/// Description: run AllReduce of float32 on topologies whose rank sizes are not a power of two.
+/// Expectation: every rank gets the element-wise sum of the data of all ranks.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceSum) {
+  RunAllReduceSum<float>(3, "8091");
+  RunAllReduceSum<float>(5, "8092");
+}
+
+/// Feature: test the AllReduce algorithms of cpu collective communication.
+/// Description: run AllReduce of float32 on a topology whose rank size is a power of two.
+/// Expectation: every rank gets the element-wise sum of the data of all ranks.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceSumPowerOfTwoRanks) { RunAllReduceSum<float>(4, "8093"); }
+
+/// Feature: test the AllReduce algorithms of cpu collective communication.
+/// Description: run AllReduce of float16 and int32 on topologies whose rank sizes are 4 and 5.
+/// Expectation: every rank gets the element-wise sum of the data of all ranks.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceSumFp16AndInt32) {
+  RunAllReduceSum<float16>(4, "8094");
+  RunAllReduceSum<float16>(5, "8095");
+  RunAllReduceSum<int>(5, "8096");
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,224 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/graph_scheduler/dynamic_memory_planner.h"
+
+namespace mindspore {
+namespace runtime {
+using DeviceAddress = device::DeviceAddress;
+using DeviceAddressPtr = device::DeviceAddressPtr;
+using DeviceContextKey = device::DeviceContextKey;
+
+class PlannerTestDeviceAddress : public DeviceAddress {
+ public:
+  explicit PlannerTestDeviceAddress(size_t size) : DeviceAddress(nullptr, size) {}
+  ~PlannerTestDeviceAddress() override = default;
+  bool SyncDeviceToHost(const ShapeVector &shape, size_t size, TypeId type, void *host_ptr) const override {
+    return true;
+  }
+  bool SyncHostToDevice(const ShapeVector &shape, size_t size, TypeId type, const void *host_ptr,
+                        const std::string &format) const override {
+    return true;
+  }
+  void ClearDeviceMemory() override {}
+};
+
+class PlannerTestDeviceResManager : public device::DeviceResManager {
+ public:
+  PlannerTestDeviceResManager() = default;
+  ~PlannerTestDeviceResManager() override = default;
+
+  void *AllocateMemory(size_t size) const override { return malloc(size); }
+  void FreeMemory(void *const ptr) const override { free(ptr); }
+  DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
+                                       TypeId type_id, const ShapeVector &shape) const override {
+    return std::make_shared<PlannerTestDeviceAddress>(device_size);
+  }
+};
+
+class PlannerTestDeviceContext : public device::DeviceInterface<PlannerTestDeviceResManager> {
+ public:
+  explicit PlannerTestDeviceContext(const DeviceContextKey &device_context_key)
+      : DeviceInterface(device_context_key) {}
+  ~PlannerTestDeviceContext() override = default;
+
+  void Initialize() override {}
+  device::RunMode GetRunMode(const FuncGraphPtr &func_graph) const override { return device::RunMode::kKernelMode; }
+};
+
+// The actor only provides the input arrows for the reachability of planner.
+class PlannerTestActor : public AbstractActor {
+ public:
+  explicit PlannerTestActor(const std::string &name)
+      : AbstractActor(name, KernelTransformType::kKernelActor, nullptr) {}
+  ~PlannerTestActor() override = default;
+
+  void AddInputActor(const AbstractActor *input_actor) {
+    MS_EXCEPTION_IF_NULL(input_actor);
+    (void)input_control_arrow_aids_.emplace_back(input_actor->GetAID(), nullptr);
+  }
+};
+
+class DynamicMemoryPlannerTest : public UT::Common {
+ public:
+  DynamicMemoryPlannerTest() : device_context_(DeviceContextKey{"CPU", 0}) {}
+
+  void SetUp() override {
+    // The actors of chain: actor0 --> actor1 --> actor2 --> actor3.
+    for (size_t i = 0; i < kActorNum; ++i) {
+      auto actor = std::make_shared<PlannerTestActor>("actor" + std::to_string(i));
+      if (i > 0) {
+        actor->AddInputActor(actors_[i - 1].get());
+      }
+      (void)actors_.emplace_back(actor);
+    }
+    planner_ = std::make_shared<DynamicMemoryPlanner>("test_actor_set", &device_context_);
+    planner_->Init(actors_);
+  }
+
+  std::vector<std::vector<TensorPtr>> InputTensors(int64_t dim) const {
+    return {{std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{dim})}};
+  }
+
+  // Run one step by the actor order: device_tensors[i] is produced by actor i and used by actor i + 1, the last one is
+  // the graph output which isn't freed in the step.
+  std::vector<bool> RunStep(const std::vector<PlannerTestDeviceAddress *> &device_tensors, bool is_success) {
+    std::vector<bool> is_served;
+    for (size_t i = 0; i < device_tensors.size(); ++i) {
+      auto actor_name = actors_[i]->GetAID().Name();
+      bool is_planned = planner_->Allocate(device_tensors[i], actor_name);
+      if (!is_planned) {
+        device_tensors[i]->set_ptr(device_context_.device_res_manager_->AllocateMemory(device_tensors[i]->GetSize()));
+        device_tensors[i]->set_from_mem_pool(true);
+      }
+      (void)is_served.emplace_back(is_planned);
+      if (i == 0) {
+        continue;
+      }
+      auto input = device_tensors[i - 1];
+      planner_->RecordUser(input, actor_name);
+      if (!planner_->Free(input)) {
+        device_context_.device_res_manager_->FreeMemory(input->GetMutablePtr());
+        input->set_ptr(nullptr);
+      }
+    }
+    planner_->EndStep(is_success);
+    return is_served;
+  }
+
+  void FreeMemory(PlannerTestDeviceAddress *device_tensor) {
+    if (device_tensor->GetPtr() != nullptr) {
+      device_context_.device_res_manager_->FreeMemory(device_tensor->GetMutablePtr());
+      device_tensor->set_ptr(nullptr);
+    }
+  }
+
+  static constexpr size_t kActorNum = 4;
+  static constexpr size_t kMemorySize = 1024;
+  PlannerTestDeviceContext device_context_;
+  std::vector<AbstractActorPtr> actors_;
+  DynamicMemoryPlannerPtr planner_;
+};
+
+/// Feature: Dynamic memory planner.
+/// Description: Record the first step and serve the following step with the same input shapes from the arena.
+/// Expectation: The freed memory is served from the arena and reused after all its users finish, the graph output and
+/// the memory of new input shapes fall back to the memory pool.
+TEST_F(DynamicMemoryPlannerTest, test_dynamic_memory_planner_serve) {
+  PlannerTestDeviceAddress tensor0(kMemorySize);
+  PlannerTestDeviceAddress tensor1(kMemorySize);
+  PlannerTestDeviceAddress tensor2(kMemorySize);
+  PlannerTestDeviceAddress output(kMemorySize);
+  std::vector<PlannerTestDeviceAddress *> device_tensors{&tensor0, &tensor1, &tensor2, &output};
+
+  planner_->BeginStep(InputTensors(2));
+  auto is_served = RunStep(device_tensors, true);
+  ASSERT_EQ(is_served, std::vector<bool>(kActorNum, false));
+  FreeMemory(&output);
+
+  // The memory of tensor0 is freed by actor1 which reaches the producer of tensor2, so they share the same offset.
+  std::vector<const void *> served_ptrs;
+  planner_->BeginStep(InputTensors(2));
+  for (size_t i = 0; i < device_tensors.size(); ++i) {
+    auto actor_name = actors_[i]->GetAID().Name();
+    bool is_planned = planner_->Allocate(device_tensors[i], actor_name);
+    ASSERT_EQ(is_planned, i + 1 < device_tensors.size());
+    (void)served_ptrs.emplace_back(device_tensors[i]->GetPtr());
+    if (i > 0 && is_planned) {
+      ASSERT_FALSE(device_tensors[i]->from_mem_pool());
+      ASSERT_TRUE(planner_->Free(device_tensors[i - 1]));
+      ASSERT_EQ(device_tensors[i - 1]->GetPtr(), nullptr);
+    }
+  }
+  ASSERT_EQ(served_ptrs[0], served_ptrs[2]);
+  ASSERT_NE(served_ptrs[0], served_ptrs[1]);
+  ASSERT_TRUE(planner_->Free(&tensor2));
+  planner_->EndStep(true);
+
+  // The allocation by the other actor mismatches the plan.
+  planner_->BeginStep(InputTensors(2));
+  ASSERT_FALSE(planner_->Allocate(&tensor0, actors_[1]->GetAID().Name()));
+  planner_->EndStep(true);
+
+  // The new input shapes are recorded first.
+  planner_->BeginStep(InputTensors(3));
+  ASSERT_FALSE(planner_->Allocate(&tensor0, actors_[0]->GetAID().Name()));
+  planner_->EndStep(false);
+}
+
+/// Feature: Dynamic memory planner.
+/// Description: Fail the recording step, and use the served memory after the step.
+/// Expectation: The plan is invalidated and the memory used after the step is moved to the memory pool.
+TEST_F(DynamicMemoryPlannerTest, test_dynamic_memory_planner_invalidate) {
+  PlannerTestDeviceAddress tensor0(kMemorySize);
+  PlannerTestDeviceAddress tensor1(kMemorySize);
+  PlannerTestDeviceAddress output(kMemorySize);
+  std::vector<PlannerTestDeviceAddress *> device_tensors{&tensor0, &tensor1, &output};
+
+  // The failed recording step doesn't build the plan.
+  planner_->BeginStep(InputTensors(2));
+  (void)RunStep(device_tensors, false);
+  FreeMemory(&output);
+  planner_->BeginStep(InputTensors(2));
+  ASSERT_EQ(RunStep(device_tensors, true), std::vector<bool>(device_tensors.size(), false));
+  FreeMemory(&output);
+
+  planner_->BeginStep(InputTensors(4));
+  (void)RunStep(device_tensors, true);
+  FreeMemory(&output);
+
+  // The tensor0 isn't freed in the step, its memory is copied to the memory pool in the end of step.
+  planner_->BeginStep(InputTensors(4));
+  ASSERT_TRUE(planner_->Allocate(&tensor0, actors_[0]->GetAID().Name()));
+  auto served_ptr = static_cast<uint8_t *>(tensor0.GetMutablePtr());
+  served_ptr[0] = 1;
+  planner_->EndStep(true);
+  ASSERT_TRUE(tensor0.from_mem_pool());
+  ASSERT_NE(tensor0.GetPtr(), served_ptr);
+  ASSERT_EQ(static_cast<uint8_t *>(tensor0.GetMutablePtr())[0], 1);
+  FreeMemory(&tensor0);
+
+  planner_->BeginStep(InputTensors(4));
+  ASSERT_FALSE(planner_->Allocate(&tensor0, actors_[0]->GetAID().Name()));
+  planner_->EndStep(true);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/pynative/op_kernel_cache.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace runtime {
+using KernelGraph = session::KernelGraph;
+
+class CacheTestKernelMod : public kernel::NativeCpuKernelMod {
+ public:
+  explicit CacheTestKernelMod(bool is_need_retrieve_output_shape = false) {
+    is_need_retrieve_output_shape_ = is_need_retrieve_output_shape;
+  }
+  ~CacheTestKernelMod() override = default;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override {
+    return true;
+  }
+};
+
+class CacheTestDeprecatedKernelMod : public kernel::DeprecatedNativeCpuKernelMod {
+ public:
+  CacheTestDeprecatedKernelMod() = default;
+  ~CacheTestDeprecatedKernelMod() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override {}
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override {
+    return true;
+  }
+};
+
+class OpKernelCacheTest : public UT::Common {
+ public:
+  OpKernelCacheTest() = default;
+
+  void SetUp() override {
+    auto ms_context = MsContext::GetInstance();
+    MS_EXCEPTION_IF_NULL(ms_context);
+    enable_op_graph_cache_ = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_OP_GRAPH_CACHE);
+    ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_OP_GRAPH_CACHE, true);
+  }
+
+  void TearDown() override {
+    OpKernelCache::GetInstance().Clear();
+    auto ms_context = MsContext::GetInstance();
+    MS_EXCEPTION_IF_NULL(ms_context);
+    ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_OP_GRAPH_CACHE, enable_op_graph_cache_);
+  }
+
+  // The single op graph: the kernels of the op and its following op are set to the execution order in turn.
+  static std::shared_ptr<KernelGraph> BuildGraph(const std::vector<kernel::KernelModPtr> &kernel_mods) {
+    auto graph = std::make_shared<KernelGraph>();
+    std::vector<CNodePtr> execution_order;
+    AnfNodePtr input = graph->add_parameter();
+    for (const auto &kernel_mod : kernel_mods) {
+      std::vector<AnfNodePtr> inputs{NewValueNode(std::make_shared<Primitive>("Abs")), input};
+      auto node = graph->NewCNode(inputs);
+      MS_EXCEPTION_IF_NULL(node);
+      node->set_kernel_info(std::make_shared<device::KernelInfo>());
+      if (kernel_mod != nullptr) {
+        AnfAlgo::SetKernelMod(kernel_mod, node.get());
+      }
+      (void)execution_order.emplace_back(node);
+      input = node;
+    }
+    graph->set_execution_order(execution_order);
+    return graph;
+  }
+
+  static std::vector<kernel::KernelModPtr> GetKernelMods(const std::shared_ptr<KernelGraph> &graph) {
+    std::vector<kernel::KernelModPtr> kernel_mods;
+    for (const auto &node : graph->execution_order()) {
+      auto kernel_info = dynamic_cast<device::KernelInfo *>(node->kernel_info());
+      MS_EXCEPTION_IF_NULL(kernel_info);
+      (void)kernel_mods.emplace_back(kernel_info->GetKernelModPtr());
+    }
+    return kernel_mods;
+  }
+
+  bool enable_op_graph_cache_{true};
+};
+
+/// Feature: PyNative op kernel cache.
+/// Description: Save the kernels of a built graph, and fetch them for the graphs with the same and other graph info.
+/// Expectation: The graph with the same graph info shares the kernel mods, the other graph and the graph with a
+/// different kernel number miss the cache.
+TEST_F(OpKernelCacheTest, test_op_kernel_cache_hit) {
+  auto &cache = OpKernelCache::GetInstance();
+  std::vector<kernel::KernelModPtr> kernel_mods{std::make_shared<CacheTestKernelMod>(),
+                                                std::make_shared<CacheTestKernelMod>()};
+  cache.SaveKernels("Abs_f32_2", BuildGraph(kernel_mods));
+
+  auto graph = BuildGraph({nullptr, nullptr});
+  ASSERT_TRUE(cache.FetchKernels("Abs_f32_2", graph));
+  ASSERT_EQ(GetKernelMods(graph), kernel_mods);
+
+  auto other_graph = BuildGraph({nullptr, nullptr});
+  ASSERT_FALSE(cache.FetchKernels("Abs_f32_3", other_graph));
+  ASSERT_EQ(GetKernelMods(other_graph), std::vector<kernel::KernelModPtr>(2, nullptr));
+  ASSERT_FALSE(cache.FetchKernels("Abs_f32_2", BuildGraph({nullptr})));
+
+  cache.Erase("Abs_f32_2");
+  ASSERT_FALSE(cache.FetchKernels("Abs_f32_2", BuildGraph({nullptr, nullptr})));
+}
+
+/// Feature: PyNative op kernel cache.
+/// Description: Save the graphs holding a deprecated native cpu kernel or a kernel retrieving the output shape.
+/// Expectation: Nothing is cached, the graphs with the same graph info build their own kernels.
+TEST_F(OpKernelCacheTest, test_op_kernel_cache_not_shareable) {
+  auto &cache = OpKernelCache::GetInstance();
+  cache.SaveKernels("Unique_f32_2",
+                    BuildGraph({std::make_shared<CacheTestKernelMod>(), std::make_shared<CacheTestKernelMod>(true)}));
+  ASSERT_FALSE(cache.FetchKernels("Unique_f32_2", BuildGraph({nullptr, nullptr})));
+
+  cache.SaveKernels("Abs_f32_2", BuildGraph({std::make_shared<CacheTestDeprecatedKernelMod>()}));
+  ASSERT_FALSE(cache.FetchKernels("Abs_f32_2", BuildGraph({nullptr})));
+}
+
+/// Feature: PyNative op kernel cache.
+/// Description: Disable the op graph cache of the context, then save and fetch the kernels.
+/// Expectation: Nothing is saved or fetched while disabled, the kernels saved before are fetched after enabled again.
+TEST_F(OpKernelCacheTest, test_op_kernel_cache_switch) {
+  auto &cache = OpKernelCache::GetInstance();
+  auto ms_context = MsContext::GetInstance();
+  std::vector<kernel::KernelModPtr> kernel_mods{std::make_shared<CacheTestKernelMod>()};
+  cache.SaveKernels("Abs_f32_2", BuildGraph(kernel_mods));
+
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_OP_GRAPH_CACHE, false);
+  ASSERT_FALSE(OpKernelCache::IsEnabled());
+  auto graph = BuildGraph({nullptr});
+  ASSERT_FALSE(cache.FetchKernels("Abs_f32_2", graph));
+  ASSERT_EQ(GetKernelMods(graph), std::vector<kernel::KernelModPtr>{nullptr});
+  cache.SaveKernels("Abs_f32_3", BuildGraph({std::make_shared<CacheTestKernelMod>()}));
+
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_OP_GRAPH_CACHE, true);
+  ASSERT_FALSE(cache.FetchKernels("Abs_f32_3", BuildGraph({nullptr})));
+  ASSERT_TRUE(cache.FetchKernels("Abs_f32_2", graph));
+  ASSERT_EQ(GetKernelMods(graph), kernel_mods);
+}
+}  // namespace runtime
+}  // namespace mindspore